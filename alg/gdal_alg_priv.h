@@ -20,6 +20,7 @@
 
 #include <cstdint>
 
+#include <memory>
 #include <set>
 
 #include "gdal_alg.h"
@@ -170,6 +171,7 @@ void CPL_DLL *GDALRegisterTransformDeserializer(
 void CPL_DLL GDALUnregisterTransformDeserializer(void *pData);
 
 void GDALCleanupTransformDeserializerMutex();
+void GDALCleanupApproxTransformerCaches();
 
 /* Transformer cloning */
 
@@ -280,6 +282,9 @@ struct GDALReprojectionTransformInfo
 /* ==================================================================== */
 /************************************************************************/
 
+struct GDALTransformPointCache;
+struct GDALApproxTransformGrid;
+
 struct GDALApproxTransformInfo
 {
     GDALTransformerInfo sTI;
@@ -291,6 +296,18 @@ struct GDALApproxTransformInfo
 
     int bOwnSubtransformer = 0;
 
+    // Results of the base transformer, shared with all the approximate
+    // transformers whose base transformer serializes identically.
+    // Only used if GDAL_APPROX_TRANSFORMER_CACHE_SIZE is set.
+    std::shared_ptr<GDALTransformPointCache> poCache{};
+    bool bCacheLookupDone = false;
+
+    // Spacing in pixels of the grid of exactly transformed points used to
+    // interpolate whole scanlines in 2D (GDAL_APPROX_TRANSFORMER_GRID_STEP),
+    // or 0 to only interpolate along scanlines.
+    int nGridStep = 0;
+    std::shared_ptr<GDALApproxTransformGrid> poGrid{};
+
     GDALApproxTransformInfo() : sTI()
     {
         memset(&sTI, 0, sizeof(sTI));
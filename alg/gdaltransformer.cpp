@@ -26,11 +26,18 @@
 
 #include <algorithm>
 #include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_list.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
@@ -3990,6 +3997,8 @@ GDALCreateApproxTransformer2(GDALTransformerFunc pfnBaseTransformer,
     psATInfo->dfMaxErrorForward = dfMaxErrorForward;
     psATInfo->dfMaxErrorReverse = dfMaxErrorReverse;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->nGridStep = std::max(
+        0, atoi(CPLGetConfigOption("GDAL_APPROX_TRANSFORMER_GRID_STEP", "0")));
 
     memcpy(psATInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE,
            strlen(GDAL_GTI2_SIGNATURE));
@@ -4044,6 +4053,225 @@ void GDALDestroyApproxTransformer(void *pCBData)
     delete psATInfo;
 }
 
+/************************************************************************/
+/*                       GDALTransformPointCache                        */
+/************************************************************************/
+
+// Least recently used cache of the results of a base transformer, keyed by
+// the input coordinates.
+struct GDALTransformPointCache
+{
+    struct Key
+    {
+        double x;
+        double y;
+        double z;
+        int bDstToSrc;
+
+        bool operator==(const Key &other) const
+        {
+            return x == other.x && y == other.y && z == other.z &&
+                   bDstToSrc == other.bDstToSrc;
+        }
+    };
+
+    struct KeyHasher
+    {
+        size_t operator()(const Key &k) const
+        {
+            size_t nHash = std::hash<double>()(k.x);
+            nHash = nHash * 31 + std::hash<double>()(k.y);
+            nHash = nHash * 31 + std::hash<double>()(k.z);
+            return nHash * 31 + static_cast<size_t>(k.bDstToSrc);
+        }
+    };
+
+    struct Value
+    {
+        double x;
+        double y;
+        double z;
+        int bSuccess;
+    };
+
+    std::mutex oMutex{};
+    lru11::Cache<Key, Value, lru11::NullLock,
+                 std::unordered_map<
+                     Key,
+                     typename std::list<lru11::KeyValuePair<Key, Value>>::
+                         iterator,
+                     KeyHasher>>
+        oCache;
+
+    explicit GDALTransformPointCache(size_t nMaxSize)
+        : oCache(nMaxSize, nMaxSize / 10)
+    {
+    }
+};
+
+// Caches shared by approximate transformers, keyed by the serialization of
+// their base transformer.
+static std::mutex goApproxTransformerCachesMutex;
+static lru11::Cache<std::string, std::shared_ptr<GDALTransformPointCache>>
+    *gpoApproxTransformerCaches = nullptr;
+
+/************************************************************************/
+/*                GDALCleanupApproxTransformerCaches()                  */
+/************************************************************************/
+
+void GDALCleanupApproxTransformerCaches()
+{
+    std::lock_guard oLock(goApproxTransformerCachesMutex);
+    delete gpoApproxTransformerCaches;
+    gpoApproxTransformerCaches = nullptr;
+}
+
+/************************************************************************/
+/*                   GDALApproxTransformerGetCache()                    */
+/************************************************************************/
+
+static GDALTransformPointCache *
+GDALApproxTransformerGetCache(GDALApproxTransformInfo *psATInfo)
+{
+    if (psATInfo->bCacheLookupDone)
+        return psATInfo->poCache.get();
+    psATInfo->bCacheLookupDone = true;
+
+    const GIntBig nMaxSize = CPLAtoGIntBig(
+        CPLGetConfigOption("GDAL_APPROX_TRANSFORMER_CACHE_SIZE", "0"));
+    if (nMaxSize <= 0)
+        return nullptr;
+
+    // Transformers that cannot be serialized are not cached, as we would
+    // have no way of knowing which other transformers are identical.
+    CPLXMLNode *psTree = nullptr;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        psTree = GDALSerializeTransformer(psATInfo->pfnBaseTransformer,
+                                          psATInfo->pBaseCBData);
+    }
+    if (psTree == nullptr)
+        return nullptr;
+    char *pszXML = CPLSerializeXMLTree(psTree);
+    CPLDestroyXMLNode(psTree);
+    if (pszXML == nullptr)
+        return nullptr;
+
+    // CHECK_WITH_INVERT_PROJ is not serialized but affects results.
+    std::string osKey(pszXML);
+    CPLFree(pszXML);
+    osKey += CPLGetConfigOption("CHECK_WITH_INVERT_PROJ", "");
+    osKey += '/';
+    osKey += std::to_string(nMaxSize);
+
+    std::lock_guard oLock(goApproxTransformerCachesMutex);
+    if (gpoApproxTransformerCaches == nullptr)
+    {
+        gpoApproxTransformerCaches = new lru11::Cache<
+            std::string, std::shared_ptr<GDALTransformPointCache>>(8, 0);
+    }
+    if (!gpoApproxTransformerCaches->tryGet(osKey, psATInfo->poCache))
+    {
+        psATInfo->poCache = std::make_shared<GDALTransformPointCache>(
+            static_cast<size_t>(std::min<GIntBig>(
+                nMaxSize, std::numeric_limits<int>::max())));
+        gpoApproxTransformerCaches->insert(osKey, psATInfo->poCache);
+    }
+    return psATInfo->poCache.get();
+}
+
+/************************************************************************/
+/*                  GDALApproxTransformerResetCache()                   */
+/************************************************************************/
+
+static void GDALApproxTransformerResetCache(GDALApproxTransformInfo *psATInfo)
+{
+    psATInfo->poCache.reset();
+    psATInfo->bCacheLookupDone = false;
+    psATInfo->poGrid.reset();
+}
+
+/************************************************************************/
+/*                      GDALApproxTransformBase()                       */
+/************************************************************************/
+
+// Run the base transformer, going through the cache of its results if
+// GDAL_APPROX_TRANSFORMER_CACHE_SIZE is set.
+static int GDALApproxTransformBase(GDALApproxTransformInfo *psATInfo,
+                                   int bDstToSrc, int nPoints, double *x,
+                                   double *y, double *z, int *panSuccess)
+{
+    GDALTransformPointCache *poCache = GDALApproxTransformerGetCache(psATInfo);
+    if (poCache == nullptr)
+    {
+        return psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc,
+                                            nPoints, x, y, z, panSuccess);
+    }
+
+    std::vector<int> anMissing;
+    {
+        std::lock_guard oLock(poCache->oMutex);
+        for (int i = 0; i < nPoints; ++i)
+        {
+            GDALTransformPointCache::Value sValue;
+            if (poCache->oCache.tryGet({x[i], y[i], z[i], bDstToSrc}, sValue))
+            {
+                x[i] = sValue.x;
+                y[i] = sValue.y;
+                z[i] = sValue.z;
+                panSuccess[i] = sValue.bSuccess;
+            }
+            else
+            {
+                anMissing.push_back(i);
+            }
+        }
+    }
+    if (anMissing.empty())
+        return TRUE;
+
+    // Transform the missing points, and remember their input coordinates
+    // to insert them in the cache.
+    const size_t nMissing = anMissing.size();
+    std::vector<double> adfIn(3 * nMissing);
+    std::vector<int> anSuccess(nMissing);
+    for (size_t i = 0; i < nMissing; ++i)
+    {
+        adfIn[i] = x[anMissing[i]];
+        adfIn[nMissing + i] = y[anMissing[i]];
+        adfIn[2 * nMissing + i] = z[anMissing[i]];
+    }
+    std::vector<double> adfOut(adfIn);
+    const int bRet = psATInfo->pfnBaseTransformer(
+        psATInfo->pBaseCBData, bDstToSrc, static_cast<int>(nMissing),
+        adfOut.data(), adfOut.data() + nMissing, adfOut.data() + 2 * nMissing,
+        anSuccess.data());
+    for (size_t i = 0; i < nMissing; ++i)
+    {
+        x[anMissing[i]] = adfOut[i];
+        y[anMissing[i]] = adfOut[nMissing + i];
+        z[anMissing[i]] = adfOut[2 * nMissing + i];
+        panSuccess[anMissing[i]] = anSuccess[i];
+    }
+    if (!bRet)
+        return bRet;
+
+    std::lock_guard oLock(poCache->oMutex);
+    for (size_t i = 0; i < nMissing; ++i)
+    {
+        // NaN keys would never be found again.
+        if (std::isnan(adfIn[i]) || std::isnan(adfIn[nMissing + i]) ||
+            std::isnan(adfIn[2 * nMissing + i]))
+            continue;
+        poCache->oCache.insert(
+            {adfIn[i], adfIn[nMissing + i], adfIn[2 * nMissing + i],
+             bDstToSrc},
+            {adfOut[i], adfOut[nMissing + i], adfOut[2 * nMissing + i],
+             anSuccess[i]});
+    }
+    return bRet;
+}
+
 /************************************************************************/
 /*                  GDALRefreshApproxTransformer()                      */
 /************************************************************************/
@@ -4058,6 +4286,7 @@ void GDALRefreshApproxTransformer(void *hTransformArg)
     {
         GDALRefreshGenImgProjTransformer(psInfo->pBaseCBData);
     }
+    GDALApproxTransformerResetCache(psInfo);
 }
 
 /************************************************************************/
@@ -4159,34 +4388,31 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         int anSuccess2[3] = {};
         int bSuccess = FALSE;
         if (!bUseBaseTransformForHalf1 && !bUseBaseTransformForHalf2)
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, 3, xMiddle, yMiddle, zMiddle,
-                anSuccess2);
+            bSuccess = GDALApproxTransformBase(psATInfo, bDstToSrc, 3, xMiddle,
+                                               yMiddle, zMiddle, anSuccess2);
         else if (!bUseBaseTransformForHalf1)
         {
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, 2, xMiddle, yMiddle, zMiddle,
-                anSuccess2);
+            bSuccess = GDALApproxTransformBase(psATInfo, bDstToSrc, 2, xMiddle,
+                                               yMiddle, zMiddle, anSuccess2);
             anSuccess2[2] = TRUE;
         }
         else if (!bUseBaseTransformForHalf2)
         {
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, 1, xMiddle + 2, yMiddle + 2,
-                zMiddle + 2, anSuccess2 + 2);
+            bSuccess = GDALApproxTransformBase(
+                psATInfo, bDstToSrc, 1, xMiddle + 2, yMiddle + 2, zMiddle + 2,
+                anSuccess2 + 2);
             anSuccess2[0] = TRUE;
             anSuccess2[1] = TRUE;
         }
 
         if (!bSuccess || !anSuccess2[0] || !anSuccess2[1] || !anSuccess2[2])
         {
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, nMiddle - 1, x + 1, y + 1,
-                z + 1, panSuccess + 1);
-            bSuccess &= psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, nPoints - nMiddle - 2,
-                x + nMiddle + 1, y + nMiddle + 1, z + nMiddle + 1,
-                panSuccess + nMiddle + 1);
+            bSuccess = GDALApproxTransformBase(psATInfo, bDstToSrc, nMiddle - 1,
+                                               x + 1, y + 1, z + 1,
+                                               panSuccess + 1);
+            bSuccess &= GDALApproxTransformBase(
+                psATInfo, bDstToSrc, nPoints - nMiddle - 2, x + nMiddle + 1,
+                y + nMiddle + 1, z + nMiddle + 1, panSuccess + nMiddle + 1);
 
             x[0] = xSMETransformed[0];
             y[0] = ySMETransformed[0];
@@ -4223,9 +4449,9 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         }
         else
         {
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, nMiddle - 1, x + 1, y + 1,
-                z + 1, panSuccess + 1);
+            bSuccess = GDALApproxTransformBase(psATInfo, bDstToSrc, nMiddle - 1,
+                                               x + 1, y + 1, z + 1,
+                                               panSuccess + 1);
             x[0] = xSMETransformed[0];
             y[0] = ySMETransformed[0];
             z[0] = zSMETransformed[0];
@@ -4253,10 +4479,9 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
         }
         else
         {
-            bSuccess = psATInfo->pfnBaseTransformer(
-                psATInfo->pBaseCBData, bDstToSrc, nPoints - nMiddle - 2,
-                x + nMiddle + 1, y + nMiddle + 1, z + nMiddle + 1,
-                panSuccess + nMiddle + 1);
+            bSuccess = GDALApproxTransformBase(
+                psATInfo, bDstToSrc, nPoints - nMiddle - 2, x + nMiddle + 1,
+                y + nMiddle + 1, z + nMiddle + 1, panSuccess + nMiddle + 1);
 
             x[nMiddle] = xSMETransformed[1];
             y[nMiddle] = ySMETransformed[1];
@@ -4312,6 +4537,230 @@ static int GDALApproxTransformInternal(void *pCBData, int bDstToSrc,
     return TRUE;
 }
 
+/************************************************************************/
+/*                       GDALApproxTransformGrid                        */
+/************************************************************************/
+
+// Exact transformations, at every nGridStep pixels, of the two rows of a
+// grid surrounding the scanlines of a band, and of the centers of the cells
+// between those rows. Scanlines of the band are bilinearly interpolated in
+// the cells where the error at the center is acceptable.
+struct GDALApproxTransformGrid
+{
+    // Scanlines the grid is valid for.
+    double dfX0 = 0;
+    double dfXStep = 0;
+    double dfZ = 0;
+    int nPoints = 0;
+
+    // Index in scanlines of the columns of the grid.
+    std::vector<int> anCols{};
+
+    // Index of the current band, whose top row is at line
+    // 0.5 + iBand * nGridStep, or -1.
+    int iBand = -1;
+    std::vector<double> adfTop{};     // x, y, z of the columns.
+    std::vector<double> adfBottom{};  // x, y, z of the columns.
+    std::vector<bool> abCellValid{};
+};
+
+/************************************************************************/
+/*                  GDALApproxTransformIsGridScanline()                 */
+/************************************************************************/
+
+// Whether points form a scanline of regularly spaced pixels, long enough to
+// benefit from the grid.
+static bool
+GDALApproxTransformIsGridScanline(const GDALApproxTransformInfo *psATInfo,
+                                  int nPoints, const double *x, const double *y,
+                                  const double *z)
+{
+    if (nPoints <= 2 * psATInfo->nGridStep || !(x[1] > x[0]))
+        return false;
+    const double dfXStep = x[1] - x[0];
+    for (int i = 0; i < nPoints; ++i)
+    {
+        if (y[i] != y[0] || z[i] != z[0] || x[i] != x[0] + i * dfXStep)
+            return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     GDALApproxTransformSetupBand()                   */
+/************************************************************************/
+
+static void GDALApproxTransformSetupBand(GDALApproxTransformInfo *psATInfo,
+                                         GDALApproxTransformGrid &oGrid,
+                                         int iBand)
+{
+    const int nCols = static_cast<int>(oGrid.anCols.size());
+    const int nStep = psATInfo->nGridStep;
+    const double dfYTop = 0.5 + static_cast<double>(iBand) * nStep;
+
+    // When going down by one band, the bottom row becomes the top row.
+    const bool bReuseTop = oGrid.iBand >= 0 && iBand == oGrid.iBand + 1;
+    if (bReuseTop)
+        std::swap(oGrid.adfTop, oGrid.adfBottom);
+
+    // Transform the missing rows and the centers of the cells in a single
+    // call.
+    std::vector<double> adfX;
+    std::vector<double> adfY;
+    const auto AddPoints = [&oGrid, &adfX, &adfY](double dfPos, double dfY)
+    {
+        adfX.push_back(oGrid.dfX0 + dfPos * oGrid.dfXStep);
+        adfY.push_back(dfY);
+    };
+    if (!bReuseTop)
+    {
+        for (int c = 0; c < nCols; ++c)
+            AddPoints(oGrid.anCols[c], dfYTop);
+    }
+    for (int c = 0; c < nCols; ++c)
+        AddPoints(oGrid.anCols[c], dfYTop + nStep);
+    for (int c = 0; c + 1 < nCols; ++c)
+        AddPoints(0.5 * (oGrid.anCols[c] + oGrid.anCols[c + 1]),
+                  dfYTop + 0.5 * nStep);
+
+    const int nTransformed = static_cast<int>(adfX.size());
+    std::vector<double> adfZ(nTransformed, oGrid.dfZ);
+    std::vector<int> abSuccess(nTransformed);
+    if (!GDALApproxTransformBase(psATInfo, TRUE, nTransformed, adfX.data(),
+                                 adfY.data(), adfZ.data(), abSuccess.data()))
+    {
+        std::fill(abSuccess.begin(), abSuccess.end(), FALSE);
+    }
+
+    // Store rows as x, y, z triplets, with NaN for failed points.
+    int iPoint = 0;
+    const auto StoreRow = [&](std::vector<double> &adfRow)
+    {
+        adfRow.resize(3 * nCols);
+        for (int c = 0; c < nCols; ++c, ++iPoint)
+        {
+            const bool bOK = abSuccess[iPoint] &&
+                             std::isfinite(adfX[iPoint]) &&
+                             std::isfinite(adfY[iPoint]);
+            adfRow[3 * c] =
+                bOK ? adfX[iPoint] : std::numeric_limits<double>::quiet_NaN();
+            adfRow[3 * c + 1] = adfY[iPoint];
+            adfRow[3 * c + 2] = adfZ[iPoint];
+        }
+    };
+    if (!bReuseTop)
+        StoreRow(oGrid.adfTop);
+    StoreRow(oGrid.adfBottom);
+
+    // A cell is interpolated only if its corners could be transformed and
+    // if the interpolation of its center is within the error threshold.
+    oGrid.abCellValid.resize(nCols - 1);
+    for (int c = 0; c + 1 < nCols; ++c, ++iPoint)
+    {
+        const double *padfTop = oGrid.adfTop.data() + 3 * c;
+        const double *padfBottom = oGrid.adfBottom.data() + 3 * c;
+        const double dfInterpX =
+            0.25 * (padfTop[0] + padfTop[3] + padfBottom[0] + padfBottom[3]);
+        const double dfInterpY =
+            0.25 * (padfTop[1] + padfTop[4] + padfBottom[1] + padfBottom[4]);
+        // NaN corners give a NaN error, which fails the test.
+        const double dfError =
+            fabs(dfInterpX - adfX[iPoint]) + fabs(dfInterpY - adfY[iPoint]);
+        oGrid.abCellValid[c] =
+            abSuccess[iPoint] && dfError <= psATInfo->dfMaxErrorReverse;
+    }
+
+    oGrid.iBand = iBand;
+}
+
+/************************************************************************/
+/*                      GDALApproxTransformGridScanline()               */
+/************************************************************************/
+
+// Transform a scanline for which GDALApproxTransformIsGridScanline() is true
+// by interpolating in the grid, and falling back to the interpolation along
+// the scanline in the cells of the grid where the error is too large.
+static int GDALApproxTransformGridScanline(GDALApproxTransformInfo *psATInfo,
+                                           int nPoints, double *x, double *y,
+                                           double *z, int *panSuccess)
+{
+    if (!psATInfo->poGrid)
+        psATInfo->poGrid = std::make_shared<GDALApproxTransformGrid>();
+    GDALApproxTransformGrid &oGrid = *(psATInfo->poGrid);
+
+    const int nStep = psATInfo->nGridStep;
+    const double dfXStep = x[1] - x[0];
+    if (oGrid.nPoints != nPoints || oGrid.dfX0 != x[0] ||
+        oGrid.dfXStep != dfXStep || oGrid.dfZ != z[0])
+    {
+        oGrid.dfX0 = x[0];
+        oGrid.dfXStep = dfXStep;
+        oGrid.dfZ = z[0];
+        oGrid.nPoints = nPoints;
+        oGrid.anCols.clear();
+        for (int i = 0; i < nPoints - 1; i += nStep)
+            oGrid.anCols.push_back(i);
+        oGrid.anCols.push_back(nPoints - 1);
+        oGrid.iBand = -1;
+        CPLDebug("GDAL",
+                 "Approximate transformer: using a grid of step %d for "
+                 "scanlines of %d points",
+                 nStep, nPoints);
+    }
+
+    const double dfLine = (y[0] - 0.5) / nStep;
+    if (!(std::fabs(dfLine) < std::numeric_limits<int>::max() - 1))
+        return GDALApproxTransformBase(psATInfo, TRUE, nPoints, x, y, z,
+                                       panSuccess);
+    const int iBand = static_cast<int>(std::floor(dfLine));
+    if (iBand != oGrid.iBand)
+        GDALApproxTransformSetupBand(psATInfo, oGrid, iBand);
+    const double dfT = dfLine - iBand;
+
+    int bRet = TRUE;
+    const int nCols = static_cast<int>(oGrid.anCols.size());
+    for (int c = 0; c + 1 < nCols; ++c)
+    {
+        const int iStart = oGrid.anCols[c];
+        // The last cell includes the last point.
+        const int iEnd = c + 2 == nCols ? nPoints : oGrid.anCols[c + 1];
+        if (!oGrid.abCellValid[c])
+        {
+            // Points after iStart have not been modified yet.
+            if (!GDALApproxTransform(psATInfo, TRUE, iEnd - iStart, x + iStart,
+                                     y + iStart, z + iStart,
+                                     panSuccess + iStart))
+            {
+                bRet = FALSE;
+            }
+            continue;
+        }
+
+        const double *padfTop = oGrid.adfTop.data() + 3 * c;
+        const double *padfBottom = oGrid.adfBottom.data() + 3 * c;
+        double adfLeft[3];
+        double adfDelta[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            adfLeft[k] = padfTop[k] + dfT * (padfBottom[k] - padfTop[k]);
+            const double dfRight =
+                padfTop[k + 3] + dfT * (padfBottom[k + 3] - padfTop[k + 3]);
+            adfDelta[k] =
+                (dfRight - adfLeft[k]) / (oGrid.anCols[c + 1] - iStart);
+        }
+        for (int i = iStart; i < iEnd; ++i)
+        {
+            const int iOffset = i - iStart;
+            x[i] = adfLeft[0] + iOffset * adfDelta[0];
+            y[i] = adfLeft[1] + iOffset * adfDelta[1];
+            z[i] = adfLeft[2] + iOffset * adfDelta[2];
+            panSuccess[i] = TRUE;
+        }
+    }
+
+    return bRet;
+}
+
 /************************************************************************/
 /*                        GDALApproxTransform()                         */
 /************************************************************************/
@@ -4331,6 +4780,15 @@ int GDALApproxTransform(void *pCBData, int bDstToSrc, int nPoints, double *x,
 {
     GDALApproxTransformInfo *psATInfo =
         static_cast<GDALApproxTransformInfo *>(pCBData);
+
+    if (psATInfo->nGridStep > 0 && bDstToSrc &&
+        psATInfo->dfMaxErrorReverse > 0 &&
+        GDALApproxTransformIsGridScanline(psATInfo, nPoints, x, y, z))
+    {
+        return GDALApproxTransformGridScanline(psATInfo, nPoints, x, y, z,
+                                               panSuccess);
+    }
+
     double x2[3] = {};
     double y2[3] = {};
     double z2[3] = {};
@@ -4350,8 +4808,8 @@ int GDALApproxTransform(void *pCBData, int bDstToSrc, int nPoints, double *x,
          psATInfo->dfMaxErrorReverse == 0.0) ||
         nPoints <= 5)
     {
-        bRet = psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc,
-                                            nPoints, x, y, z, panSuccess);
+        bRet = GDALApproxTransformBase(psATInfo, bDstToSrc, nPoints, x, y, z,
+                                       panSuccess);
         goto end;
     }
 
@@ -4368,12 +4826,12 @@ int GDALApproxTransform(void *pCBData, int bDstToSrc, int nPoints, double *x,
     y2[2] = y[nPoints - 1];
     z2[2] = z[nPoints - 1];
 
-    bSuccess = psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc, 3,
-                                            x2, y2, z2, anSuccess2);
+    bSuccess = GDALApproxTransformBase(psATInfo, bDstToSrc, 3, x2, y2, z2,
+                                       anSuccess2);
     if (!bSuccess || !anSuccess2[0] || !anSuccess2[1] || !anSuccess2[2])
     {
-        bRet = psATInfo->pfnBaseTransformer(psATInfo->pBaseCBData, bDstToSrc,
-                                            nPoints, x, y, z, panSuccess);
+        bRet = GDALApproxTransformBase(psATInfo, bDstToSrc, nPoints, x, y, z,
+                                       panSuccess);
         goto end;
     }
 
@@ -4956,6 +5414,12 @@ void GDALSetTransformerDstGeoTransform(void *pTransformArg,
     if (psInfo)
     {
         GDALSetGenImgProjTransformerDstGeoTransform(psInfo, padfGeoTransform);
+        if (GDALIsTransformer(pTransformArg,
+                              GDAL_APPROX_TRANSFORMER_CLASS_NAME))
+        {
+            GDALApproxTransformerResetCache(
+                static_cast<GDALApproxTransformInfo *>(pTransformArg));
+        }
     }
 }
 
@@ -498,6 +498,7 @@ void GWKThreadsEnd(void *psThreadDataIn);
 
 /*! @cond Doxygen_Suppress */
 typedef struct _GDALWarpChunk GDALWarpChunk;
+struct GDALWarpPipeline;
 
 struct GDALTransformerUniquePtrReleaser
 {
@@ -541,8 +542,8 @@ class CPL_DLL GDALWarpOperation final
     static CPLErr CreateKernelMask(GDALWarpKernel *, int iBand,
                                    const char *pszType);
 
-    CPLMutex *hIOMutex = nullptr;
-    CPLMutex *hWarpMutex = nullptr;
+    // Only set during ChunkAndWarpMulti()
+    GDALWarpPipeline *m_poPipeline = nullptr;
 
     int nChunkListCount = 0;
     int nChunkListMax = 0;
@@ -561,11 +562,22 @@ class CPL_DLL GDALWarpOperation final
 
     void WipeChunkList();
     CPLErr CollectChunkListInternal(int nDstXOff, int nDstYOff, int nDstXSize,
-                                    int nDstYSize);
+                                    int nDstYSize, double dfMemoryLimit);
     void CollectChunkList(int nDstXOff, int nDstYOff, int nDstXSize,
-                          int nDstYSize);
+                          int nDstYSize, double dfMemoryLimit);
     void ReportTiming(const char *);
 
+    CPLErr WarpRegionInternal(int iChunk, int nDstXOff, int nDstYOff,
+                              int nDstXSize, int nDstYSize, int nSrcXOff,
+                              int nSrcYOff, int nSrcXSize, int nSrcYSize,
+                              double dfSrcXExtraSize, double dfSrcYExtraSize,
+                              double dfProgressBase, double dfProgressScale);
+    CPLErr WarpRegionToBufferInternal(
+        int iChunk, int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+        void *pDataBuf, GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
+        int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
+        double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale);
+
   public:
     GDALWarpOperation();
     ~GDALWarpOperation();
@@ -26,6 +26,7 @@
 #include <limits>
 #include <mutex>
 #include <new>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -2626,6 +2627,93 @@ static bool GWKGetPixelRow(const GDALWarpKernel *poWK, int iBand,
     return bHasValid;
 }
 
+/************************************************************************/
+/*                        GWKGetPixelRowRealT()                         */
+/************************************************************************/
+
+/* Typed version of GWKGetPixelRow() for real data types, which only fills */
+/* adfReal[] and computes the validity of each pixel in a single pass, so */
+/* that the loops can be vectorized. */
+
+template <class T>
+static bool GWKGetPixelRowRealT(const GDALWarpKernel *poWK, int iBand,
+                                GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                                double *padfDensity, double adfReal[])
+{
+    const int nSrcLen = nHalfSrcLen * 2;
+    const T *pSrc =
+        reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]) + iSrcOffset;
+    for (int i = 0; i < nSrcLen; ++i)
+        adfReal[i] = static_cast<double>(pSrc[i]);
+
+    if (padfDensity == nullptr)
+        return true;
+
+    const float *pafUnifiedSrcDensity = poWK->pafUnifiedSrcDensity;
+    if (pafUnifiedSrcDensity == nullptr)
+    {
+        for (int i = 0; i < nSrcLen; ++i)
+            padfDensity[i] = 1.0;
+    }
+    else
+    {
+        for (int i = 0; i < nSrcLen; ++i)
+            padfDensity[i] = pafUnifiedSrcDensity[iSrcOffset + i];
+    }
+
+    GUInt32 *panUnifiedSrcValid = poWK->panUnifiedSrcValid;
+    if (panUnifiedSrcValid != nullptr)
+    {
+        for (int i = 0; i < nSrcLen; ++i)
+        {
+            if (!CPLMaskGet(panUnifiedSrcValid, iSrcOffset + i))
+                padfDensity[i] = 0.0;
+        }
+    }
+
+    GUInt32 *panBandSrcValid = poWK->papanBandSrcValid != nullptr
+                                   ? poWK->papanBandSrcValid[iBand]
+                                   : nullptr;
+    if (panBandSrcValid != nullptr)
+    {
+        for (int i = 0; i < nSrcLen; ++i)
+        {
+            if (!CPLMaskGet(panBandSrcValid, iSrcOffset + i))
+                padfDensity[i] = 0.0;
+        }
+    }
+
+    bool bHasValid = false;
+    for (int i = 0; i < nSrcLen; ++i)
+        bHasValid |= padfDensity[i] > SRC_DENSITY_THRESHOLD;
+    return bHasValid;
+}
+
+/************************************************************************/
+/*                          GWKGetPixelRowT()                           */
+/************************************************************************/
+
+/* Dispatch to GWKGetPixelRowRealT<T>(), or to the generic GWKGetPixelRow() */
+/* when T is void. */
+
+template <class T>
+static CPL_INLINE bool GWKGetPixelRowT(const GDALWarpKernel *poWK, int iBand,
+                                       GPtrDiff_t iSrcOffset, int nHalfSrcLen,
+                                       double *padfDensity, double adfReal[],
+                                       [[maybe_unused]] double *padfImag)
+{
+    if constexpr (std::is_void_v<T>)
+    {
+        return GWKGetPixelRow(poWK, iBand, iSrcOffset, nHalfSrcLen,
+                              padfDensity, adfReal, padfImag);
+    }
+    else
+    {
+        return GWKGetPixelRowRealT<T>(poWK, iBand, iSrcOffset, nHalfSrcLen,
+                                      padfDensity, adfReal);
+    }
+}
+
 /************************************************************************/
 /*                          GWKGetPixelT()                              */
 /************************************************************************/
@@ -2662,6 +2750,7 @@ static bool GWKGetPixelT(const GDALWarpKernel *poWK, int iBand,
 /*     Set of bilinear interpolators                                    */
 /************************************************************************/
 
+template <class T = void>
 static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                        double dfSrcX, double dfSrcY,
                                        double *pdfDensity, double *pdfReal,
@@ -2712,8 +2801,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY >= 0 && iSrcY < nSrcYSize && iSrcOffset >= 0 &&
         iSrcOffset < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
-                       adfImag))
+        GWKGetPixelRowT<T>(poWK, iBand, iSrcOffset, 1, adfDensity, adfReal,
+                           adfImag))
     {
         double dfMult1 = dfRatioX * dfRatioY;
         double dfMult2 = (1.0 - dfRatioX) * dfRatioY;
@@ -2752,8 +2841,8 @@ static bool GWKBilinearResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get pixel row.
     if (iSrcY + 1 >= 0 && iSrcY + 1 < nSrcYSize &&
         iSrcOffset + nSrcXSize >= 0 && iSrcOffset + nSrcXSize < nSrcPixels &&
-        GWKGetPixelRow(poWK, iBand, iSrcOffset + nSrcXSize, 1, adfDensity,
-                       adfReal, adfImag))
+        GWKGetPixelRowT<T>(poWK, iBand, iSrcOffset + nSrcXSize, 1,
+                           adfDensity, adfReal, adfImag))
     {
         double dfMult1 = dfRatioX * (1.0 - dfRatioY);
         double dfMult2 = (1.0 - dfRatioX) * (1.0 - dfRatioY);
@@ -2985,6 +3074,7 @@ static inline void GWKCubicComputeWeights(T x, T coeffs[4])
                            (adfCoeffs)[2] * (v)[2] + (adfCoeffs)[3] * (v)[3]))
 #endif
 
+template <class T = void>
 static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
                                     double dfSrcX, double dfSrcY,
                                     double *pdfDensity, double *pdfReal,
@@ -3004,8 +3094,8 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
     // Get the bilinear interpolation at the image borders.
     if (iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize || iSrcY - 1 < 0 ||
         iSrcY + 2 >= poWK->nSrcYSize)
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                          pdfDensity, pdfReal, pdfImag);
+        return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
+                                             pdfDensity, pdfReal, pdfImag);
 
     double adfValueDens[4] = {};
     double adfValueReal[4] = {};
@@ -3016,15 +3106,16 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
 
     for (GPtrDiff_t i = -1; i < 3; i++)
     {
-        if (!GWKGetPixelRow(poWK, iBand, iSrcOffset + i * poWK->nSrcXSize - 1,
-                            2, adfDensity, adfReal, adfImag) ||
+        if (!GWKGetPixelRowT<T>(poWK, iBand,
+                                iSrcOffset + i * poWK->nSrcXSize - 1, 2,
+                                adfDensity, adfReal, adfImag) ||
             adfDensity[0] < SRC_DENSITY_THRESHOLD ||
             adfDensity[1] < SRC_DENSITY_THRESHOLD ||
             adfDensity[2] < SRC_DENSITY_THRESHOLD ||
             adfDensity[3] < SRC_DENSITY_THRESHOLD)
         {
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                              pdfDensity, pdfReal, pdfImag);
+            return GWKBilinearResample4Sample<T>(poWK, iBand, dfSrcX, dfSrcY,
+                                                 pdfDensity, pdfReal, pdfImag);
         }
 
         adfValueDens[i + 1] = CONVOL4(adfCoeffsX, adfDensity);
@@ -3049,6 +3140,43 @@ static bool GWKCubicResample4Sample(const GDALWarpKernel *poWK, int iBand,
     return true;
 }
 
+/************************************************************************/
+/*                     GWKGetResample4SampleFunc()                      */
+/************************************************************************/
+
+typedef bool (*pfnGWKResample4SampleType)(const GDALWarpKernel *poWK,
+                                          int iBand, double dfSrcX,
+                                          double dfSrcY, double *pdfDensity,
+                                          double *pdfReal, double *pdfImag);
+
+// Return the instantiation of GWKBilinearResample4Sample() or
+// GWKCubicResample4Sample() for the working data type.
+static pfnGWKResample4SampleType
+GWKGetResample4SampleFunc(GDALResampleAlg eResample,
+                          GDALDataType eWorkingDataType)
+{
+    const bool bCubic = eResample == GRA_Cubic;
+    switch (eWorkingDataType)
+    {
+        case GDT_Byte:
+            return bCubic ? GWKCubicResample4Sample<GByte>
+                          : GWKBilinearResample4Sample<GByte>;
+        case GDT_Int16:
+            return bCubic ? GWKCubicResample4Sample<GInt16>
+                          : GWKBilinearResample4Sample<GInt16>;
+        case GDT_UInt16:
+            return bCubic ? GWKCubicResample4Sample<GUInt16>
+                          : GWKBilinearResample4Sample<GUInt16>;
+        case GDT_Float32:
+            return bCubic ? GWKCubicResample4Sample<float>
+                          : GWKBilinearResample4Sample<float>;
+        default:
+            break;
+    }
+    return bCubic ? GWKCubicResample4Sample<void>
+                  : GWKBilinearResample4Sample<void>;
+}
+
 #ifdef USE_SSE2
 
 /************************************************************************/
@@ -3259,68 +3387,6 @@ static CPL_INLINE bool GWKCubicResampleSrcMaskIsDensity4SampleRealT(
     return true;
 }
 
-/************************************************************************/
-/*              GWKCubicResampleSrcMaskIsDensity4SampleReal()             */
-/*     Bi-cubic when source has and only has pafUnifiedSrcDensity.      */
-/************************************************************************/
-
-static bool GWKCubicResampleSrcMaskIsDensity4SampleReal(
-    const GDALWarpKernel *poWK, int iBand, double dfSrcX, double dfSrcY,
-    double *pdfDensity, double *pdfReal)
-
-{
-    const int iSrcX = static_cast<int>(dfSrcX - 0.5);
-    const int iSrcY = static_cast<int>(dfSrcY - 0.5);
-    const GPtrDiff_t iSrcOffset =
-        iSrcX + static_cast<GPtrDiff_t>(iSrcY) * poWK->nSrcXSize;
-    const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
-    const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
-
-    // Get the bilinear interpolation at the image borders.
-    if (iSrcX - 1 < 0 || iSrcX + 2 >= poWK->nSrcXSize || iSrcY - 1 < 0 ||
-        iSrcY + 2 >= poWK->nSrcYSize)
-    {
-        double adfImagIgnored[4] = {};
-        return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                          pdfDensity, pdfReal, adfImagIgnored);
-    }
-
-    double adfCoeffsX[4] = {};
-    GWKCubicComputeWeights(dfDeltaX, adfCoeffsX);
-
-    double adfCoeffsY[4] = {};
-    GWKCubicComputeWeights(dfDeltaY, adfCoeffsY);
-
-    double adfValueDens[4] = {};
-    double adfValueReal[4] = {};
-    double adfDensity[4] = {};
-    double adfReal[4] = {};
-    double adfImagIgnored[4] = {};
-
-    for (GPtrDiff_t i = -1; i < 3; i++)
-    {
-        if (!GWKGetPixelRow(poWK, iBand, iSrcOffset + i * poWK->nSrcXSize - 1,
-                            2, adfDensity, adfReal, adfImagIgnored) ||
-            adfDensity[0] < SRC_DENSITY_THRESHOLD ||
-            adfDensity[1] < SRC_DENSITY_THRESHOLD ||
-            adfDensity[2] < SRC_DENSITY_THRESHOLD ||
-            adfDensity[3] < SRC_DENSITY_THRESHOLD)
-        {
-            return GWKBilinearResample4Sample(poWK, iBand, dfSrcX, dfSrcY,
-                                              pdfDensity, pdfReal,
-                                              adfImagIgnored);
-        }
-
-        adfValueDens[i + 1] = CONVOL4(adfCoeffsX, adfDensity);
-        adfValueReal[i + 1] = CONVOL4(adfCoeffsX, adfReal);
-    }
-
-    *pdfDensity = CONVOL4(adfCoeffsY, adfValueDens);
-    *pdfReal = CONVOL4(adfCoeffsY, adfValueReal);
-
-    return true;
-}
-
 template <class T>
 static bool GWKCubicResampleNoMasks4SampleT(const GDALWarpKernel *poWK,
                                             int iBand, double dfSrcX,
@@ -3613,21 +3679,58 @@ struct _GWKResampleWrkStruct
     double *padfRowImag;
 };
 
-/************************************************************************/
-/*                    GWKResampleCreateWrkStruct()                      */
-/************************************************************************/
-
+template <class T>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct);
 
+template <class T>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
                                         double *pdfImag,
                                         GWKResampleWrkStruct *psWrkStruct);
 
-static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
+/************************************************************************/
+/*                         GWKGetResampleFunc()                         */
+/************************************************************************/
+
+// Return the instantiation of GWKResample() or GWKResampleOptimizedLanczos()
+// for the working data type, so that source pixels are fetched without
+// going through a switch on the data type for each row of the kernel.
+static pfnGWKResampleType GWKGetResampleFunc(GDALResampleAlg eResample,
+                                             GDALDataType eWorkingDataType)
+{
+    const bool bLanczos = eResample == GRA_Lanczos;
+    switch (eWorkingDataType)
+    {
+        case GDT_Byte:
+            return bLanczos ? GWKResampleOptimizedLanczos<GByte>
+                            : GWKResample<GByte>;
+        case GDT_Int16:
+            return bLanczos ? GWKResampleOptimizedLanczos<GInt16>
+                            : GWKResample<GInt16>;
+        case GDT_UInt16:
+            return bLanczos ? GWKResampleOptimizedLanczos<GUInt16>
+                            : GWKResample<GUInt16>;
+        case GDT_Float32:
+            return bLanczos ? GWKResampleOptimizedLanczos<float>
+                            : GWKResample<float>;
+        default:
+            break;
+    }
+    return bLanczos ? GWKResampleOptimizedLanczos<void> : GWKResample<void>;
+}
+
+/************************************************************************/
+/*                    GWKResampleCreateWrkStruct()                      */
+/************************************************************************/
+
+// eResampleDataType selects the instantiation of the resampling function.
+// GDT_Unknown selects the generic one, that handles all data types.
+static GWKResampleWrkStruct *
+GWKResampleCreateWrkStruct(GDALWarpKernel *poWK,
+                           GDALDataType eResampleDataType)
 {
     const int nXDist = (poWK->nXRadius + 1) * 2;
     const int nYDist = (poWK->nYRadius + 1) * 2;
@@ -3667,7 +3770,8 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
 
     if (poWK->eResample == GRA_Lanczos)
     {
-        psWrkStruct->pfnGWKResample = GWKResampleOptimizedLanczos;
+        psWrkStruct->pfnGWKResample =
+            GWKGetResampleFunc(GRA_Lanczos, eResampleDataType);
 
         if (poWK->dfXScale < 1)
         {
@@ -3706,7 +3810,8 @@ static GWKResampleWrkStruct *GWKResampleCreateWrkStruct(GDALWarpKernel *poWK)
         }
     }
     else
-        psWrkStruct->pfnGWKResample = GWKResample;
+        psWrkStruct->pfnGWKResample =
+            GWKGetResampleFunc(poWK->eResample, eResampleDataType);
 
     return psWrkStruct;
 }
@@ -3730,6 +3835,7 @@ static void GWKResampleDeleteWrkStruct(GWKResampleWrkStruct *psWrkStruct)
 /*                           GWKResample()                              */
 /************************************************************************/
 
+template <class T>
 static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
                         double dfSrcY, double *pdfDensity, double *pdfReal,
                         double *pdfImag, GWKResampleWrkStruct *psWrkStruct)
@@ -3802,8 +3908,8 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRowT<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         // Calculate the Y weight.
@@ -3844,7 +3950,8 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
 
             // Accumulate!
             dfAccumulatorRealLocal += padfRowReal[i - iMin] * dfWeight2;
-            dfAccumulatorImagLocal += padfRowImag[i - iMin] * dfWeight2;
+            if constexpr (std::is_void_v<T>)
+                dfAccumulatorImagLocal += padfRowImag[i - iMin] * dfWeight2;
             if (padfRowDensity != nullptr)
                 dfAccumulatorDensityLocal +=
                     padfRowDensity[i - iMin] * dfWeight2;
@@ -3891,6 +3998,7 @@ static bool GWKResample(const GDALWarpKernel *poWK, int iBand, double dfSrcX,
 /*                      GWKResampleOptimizedLanczos()                   */
 /************************************************************************/
 
+template <class T>
 static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
                                         double dfSrcX, double dfSrcY,
                                         double *pdfDensity, double *pdfReal,
@@ -4337,7 +4445,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         iSrcOffset + static_cast<GPtrDiff_t>(jMin - 1) * nSrcXSize + iMin;
 
     int nCountValid = 0;
-    const bool bIsNonComplex = !GDALDataTypeIsComplex(poWK->eWorkingDataType);
+    const bool bIsNonComplex =
+        !std::is_void_v<T> || !GDALDataTypeIsComplex(poWK->eWorkingDataType);
 
     for (int j = jMin; j <= jMax; ++j)
     {
@@ -4348,8 +4457,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
         // source arrays, but the contract of papabySrcImage[iBand],
         // papanBandSrcValid[iBand], panUnifiedSrcValid and pafUnifiedSrcDensity
         // is to have WARP_EXTRA_ELTS reserved at their end.
-        if (!GWKGetPixelRow(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
-                            padfRowDensity, padfRowReal, padfRowImag))
+        if (!GWKGetPixelRowT<T>(poWK, iBand, iRowOffset, (iMax - iMin + 2) / 2,
+                                padfRowDensity, padfRowReal, padfRowImag))
             continue;
 
         const double dfWeight1 = padfWeightsYShifted[j];
@@ -4370,7 +4479,8 @@ static bool GWKResampleOptimizedLanczos(const GDALWarpKernel *poWK, int iBand,
 
                 // Accumulate!
                 dfAccumulatorReal += padfRowReal[i - iMin] * dfWeight2;
-                dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
+                if constexpr (std::is_void_v<T>)
+                    dfAccumulatorImag += padfRowImag[i - iMin] * dfWeight2;
                 dfAccumulatorDensity += padfRowDensity[i - iMin] * dfWeight2;
                 dfAccumulatorWeight += dfWeight2;
             }
@@ -5270,7 +5380,9 @@ static void GWKGeneralCaseThread(void *pData)
     GWKResampleWrkStruct *psWrkStruct = nullptr;
     if (poWK->eResample != GRA_NearestNeighbour)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        // The general case keeps the generic resamplers, so that it can
+        // serve as a reference for the specialized ones.
+        psWrkStruct = GWKResampleCreateWrkStruct(poWK, GDT_Unknown);
     }
     const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
         poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
@@ -5542,7 +5654,8 @@ static void GWKRealCaseThread(void *pData)
     GWKResampleWrkStruct *psWrkStruct = nullptr;
     if (poWK->eResample != GRA_NearestNeighbour)
     {
-        psWrkStruct = GWKResampleCreateWrkStruct(poWK);
+        psWrkStruct =
+            GWKResampleCreateWrkStruct(poWK, poWK->eWorkingDataType);
     }
     const double dfSrcCoordPrecision = CPLAtof(CSLFetchNameValueDef(
         poWK->papszWarpOptions, "SRC_COORD_PRECISION", "0"));
@@ -5553,6 +5666,11 @@ static void GWKRealCaseThread(void *pData)
                                    poWK->papanBandSrcValid == nullptr &&
                                    poWK->pafUnifiedSrcDensity != nullptr;
 
+    const pfnGWKResample4SampleType pfnBilinearResample4Sample =
+        GWKGetResample4SampleFunc(GRA_Bilinear, poWK->eWorkingDataType);
+    const pfnGWKResample4SampleType pfnCubicResample4Sample =
+        GWKGetResample4SampleFunc(GRA_Cubic, poWK->eWorkingDataType);
+
     const bool bOneSourceCornerFailsToReproject =
         GWKOneSourceCornerFailsToReproject(psJob);
 
@@ -5680,42 +5798,33 @@ static void GWKRealCaseThread(void *pData)
                 else if (poWK->eResample == GRA_Bilinear && bUse4SamplesFormula)
                 {
                     double dfValueImagIgnored = 0.0;
-                    GWKBilinearResample4Sample(
+                    pfnBilinearResample4Sample(
                         poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                         padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                         &dfValueReal, &dfValueImagIgnored);
                 }
                 else if (poWK->eResample == GRA_Cubic && bUse4SamplesFormula)
                 {
-                    if (bSrcMaskIsDensity)
+                    if (bSrcMaskIsDensity &&
+                        poWK->eWorkingDataType == GDT_Byte)
                     {
-                        if (poWK->eWorkingDataType == GDT_Byte)
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<GByte>(
-                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                                &dfValueReal);
-                        }
-                        else if (poWK->eWorkingDataType == GDT_UInt16)
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleRealT<
-                                GUInt16>(poWK, iBand,
-                                         padfX[iDstX] - poWK->nSrcXOff,
-                                         padfY[iDstX] - poWK->nSrcYOff,
-                                         &dfBandDensity, &dfValueReal);
-                        }
-                        else
-                        {
-                            GWKCubicResampleSrcMaskIsDensity4SampleReal(
-                                poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
-                                padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
-                                &dfValueReal);
-                        }
+                        GWKCubicResampleSrcMaskIsDensity4SampleRealT<GByte>(
+                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                            &dfValueReal);
+                    }
+                    else if (bSrcMaskIsDensity &&
+                             poWK->eWorkingDataType == GDT_UInt16)
+                    {
+                        GWKCubicResampleSrcMaskIsDensity4SampleRealT<GUInt16>(
+                            poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
+                            padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
+                            &dfValueReal);
                     }
                     else
                     {
                         double dfValueImagIgnored = 0.0;
-                        GWKCubicResample4Sample(
+                        pfnCubicResample4Sample(
                             poWK, iBand, padfX[iDstX] - poWK->nSrcXOff,
                             padfY[iDstX] - poWK->nSrcYOff, &dfBandDensity,
                             &dfValueReal, &dfValueImagIgnored);
@@ -6492,6 +6601,70 @@ static CPLErr GWKNearestFloat(GDALWarpKernel *poWK)
     return GWKRun(poWK, "GWKNearestFloat", GWKNearestThread<float>);
 }
 
+/************************************************************************/
+/*                          GWKAlignedAverageT()                        */
+/************************************************************************/
+
+// Average of the source pixels of a window whose edges are aligned on
+// source pixels, when there is no source mask. Sums are done with integers,
+// by chunks small enough not to overflow, which lets compilers vectorize
+// the inner loop.
+template <class T>
+static double GWKAlignedAverageT(const GDALWarpKernel *poWK, int iBand,
+                                 int iSrcXMin, int iSrcXMax, int iSrcYMin,
+                                 int iSrcYMax)
+{
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 4);
+    using AccType = std::conditional_t<sizeof(T) <= 2, int, std::int64_t>;
+    constexpr int CHUNK_SIZE = sizeof(T) <= 2 ? 32768 : INT_MAX;
+
+    const T *pSrc = reinterpret_cast<const T *>(poWK->papabySrcImage[iBand]);
+    const int nXCount = iSrcXMax - iSrcXMin;
+    std::int64_t nSum = 0;
+    for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; ++iSrcY)
+    {
+        const T *pSrcLine =
+            pSrc + iSrcXMin + static_cast<GPtrDiff_t>(iSrcY) * poWK->nSrcXSize;
+        for (int iChunk = 0; iChunk < nXCount; iChunk += CHUNK_SIZE)
+        {
+            const int nChunkEnd = nXCount - iChunk > CHUNK_SIZE
+                                      ? iChunk + CHUNK_SIZE
+                                      : nXCount;
+            AccType nChunkSum = 0;
+            for (int i = iChunk; i < nChunkEnd; ++i)
+                nChunkSum += pSrcLine[i];
+            nSum += nChunkSum;
+        }
+    }
+    return static_cast<double>(nSum) /
+           (static_cast<double>(nXCount) * (iSrcYMax - iSrcYMin));
+}
+
+typedef double (*pfnGWKAlignedAverageType)(const GDALWarpKernel *, int, int,
+                                           int, int, int);
+
+static pfnGWKAlignedAverageType GWKGetAlignedAverageFunc(GDALDataType eDT)
+{
+    switch (eDT)
+    {
+        case GDT_Byte:
+            return GWKAlignedAverageT<GByte>;
+        case GDT_Int8:
+            return GWKAlignedAverageT<GInt8>;
+        case GDT_Int16:
+            return GWKAlignedAverageT<GInt16>;
+        case GDT_UInt16:
+            return GWKAlignedAverageT<GUInt16>;
+        case GDT_Int32:
+            return GWKAlignedAverageT<GInt32>;
+        case GDT_UInt32:
+            return GWKAlignedAverageT<GUInt32>;
+        default:
+            break;
+    }
+    return nullptr;
+}
+
 /************************************************************************/
 /*                           GWKAverageOrMode()                         */
 /*                                                                      */
@@ -6581,7 +6754,7 @@ static void GWKAverageOrModeThread(void *pData)
                 nBins = 65536;
             }
             pafCounts =
-                static_cast<float *>(VSI_MALLOC_VERBOSE(nBins * sizeof(float)));
+                static_cast<float *>(VSI_CALLOC_VERBOSE(nBins, sizeof(float)));
             if (pafCounts == nullptr)
                 return;
         }
@@ -6683,6 +6856,23 @@ static void GWKAverageOrModeThread(void *pData)
     const int nYMargin =
         2 * std::max(1, static_cast<int>(std::ceil(1. / poWK->dfYScale)));
 
+    // Only used for GWKAOM_Imode: bins of pafCounts[] to reset after each
+    // pixel, which is much cheaper than clearing 65536 bins.
+    std::vector<int> anModifiedBins;
+
+    // Only used for GWKAOM_Quant.
+    std::vector<double> dfRealValuesTmp;
+
+    // Only used for GWKAOM_Average without any source mask, to compute the
+    // average directly from the source buffer when the source window of a
+    // pixel is aligned on source pixels, as all weights are then 1.
+    const pfnGWKAlignedAverageType pfnAlignedAverage =
+        (nAlgo == GWKAOM_Average && poWK->panUnifiedSrcValid == nullptr &&
+         poWK->papanBandSrcValid == nullptr &&
+         poWK->pafUnifiedSrcDensity == nullptr)
+            ? GWKGetAlignedAverageFunc(poWK->eWorkingDataType)
+            : nullptr;
+
     /* ==================================================================== */
     /*      Loop over output lines.                                         */
     /* ==================================================================== */
@@ -6835,6 +7025,13 @@ static void GWKAverageOrModeThread(void *pData)
             if (iSrcYMin == iSrcYMax && iSrcYMax < nSrcYSize)
                 iSrcYMax++;
 
+            const bool bAlignedWindow =
+                pfnAlignedAverage != nullptr && !bWrapOverX &&
+                std::fabs(dfXMin - iSrcXMin) < EPS &&
+                std::fabs(dfXMax - iSrcXMax) < EPS &&
+                std::fabs(dfYMin - iSrcYMin) < EPS &&
+                std::fabs(dfYMax - iSrcYMax) < EPS;
+
 #define COMPUTE_WEIGHT_Y(iSrcY)                                                \
     ((iSrcY == iSrcYMin)                                                       \
          ? ((iSrcYMin + 1 == iSrcYMax) ? 1.0 : 1 - (dfYMin - iSrcYMin))        \
@@ -7018,48 +7215,62 @@ static void GWKAverageOrModeThread(void *pData)
                 {
                     double dfTotalWeight = 0.0;
 
-                    // This code adapted from GDALDownsampleChunk32R_AverageT()
-                    // in gcore/overview.cpp.
-                    for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
+                    if (bAlignedWindow)
                     {
-                        const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
-                        iSrcOffset = iSrcXMin +
-                                     static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
-                        for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax;
-                             iSrcX++, iSrcOffset++)
+                        dfValueReal = pfnAlignedAverage(
+                            poWK, iBand, iSrcXMin, iSrcXMax, iSrcYMin,
+                            iSrcYMax);
+                        dfTotalWeight = 1.0;
+                    }
+                    else
+                    {
+                        // This code adapted from
+                        // GDALDownsampleChunk32R_AverageT() in
+                        // gcore/overview.cpp.
+                        for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
-                            if (bWrapOverX)
-                                iSrcOffset =
-                                    (iSrcX % nSrcXSize) +
-                                    static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
-
-                            if (poWK->panUnifiedSrcValid != nullptr &&
-                                !CPLMaskGet(poWK->panUnifiedSrcValid,
-                                            iSrcOffset))
+                            const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
+                            iSrcOffset =
+                                iSrcXMin +
+                                static_cast<GPtrDiff_t>(iSrcY) * nSrcXSize;
+                            for (int iSrcX = iSrcXMin; iSrcX < iSrcXMax;
+                                 iSrcX++, iSrcOffset++)
                             {
-                                continue;
-                            }
+                                if (bWrapOverX)
+                                    iSrcOffset =
+                                        (iSrcX % nSrcXSize) +
+                                        static_cast<GPtrDiff_t>(iSrcY) *
+                                            nSrcXSize;
 
-                            if (GWKGetPixelValue(
-                                    poWK, iBand, iSrcOffset, &dfBandDensity,
-                                    &dfValueRealTmp, &dfValueImagTmp) &&
-                                dfBandDensity > BAND_DENSITY_THRESHOLD)
-                            {
-                                const double dfWeight =
-                                    COMPUTE_WEIGHT(iSrcX, dfWeightY);
-                                if (dfWeight > 0)
+                                if (poWK->panUnifiedSrcValid != nullptr &&
+                                    !CPLMaskGet(poWK->panUnifiedSrcValid,
+                                                iSrcOffset))
+                                {
+                                    continue;
+                                }
+
+                                if (GWKGetPixelValue(poWK, iBand, iSrcOffset,
+                                                     &dfBandDensity,
+                                                     &dfValueRealTmp,
+                                                     &dfValueImagTmp) &&
+                                    dfBandDensity > BAND_DENSITY_THRESHOLD)
                                 {
-                                    // Weighted incremental algorithm mean
-                                    // Cf https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Weighted_incremental_algorithm
-                                    dfTotalWeight += dfWeight;
-                                    dfValueReal +=
-                                        (dfWeight / dfTotalWeight) *
-                                        (dfValueRealTmp - dfValueReal);
-                                    if (bIsComplex)
+                                    const double dfWeight =
+                                        COMPUTE_WEIGHT(iSrcX, dfWeightY);
+                                    if (dfWeight > 0)
                                     {
-                                        dfValueImag +=
+                                        // Weighted incremental algorithm mean
+                                        // Cf https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Weighted_incremental_algorithm
+                                        dfTotalWeight += dfWeight;
+                                        dfValueReal +=
                                             (dfWeight / dfTotalWeight) *
-                                            (dfValueImagTmp - dfValueImag);
+                                            (dfValueRealTmp - dfValueReal);
+                                        if (bIsComplex)
+                                        {
+                                            dfValueImag +=
+                                                (dfWeight / dfTotalWeight) *
+                                                (dfValueImagTmp - dfValueImag);
+                                        }
                                     }
                                 }
                             }
@@ -7354,8 +7565,6 @@ static void GWKAverageOrModeThread(void *pData)
                         int nMode = -1;
                         bool bHasSourceValues = false;
 
-                        memset(pafCounts, 0, nBins * sizeof(float));
-
                         for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
                         {
                             const double dfWeightY = COMPUTE_WEIGHT_Y(iSrcY);
@@ -7389,6 +7598,8 @@ static void GWKAverageOrModeThread(void *pData)
                                         COMPUTE_WEIGHT(iSrcX, dfWeightY);
 
                                     // Sum the density.
+                                    if (pafCounts[iBin] == 0)
+                                        anModifiedBins.push_back(iBin);
                                     pafCounts[iBin] +=
                                         static_cast<float>(dfWeight);
                                     // Is it the most common value so far?
@@ -7418,6 +7629,10 @@ static void GWKAverageOrModeThread(void *pData)
                             }
                         }
 
+                        for (const int iBin : anModifiedBins)
+                            pafCounts[iBin] = 0;
+                        anModifiedBins.clear();
+
                         if (bHasSourceValues)
                         {
                             dfValueReal = nMode;
@@ -7564,7 +7779,7 @@ static void GWKAverageOrModeThread(void *pData)
                 // poWK->eResample == GRA_Med | GRA_Q1 | GRA_Q3.
                 {
                     bool bFoundValid = false;
-                    std::vector<double> dfRealValuesTmp;
+                    dfRealValuesTmp.clear();
 
                     // This code adapted from nAlgo 1 method, GRA_Average.
                     for (int iSrcY = iSrcYMin; iSrcY < iSrcYMax; iSrcY++)
@@ -7600,10 +7815,13 @@ static void GWKAverageOrModeThread(void *pData)
 
                     if (bFoundValid)
                     {
-                        std::sort(dfRealValuesTmp.begin(),
-                                  dfRealValuesTmp.end());
                         int quantIdx = static_cast<int>(
                             std::ceil(quant * dfRealValuesTmp.size() - 1));
+                        // Only the quantile needs to be at its sorted
+                        // position, which is O(n) instead of O(n log n).
+                        std::nth_element(dfRealValuesTmp.begin(),
+                                         dfRealValuesTmp.begin() + quantIdx,
+                                         dfRealValuesTmp.end());
                         dfValueReal = dfRealValuesTmp[quantIdx];
 
                         if (poWK->bApplyVerticalShift)
@@ -7620,7 +7838,6 @@ static void GWKAverageOrModeThread(void *pData)
 
                         dfBandDensity = 1;
                         bHasFoundDensity = true;
-                        dfRealValuesTmp.clear();
                     }
                 }  // Quantile.
 
@@ -22,10 +22,12 @@
 #include <cstring>
 
 #include <algorithm>
+#include <condition_variable>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "cpl_config.h"
 #include "cpl_conv.h"
@@ -35,6 +37,7 @@
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_alg_priv.h"
@@ -56,6 +59,132 @@ struct GDALWarpPrivateData
     std::vector<double> adfDstY{};
 };
 
+/************************************************************************/
+/*                           GDALWarpPipeline                           */
+/************************************************************************/
+
+// State shared by the chunks processed concurrently by ChunkAndWarpMulti().
+// Each chunk goes through three stages: reading of the source (and of the
+// destination if needed), warping, and writing to the destination. Several
+// chunks can be in the reading stage at the same time, but the warping and
+// writing stages are run by one chunk at a time, in the order of the chunk
+// list, so that progress is monotonic and the output is written sequentially.
+struct GDALWarpPipeline
+{
+    // Taken while reading the source dataset, unless it is thread-safe.
+    std::mutex oSrcMutex{};
+    bool bParallelSrcReads = false;
+
+    // Taken while the transformer may be used.
+    std::mutex oWarpMutex{};
+
+    // Taken while accessing the destination dataset.
+    std::mutex oDstMutex{};
+
+    bool IsStopped();
+    bool WaitForWarpTurn(int iChunk);
+    void EndWarp(int iChunk);
+    bool BeginWrite(int iChunk);
+    void EndChunk(int iChunk, CPLErr eErr);
+
+  private:
+    std::mutex m_oMutex{};
+    std::condition_variable m_oCV{};
+    int m_iNextChunkToWarp = 0;
+    int m_iNextChunkToWrite = 0;
+    // Only accessed by the chunk whose turn it is to write.
+    bool m_bDstLockedForWrite = false;
+    bool m_bStop = false;
+};
+
+/************************************************************************/
+/*                              IsStopped()                             */
+/************************************************************************/
+
+bool GDALWarpPipeline::IsStopped()
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    return m_bStop;
+}
+
+/************************************************************************/
+/*                          WaitForWarpTurn()                           */
+/************************************************************************/
+
+// Wait until all previous chunks have been warped. Returns false if the
+// processing has been stopped because of an error in another chunk.
+bool GDALWarpPipeline::WaitForWarpTurn(int iChunk)
+{
+    std::unique_lock<std::mutex> oLock(m_oMutex);
+    m_oCV.wait(oLock, [this, iChunk]
+               { return m_bStop || m_iNextChunkToWarp == iChunk; });
+    return !m_bStop;
+}
+
+/************************************************************************/
+/*                              EndWarp()                               */
+/************************************************************************/
+
+void GDALWarpPipeline::EndWarp(int iChunk)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (m_iNextChunkToWarp == iChunk)
+    {
+        ++m_iNextChunkToWarp;
+        m_oCV.notify_all();
+    }
+}
+
+/************************************************************************/
+/*                             BeginWrite()                             */
+/************************************************************************/
+
+// Wait until all previous chunks have been written, and lock the destination
+// dataset until EndChunk() is called. May be called several times for a
+// same chunk. Returns false if the processing has been stopped because of an
+// error in another chunk.
+bool GDALWarpPipeline::BeginWrite(int iChunk)
+{
+    {
+        std::unique_lock<std::mutex> oLock(m_oMutex);
+        m_oCV.wait(oLock, [this, iChunk]
+                   { return m_bStop || m_iNextChunkToWrite == iChunk; });
+        if (m_iNextChunkToWrite != iChunk)
+            return false;
+    }
+    if (!m_bDstLockedForWrite)
+    {
+        oDstMutex.lock();
+        m_bDstLockedForWrite = true;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                              EndChunk()                              */
+/************************************************************************/
+
+// Must be called once a chunk has been processed, whether successfully or
+// not, to let next chunks proceed.
+void GDALWarpPipeline::EndChunk(int iChunk, CPLErr eErr)
+{
+    std::lock_guard<std::mutex> oLock(m_oMutex);
+    if (eErr != CE_None)
+        m_bStop = true;
+    if (m_iNextChunkToWarp == iChunk)
+        ++m_iNextChunkToWarp;
+    if (m_iNextChunkToWrite == iChunk)
+    {
+        if (m_bDstLockedForWrite)
+        {
+            m_bDstLockedForWrite = false;
+            oDstMutex.unlock();
+        }
+        ++m_iNextChunkToWrite;
+    }
+    m_oCV.notify_all();
+}
+
 static std::mutex gMutex{};
 static std::map<GDALWarpOperation *, std::unique_ptr<GDALWarpPrivateData>>
     gMapPrivate{};
@@ -174,12 +303,6 @@ GDALWarpOperation::~GDALWarpOperation()
 
     WipeOptions();
 
-    if (hIOMutex != nullptr)
-    {
-        CPLDestroyMutex(hIOMutex);
-        CPLDestroyMutex(hWarpMutex);
-    }
-
     WipeChunkList();
     if (psThreadData)
         GWKThreadsEnd(psThreadData);
@@ -928,14 +1051,16 @@ void GDALDestroyWarpOperation(GDALWarpOperationH hOperation)
 /************************************************************************/
 
 void GDALWarpOperation::CollectChunkList(int nDstXOff, int nDstYOff,
-                                         int nDstXSize, int nDstYSize)
+                                         int nDstXSize, int nDstYSize,
+                                         double dfMemoryLimit)
 
 {
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
     WipeChunkList();
-    CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                             dfMemoryLimit);
 
     // Sort chunks from top to bottom, and for equal y, from left to right.
     if (nChunkListCount > 1)
@@ -1023,7 +1148,8 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(int nDstXOff, int nDstYOff,
     /* -------------------------------------------------------------------- */
     /*      Collect the list of chunks to operate on.                       */
     /* -------------------------------------------------------------------- */
-    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                     psOptions->dfWarpMemoryLimit);
 
     /* -------------------------------------------------------------------- */
     /*      Total up output pixels to process.                              */
@@ -1093,71 +1219,21 @@ CPLErr GDALChunkAndWarpImage(GDALWarpOperationH hOperation, int nDstXOff,
 }
 
 /************************************************************************/
-/*                          ChunkThreadMain()                           */
+/*                         GetWarpThreadCount()                         */
 /************************************************************************/
 
-struct ChunkThreadData
-{
-    GDALWarpOperation *poOperation = nullptr;
-    GDALWarpChunk *pasChunkInfo = nullptr;
-    CPLJoinableThread *hThreadHandle = nullptr;
-    CPLErr eErr = CE_None;
-    double dfProgressBase = 0;
-    double dfProgressScale = 0;
-    CPLMutex *hIOMutex = nullptr;
-
-    CPLMutex *hCondMutex = nullptr;
-    volatile int bIOMutexTaken = 0;
-    CPLCond *hCond = nullptr;
-
-    CPLErrorAccumulator *poErrorAccumulator = nullptr;
-};
-
-static void ChunkThreadMain(void *pThreadData)
-
+// Same logic as in GWKThreadsCreate()
+static int GetWarpThreadCount(CSLConstList papszWarpOptions)
 {
-    volatile ChunkThreadData *psData =
-        static_cast<volatile ChunkThreadData *>(pThreadData);
-
-    GDALWarpChunk *pasChunkInfo = psData->pasChunkInfo;
-
-    /* -------------------------------------------------------------------- */
-    /*      Acquire IO mutex.                                               */
-    /* -------------------------------------------------------------------- */
-    if (!CPLAcquireMutex(psData->hIOMutex, 600.0))
-    {
-        CPLError(CE_Failure, CPLE_AppDefined,
-                 "Failed to acquire IOMutex in WarpRegion().");
-        psData->eErr = CE_Failure;
-    }
-    else
-    {
-        if (psData->hCond != nullptr)
-        {
-            CPLAcquireMutex(psData->hCondMutex, 1.0);
-            psData->bIOMutexTaken = TRUE;
-            CPLCondSignal(psData->hCond);
-            CPLReleaseMutex(psData->hCondMutex);
-        }
-
-        auto oAccumulator =
-            psData->poErrorAccumulator->InstallForCurrentScope();
-        CPL_IGNORE_RET_VAL(oAccumulator);
-
-        psData->eErr = psData->poOperation->WarpRegion(
-            pasChunkInfo->dx, pasChunkInfo->dy, pasChunkInfo->dsx,
-            pasChunkInfo->dsy, pasChunkInfo->sx, pasChunkInfo->sy,
-            pasChunkInfo->ssx, pasChunkInfo->ssy, pasChunkInfo->sExtraSx,
-            pasChunkInfo->sExtraSy, psData->dfProgressBase,
-            psData->dfProgressScale);
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Release the IO mutex. */
-        /* --------------------------------------------------------------------
-         */
-        CPLReleaseMutex(psData->hIOMutex);
-    }
+    const char *pszWarpThreads =
+        CSLFetchNameValue(papszWarpOptions, "NUM_THREADS");
+    if (pszWarpThreads == nullptr)
+        pszWarpThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+
+    const int nThreads = EQUAL(pszWarpThreads, "ALL_CPUS")
+                             ? CPLGetNumCPUs()
+                             : atoi(pszWarpThreads);
+    return std::max(1, std::min(128, nThreads));
 }
 
 /************************************************************************/
@@ -1174,7 +1250,18 @@ static void ChunkThreadMain(void *pThreadData)
  *
  * Externally this method operates the same as ChunkAndWarpImage(), but
  * internally this method uses multiple threads to interleave input/output
- * for one region while the processing is being done for another.
+ * for some regions while the processing is being done for another.
+ *
+ * Chunks are processed as a pipeline: while one chunk is warped, the
+ * previously warped one is written to the destination dataset and the next
+ * ones are read from the source dataset. Chunks are warped and written in
+ * order. Starting with GDAL 3.12, if the source dataset is opened in read-only
+ * mode and can be reopened (see GDALGetThreadSafeDataset()), and if more than
+ * one thread is requested with the NUM_THREADS warping option or the
+ * GDAL_NUM_THREADS configuration option, up to that number of chunks are read
+ * in parallel. The memory limit of GDALWarpOptions::dfWarpMemoryLimit is then
+ * shared by the chunks being processed at the same time, so that they do not
+ * use more than twice that amount.
  *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
@@ -1188,133 +1275,114 @@ CPLErr GDALWarpOperation::ChunkAndWarpMulti(int nDstXOff, int nDstYOff,
                                             int nDstXSize, int nDstYSize)
 
 {
-    hIOMutex = CPLCreateMutex();
-    hWarpMutex = CPLCreateMutex();
-
-    CPLReleaseMutex(hIOMutex);
-    CPLReleaseMutex(hWarpMutex);
+    /* -------------------------------------------------------------------- */
+    /*      Use a thread-safe source dataset if possible, so that several   */
+    /*      chunks can be read at the same time.                            */
+    /* -------------------------------------------------------------------- */
+    const int nThreads = GetWarpThreadCount(psOptions->papszWarpOptions);
+    GDALDatasetH hSrcDS = psOptions->hSrcDS;
+    GDALDataset *poThreadSafeSrcDS = nullptr;
+    if (nThreads > 1 &&
+        GDALDataset::FromHandle(hSrcDS)->GetAccess() == GA_ReadOnly)
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        poThreadSafeSrcDS = GDALGetThreadSafeDataset(
+            GDALDataset::FromHandle(hSrcDS), GDAL_OF_RASTER);
+    }
 
-    CPLCond *hCond = CPLCreateCond();
-    CPLMutex *hCondMutex = CPLCreateMutex();
-    CPLReleaseMutex(hCondMutex);
+    // Chunks being read, plus one being warped and one being written.
+    const int nMaxChunksInFlight = (poThreadSafeSrcDS ? nThreads : 1) + 2;
 
     /* -------------------------------------------------------------------- */
-    /*      Collect the list of chunks to operate on.                       */
+    /*      Collect the list of chunks to operate on, such that the chunks  */
+    /*      in flight use at most twice the warp memory limit, as the two   */
+    /*      threads of former implementations did.                          */
     /* -------------------------------------------------------------------- */
-    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize);
+    CollectChunkList(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                     psOptions->dfWarpMemoryLimit * 2 / nMaxChunksInFlight);
+
+    GDALWarpPipeline oPipeline;
+    if (poThreadSafeSrcDS)
+    {
+        CPLDebug("WARP", "Reading up to %d chunks in parallel", nThreads);
+        oPipeline.bParallelSrcReads = true;
+        psOptions->hSrcDS = GDALDataset::ToHandle(poThreadSafeSrcDS);
+    }
+    m_poPipeline = &oPipeline;
 
     /* -------------------------------------------------------------------- */
-    /*      Process them one at a time, updating the progress               */
-    /*      information for each region.                                    */
+    /*      Process them on a dedicated pool of threads, as most of the     */
+    /*      time they wait for their turn, which would starve the global    */
+    /*      thread pool used by the warp kernel and by drivers.             */
     /* -------------------------------------------------------------------- */
-    ChunkThreadData volatile asThreadData[2] = {};
+    CPLErr eErr = CE_None;
     CPLErrorAccumulator oErrorAccumulator;
-    for (int i = 0; i < 2; ++i)
+    std::vector<CPLErr> aeChunkErrors(nChunkListCount, CE_None);
+    CPLWorkerThreadPool oThreadPool;
+    if (nChunkListCount > 0 &&
+        !oThreadPool.Setup(std::min(nMaxChunksInFlight, nChunkListCount),
+                           nullptr, nullptr))
     {
-        asThreadData[i].poOperation = this;
-        asThreadData[i].hIOMutex = hIOMutex;
-        asThreadData[i].poErrorAccumulator = &oErrorAccumulator;
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot create threads in ChunkAndWarpMulti()");
+        eErr = CE_Failure;
     }
 
     double dfPixelsProcessed = 0.0;
-    double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
-
-    CPLErr eErr = CE_None;
-    for (int iChunk = 0; iChunk < nChunkListCount + 1; iChunk++)
+    const double dfTotalPixels = static_cast<double>(nDstXSize) * nDstYSize;
+    for (int iChunk = 0; eErr == CE_None && iChunk < nChunkListCount;
+         iChunk++)
     {
-        int iThread = iChunk % 2;
-
-        /* --------------------------------------------------------------------
-         */
-        /*      Launch thread for this chunk. */
-        /* --------------------------------------------------------------------
-         */
-        if (pasChunkList != nullptr && iChunk < nChunkListCount)
-        {
-            GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
-            const double dfChunkPixels =
-                pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
-
-            asThreadData[iThread].dfProgressBase =
-                dfPixelsProcessed / dfTotalPixels;
-            asThreadData[iThread].dfProgressScale =
-                dfChunkPixels / dfTotalPixels;
-
-            dfPixelsProcessed += dfChunkPixels;
-
-            asThreadData[iThread].pasChunkInfo = pasThisChunk;
-
-            if (iChunk == 0)
-            {
-                asThreadData[iThread].hCond = hCond;
-                asThreadData[iThread].hCondMutex = hCondMutex;
-            }
-            else
-            {
-                asThreadData[iThread].hCond = nullptr;
-                asThreadData[iThread].hCondMutex = nullptr;
-            }
-            asThreadData[iThread].bIOMutexTaken = FALSE;
-
-            CPLDebug("GDAL", "Start chunk %d / %d.", iChunk, nChunkListCount);
-            asThreadData[iThread].hThreadHandle = CPLCreateJoinableThread(
-                ChunkThreadMain,
-                const_cast<ChunkThreadData *>(&asThreadData[iThread]));
-            if (asThreadData[iThread].hThreadHandle == nullptr)
-            {
-                CPLError(
-                    CE_Failure, CPLE_AppDefined,
-                    "CPLCreateJoinableThread() failed in ChunkAndWarpMulti()");
-                eErr = CE_Failure;
-                break;
-            }
+        const GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+        const double dfChunkPixels =
+            pasThisChunk->dsx * static_cast<double>(pasThisChunk->dsy);
+        const double dfProgressBase = dfPixelsProcessed / dfTotalPixels;
+        const double dfProgressScale = dfChunkPixels / dfTotalPixels;
+        dfPixelsProcessed += dfChunkPixels;
 
-            // Wait that the first thread has acquired the IO mutex before
-            // proceeding.  This will ensure that the first thread will run
-            // before the second one.
-            if (iChunk == 0)
+        oThreadPool.SubmitJob(
+            [this, &oPipeline, &oErrorAccumulator, &aeChunkErrors,
+             pasThisChunk, iChunk, dfProgressBase, dfProgressScale]()
             {
-                CPLAcquireMutex(hCondMutex, 1.0);
-                while (asThreadData[iThread].bIOMutexTaken == FALSE)
-                    CPLCondWait(hCond, hCondMutex);
-                CPLReleaseMutex(hCondMutex);
-            }
-        }
+                auto oAccumulator = oErrorAccumulator.InstallForCurrentScope();
+                CPL_IGNORE_RET_VAL(oAccumulator);
 
-        /* --------------------------------------------------------------------
-         */
-        /*      Wait for previous chunks thread to complete. */
-        /* --------------------------------------------------------------------
-         */
-        if (iChunk > 0)
-        {
-            iThread = (iChunk - 1) % 2;
-
-            // Wait for thread to finish.
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
-            asThreadData[iThread].hThreadHandle = nullptr;
-
-            CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk - 1,
-                     nChunkListCount);
-
-            eErr = asThreadData[iThread].eErr;
-
-            if (eErr != CE_None)
-                break;
-        }
+                CPLErr eChunkErr = CE_Failure;
+                if (!oPipeline.IsStopped())
+                {
+                    CPLDebug("GDAL", "Start chunk %d / %d.", iChunk,
+                             nChunkListCount);
+                    eChunkErr = WarpRegionInternal(
+                        iChunk, pasThisChunk->dx, pasThisChunk->dy,
+                        pasThisChunk->dsx, pasThisChunk->dsy,
+                        pasThisChunk->sx, pasThisChunk->sy,
+                        pasThisChunk->ssx, pasThisChunk->ssy,
+                        pasThisChunk->sExtraSx, pasThisChunk->sExtraSy,
+                        dfProgressBase, dfProgressScale);
+                    CPLDebug("GDAL", "Finished chunk %d / %d.", iChunk,
+                             nChunkListCount);
+                }
+                aeChunkErrors[iChunk] = eChunkErr;
+                oPipeline.EndChunk(iChunk, eChunkErr);
+            });
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Wait for all threads to complete.                               */
+    /*      Wait for all chunks to complete.                                */
     /* -------------------------------------------------------------------- */
-    for (int iThread = 0; iThread < 2; iThread++)
+    oThreadPool.WaitCompletion();
+    for (const CPLErr eChunkErr : aeChunkErrors)
     {
-        if (asThreadData[iThread].hThreadHandle)
-            CPLJoinThread(asThreadData[iThread].hThreadHandle);
+        if (eErr == CE_None)
+            eErr = eChunkErr;
     }
 
-    CPLDestroyCond(hCond);
-    CPLDestroyMutex(hCondMutex);
+    m_poPipeline = nullptr;
+    if (poThreadSafeSrcDS)
+    {
+        psOptions->hSrcDS = hSrcDS;
+        poThreadSafeSrcDS->ReleaseRef();
+    }
 
     WipeChunkList();
 
@@ -1426,7 +1494,8 @@ double GDALWarpOperation::GetWorkingMemoryForWindow(int nSrcXSize,
 /************************************************************************/
 
 CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
-                                                   int nDstXSize, int nDstYSize)
+                                                   int nDstXSize, int nDstYSize,
+                                                   double dfMemoryLimit)
 
 {
     /* -------------------------------------------------------------------- */
@@ -1500,7 +1569,7 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
              nSrcXSize, nSrcYSize, dfSrcFillRatio,
              dfTotalMemoryUse / (1024 * 1024));
 #endif
-    if ((dfTotalMemoryUse > psOptions->dfWarpMemoryLimit &&
+    if ((dfTotalMemoryUse > dfMemoryLimit &&
          (nDstXSize > 2 || nDstYSize > 2)) ||
         (dfSrcFillRatio > 0 && dfSrcFillRatio < 0.5 &&
          (nDstXSize > 100 || nDstYSize > 100) &&
@@ -1562,10 +1631,10 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
             int nChunk2 = nDstXSize - nChunk1;
 
             eErr = CollectChunkListInternal(nDstXOff, nDstYOff, nChunk1,
-                                            nDstYSize);
+                                            nDstYSize, dfMemoryLimit);
 
             eErr2 = CollectChunkListInternal(nDstXOff + nChunk1, nDstYOff,
-                                             nChunk2, nDstYSize);
+                                             nChunk2, nDstYSize, dfMemoryLimit);
         }
         else if (!(bStreamableOutput && nDstYSize / 2 < nBlockYSize))
         {
@@ -1580,10 +1649,10 @@ CPLErr GDALWarpOperation::CollectChunkListInternal(int nDstXOff, int nDstYOff,
             const int nChunk2 = nDstYSize - nChunk1;
 
             eErr = CollectChunkListInternal(nDstXOff, nDstYOff, nDstXSize,
-                                            nChunk1);
+                                            nChunk1, dfMemoryLimit);
 
             eErr2 = CollectChunkListInternal(nDstXOff, nDstYOff + nChunk1,
-                                             nDstXSize, nChunk2);
+                                             nDstXSize, nChunk2, dfMemoryLimit);
         }
 
         if (bHasDivided)
@@ -1704,6 +1773,27 @@ CPLErr GDALWarpOperation::WarpRegion(
     double dfSrcYExtraSize, double dfProgressBase, double dfProgressScale)
 
 {
+    return WarpRegionInternal(-1, nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+                              nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                              dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase,
+                              dfProgressScale);
+}
+
+/************************************************************************/
+/*                         WarpRegionInternal()                         */
+/************************************************************************/
+
+// iChunk is the index of the chunk in the chunk list when called from
+// ChunkAndWarpMulti(), or -1.
+CPLErr GDALWarpOperation::WarpRegionInternal(
+    int iChunk, int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+    int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
+    double dfSrcXExtraSize, double dfSrcYExtraSize, double dfProgressBase,
+    double dfProgressScale)
+
+{
+    GDALWarpPipeline *poPipeline = iChunk >= 0 ? m_poPipeline : nullptr;
+
     ReportTiming(nullptr);
 
     /* -------------------------------------------------------------------- */
@@ -1724,6 +1814,10 @@ CPLErr GDALWarpOperation::WarpRegion(
     GDALDataset *poDstDS = GDALDataset::FromHandle(psOptions->hDstDS);
     if (!bDstBufferInitialized)
     {
+        std::unique_lock<std::mutex> oDstLock;
+        if (poPipeline)
+            oDstLock = std::unique_lock<std::mutex>(poPipeline->oDstMutex);
+
         CPLErr eErr = CE_None;
         if (psOptions->nBandCount == 1)
         {
@@ -1755,17 +1849,27 @@ CPLErr GDALWarpOperation::WarpRegion(
     /* -------------------------------------------------------------------- */
     /*      Perform the warp.                                               */
     /* -------------------------------------------------------------------- */
-    CPLErr eErr = nSrcXSize == 0
-                      ? CE_None
-                      : WarpRegionToBuffer(
-                            nDstXOff, nDstYOff, nDstXSize, nDstYSize,
-                            pDstBuffer, psOptions->eWorkingDataType, nSrcXOff,
-                            nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
-                            dfSrcYExtraSize, dfProgressBase, dfProgressScale);
+    CPLErr eErr = CE_None;
+    if (nSrcXSize != 0)
+    {
+        eErr = WarpRegionToBufferInternal(
+            iChunk, nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDstBuffer,
+            psOptions->eWorkingDataType, nSrcXOff, nSrcYOff, nSrcXSize,
+            nSrcYSize, dfSrcXExtraSize, dfSrcYExtraSize, dfProgressBase,
+            dfProgressScale);
+    }
+    else if (poPipeline)
+    {
+        poPipeline->EndWarp(iChunk);
+    }
 
     /* -------------------------------------------------------------------- */
     /*      Write the output data back to disk if all went well.            */
+    /*      In ChunkAndWarpMulti(), the destination dataset stays locked    */
+    /*      until the chunk is ended.                                       */
     /* -------------------------------------------------------------------- */
+    if (eErr == CE_None && poPipeline && !poPipeline->BeginWrite(iChunk))
+        eErr = CE_Failure;
     if (eErr == CE_None)
     {
         if (psOptions->nBandCount == 1)
@@ -1904,6 +2008,26 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
 CPLErr GDALWarpOperation::WarpRegionToBuffer(
     int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, void *pDataBuf,
+    GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff, int nSrcXSize,
+    int nSrcYSize, double dfSrcXExtraSize, double dfSrcYExtraSize,
+    double dfProgressBase, double dfProgressScale)
+
+{
+    return WarpRegionToBufferInternal(
+        -1, nDstXOff, nDstYOff, nDstXSize, nDstYSize, pDataBuf, eBufDataType,
+        nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize, dfSrcXExtraSize,
+        dfSrcYExtraSize, dfProgressBase, dfProgressScale);
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+// iChunk is the index of the chunk in the chunk list when called from
+// ChunkAndWarpMulti(), or -1.
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal(
+    int iChunk, int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize,
+    void *pDataBuf,
     // Only in a CPLAssert.
     CPL_UNUSED GDALDataType eBufDataType, int nSrcXOff, int nSrcYOff,
     int nSrcXSize, int nSrcYSize, double dfSrcXExtraSize,
@@ -1914,6 +2038,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     CPLAssert(eBufDataType == psOptions->eWorkingDataType);
 
+    GDALWarpPipeline *poPipeline = iChunk >= 0 ? m_poPipeline : nullptr;
+    std::unique_lock<std::mutex> oWarpLock;
+
     /* -------------------------------------------------------------------- */
     /*      If not given a corresponding source window compute one now.     */
     /* -------------------------------------------------------------------- */
@@ -1922,18 +2049,14 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
         // TODO: This taking of the warp mutex is suboptimal. We could get rid
         // of it, but that would require making sure ComputeSourceWindow()
         // uses a different pTransformerArg than the warp kernel.
-        if (hWarpMutex != nullptr && !CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        if (poPipeline)
+            oWarpLock = std::unique_lock<std::mutex>(poPipeline->oWarpMutex);
         const CPLErr eErr =
             ComputeSourceWindow(nDstXOff, nDstYOff, nDstXSize, nDstYSize,
                                 &nSrcXOff, &nSrcYOff, &nSrcXSize, &nSrcYSize,
                                 &dfSrcXExtraSize, &dfSrcYExtraSize, nullptr);
-        if (hWarpMutex != nullptr)
-            CPLReleaseMutex(hWarpMutex);
+        if (oWarpLock.owns_lock())
+            oWarpLock.unlock();
         if (eErr != CE_None)
         {
             const bool bErrorOutIfEmptySourceWindow =
@@ -1982,6 +2105,10 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.dfSrcXExtraSize = dfSrcXExtraSize;
     oWK.dfSrcYExtraSize = dfSrcYExtraSize;
 
+    std::unique_lock<std::mutex> oSrcLock;
+    if (poPipeline && !poPipeline->bParallelSrcReads)
+        oSrcLock = std::unique_lock<std::mutex>(poPipeline->oSrcMutex);
+
     GInt64 nAlloc64 =
         nWordSize *
         (static_cast<GInt64>(nSrcXSize) * nSrcYSize + WARP_EXTRA_ELTS) *
@@ -2144,6 +2271,9 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
         eErr = CreateKernelMask(&oWK, 0 /* not used */, "DstDensity");
 
+        std::unique_lock<std::mutex> oDstLock;
+        if (poPipeline)
+            oDstLock = std::unique_lock<std::mutex>(poPipeline->oDstMutex);
         if (eErr == CE_None)
             eErr = GDALWarpDstAlphaMasker(
                 psOptions, psOptions->nBandCount, psOptions->eWorkingDataType,
@@ -2355,17 +2485,16 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     }
 
     /* -------------------------------------------------------------------- */
-    /*      Release IO Mutex, and acquire warper mutex.                     */
+    /*      Release the source lock, and wait for our turn to warp.         */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    if (oSrcLock.owns_lock())
+        oSrcLock.unlock();
+    if (poPipeline && eErr == CE_None)
     {
-        CPLReleaseMutex(hIOMutex);
-        if (!CPLAcquireMutex(hWarpMutex, 600.0))
-        {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire WarpMutex in WarpRegion().");
-            return CE_Failure;
-        }
+        if (poPipeline->WaitForWarpTurn(iChunk))
+            oWarpLock = std::unique_lock<std::mutex>(poPipeline->oWarpMutex);
+        else
+            eErr = CE_Failure;
     }
 
     /* -------------------------------------------------------------------- */
@@ -2392,16 +2521,17 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
             &oWK, psOptions->pPostWarpProcessorArg);
 
     /* -------------------------------------------------------------------- */
-    /*      Release Warp Mutex, and acquire io mutex.                       */
+    /*      Let the next chunk be warped, and wait for our turn to write.   */
     /* -------------------------------------------------------------------- */
-    if (hIOMutex != nullptr)
+    if (poPipeline)
     {
-        CPLReleaseMutex(hWarpMutex);
-        if (!CPLAcquireMutex(hIOMutex, 600.0))
+        if (oWarpLock.owns_lock())
+            oWarpLock.unlock();
+        poPipeline->EndWarp(iChunk);
+        if (eErr == CE_None && psOptions->nDstAlphaBand > 0 &&
+            !poPipeline->BeginWrite(iChunk))
         {
-            CPLError(CE_Failure, CPLE_AppDefined,
-                     "Failed to acquire IOMutex in WarpRegion().");
-            return CE_Failure;
+            eErr = CE_Failure;
         }
     }
 
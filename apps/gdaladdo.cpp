@@ -238,6 +238,8 @@ static bool PartialRefreshFromSourceTimestamp(
                      "Band is not a VRTSourcedRasterBand");
             return false;
         }
+        if (!poVRTBand->LoadDeferredSources())
+            return false;
 
         for (auto &poSource : poVRTBand->m_papoSources)
         {
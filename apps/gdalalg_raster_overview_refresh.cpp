@@ -150,6 +150,8 @@ PartialRefreshFromSourceTimestamp(GDALDataset *poDS, const char *pszResampling,
                      "Band is not a VRTSourcedRasterBand");
             return false;
         }
+        if (!poVRTBand->LoadDeferredSources())
+            return false;
 
         for (auto &poSource : poVRTBand->m_papoSources)
         {
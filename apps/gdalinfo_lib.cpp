@@ -1002,6 +1002,34 @@ char *GDALInfo(GDALDatasetH hDataset, const GDALInfoOptions *psOptions)
         hTransform = nullptr;
     }
 
+    /* ==================================================================== */
+    /*      Compute exact statistics of all bands lacking them in a         */
+    /*      single pass, rather than reading the dataset once per band.     */
+    /* ==================================================================== */
+    if (psOptions->bStats && !psOptions->bApproxStats)
+    {
+        std::vector<int> anBandList;
+        for (int iBand = 0; iBand < GDALGetRasterCount(hDataset); iBand++)
+        {
+            double dfMin, dfMax, dfMean, dfStdDev;
+            if (GDALGetRasterStatistics(GDALGetRasterBand(hDataset, iBand + 1),
+                                        FALSE, FALSE, &dfMin, &dfMax, &dfMean,
+                                        &dfStdDev) != CE_None)
+            {
+                anBandList.push_back(iBand + 1);
+            }
+        }
+        if (anBandList.size() > 1)
+        {
+            // Bands whose statistics cannot be computed are processed again
+            // below, which reports the error.
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            GDALDatasetComputeStatistics(
+                hDataset, static_cast<int>(anBandList.size()),
+                anBandList.data(), FALSE, nullptr, nullptr);
+        }
+    }
+
     /* ==================================================================== */
     /*      Loop over bands.                                                */
     /* ==================================================================== */
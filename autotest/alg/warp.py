@@ -1527,6 +1527,32 @@ def test_warp_53(typestr, option, alg_name, expected_cs):
     assert cs2 == 1218
 
 
+###############################################################################
+# Test that the resampling kernels specialized for the working data type give
+# the same result as the general case on a source with nodata. The general
+# case always uses the generic resamplers, that handle all data types.
+
+
+@pytest.mark.parametrize("typestr", ("Byte", "UInt16", "Int16", "Float32"))
+@pytest.mark.parametrize("alg_name", ("bilinear", "cubic", "lanczos"))
+def test_warp_nodata_specialized_kernels(typestr, alg_name):
+
+    gdaltest.importorskip_gdal_array()
+    numpy = pytest.importorskip("numpy")
+
+    src_ds = gdal.Translate(
+        "", "../gcore/data/byte.tif", options=f"-of MEM -ot {typestr} -a_nodata 107"
+    )
+    options = f"-of MEM -t_srs EPSG:4326 -r {alg_name}"
+    ref_ds = gdal.Warp("", src_ds, options=options + " -wo USE_GENERAL_CASE=TRUE")
+    out_ds = gdal.Warp("", src_ds, options=options)
+
+    ref = ref_ds.GetRasterBand(1).ReadAsArray()
+    out = out_ds.GetRasterBand(1).ReadAsArray()
+    assert numpy.count_nonzero(ref == 107) > 0
+    numpy.testing.assert_array_equal(out, ref)
+
+
 ###############################################################################
 # Test Alpha on UInt16/Int16
 
@@ -1755,6 +1781,67 @@ def test_warp_mode_ties(tie_strategy, dtype):
         assert result == 1
 
 
+###############################################################################
+# Test average, mode and quantile downsampling by an integer factor, against
+# a straightforward implementation
+
+
+@pytest.mark.parametrize("dtype", [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_UInt16])
+@pytest.mark.parametrize("alg_name", ["average", "mode", "med", "q1", "q3"])
+def test_warp_downsampling_integer_factor(dtype, alg_name):
+
+    gdaltest.importorskip_gdal_array()
+    numpy = pytest.importorskip("numpy")
+
+    factor = 4
+    size = 30 * factor
+    rng = numpy.random.default_rng(0)
+    if alg_name == "mode":
+        # Few distinct values so that there are ties
+        offset = {gdal.GDT_Byte: 250, gdal.GDT_Int16: -30000, gdal.GDT_UInt16: 60000}
+        data = rng.integers(0, 4, (size, size)) + offset[dtype]
+    else:
+        bounds = {
+            gdal.GDT_Byte: (0, 256),
+            gdal.GDT_Int16: (-32768, 32768),
+            gdal.GDT_UInt16: (0, 65536),
+        }
+        data = rng.integers(*bounds[dtype], (size, size))
+
+    src_ds = gdal.GetDriverByName("MEM").Create("", size, size, 1, dtype)
+    src_ds.SetGeoTransform([0, 1, 0, size, 0, -1])
+    src_ds.GetRasterBand(1).WriteArray(data)
+
+    out_ds = gdal.Warp(
+        "", src_ds, format="MEM", resampleAlg=alg_name, xRes=factor, yRes=factor
+    )
+    got = out_ds.GetRasterBand(1).ReadAsArray()
+
+    blocks = data.reshape(size // factor, factor, size // factor, factor)
+    blocks = blocks.transpose(0, 2, 1, 3).reshape(size // factor, size // factor, -1)
+    expected = numpy.zeros(got.shape, dtype=numpy.int64)
+    for j in range(expected.shape[0]):
+        for i in range(expected.shape[1]):
+            values = blocks[j, i]
+            if alg_name == "average":
+                expected[j, i] = math.floor(values.mean() + 0.5)
+            elif alg_name == "mode":
+                # First value to reach the highest count
+                counts = {}
+                max_count = 0
+                for v in values:
+                    counts[v] = counts.get(v, 0) + 1
+                    if counts[v] > max_count:
+                        max_count = counts[v]
+                        expected[j, i] = v
+            else:
+                quant = {"med": 0.5, "q1": 0.25, "q3": 0.75}[alg_name]
+                idx = math.ceil(quant * len(values) - 1)
+                expected[j, i] = numpy.sort(values)[idx]
+
+    numpy.testing.assert_array_equal(got, expected)
+
+
 ###############################################################################
 # Test bugfix for #6526
 
@@ -19,10 +19,12 @@
 #include "gdal.h"
 #include "tilematrixset.hpp"
 #include "gdalcachedpixelaccessor.h"
+#include "gdal_thread_pool.h"
 #include "memdataset.h"
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <string>
 
@@ -6061,4 +6063,384 @@ TEST_F(test_gdal, GDALRasterBand_window_iterator)
     EXPECT_EQ(windows[8].nYSize, 600 - 512);
 }
 
+// Test GDALDataset::SetBlockCacheMax() and SetBlockCachePriority()
+TEST_F(test_gdal, block_cache_quota_and_priority)
+{
+    const GIntBig nOldCacheMax = GDALGetCacheMax64();
+    GDALSetCacheMax64(1024 * 1024);
+
+    const auto ReadAllBlocks = [](GDALDataset *poDS)
+    {
+        auto poBand = poDS->GetRasterBand(1);
+        for (int i = 0; i < poDS->GetRasterYSize(); ++i)
+        {
+            auto poBlock = poBand->GetLockedBlockRef(0, i);
+            ASSERT_NE(poBlock, nullptr);
+            poBlock->DropLock();
+        }
+    };
+
+    {
+        // 2048 blocks of 1024 bytes
+        auto poDS = std::unique_ptr<GDALDataset>(
+            MEMDataset::Create("", 1024, 2048, 1, GDT_Byte, nullptr));
+        EXPECT_EQ(poDS->GetBlockCacheMax(), 0);
+        poDS->SetBlockCacheMax(100 * 1024);
+        EXPECT_EQ(poDS->GetBlockCacheMax(), 100 * 1024);
+        ReadAllBlocks(poDS.get());
+        EXPECT_GT(poDS->GetBlockCacheUsed(), 0);
+        EXPECT_LE(poDS->GetBlockCacheUsed(), 100 * 1024);
+        poDS->FlushCache(false);
+        EXPECT_EQ(poDS->GetBlockCacheUsed(), 0);
+    }
+
+    {
+        auto poHighDS = std::unique_ptr<GDALDataset>(
+            MEMDataset::Create("", 1024, 100, 1, GDT_Byte, nullptr));
+        EXPECT_EQ(poHighDS->GetBlockCachePriority(), GBCP_Normal);
+        poHighDS->SetBlockCachePriority(GBCP_High);
+        EXPECT_EQ(poHighDS->GetBlockCachePriority(), GBCP_High);
+        ReadAllBlocks(poHighDS.get());
+        const GIntBig nHighCacheUsed = poHighDS->GetBlockCacheUsed();
+        EXPECT_GT(nHighCacheUsed, 0);
+
+        // Reading a dataset much larger than the cache must not evict the
+        // blocks of the high priority dataset.
+        auto poLowDS = std::unique_ptr<GDALDataset>(
+            MEMDataset::Create("", 1024, 4096, 1, GDT_Byte, nullptr));
+        poLowDS->SetBlockCachePriority(GBCP_Low);
+        ReadAllBlocks(poLowDS.get());
+        EXPECT_EQ(poHighDS->GetBlockCacheUsed(), nHighCacheUsed);
+        EXPECT_GT(poLowDS->GetBlockCacheUsed(), 0);
+    }
+
+    GDALSetCacheMax64(nOldCacheMax);
+}
+
+// Test multi-threaded ComputeStatistics(), ComputeRasterMinMax() and
+// GetHistogram()
+TEST_F(test_gdal, compute_statistics_multithreaded)
+{
+    auto poDS = std::unique_ptr<GDALDataset>(
+        MEMDataset::Create("", 257, 300, 0, GDT_Byte, nullptr));
+    for (GDALDataType eDT : {GDT_Byte, GDT_UInt16, GDT_Float32})
+        poDS->AddBand(eDT, nullptr);
+    std::vector<double> adfValues(257 * 300);
+    unsigned nSeed = 0;
+    for (auto &dfValue : adfValues)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        dfValue = (nSeed >> 16) % 251;
+    }
+    for (int iBand = 1; iBand <= 3; ++iBand)
+    {
+        EXPECT_EQ(poDS->GetRasterBand(iBand)->RasterIO(
+                      GF_Write, 0, 0, 257, 300, adfValues.data(), 257, 300,
+                      GDT_Float64, 0, 0, nullptr),
+                  CE_None);
+    }
+    poDS->GetRasterBand(2)->SetNoDataValue(0);
+
+    // Mask out the first lines of the third band
+    auto poFloatBand = poDS->GetRasterBand(3);
+    ASSERT_EQ(poFloatBand->CreateMaskBand(0), CE_None);
+    std::vector<GByte> abyMask(257 * 300, 255);
+    std::fill_n(abyMask.begin(), 257 * 10, 0);
+    EXPECT_EQ(poFloatBand->GetMaskBand()->RasterIO(
+                  GF_Write, 0, 0, 257, 300, abyMask.data(), 257, 300, GDT_Byte,
+                  0, 0, nullptr),
+              CE_None);
+
+    for (int iBand = 1; iBand <= 3; ++iBand)
+    {
+        auto poBand = poDS->GetRasterBand(iBand);
+        double adfStats[4] = {0, 0, 0, 0};
+        double adfMinMax[2] = {0, 0};
+        GUIntBig anHistogram[256] = {0};
+        EXPECT_EQ(poBand->ComputeStatistics(false, &adfStats[0], &adfStats[1],
+                                            &adfStats[2], &adfStats[3],
+                                            nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->ComputeRasterMinMax(false, adfMinMax), CE_None);
+        EXPECT_EQ(poBand->GetHistogram(-0.5, 255.5, 256, anHistogram, false,
+                                       false, nullptr, nullptr),
+                  CE_None);
+
+        CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "4", false);
+        double adfStatsMT[4] = {0, 0, 0, 0};
+        double adfMinMaxMT[2] = {0, 0};
+        GUIntBig anHistogramMT[256] = {0};
+        EXPECT_EQ(poBand->ComputeStatistics(false, &adfStatsMT[0],
+                                            &adfStatsMT[1], &adfStatsMT[2],
+                                            &adfStatsMT[3], nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->ComputeRasterMinMax(false, adfMinMaxMT), CE_None);
+        EXPECT_EQ(poBand->GetHistogram(-0.5, 255.5, 256, anHistogramMT, false,
+                                       false, nullptr, nullptr),
+                  CE_None);
+
+        EXPECT_EQ(adfStatsMT[0], adfStats[0]) << iBand;
+        EXPECT_EQ(adfStatsMT[1], adfStats[1]) << iBand;
+        EXPECT_NEAR(adfStatsMT[2], adfStats[2], 1e-10) << iBand;
+        EXPECT_NEAR(adfStatsMT[3], adfStats[3], 1e-10) << iBand;
+        EXPECT_EQ(adfMinMaxMT[0], adfMinMax[0]) << iBand;
+        EXPECT_EQ(adfMinMaxMT[1], adfMinMax[1]) << iBand;
+        for (int i = 0; i < 256; ++i)
+            EXPECT_EQ(anHistogramMT[i], anHistogram[i]) << iBand << " " << i;
+    }
+}
+
+// Test GDALDataset::ComputeStatistics()
+TEST_F(test_gdal, dataset_compute_statistics)
+{
+    for (GDALDataType eDT : {GDT_Byte, GDT_Float32})
+    {
+        CPLStringList aosOptions;
+        aosOptions.SetNameValue("INTERLEAVE", "PIXEL");
+        auto poDS = std::unique_ptr<GDALDataset>(MEMDataset::Create(
+            "", 123, 45, 3, eDT, aosOptions.List()));
+        std::vector<double> adfValues(123 * 45 * 3);
+        unsigned nSeed = 0;
+        for (auto &dfValue : adfValues)
+        {
+            nSeed = nSeed * 1103515245U + 12345U;
+            dfValue = (nSeed >> 16) % 251;
+        }
+        EXPECT_EQ(poDS->RasterIO(GF_Write, 0, 0, 123, 45, adfValues.data(), 123,
+                                 45, GDT_Float64, 3, nullptr, 0, 0, 0,
+                                 nullptr),
+                  CE_None);
+        poDS->GetRasterBand(2)->SetNoDataValue(0);
+        ASSERT_EQ(poDS->GetRasterBand(3)->CreateMaskBand(0), CE_None);
+        std::vector<GByte> abyMask(123 * 45, 255);
+        std::fill_n(abyMask.begin(), 123 * 10, 0);
+        EXPECT_EQ(poDS->GetRasterBand(3)->GetMaskBand()->RasterIO(
+                      GF_Write, 0, 0, 123, 45, abyMask.data(), 123, 45,
+                      GDT_Byte, 0, 0, nullptr),
+                  CE_None);
+
+        double adfExpected[3][4];
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(poDS->GetRasterBand(i + 1)->ComputeStatistics(
+                          false, &adfExpected[i][0], &adfExpected[i][1],
+                          &adfExpected[i][2], &adfExpected[i][3], nullptr,
+                          nullptr),
+                      CE_None);
+        }
+        // Remove the statistics, so that GetStatistics() below only
+        // succeeds if they are computed again.
+        for (int i = 0; i < 3; ++i)
+        {
+            poDS->GetRasterBand(i + 1)->SetMetadataItem("STATISTICS_MINIMUM",
+                                                        nullptr);
+        }
+
+        EXPECT_EQ(poDS->ComputeStatistics(0, nullptr, false, nullptr, nullptr),
+                  CE_None);
+        for (int i = 0; i < 3; ++i)
+        {
+            double adfStats[4] = {0, 0, 0, 0};
+            EXPECT_EQ(poDS->GetRasterBand(i + 1)->GetStatistics(
+                          false, false, &adfStats[0], &adfStats[1],
+                          &adfStats[2], &adfStats[3]),
+                      CE_None);
+            EXPECT_EQ(adfStats[0], adfExpected[i][0]) << i;
+            EXPECT_EQ(adfStats[1], adfExpected[i][1]) << i;
+            EXPECT_NEAR(adfStats[2], adfExpected[i][2], 1e-10) << i;
+            EXPECT_NEAR(adfStats[3], adfExpected[i][3], 1e-10) << i;
+        }
+
+        const int anBandList[] = {1, 4};
+        CPLErrorStateBackuper oErrorHandler(CPLQuietErrorHandler);
+        EXPECT_EQ(poDS->ComputeStatistics(2, anBandList, false, nullptr,
+                                          nullptr),
+                  CE_Failure);
+    }
+}
+
+// Test approximate statistics with GDAL_STATS_APPROX_SAMPLING=BLOCKS
+TEST_F(test_gdal, compute_statistics_approx_sampling_blocks)
+{
+    // 1000 blocks of one line of 400 bytes
+    auto poDS = std::unique_ptr<GDALDataset>(
+        MEMDataset::Create("", 100, 1000, 1, GDT_Float32, nullptr));
+    std::vector<float> afValues(100 * 1000);
+    unsigned nSeed = 0;
+    for (size_t i = 0; i < afValues.size(); ++i)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        afValues[i] = static_cast<float>(i / 1000 + (nSeed >> 16) % 100);
+    }
+    auto poBand = poDS->GetRasterBand(1);
+    EXPECT_EQ(poBand->RasterIO(GF_Write, 0, 0, 100, 1000, afValues.data(), 100,
+                               1000, GDT_Float32, 0, 0, nullptr),
+              CE_None);
+
+    double adfExact[4] = {0, 0, 0, 0};
+    EXPECT_EQ(poBand->ComputeStatistics(false, &adfExact[0], &adfExact[1],
+                                        &adfExact[2], &adfExact[3], nullptr,
+                                        nullptr),
+              CE_None);
+
+    CPLConfigOptionSetter oSamplingSetter("GDAL_STATS_APPROX_SAMPLING",
+                                          "BLOCKS", false);
+    {
+        // Budget of 100 blocks
+        CPLConfigOptionSetter oMaxBytesSetter("GDAL_STATS_APPROX_MAX_BYTES",
+                                              "40KB", false);
+        double adfStats[4] = {0, 0, 0, 0};
+        EXPECT_EQ(poBand->ComputeStatistics(true, &adfStats[0], &adfStats[1],
+                                            &adfStats[2], &adfStats[3],
+                                            nullptr, nullptr),
+                  CE_None);
+        EXPECT_STREQ(poBand->GetMetadataItem("STATISTICS_APPROXIMATE"), "YES");
+        const char *pszStdErr =
+            poBand->GetMetadataItem("STATISTICS_MEAN_STDERR");
+        ASSERT_NE(pszStdErr, nullptr);
+        const double dfStdErr = CPLAtof(pszStdErr);
+        EXPECT_GT(dfStdErr, 0);
+        EXPECT_NEAR(adfStats[2], adfExact[2], 5 * dfStdErr);
+        EXPECT_GE(adfStats[0], adfExact[0]);
+        EXPECT_LE(adfStats[1], adfExact[1]);
+    }
+    {
+        // Budget larger than the band: exact statistics
+        CPLConfigOptionSetter oMaxBytesSetter("GDAL_STATS_APPROX_MAX_BYTES",
+                                              "1MB", false);
+        double adfStats[4] = {0, 0, 0, 0};
+        EXPECT_EQ(poBand->ComputeStatistics(true, &adfStats[0], &adfStats[1],
+                                            &adfStats[2], &adfStats[3],
+                                            nullptr, nullptr),
+                  CE_None);
+        EXPECT_EQ(poBand->GetMetadataItem("STATISTICS_APPROXIMATE"), nullptr);
+        EXPECT_EQ(poBand->GetMetadataItem("STATISTICS_MEAN_STDERR"), nullptr);
+        EXPECT_EQ(adfStats[0], adfExact[0]);
+        EXPECT_EQ(adfStats[1], adfExact[1]);
+        EXPECT_NEAR(adfStats[2], adfExact[2], 1e-10);
+        EXPECT_NEAR(adfStats[3], adfExact[3], 1e-10);
+    }
+}
+
+// Test that a resampled RasterIO() with GDAL_NUM_THREADS does not deadlock
+// when run from jobs of the global thread pool occupying all its threads
+TEST_F(test_gdal, RasterIOResampled_from_global_thread_pool_jobs)
+{
+    constexpr int SRC_SIZE = 2000;
+    constexpr int BUF_SIZE = 100;
+    std::vector<GByte> abySrc(SRC_SIZE * SRC_SIZE);
+    for (size_t i = 0; i < abySrc.size(); ++i)
+        abySrc[i] = static_cast<GByte>(i % 251);
+
+    const auto CreateDS = [&abySrc]()
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(MEMDataset::Create(
+            "", SRC_SIZE, SRC_SIZE, 1, GDT_Byte, nullptr));
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, 0, SRC_SIZE, SRC_SIZE, abySrc.data(), SRC_SIZE,
+            SRC_SIZE, GDT_Byte, 0, 0, nullptr));
+        return poDS;
+    };
+    const auto Read = [](GDALDataset *poDS, std::vector<GByte> &abyBuf)
+    {
+        GDALRasterIOExtraArg sExtraArg;
+        INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+        sExtraArg.eResampleAlg = GRIORA_Average;
+        abyBuf.resize(BUF_SIZE * BUF_SIZE);
+        return poDS->GetRasterBand(1)->RasterIO(
+            GF_Read, 0, 0, SRC_SIZE, SRC_SIZE, abyBuf.data(), BUF_SIZE,
+            BUF_SIZE, GDT_Byte, 0, 0, &sExtraArg);
+    };
+
+    std::vector<GByte> abyRef;
+    {
+        auto poDS = CreateDS();
+        ASSERT_EQ(Read(poDS.get(), abyRef), CE_None);
+    }
+
+    CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "2", false);
+    auto poPool = GDALGetGlobalThreadPool(2);
+    ASSERT_NE(poPool, nullptr);
+    const int nJobs = 2 * poPool->GetThreadCount();
+    std::vector<std::unique_ptr<GDALDataset>> apoDS;
+    for (int i = 0; i < nJobs; ++i)
+        apoDS.push_back(CreateDS());
+    std::vector<std::vector<GByte>> aabyBuf(nJobs);
+    std::atomic<int> nSuccess{0};
+    auto poQueue = poPool->CreateJobQueue();
+    for (int i = 0; i < nJobs; ++i)
+    {
+        ASSERT_TRUE(poQueue->SubmitJob(
+            [&, i]()
+            {
+                if (Read(apoDS[i].get(), aabyBuf[i]) == CE_None)
+                    ++nSuccess;
+            }));
+    }
+    poQueue->WaitCompletion();
+    EXPECT_EQ(nSuccess.load(), nJobs);
+    for (int i = 0; i < nJobs; ++i)
+        EXPECT_EQ(aabyBuf[i], abyRef);
+}
+
+// Test that ComputeStatistics() with GDAL_NUM_THREADS does not deadlock
+// when called from jobs of the global thread pool
+TEST_F(test_gdal, ComputeStatistics_from_global_thread_pool_jobs)
+{
+    constexpr int SIZE = 1000;
+    const auto CreateDS = []()
+    {
+        auto poDS = std::unique_ptr<GDALDataset>(
+            MEMDataset::Create("", SIZE, SIZE, 1, GDT_Byte, nullptr));
+        std::vector<GByte> abyValues(SIZE * SIZE);
+        for (size_t i = 0; i < abyValues.size(); ++i)
+            abyValues[i] = static_cast<GByte>(i % 251);
+        CPL_IGNORE_RET_VAL(poDS->GetRasterBand(1)->RasterIO(
+            GF_Write, 0, 0, SIZE, SIZE, abyValues.data(), SIZE, SIZE, GDT_Byte,
+            0, 0, nullptr));
+        return poDS;
+    };
+
+    double adfRef[4] = {0, 0, 0, 0};
+    {
+        auto poDS = CreateDS();
+        ASSERT_EQ(poDS->GetRasterBand(1)->ComputeStatistics(
+                      false, &adfRef[0], &adfRef[1], &adfRef[2], &adfRef[3],
+                      nullptr, nullptr),
+                  CE_None);
+    }
+
+    CPLConfigOptionSetter oSetter("GDAL_NUM_THREADS", "2", false);
+    auto poPool = GDALGetGlobalThreadPool(2);
+    ASSERT_NE(poPool, nullptr);
+    const int nJobs = 2 * poPool->GetThreadCount();
+    std::vector<std::unique_ptr<GDALDataset>> apoDS;
+    for (int i = 0; i < nJobs; ++i)
+        apoDS.push_back(CreateDS());
+    std::vector<std::array<double, 4>> aadfStats(nJobs);
+    std::atomic<int> nSuccess{0};
+    auto poQueue = poPool->CreateJobQueue();
+    for (int i = 0; i < nJobs; ++i)
+    {
+        ASSERT_TRUE(poQueue->SubmitJob(
+            [&, i]()
+            {
+                auto &adfStats = aadfStats[i];
+                if (apoDS[i]->GetRasterBand(1)->ComputeStatistics(
+                        false, &adfStats[0], &adfStats[1], &adfStats[2],
+                        &adfStats[3], nullptr, nullptr) == CE_None)
+                {
+                    ++nSuccess;
+                }
+            }));
+    }
+    poQueue->WaitCompletion();
+    EXPECT_EQ(nSuccess.load(), nJobs);
+    for (int i = 0; i < nJobs; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+            EXPECT_EQ(aadfStats[i][j], adfRef[j]) << i << " " << j;
+    }
+}
+
 }  // namespace
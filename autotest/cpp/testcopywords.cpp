@@ -19,6 +19,7 @@
 #include <iostream>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "gtest_include.h"
 
@@ -1301,6 +1302,78 @@ INSTANTIATE_TEST_SUITE_P(
                GDALGetDataTypeName(eOut);
     });
 
+// Check that conversions of packed buffers, which may use SIMD code paths,
+// give the same results as word by word conversions.
+TEST_F(TestCopyWords, PackedSameAsWordByWord)
+{
+    const GDALDataType aeTypes[] = {
+        GDT_Byte,    GDT_Int8,    GDT_UInt16, GDT_Int16,  GDT_Int32,
+        GDT_Float32, GDT_Float64, GDT_CInt16, GDT_CInt32, GDT_CFloat32,
+        GDT_CFloat64};
+    constexpr int N = 64 + 13;
+    std::vector<double> adfValues;
+    for (int i = 0; adfValues.size() < 2 * N; ++i)
+    {
+        adfValues.push_back(i * 0.5 - 10);
+        adfValues.push_back(-i * 1e3 - 0.5);
+        adfValues.push_back(i * 1e3 + 0.4);
+        adfValues.push_back(i * 1e8 + 0.6);
+        adfValues.push_back(-i * 1e8);
+        adfValues.push_back(i % 2 ? 1e300 : -1e300);
+        adfValues.push_back(i % 2 ? std::numeric_limits<double>::infinity()
+                                  : -std::numeric_limits<double>::infinity());
+        adfValues.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    for (const GDALDataType eIn : aeTypes)
+    {
+        const int nInSize = GDALGetDataTypeSizeBytes(eIn);
+        for (const GDALDataType eOut : aeTypes)
+        {
+            const int nOutSize = GDALGetDataTypeSizeBytes(eOut);
+            std::vector<GByte> abyIn(N * nInSize);
+            int iValue = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                double adfValue[2];
+                for (double &dfValue : adfValue)
+                    dfValue = adfValues[iValue++ % adfValues.size()];
+                GDALCopyWords(adfValue, GDT_CFloat64, 0, &abyIn[i * nInSize],
+                              eIn, 0, 1);
+            }
+
+            std::vector<GByte> abyOut(N * nOutSize);
+            GDALCopyWords(abyIn.data(), eIn, nInSize, abyOut.data(), eOut,
+                          nOutSize, N);
+
+            std::vector<GByte> abyExpected(N * nOutSize);
+            for (int i = 0; i < N; ++i)
+            {
+                GDALCopyWords(&abyIn[i * nInSize], eIn, 0,
+                              &abyExpected[i * nOutSize], eOut, 0, 1);
+            }
+
+            const GDALDataType eOutComponent = GDALGetNonComplexDataType(eOut);
+            const int nComponentSize = GDALGetDataTypeSizeBytes(eOutComponent);
+            for (int i = 0; i < N * nOutSize / nComponentSize; ++i)
+            {
+                double dfGot = 0;
+                double dfExpected = 0;
+                GDALCopyWords(&abyOut[i * nComponentSize], eOutComponent, 0,
+                              &dfGot, GDT_Float64, 0, 1);
+                GDALCopyWords(&abyExpected[i * nComponentSize], eOutComponent,
+                              0, &dfExpected, GDT_Float64, 0, 1);
+                if (!(std::isnan(dfGot) && std::isnan(dfExpected)))
+                {
+                    EXPECT_EQ(dfGot, dfExpected)
+                        << GDALGetDataTypeName(eIn) << " -> "
+                        << GDALGetDataTypeName(eOut) << ", component " << i;
+                }
+            }
+        }
+    }
+}
+
 TEST_F(TestCopyWords, ByteToByte)
 {
     for (int k = 0; k < 2; k++)
@@ -981,3 +981,67 @@ def test_stats_uint64():
         1 << 50,
         0,
     ]
+
+
+###############################################################################
+# Test that the AVX2 statistics and histogram kernels give the same results
+# as the scalar code paths (GDAL_USE_AVX2=NO is only honoured in debug builds)
+# and as a straightforward implementation, on widths that are and are not
+# multiples of the vector width.
+
+
+@pytest.mark.parametrize(
+    "datatype,struct_frmt",
+    [(gdal.GDT_Int16, "h"), (gdal.GDT_Float32, "f"), (gdal.GDT_Float64, "d")],
+)
+@pytest.mark.parametrize("width", [64, 67])
+@pytest.mark.parametrize("with_nodata", [False, True])
+@pytest.mark.parametrize("with_nan", [False, True])
+def test_stats_avx2_same_as_scalar(
+    datatype, struct_frmt, width, with_nodata, with_nan
+):
+
+    if with_nan and datatype == gdal.GDT_Int16:
+        pytest.skip("NaN not representable")
+
+    height = 3
+    nodata = -5
+    values = []
+    for i in range(width * height):
+        val = ((i * 7919) % 201) - 100
+        if with_nodata and i % 13 == 0:
+            val = nodata
+        elif with_nan and i % 11 == 0:
+            val = float("nan")
+        elif struct_frmt != "h":
+            val += 0.25
+        values.append(val)
+
+    ds = gdal.GetDriverByName("MEM").Create("", width, height, 1, datatype)
+    band = ds.GetRasterBand(1)
+    if with_nodata:
+        band.SetNoDataValue(nodata)
+    ds.WriteRaster(
+        0, 0, width, height, struct.pack(struct_frmt * len(values), *values)
+    )
+
+    valid = [
+        v
+        for v in values
+        if not (with_nodata and v == nodata) and not math.isnan(v)
+    ]
+    mean = sum(valid) / len(valid)
+    stddev = math.sqrt(sum((v - mean) ** 2 for v in valid) / len(valid))
+    expected = [min(valid), max(valid), mean, stddev]
+
+    with gdal.config_option("GDAL_USE_AVX2", "NO"):
+        scalar_stats = band.ComputeStatistics(False)
+        scalar_hist = band.GetHistogram(-100.5, 100.5, 201, False, False)
+    stats = band.ComputeStatistics(False)
+    hist = band.GetHistogram(-100.5, 100.5, 201, False, False)
+
+    # The mean can be close to zero, hence the absolute tolerance
+    assert stats == pytest.approx(expected, rel=1e-12, abs=1e-10)
+    assert stats == pytest.approx(scalar_stats, rel=1e-12, abs=1e-10)
+    assert hist == scalar_hist
+    assert sum(hist) == len(valid)
@@ -3568,6 +3568,136 @@ def test_rasterio_constant_value(resample_alg, dt, struct_type, val):
     )
 
 
+###############################################################################
+# Test that resampled RasterIO() gives the same result whether chunks are
+# resampled by worker threads or not
+
+
+@pytest.mark.parametrize(
+    "resample_alg",
+    [
+        gdal.GRIORA_Bilinear,
+        gdal.GRIORA_Cubic,
+        gdal.GRIORA_Mode,
+        gdal.GRIORA_Average,
+    ],
+)
+@pytest.mark.parametrize("buf_type", [gdal.GDT_Byte, gdal.GDT_Float32])
+def test_rasterio_resampled_multithreaded(resample_alg, buf_type):
+
+    xsize = 3001
+    ysize = 2503
+    ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1)
+    data = bytes(range(251)) * (xsize * ysize // 251 + 1)
+    ds.WriteRaster(0, 0, xsize, ysize, data[: xsize * ysize])
+    # Fully transparent and partially transparent chunks
+    ds.WriteRaster(0, 0, 1500, 1000, b"\0" * (1500 * 1000))
+    ds.WriteRaster(2000, 1500, 2, 2, b"\0" * 4)
+    ds.GetRasterBand(1).SetNoDataValue(0)
+
+    def read(num_threads):
+        tab_pct = [0]
+
+        def callback(pct, message, user_data):
+            assert pct >= tab_pct[0]
+            tab_pct[0] = pct
+            return 1
+
+        with gdal.config_option("GDAL_NUM_THREADS", num_threads):
+            data = ds.GetRasterBand(1).ReadRaster(
+                0.5,
+                0.5,
+                xsize - 1,
+                ysize - 1,
+                123,
+                101,
+                buf_type=buf_type,
+                resample_alg=resample_alg,
+                callback=callback,
+            )
+        assert tab_pct[0] == 1.0
+        return data
+
+    assert read("4") == read("1")
+
+
+###############################################################################
+# Test reading whole blocks directly into the user buffer
+
+
+def test_rasterio_direct_block_read(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.tif")
+    xsize = 100
+    ysize = 70
+    src_ds = gdal.GetDriverByName("MEM").Create("", xsize, ysize, 1, gdal.GDT_Int16)
+    data = struct.pack("h" * (xsize * ysize), *range(xsize * ysize))
+    src_ds.WriteRaster(0, 0, xsize, ysize, data)
+    gdal.GetDriverByName("GTiff").CreateCopy(
+        filename, src_ds, options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"]
+    )
+
+    def expected(xoff, yoff, xsize, ysize):
+        return src_ds.GetRasterBand(1).ReadRaster(xoff, yoff, xsize, ysize)
+
+    with gdal.Open(filename, gdal.GA_Update) as ds:
+        band = ds.GetRasterBand(1)
+
+        tab_pct = [0]
+
+        def callback(pct, message, user_data):
+            assert pct >= tab_pct[0]
+            tab_pct[0] = pct
+            return 1
+
+        # 3 whole blocks and 2 remaining lines
+        assert band.ReadRaster(16, 0, 16, 50, callback=callback) == expected(
+            16, 0, 16, 50
+        )
+        assert tab_pct[0] == 1.0
+
+        # Whole blocks only, one of them cached
+        band.ReadRaster(32, 16, 1, 1)
+        assert band.ReadRaster(32, 0, 16, 64) == expected(32, 0, 16, 64)
+
+        # Cached blocks are used, even if they are dirty
+        modified = struct.pack("h" * 16, *range(-16, 0))
+        band.WriteRaster(48, 20, 16, 1, modified)
+        got = band.ReadRaster(48, 16, 16, 16)
+        assert got[4 * 32 : 5 * 32] == modified
+        assert got[: 4 * 32] == expected(48, 16, 16, 4)
+
+
+###############################################################################
+# Test reading contiguous lines of a raw file directly into the user buffer
+
+
+def test_rasterio_raw_contiguous_read(tmp_vsimem):
+
+    filename = str(tmp_vsimem / "test.bil")
+    xsize = 101
+    ysize = 53
+    data = struct.pack("H" * (xsize * ysize), *range(xsize * ysize))
+    with gdal.GetDriverByName("EHdr").Create(
+        filename, xsize, ysize, 1, gdal.GDT_UInt16
+    ) as ds:
+        ds.WriteRaster(0, 0, xsize, ysize, data)
+
+    with gdal.Open(filename, gdal.GA_Update) as ds:
+        band = ds.GetRasterBand(1)
+        assert band.ReadRaster() == data
+        assert band.ReadRaster(0, 10, xsize, 20) == data[
+            10 * xsize * 2 : 30 * xsize * 2
+        ]
+
+        # Dirty lines in the block cache must be taken into account
+        modified = struct.pack("H" * xsize, *range(xsize, 0, -1))
+        band.WriteRaster(0, 5, xsize, 1, modified)
+        assert band.ReadRaster() == data[: 5 * xsize * 2] + modified + data[
+            6 * xsize * 2 :
+        ]
+
+
 ###############################################################################
 # Test RasterIO() overview selection logic
 
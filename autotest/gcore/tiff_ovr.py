@@ -2414,6 +2414,62 @@ def test_tiff_ovr_multithreading_singleband():
     gdal.Unlink("/vsimem/test.tif")
 
 
+###############################################################################
+# Test that GDAL_OVR_SINGLE_PASS=YES gives the same result as the default
+# level by level computation. This only holds for lossless compression: with
+# a lossy one, the default computation derives each level from the decoded
+# previous level.
+
+
+@pytest.mark.parametrize("resampling", ["NEAREST", "AVERAGE", "MODE", "RMS"])
+@pytest.mark.parametrize("nodata", [None, 0])
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_tiff_ovr_single_pass(resampling, nodata, num_threads):
+
+    src_ds = gdal.Translate(
+        "",
+        "data/stefan_full_rgba.tif",
+        format="MEM",
+        outputType=gdal.GDT_UInt16,
+        width=203,
+        height=181,
+        bandList=[1, 2, 3],
+    )
+    if nodata is not None:
+        for i in range(3):
+            src_ds.GetRasterBand(i + 1).SetNoDataValue(nodata)
+
+    checksums = []
+    for single_pass in ["NO", "YES"]:
+        filename = f"/vsimem/test_tiff_ovr_single_pass_{single_pass}.tif"
+        ds = gdal.GetDriverByName("GTiff").CreateCopy(
+            filename,
+            src_ds,
+            options=["TILED=YES", "BLOCKXSIZE=16", "BLOCKYSIZE=16"],
+        )
+        with gdaltest.config_options(
+            {
+                "GDAL_OVR_SINGLE_PASS": single_pass,
+                "GDAL_NUM_THREADS": num_threads,
+                "GDAL_OVR_CHUNK_MAX_SIZE": "2000",
+            }
+        ):
+            ds.BuildOverviews(resampling, [2, 4, 8, 16])
+        ds = None
+        ds = gdal.Open(filename)
+        checksums.append(
+            [
+                ds.GetRasterBand(i + 1).GetOverview(j).Checksum()
+                for i in range(3)
+                for j in range(4)
+            ]
+        )
+        ds = None
+        gdal.Unlink(filename)
+
+    assert checksums[0] == checksums[1]
+
+
 ###############################################################################
 
 
@@ -3143,3 +3199,35 @@ def test_tiff_ovr_INT_MAX_reduction_factor_external(tmp_vsimem):
     gdal.GetDriverByName("GTIFF").Create(tmp_vsimem / "out.tif", 20, 20)
     ds = gdal.Open(tmp_vsimem / "out.tif")
     ds.BuildOverviews("NEAR", [(1 << 31) - 1])
+
+
+###############################################################################
+# Test that the AVX2 overview kernels give exactly the same results as the
+# SSE2 code paths (GDAL_USE_AVX2=NO is only honoured in debug builds)
+
+
+@pytest.mark.parametrize(
+    "resampling", ["AVERAGE", "BILINEAR", "CUBIC", "CUBICSPLINE", "LANCZOS"]
+)
+@pytest.mark.parametrize("datatype", [gdal.GDT_Byte, gdal.GDT_UInt16])
+@pytest.mark.parametrize("factor", [2, 3, 5])
+def test_tiff_ovr_avx2_same_as_sse2(tmp_vsimem, resampling, datatype, factor):
+
+    width = 131
+    height = 67
+    struct_frmt = "B" if datatype == gdal.GDT_Byte else "H"
+    values = [((i * 7919) % 251) for i in range(width * height)]
+
+    def build_overview(filename):
+        ds = gdal.GetDriverByName("GTiff").Create(
+            filename, width, height, 1, datatype
+        )
+        ds.WriteRaster(
+            0, 0, width, height, struct.pack(struct_frmt * len(values), *values)
+        )
+        ds.BuildOverviews(resampling, [factor])
+        return ds.GetRasterBand(1).GetOverview(0).ReadRaster()
+
+    with gdal.config_option("GDAL_USE_AVX2", "NO"):
+        ref = build_overview(tmp_vsimem / "ref.tif")
+    assert build_overview(tmp_vsimem / "test.tif") == ref
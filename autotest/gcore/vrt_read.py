@@ -3024,3 +3024,214 @@ def test_vrt_read_CheckCompatibleForDatasetIO():
     assert (
         another_vrt.GetMetadataItem("CheckCompatibleForDatasetIO()", "__DEBUG__") == "1"
     )
+
+
+###############################################################################
+# Test a mosaic with enough sources for the spatial index of sources to be used
+
+
+def _get_many_sources_vrt(filename=None):
+
+    ref_data = gdal.Open("data/byte.tif").ReadRaster()
+
+    sources = ""
+    expected = bytearray(200 * 200)
+    for j in range(10):
+        for i in range(10):
+            if (i, j) == (5, 5):
+                # Leave a hole
+                continue
+            sources += f"""
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="{i * 20}" yOff="{j * 20}" xSize="20" ySize="20" />
+    </SimpleSource>"""
+            for y in range(20):
+                offset = (j * 20 + y) * 200 + i * 20
+                expected[offset : offset + 20] = ref_data[y * 20 : (y + 1) * 20]
+
+    # Last source wins over the ones it overlaps
+    sources += """
+    <ComplexSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="10" yOff="10" xSize="20" ySize="20" />
+      <ScaleOffset>255</ScaleOffset>
+      <ScaleRatio>0</ScaleRatio>
+    </ComplexSource>"""
+    for y in range(20):
+        offset = (10 + y) * 200 + 10
+        expected[offset : offset + 20] = b"\xff" * 20
+
+    xml = f"""<VRTDataset rasterXSize="200" rasterYSize="200">
+  <VRTRasterBand dataType="Byte" band="1">{sources}
+  </VRTRasterBand>
+</VRTDataset>"""
+    if filename:
+        with open(filename, "wt") as f:
+            f.write(xml)
+        return gdal.Open(filename), expected
+    return gdal.Open(xml), expected
+
+
+def test_vrt_read_many_sources_spatial_index():
+
+    ds, expected = _get_many_sources_vrt()
+    assert ds.ReadRaster() == expected
+    assert ds.GetRasterBand(1).ReadRaster() == expected
+
+    for xoff, yoff, xsize, ysize in [
+        (0, 0, 20, 20),
+        (5, 5, 30, 30),
+        (100, 100, 20, 20),
+        (95, 98, 10, 30),
+        (180, 190, 20, 10),
+    ]:
+        expected_window = b"".join(
+            expected[(yoff + y) * 200 + xoff : (yoff + y) * 200 + xoff + xsize]
+            for y in range(ysize)
+        )
+        assert ds.ReadRaster(xoff, yoff, xsize, ysize) == expected_window
+        assert (
+            ds.GetRasterBand(1).ReadRaster(xoff, yoff, xsize, ysize)
+            == expected_window
+        )
+
+
+@pytest.mark.require_geos
+def test_vrt_read_many_sources_spatial_index_data_coverage_status():
+
+    ds, _ = _get_many_sources_vrt()
+
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(100, 100, 20, 20)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY and pct == 0.0
+
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(110, 90, 20, 20)
+    assert (
+        flags
+        == gdal.GDAL_DATA_COVERAGE_STATUS_DATA | gdal.GDAL_DATA_COVERAGE_STATUS_EMPTY
+        and pct == 75.0
+    )
+
+    (flags, pct) = ds.GetRasterBand(1).GetDataCoverageStatus(40, 60, 20, 20)
+    assert flags == gdal.GDAL_DATA_COVERAGE_STATUS_DATA and pct == 100.0
+
+
+###############################################################################
+# Test deferred instantiation of sources
+
+
+def test_vrt_read_many_sources_lazy():
+
+    with gdal.config_option("VRT_LAZY_SOURCES", "NO"):
+        ref_ds, expected = _get_many_sources_vrt()
+    with gdal.config_option("VRT_LAZY_SOURCES", "YES"):
+        ds, _ = _get_many_sources_vrt()
+
+    assert ds.GetRasterBand(1).ReadRaster(95, 98, 10, 30) == ref_ds.GetRasterBand(
+        1
+    ).ReadRaster(95, 98, 10, 30)
+    assert ds.ReadRaster(0, 0, 20, 20) == ref_ds.ReadRaster(0, 0, 20, 20)
+    assert ds.ReadRaster() == expected
+    assert ds.GetRasterBand(1).ReadRaster() == expected
+
+    assert ds.GetRasterBand(1).GetMetadataItem(
+        "Pixel_15_15", "LocationInfo"
+    ) == ref_ds.GetRasterBand(1).GetMetadataItem("Pixel_15_15", "LocationInfo")
+    assert ds.GetRasterBand(1).GetMetadataItem(
+        "Pixel_110_110", "LocationInfo"
+    ) == ref_ds.GetRasterBand(1).GetMetadataItem("Pixel_110_110", "LocationInfo")
+
+
+def test_vrt_read_many_sources_lazy_serialization():
+
+    with gdal.config_option("VRT_LAZY_SOURCES", "NO"):
+        ref_ds, _ = _get_many_sources_vrt()
+    with gdal.config_option("VRT_LAZY_SOURCES", "YES"):
+        ds, expected = _get_many_sources_vrt()
+
+    # Serialize before any source has been instantiated
+    assert ds.GetMetadata("xml:VRT") == ref_ds.GetMetadata("xml:VRT")
+    assert ds.GetFileList() == ref_ds.GetFileList()
+    assert ds.GetRasterBand(1).GetMetadata(
+        "vrt_sources"
+    ) == ref_ds.GetRasterBand(1).GetMetadata("vrt_sources")
+    assert ds.ReadRaster() == expected
+
+
+###############################################################################
+# Test opening a VRT from its sources cache
+
+
+def test_vrt_read_many_sources_cache(tmp_path):
+
+    filename = str(tmp_path / "test.vrt")
+    cache_filename = filename + ".srccache"
+
+    with gdal.config_options(
+        {"VRT_SOURCES_CACHE": "YES", "VRT_LAZY_SOURCES": "YES"}
+    ):
+        ds, expected = _get_many_sources_vrt(filename)
+        assert ds.ReadRaster() == expected
+        ref_window = ds.ReadRaster(95, 98, 10, 30)
+        ref_location_info = ds.GetRasterBand(1).GetMetadataItem(
+            "Pixel_15_15", "LocationInfo"
+        )
+        ref_xml = ds.GetMetadata("xml:VRT")
+        ds.Close()
+        assert os.path.exists(cache_filename)
+
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster(95, 98, 10, 30) == ref_window
+        assert ds.ReadRaster() == expected
+        assert (
+            ds.GetRasterBand(1).GetMetadataItem("Pixel_15_15", "LocationInfo")
+            == ref_location_info
+        )
+        assert ds.GetMetadata("xml:VRT") == ref_xml
+        ds.Close()
+
+        # Cache invalidated by a change of the VRT file
+        with open(filename, "at") as f:
+            f.write("\n")
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == expected
+        ds.Close()
+
+        # Cache invalidated by a change of the VRT file that keeps its size
+        # and modification time
+        with open(filename, "rt") as f:
+            xml = f.read()
+        new_xml = xml.replace(
+            '<DstRect xOff="0" yOff="0"', '<DstRect xOff="0" yOff="1"', 1
+        )
+        assert len(new_xml) == len(xml)
+        stat = os.stat(filename)
+        with open(filename, "wt") as f:
+            f.write(new_xml)
+        os.utime(filename, ns=(stat.st_atime_ns, stat.st_mtime_ns))
+        with gdal.config_option("VRT_SOURCES_CACHE", "NO"):
+            new_expected = gdal.Open(filename).ReadRaster()
+        assert new_expected != expected
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == new_expected
+        ds.Close()
+
+        # Corrupted cache ignored
+        with open(cache_filename, "r+b") as f:
+            f.truncate(os.path.getsize(cache_filename) // 2)
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == new_expected
+        ds.Close()
+
+    os.unlink(cache_filename)
+    with gdal.config_options(
+        {"VRT_SOURCES_CACHE": "READ_ONLY", "VRT_LAZY_SOURCES": "YES"}
+    ):
+        ds = gdal.Open(filename)
+        assert ds.ReadRaster() == new_expected
+        ds.Close()
+    assert not os.path.exists(cache_filename)
@@ -14,6 +14,7 @@
 
 import math
 import os
+import struct
 import sys
 import threading
 
@@ -1375,6 +1376,176 @@ def test_vrt_pixelfn_expression_coordinates_no_geotransform():
         gdal.Open(xml).ReadRaster()
 
 
+###############################################################################
+# Test that the vectorized evaluation of muparser expressions gives the same
+# results as muparser itself
+
+
+@pytest.mark.parametrize(
+    "expression",
+    [
+        "(B1 - B2) / (B1 + B2)",
+        "B1 > 100 ? B2 : -B1",
+        "B1 >= 107 && B2 != 115 || B1 == 0",
+        "min(B1, B2, 50) + max(BANDS) - avg(BANDS) + sum(BANDS)",
+        "sqrt(abs(B1 - B2)) * sin(B1) + B2^2 - B1^3 / 1e4",
+        "isnan(B1 / (B1 - B2)) ? _pi : ln(B1) * exp(-B2 / 100)",
+        "isnodata(B1) ? 0 : B1 * NODATA",
+        "_CENTER_X_ + _CENTER_Y_ * B1",
+        "log2(B1)",
+    ],
+)
+def test_vrt_pixelfn_expression_vectorized(expression):
+
+    if not gdaltest.gdal_has_vrt_expression_dialect("muparser"):
+        pytest.skip("muparser not available")
+
+    if (
+        "isnodata" in expression
+        and gdal.GetDriverByName("VRT").GetMetadataItem(
+            "MUPARSER_HAS_DEFINE_FUN_USER_DATA"
+        )
+        is None
+    ):
+        pytest.skip("muparser does not support isnodata")
+
+    expression = (
+        expression.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;")
+    )
+
+    xml = f"""
+    <VRTDataset rasterXSize="19" rasterYSize="19">
+      <GeoTransform>440720, 60, 0, 3751320, 0, -60</GeoTransform>
+      <VRTRasterBand dataType="Float64" band="1" subClass="VRTDerivedRasterBand">
+        <NoDataValue>107</NoDataValue>
+        <PixelFunctionType>expression</PixelFunctionType>
+        <PixelFunctionArguments expression="{expression}" dialect="muparser"/>
+        <SimpleSource>
+          <SourceFilename>data/byte.tif</SourceFilename>
+          <SourceBand>1</SourceBand>
+          <SrcRect xOff="0" yOff="0" xSize="19" ySize="19" />
+          <DstRect xOff="0" yOff="0" xSize="19" ySize="19" />
+        </SimpleSource>
+        <SimpleSource>
+          <SourceFilename>data/byte.tif</SourceFilename>
+          <SourceBand>1</SourceBand>
+          <SrcRect xOff="1" yOff="1" xSize="19" ySize="19" />
+          <DstRect xOff="0" yOff="0" xSize="19" ySize="19" />
+        </SimpleSource>
+      </VRTRasterBand>
+    </VRTDataset>"""
+
+    with gdal.config_option("VRT_VECTORIZED_EXPRESSION", "NO"):
+        expected = struct.unpack("d" * 19 * 19, gdal.Open(xml).ReadRaster())
+    with gdal.config_option("VRT_VECTORIZED_EXPRESSION", "YES"):
+        got = struct.unpack("d" * 19 * 19, gdal.Open(xml).ReadRaster())
+
+    assert got == pytest.approx(expected, rel=1e-14, nan_ok=True)
+
+
+###############################################################################
+# Test that large requests on a derived band evaluated by chunks in several
+# threads give the same result as in a single thread
+
+
+def test_vrt_derived_multithreaded(tmp_vsimem):
+
+    gdaltest.importorskip_gdal_array()
+    np = pytest.importorskip("numpy")
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename, 1000, 1100, 2, gdal.GDT_UInt16
+    )
+    rng = np.random.default_rng(0)
+    for i in range(2):
+        src_ds.GetRasterBand(i + 1).WriteArray(
+            rng.integers(0, 10000, size=(1100, 1000), dtype=np.uint16)
+        )
+    src_ds.Close()
+
+    xml = f"""
+    <VRTDataset rasterXSize="1000" rasterYSize="1100">
+      <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+        <PixelFunctionType>diff</PixelFunctionType>
+        <SimpleSource>
+          <SourceFilename>{src_filename}</SourceFilename>
+          <SourceBand>1</SourceBand>
+        </SimpleSource>
+        <SimpleSource>
+          <SourceFilename>{src_filename}</SourceFilename>
+          <SourceBand>2</SourceBand>
+        </SimpleSource>
+      </VRTRasterBand>
+    </VRTDataset>"""
+
+    ds = gdal.OpenEx(xml, open_options=["NUM_THREADS=1"])
+    expected = ds.ReadAsArray()
+
+    ds = gdal.OpenEx(xml, open_options=["NUM_THREADS=4"])
+    tab_pct = [0]
+
+    def my_progress(pct, msg, user_data):
+        assert pct >= tab_pct[0]
+        tab_pct[0] = pct
+        return 1
+
+    np.testing.assert_array_equal(ds.ReadAsArray(callback=my_progress), expected)
+    np.testing.assert_array_equal(
+        ds.ReadAsArray(0, 50, 1000, 1000), expected[50:1050, :]
+    )
+
+    if gdal.GetNumCPUs() >= 2:
+        assert tab_pct[0] == 1.0
+
+        with pytest.raises(Exception, match="User terminated"):
+            ds.ReadAsArray(callback=lambda pct, msg, user_data: 0)
+
+
+###############################################################################
+# Test that the clones used for multithreaded requests on a derived band are
+# refreshed when the dataset is modified
+
+
+def test_vrt_derived_multithreaded_modified(tmp_vsimem):
+
+    gdaltest.importorskip_gdal_array()
+    np = pytest.importorskip("numpy")
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename, 1000, 1100, 2, gdal.GDT_UInt16
+    )
+    rng = np.random.default_rng(0)
+    src = [rng.integers(0, 10000, size=(1100, 1000), dtype=np.uint16) for i in range(2)]
+    for i in range(2):
+        src_ds.GetRasterBand(i + 1).WriteArray(src[i])
+    src_ds.Close()
+
+    def source_xml(band):
+        return f"""<SimpleSource>
+          <SourceFilename>{src_filename}</SourceFilename>
+          <SourceBand>{band}</SourceBand>
+        </SimpleSource>"""
+
+    xml = f"""
+    <VRTDataset rasterXSize="1000" rasterYSize="1100">
+      <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+        <PixelFunctionType>sum</PixelFunctionType>
+        {source_xml(1)}
+      </VRTRasterBand>
+    </VRTDataset>"""
+
+    ds = gdal.OpenEx(xml, open_options=["NUM_THREADS=4"])
+    band = ds.GetRasterBand(1)
+    np.testing.assert_array_equal(band.ReadAsArray(), src[0].astype(np.float32))
+
+    band.SetMetadataItem("source_1", source_xml(2), "new_vrt_sources")
+    np.testing.assert_array_equal(
+        band.ReadAsArray(), src[0].astype(np.float32) + src[1]
+    )
+
+
 ###############################################################################
 # Test multiplication / summation by a constant factor
 
@@ -1819,6 +1819,59 @@ def test_vrtprocesseddataset_RasterIO(tmp_vsimem):
             ds.ReadAsArray()
 
 
+###############################################################################
+# Test that large requests processed by chunks in several threads give the
+# same result as in a single thread
+
+
+def test_vrtprocesseddataset_RasterIO_multithreaded(tmp_vsimem):
+
+    src_filename = str(tmp_vsimem / "src.tif")
+    src_ds = gdal.GetDriverByName("GTiff").Create(
+        src_filename, 1000, 1100, 3, options=["TILED=YES"]
+    )
+    rng = np.random.default_rng(0)
+    for i in range(3):
+        src_ds.GetRasterBand(i + 1).WriteArray(
+            rng.integers(0, 256, size=(1100, 1000), dtype=np.uint8)
+        )
+    src_ds.Close()
+
+    vrt_content = f"""<VRTDataset subclass='VRTProcessedDataset'>
+    <Input>
+        <SourceFilename>{src_filename}</SourceFilename>
+    </Input>
+    <ProcessingSteps>
+        <Step>
+            <Algorithm>BandAffineCombination</Algorithm>
+            <Argument name="coefficients_1">1,0.5,0.25,0</Argument>
+            <Argument name="coefficients_2">2,0,0.5,0.25</Argument>
+            <Argument name="coefficients_3">3,0.25,0,0.5</Argument>
+        </Step>
+    </ProcessingSteps>
+    </VRTDataset>
+        """
+
+    ds = gdal.OpenEx(vrt_content, open_options=["NUM_THREADS=1"])
+    expected = ds.ReadAsArray()
+    expected_pixel = ds.ReadAsArray(interleave="PIXEL")
+
+    ds = gdal.OpenEx(vrt_content, open_options=["NUM_THREADS=4"])
+    tab_pct = [0]
+
+    def my_progress(pct, msg, user_data):
+        assert pct >= tab_pct[0]
+        tab_pct[0] = pct
+        return 1
+
+    np.testing.assert_equal(ds.ReadAsArray(callback=my_progress), expected)
+    assert tab_pct[0] == 1.0
+    np.testing.assert_equal(ds.ReadAsArray(interleave="PIXEL"), expected_pixel)
+    np.testing.assert_equal(
+        ds.ReadAsArray(0, 100, 1000, 1000), expected[:, 100:1100, :]
+    )
+
+
 ###############################################################################
 # Validate processed datasets according to xsd
 
@@ -4651,3 +4651,110 @@ def test_gdalwarp_te_srs_check_extent():
     assert out_ds.GetGeoTransform() == pytest.approx(
         (166021, 37108, 0.0, 0.0, 0.0, -36622), abs=1000
     )
+
+
+###############################################################################
+# Test that the pipelined multithreaded warping gives the same result as the
+# single-threaded one, with chunks read in parallel or not
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+@pytest.mark.parametrize("dstalpha", [False, True])
+def test_gdalwarp_lib_multithread_pipeline(tmp_path, num_threads, dstalpha):
+
+    src_filename = str(tmp_path / "src.tif")
+    gdal.Translate(src_filename, "../gcore/data/byte.tif", options="-outsize 400 400")
+
+    # -et 0 so that the result does not depend on the chunk size
+    options = "-t_srs EPSG:4326 -r bilinear -et 0 -wm 0.1"
+    if dstalpha:
+        options += " -dstalpha"
+    ref_ds = gdal.Warp(str(tmp_path / "ref.tif"), src_filename, options=options)
+
+    out_ds = gdal.Warp(
+        str(tmp_path / "out.tif"),
+        src_filename,
+        options=options + " -multi -wo NUM_THREADS=" + num_threads,
+    )
+
+    assert out_ds.RasterCount == ref_ds.RasterCount
+    assert out_ds.RasterXSize == ref_ds.RasterXSize
+    assert out_ds.RasterYSize == ref_ds.RasterYSize
+    for i in range(ref_ds.RasterCount):
+        assert (
+            out_ds.GetRasterBand(i + 1).Checksum()
+            == ref_ds.GetRasterBand(i + 1).Checksum()
+        )
+
+
+###############################################################################
+# Test that GDAL_APPROX_TRANSFORMER_CACHE_SIZE does not change the result of
+# warping, including when the cache is reused by a warp with the same grids
+
+
+@pytest.mark.parametrize("num_threads", ["1", "4"])
+def test_gdalwarp_lib_approx_transformer_cache(tmp_path, num_threads):
+
+    src_filename = str(tmp_path / "src.tif")
+    gdal.Translate(src_filename, "../gcore/data/byte.tif", options="-outsize 400 400")
+    src2_filename = str(tmp_path / "src2.tif")
+    gdal.Translate(
+        src2_filename, "../gcore/data/byte.tif", options="-outsize 400 400 -scale"
+    )
+
+    options = "-t_srs EPSG:4326 -wm 0.1 -multi -wo NUM_THREADS=" + num_threads
+    ref_ds = gdal.Warp(str(tmp_path / "ref.tif"), src_filename, options=options)
+    ref2_ds = gdal.Warp(str(tmp_path / "ref2.tif"), src2_filename, options=options)
+
+    with gdal.config_option("GDAL_APPROX_TRANSFORMER_CACHE_SIZE", "1000000"):
+        for i in range(2):
+            out_ds = gdal.Warp(
+                str(tmp_path / f"out{i}.tif"), src_filename, options=options
+            )
+            assert (
+                out_ds.GetRasterBand(1).Checksum()
+                == ref_ds.GetRasterBand(1).Checksum()
+            )
+            out_ds = gdal.Warp(
+                str(tmp_path / f"out2_{i}.tif"), src2_filename, options=options
+            )
+            assert (
+                out_ds.GetRasterBand(1).Checksum()
+                == ref2_ds.GetRasterBand(1).Checksum()
+            )
+
+
+###############################################################################
+# Test that GDAL_APPROX_TRANSFORMER_GRID_STEP gives results close to the exact
+# transformation
+
+
+@pytest.mark.parametrize("grid_step", ["4", "16", "64"])
+def test_gdalwarp_lib_approx_transformer_grid(tmp_path, grid_step):
+
+    src_filename = str(tmp_path / "src.tif")
+    gdal.Translate(src_filename, "../gcore/data/byte.tif", options="-outsize 400 400")
+
+    ref_ds = gdal.Warp(
+        str(tmp_path / "ref.tif"), src_filename, options="-t_srs EPSG:4326 -et 0"
+    )
+    # The grid step is smaller than the scanlines, so the grid must be used.
+    with gdal.config_options(
+        {"GDAL_APPROX_TRANSFORMER_GRID_STEP": grid_step, "CPL_DEBUG": "ON"}
+    ), gdaltest.error_raised(
+        gdal.CE_Debug, f"Approximate transformer: using a grid of step {grid_step}"
+    ):
+        out_ds = gdal.Warp(
+            str(tmp_path / "out.tif"),
+            src_filename,
+            options="-t_srs EPSG:4326 -et 0.125",
+        )
+
+    assert out_ds.RasterXSize == ref_ds.RasterXSize
+    assert out_ds.RasterYSize == ref_ds.RasterYSize
+    ref_data = ref_ds.ReadRaster()
+    out_data = out_ds.ReadRaster()
+    # Nearest neighbour resampling may pick a neighbouring pixel when the
+    # source location is close to a pixel edge.
+    diff_count = sum(1 for a, b in zip(ref_data, out_data) if a != b)
+    assert diff_count < len(ref_data) // 100
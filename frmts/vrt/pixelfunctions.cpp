@@ -2860,14 +2860,6 @@ static CPLErr ExprPixelFunc(void **papoSources, int nSources, void *pData,
         pszDialect = "muparser";
     }
 
-    auto poExpression = gdal::MathExpression::Create(pszExpression, pszDialect);
-
-    // cppcheck-suppress knownConditionTrueFalse
-    if (!poExpression)
-    {
-        return CE_Failure;
-    }
-
     int nXOff = 0;
     int nYOff = 0;
     GDALGeoTransform gt;
@@ -2909,6 +2901,122 @@ static CPLErr ExprPixelFunc(void **papoSources, int nSources, void *pData,
         }
     }
 
+    std::unique_ptr<double, VSIFreeReleaser> padfResults(
+        static_cast<double *>(VSI_MALLOC2_VERBOSE(nXSize, sizeof(double))));
+    if (!padfResults)
+        return CE_Failure;
+
+#if GDAL_VRT_ENABLE_MUPARSER
+    // Expressions made only of the pure part of the muparser dialect are
+    // evaluated on whole lines at a time.
+    if (EQUAL(pszDialect, "muparser") &&
+        CPLTestBool(CPLGetConfigOption("VRT_VECTORIZED_EXPRESSION", "YES")))
+    {
+        std::vector<std::string> aosVariables;
+        for (const char *pszName : aosSourceNames)
+            aosVariables.push_back(pszName);
+        if (includeCenterCoords)
+        {
+            aosVariables.push_back("_CENTER_X_");
+            aosVariables.push_back("_CENTER_Y_");
+        }
+        // Without DefineFunUserData(), muparser has no isnodata() function
+        auto poVectorizedExpression = gdal::VectorizedExpression::Compile(
+            pszExpression, aosVariables,
+            strstr(pszExpression, "BANDS") ? nSources : 0,
+            bHasNoData && gdal::MuParserHasDefineFunUserData() ? &dfNoData
+                                                               : nullptr);
+        if (poVectorizedExpression)
+        {
+            const int nSrcTypeSize = GDALGetDataTypeSizeBytes(eSrcType);
+            std::vector<double> adfSrcValues;
+            if (eSrcType != GDT_Float64)
+            {
+                adfSrcValues.resize(static_cast<size_t>(nXSize) * nSources);
+            }
+            std::vector<double> adfCenterX;
+            std::vector<double> adfCenterY;
+            if (includeCenterCoords)
+            {
+                adfCenterX.resize(nXSize);
+                adfCenterY.resize(nXSize);
+            }
+            std::vector<const double *> apadfVariables(aosVariables.size());
+
+            for (int iLine = 0; iLine < nYSize; ++iLine)
+            {
+                const size_t nLineStart = static_cast<size_t>(iLine) * nXSize;
+                for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                {
+                    if (eSrcType == GDT_Float64)
+                    {
+                        apadfVariables[iSrc] =
+                            static_cast<const double *>(papoSources[iSrc]) +
+                            nLineStart;
+                    }
+                    else
+                    {
+                        double *padfSrc =
+                            adfSrcValues.data() +
+                            static_cast<size_t>(iSrc) * nXSize;
+                        GDALCopyWords64(
+                            static_cast<const GByte *>(papoSources[iSrc]) +
+                                nLineStart * nSrcTypeSize,
+                            eSrcType, nSrcTypeSize, padfSrc, GDT_Float64,
+                            sizeof(double), nXSize);
+                        apadfVariables[iSrc] = padfSrc;
+                    }
+                }
+
+                if (includeCenterCoords)
+                {
+                    for (int iCol = 0; iCol < nXSize; ++iCol)
+                    {
+                        gt.Apply(static_cast<double>(iCol + nXOff) + 0.5,
+                                 static_cast<double>(iLine + nYOff) + 0.5,
+                                 &adfCenterX[iCol], &adfCenterY[iCol]);
+                    }
+                    apadfVariables[nSources] = adfCenterX.data();
+                    apadfVariables[nSources + 1] = adfCenterY.data();
+                }
+
+                double *padfLineResults = padfResults.get();
+                poVectorizedExpression->Evaluate(apadfVariables.data(), nXSize,
+                                                 padfLineResults);
+
+                if (bHasNoData && bPropagateNoData)
+                {
+                    for (int iCol = 0; iCol < nXSize; ++iCol)
+                    {
+                        for (int iSrc = 0; iSrc < nSources; ++iSrc)
+                        {
+                            if (IsNoData(apadfVariables[iSrc][iCol], dfNoData))
+                            {
+                                padfLineResults[iCol] = dfNoData;
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                GDALCopyWords(padfLineResults, GDT_Float64, sizeof(double),
+                              static_cast<GByte *>(pData) +
+                                  static_cast<GSpacing>(nLineSpace) * iLine,
+                              eBufType, nPixelSpace, nXSize);
+            }
+            return CE_None;
+        }
+    }
+#endif
+
+    auto poExpression = gdal::MathExpression::Create(pszExpression, pszDialect);
+
+    // cppcheck-suppress knownConditionTrueFalse
+    if (!poExpression)
+    {
+        return CE_Failure;
+    }
+
     {
         int iSource = 0;
         for (const auto &osName : aosSourceNames)
@@ -2934,11 +3042,6 @@ static CPLErr ExprPixelFunc(void **papoSources, int nSources, void *pData,
         poExpression->RegisterVector("BANDS", &adfValuesForPixel);
     }
 
-    std::unique_ptr<double, VSIFreeReleaser> padfResults(
-        static_cast<double *>(VSI_MALLOC2_VERBOSE(nXSize, sizeof(double))));
-    if (!padfResults)
-        return CE_Failure;
-
     /* ---- Set pixels ---- */
     size_t ii = 0;
     for (int iLine = 0; iLine < nYSize; ++iLine)
@@ -15,7 +15,10 @@
 
 #include "cpl_error_internal.h"
 #include "cpl_minixml.h"
+#include "cpl_multiproc.h"
+#include "cpl_sha256.h"
 #include "cpl_string.h"
+#include "cpl_vsi_virtual.h"
 #include "gdal_frmts.h"
 #include "ogr_spatialref.h"
 #include "gdal_thread_pool.h"
@@ -832,7 +835,7 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
         return OpenVRTProtocol(poOpenInfo->pszFilename);
 
     /* -------------------------------------------------------------------- */
-    /*      Try to read the whole file into memory.                         */
+    /*      Determine the path of the file.                                 */
     /* -------------------------------------------------------------------- */
     char *pszXML = nullptr;
     VSILFILE *fp = poOpenInfo->fpL;
@@ -842,15 +845,6 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     {
         poOpenInfo->fpL = nullptr;
 
-        GByte *pabyOut = nullptr;
-        if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, nullptr,
-                           INT_MAX - 1))
-        {
-            CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
-            return nullptr;
-        }
-        pszXML = reinterpret_cast<char *>(pabyOut);
-
         char *pszCurDir = CPLGetCurrentDir();
         std::string currentVrtFilename =
             CPLProjectRelativeFilenameSafe(pszCurDir, poOpenInfo->pszFilename);
@@ -874,7 +868,6 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
                 else
                 {
                     CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
-                    CPLFree(pszXML);
                     CPLError(CE_Failure, CPLE_FileIO, "Failed to lstat %s: %s",
                              currentVrtFilename.c_str(), VSIStrerror(errno));
                     return nullptr;
@@ -903,7 +896,6 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
             else
             {
                 CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
-                CPLFree(pszXML);
                 CPLError(CE_Failure, CPLE_FileIO,
                          "Failed to read filename from symlink %s: %s",
                          currentVrtFilename.c_str(), VSIStrerror(errno));
@@ -918,6 +910,30 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
         else
             pszVRTPath =
                 CPLStrdup(CPLGetPathSafe(currentVrtFilename.c_str()).c_str());
+    }
+
+    if (CSLFetchNameValue(poOpenInfo->papszOpenOptions, "ROOT_PATH") != nullptr)
+    {
+        CPLFree(pszVRTPath);
+        pszVRTPath = CPLStrdup(
+            CSLFetchNameValue(poOpenInfo->papszOpenOptions, "ROOT_PATH"));
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read the whole file into memory.                                */
+    /* -------------------------------------------------------------------- */
+    const bool bIsFile = fp != nullptr;
+    if (fp != nullptr)
+    {
+        GByte *pabyOut = nullptr;
+        if (!VSIIngestFile(fp, poOpenInfo->pszFilename, &pabyOut, nullptr,
+                           INT_MAX - 1))
+        {
+            CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+            CPLFree(pszVRTPath);
+            return nullptr;
+        }
+        pszXML = reinterpret_cast<char *>(pabyOut);
 
         CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
     }
@@ -929,17 +945,42 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
         pszXML = CPLStrdup(poOpenInfo->pszFilename);
     }
 
-    if (CSLFetchNameValue(poOpenInfo->papszOpenOptions, "ROOT_PATH") != nullptr)
+    /* -------------------------------------------------------------------- */
+    /*      Try to open the dataset from its sources cache, which avoids    */
+    /*      parsing the SimpleSource and ComplexSource elements of bands    */
+    /*      with many sources. The cache is only used if it has been        */
+    /*      created from a file with the same SHA-256 hash.                 */
+    /* -------------------------------------------------------------------- */
+    std::unique_ptr<VRTDataset> poDS;
+    const char *pszSourcesCache = CPLGetConfigOption("VRT_SOURCES_CACHE", "NO");
+    // The cache only holds deferred sources, hence it is not used when
+    // VRT_LAZY_SOURCES=NO.
+    const bool bUseSourcesCache =
+        bIsFile && poOpenInfo->eAccess == GA_ReadOnly &&
+        (EQUAL(pszSourcesCache, "READ_ONLY") || CPLTestBool(pszSourcesCache)) &&
+        CPLTestBool(CPLGetConfigOption("VRT_LAZY_SOURCES", "AUTO"));
+    GByte abyVRTHash[CPL_SHA256_HASH_SIZE] = {};
+    if (bUseSourcesCache)
     {
-        CPLFree(pszVRTPath);
-        pszVRTPath = CPLStrdup(
-            CSLFetchNameValue(poOpenInfo->papszOpenOptions, "ROOT_PATH"));
+        CPL_SHA256(pszXML, strlen(pszXML), abyVRTHash);
+        poDS = OpenFromSourcesCache(poOpenInfo->pszFilename, abyVRTHash,
+                                    pszVRTPath);
     }
 
     /* -------------------------------------------------------------------- */
     /*      Turn the XML representation into a VRTDataset.                  */
     /* -------------------------------------------------------------------- */
-    auto poDS = OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess);
+    if (poDS == nullptr)
+    {
+        poDS = OpenXML(pszXML, pszVRTPath, poOpenInfo->eAccess);
+
+        if (poDS != nullptr && bUseSourcesCache &&
+            !EQUAL(pszSourcesCache, "READ_ONLY"))
+        {
+            poDS->WriteSourcesCache(poOpenInfo->pszFilename, abyVRTHash,
+                                    pszXML);
+        }
+    }
 
     if (poDS != nullptr)
         poDS->m_bNeedsFlush = false;
@@ -948,7 +989,8 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     {
         if (poDS->GetRasterCount() == 0 &&
             (poOpenInfo->nOpenFlags & GDAL_OF_MULTIDIM_RASTER) == 0 &&
-            strstr(pszXML, "VRTPansharpenedDataset") == nullptr)
+            (pszXML == nullptr ||
+             strstr(pszXML, "VRTPansharpenedDataset") == nullptr))
         {
             poDS.reset();
         }
@@ -1030,6 +1072,246 @@ GDALDataset *VRTDataset::Open(GDALOpenInfo *poOpenInfo)
     return poDS.release();
 }
 
+/************************************************************************/
+/*                     GetSourcesCacheFilename()                        */
+/************************************************************************/
+
+static std::string GetSourcesCacheFilename(const char *pszFilename)
+{
+    return std::string(pszFilename).append(".srccache");
+}
+
+// A sources cache file is made of:
+// - a header: signature, version, number of bands, SHA-256 hash of the
+//   content of the VRT file it has been created from, and size of the XML
+//   document;
+// - the XML document of the VRT file, without the SimpleSource and
+//   ComplexSource elements of bands whose sources are all deferred;
+// - for each band, the section written by
+//   VRTSourcedRasterBand::WriteDeferredSources().
+// All numbers are little-endian.
+constexpr char SOURCES_CACHE_SIGNATURE[] = "VRTSourcesCache";
+constexpr uint32_t SOURCES_CACHE_VERSION = 2;
+constexpr size_t SOURCES_CACHE_HEADER_SIZE =
+    sizeof(SOURCES_CACHE_SIGNATURE) + 4 + 4 + CPL_SHA256_HASH_SIZE + 8;
+
+/************************************************************************/
+/*                       OpenFromSourcesCache()                         */
+/************************************************************************/
+
+/** Open the VRT file pszFilename, whose content has the SHA-256 hash
+ * pabyVRTHash, from its sources cache, if it exists and is up to date.
+ */
+std::unique_ptr<VRTDataset>
+VRTDataset::OpenFromSourcesCache(const char *pszFilename,
+                                 const GByte *pabyVRTHash,
+                                 const char *pszVRTPath)
+{
+    const std::string osCacheFilename = GetSourcesCacheFilename(pszFilename);
+    VSIVirtualHandleUniquePtr fp(VSIFOpenL(osCacheFilename.c_str(), "rb"));
+    if (!fp)
+        return nullptr;
+    if (fp->Seek(0, SEEK_END) != 0)
+        return nullptr;
+    const vsi_l_offset nFileSize = fp->Tell();
+    if (fp->Seek(0, SEEK_SET) != 0)
+        return nullptr;
+
+    GByte abyHeader[SOURCES_CACHE_HEADER_SIZE];
+    if (fp->Read(abyHeader, sizeof(abyHeader), 1) != 1 ||
+        memcmp(abyHeader, SOURCES_CACHE_SIGNATURE,
+               sizeof(SOURCES_CACHE_SIGNATURE)) != 0)
+    {
+        CPLDebug("VRT", "%s is not a sources cache", osCacheFilename.c_str());
+        return nullptr;
+    }
+    GByte *pabyIter = abyHeader + sizeof(SOURCES_CACHE_SIGNATURE);
+    uint32_t nVersion = 0;
+    memcpy(&nVersion, pabyIter, 4);
+    CPL_LSBPTR32(&nVersion);
+    uint32_t nBandCount = 0;
+    memcpy(&nBandCount, pabyIter + 4, 4);
+    CPL_LSBPTR32(&nBandCount);
+    uint64_t nXMLSize = 0;
+    memcpy(&nXMLSize, pabyIter + 8 + CPL_SHA256_HASH_SIZE, 8);
+    CPL_LSBPTR64(&nXMLSize);
+    if (nVersion != SOURCES_CACHE_VERSION ||
+        memcmp(pabyIter + 8, pabyVRTHash, CPL_SHA256_HASH_SIZE) != 0)
+    {
+        CPLDebug("VRT", "Sources cache %s is out of date",
+                 osCacheFilename.c_str());
+        return nullptr;
+    }
+    if (nXMLSize > nFileSize - SOURCES_CACHE_HEADER_SIZE ||
+        nXMLSize > static_cast<uint64_t>(INT_MAX - 1))
+    {
+        return nullptr;
+    }
+
+    std::string osXML;
+    osXML.resize(static_cast<size_t>(nXMLSize));
+    if (fp->Read(osXML.data(), 1, osXML.size()) != osXML.size())
+        return nullptr;
+
+    auto poDS = OpenXML(osXML.c_str(), pszVRTPath, GA_ReadOnly);
+    if (!poDS || typeid(*poDS) != typeid(VRTDataset) ||
+        static_cast<uint32_t>(poDS->nBands) != nBandCount)
+    {
+        return nullptr;
+    }
+    for (int iBand = 0; iBand < poDS->nBands; ++iBand)
+    {
+        auto poBand = static_cast<VRTRasterBand *>(poDS->papoBands[iBand]);
+        if (!poBand->IsSourcedRasterBand() ||
+            !static_cast<VRTSourcedRasterBand *>(poBand)->ReadDeferredSources(
+                fp.get(), osCacheFilename.c_str(), nFileSize))
+        {
+            CPLDebug("VRT", "Invalid sources cache %s",
+                     osCacheFilename.c_str());
+            return nullptr;
+        }
+    }
+    if (fp->Tell() != nFileSize)
+        return nullptr;
+
+    CPLDebug("VRT", "Opened %s from its sources cache", pszFilename);
+    return poDS;
+}
+
+/************************************************************************/
+/*                         WriteSourcesCache()                          */
+/************************************************************************/
+
+/** Write the sources cache of the VRT file pszFilename, from which this
+ * dataset has just been opened, and whose content is pszXML, of SHA-256
+ * hash pabyVRTHash.
+ *
+ * Nothing is written if no band has all its sources deferred.
+ */
+bool VRTDataset::WriteSourcesCache(const char *pszFilename,
+                                   const GByte *pabyVRTHash,
+                                   const char *pszXML)
+{
+    if (typeid(*this) != typeid(VRTDataset))
+        return false;
+
+    std::vector<bool> abAllSourcesDeferred;
+    for (int iBand = 0; iBand < nBands; ++iBand)
+    {
+        auto poBand = static_cast<VRTRasterBand *>(papoBands[iBand]);
+        if (!poBand->IsSourcedRasterBand())
+            return false;
+        abAllSourcesDeferred.push_back(
+            static_cast<VRTSourcedRasterBand *>(poBand)->AllSourcesDeferred());
+    }
+    if (std::find(abAllSourcesDeferred.begin(), abAllSourcesDeferred.end(),
+                  true) == abAllSourcesDeferred.end())
+    {
+        return false;
+    }
+
+    // Remove the deferred source elements from the XML document
+    CPLXMLTreeCloser psTree(CPLParseXMLString(pszXML));
+    CPLXMLNode *psRoot =
+        psTree ? CPLGetXMLNode(psTree.get(), "=VRTDataset") : nullptr;
+    if (!psRoot)
+        return false;
+    int iBand = 0;
+    for (CPLXMLNode *psBandNode = psRoot->psChild; psBandNode;
+         psBandNode = psBandNode->psNext)
+    {
+        if (psBandNode->eType != CXT_Element ||
+            !EQUAL(psBandNode->pszValue, "VRTRasterBand"))
+        {
+            continue;
+        }
+        if (iBand >= nBands)
+            return false;
+        if (abAllSourcesDeferred[iBand])
+        {
+            for (CPLXMLNode *psChild = psBandNode->psChild; psChild;)
+            {
+                CPLXMLNode *psNext = psChild->psNext;
+                if (psChild->eType == CXT_Element &&
+                    (EQUAL(psChild->pszValue,
+                           VRTSimpleSource::GetTypeStatic()) ||
+                     EQUAL(psChild->pszValue,
+                           VRTComplexSource::GetTypeStatic())))
+                {
+                    CPLRemoveXMLChild(psBandNode, psChild);
+                    CPLDestroyXMLNode(psChild);
+                }
+                psChild = psNext;
+            }
+        }
+        ++iBand;
+    }
+    if (iBand != nBands)
+        return false;
+    char *pszStrippedXML = CPLSerializeXMLTree(psTree.get());
+    if (!pszStrippedXML)
+        return false;
+    const std::string osStrippedXML(pszStrippedXML);
+    CPLFree(pszStrippedXML);
+
+    // Write into a temporary file that is renamed at the end, so that other
+    // processes and threads never see a partially written file. Its name is
+    // unique to the writing thread (CPLGetPID() returns a thread id).
+    const std::string osCacheFilename = GetSourcesCacheFilename(pszFilename);
+    const std::string osTmpFilename =
+        osCacheFilename +
+        CPLSPrintf(".%d." CPL_FRMT_GIB ".tmp", CPLGetCurrentProcessID(),
+                   CPLGetPID());
+    VSIVirtualHandleUniquePtr fp;
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        fp.reset(VSIFOpenL(osTmpFilename.c_str(), "wb"));
+    }
+    if (!fp)
+    {
+        CPLDebug("VRT", "Cannot create %s", osTmpFilename.c_str());
+        return false;
+    }
+
+    GByte abyHeader[SOURCES_CACHE_HEADER_SIZE];
+    memcpy(abyHeader, SOURCES_CACHE_SIGNATURE,
+           sizeof(SOURCES_CACHE_SIGNATURE));
+    GByte *pabyIter = abyHeader + sizeof(SOURCES_CACHE_SIGNATURE);
+    uint32_t nVersion = SOURCES_CACHE_VERSION;
+    CPL_LSBPTR32(&nVersion);
+    memcpy(pabyIter, &nVersion, 4);
+    uint32_t nBandCount = static_cast<uint32_t>(nBands);
+    CPL_LSBPTR32(&nBandCount);
+    memcpy(pabyIter + 4, &nBandCount, 4);
+    memcpy(pabyIter + 8, pabyVRTHash, CPL_SHA256_HASH_SIZE);
+    uint64_t nXMLSize = osStrippedXML.size();
+    CPL_LSBPTR64(&nXMLSize);
+    memcpy(pabyIter + 8 + CPL_SHA256_HASH_SIZE, &nXMLSize, 8);
+
+    bool bOK = fp->Write(abyHeader, sizeof(abyHeader), 1) == 1 &&
+               fp->Write(osStrippedXML.data(), 1, osStrippedXML.size()) ==
+                   osStrippedXML.size();
+    for (iBand = 0; bOK && iBand < nBands; ++iBand)
+    {
+        bOK = static_cast<VRTSourcedRasterBand *>(papoBands[iBand])
+                  ->WriteDeferredSources(fp.get());
+    }
+    bOK = fp->Close() == 0 && bOK;
+    fp.reset();
+    bOK = bOK && VSIRename(osTmpFilename.c_str(), osCacheFilename.c_str()) == 0;
+    if (bOK)
+    {
+        CPLDebug("VRT", "Sources cache %s written", osCacheFilename.c_str());
+    }
+    else
+    {
+        CPLDebug("VRT", "Cannot write sources cache %s",
+                 osCacheFilename.c_str());
+        VSIUnlink(osTmpFilename.c_str());
+    }
+    return bOK;
+}
+
 /************************************************************************/
 /*                         OpenVRTProtocol()                            */
 /*                                                                      */
@@ -2152,6 +2434,15 @@ int VRTDataset::CloseDependentDatasets()
                               ->CloseDependentDatasets();
     }
 
+    {
+        std::lock_guard oLock(m_oThreadedClones.oMutex);
+        if (!m_oThreadedClones.apoClones.empty())
+        {
+            m_oThreadedClones.apoClones.clear();
+            bHasDroppedRef = TRUE;
+        }
+    }
+
     return bHasDroppedRef;
 }
 
@@ -2192,12 +2483,25 @@ bool VRTDataset::CheckCompatibleForDatasetIO() const
         if (typeid(*poBand) != typeid(VRTSourcedRasterBand))
             return false;
 
+        // Sources whose instantiation has been deferred have been checked to
+        // be simple sources with a non-empty filename. Comparing sources of
+        // several bands requires them to be instantiated though.
+        if (poBand->HasDeferredSources() &&
+            (!poBand->DeferredSourcesAreSimpleSourcesOfBand(iBand + 1) ||
+             (nBands > 1 && !const_cast<VRTSourcedRasterBand *>(poBand)
+                                 ->LoadDeferredSources())))
+        {
+            return false;
+        }
+
         if (iBand == 0)
         {
             nSources = poBand->m_papoSources.size();
             papoSources = poBand->m_papoSources.data();
             for (auto &poSource : poBand->m_papoSources)
             {
+                if (!poSource)
+                    continue;
                 if (!poSource->IsSimpleSource())
                     return false;
 
@@ -2287,7 +2591,7 @@ GDALDataset *VRTDataset::GetSingleSimpleSource()
 
     VRTSourcedRasterBand *poVRTBand =
         static_cast<VRTSourcedRasterBand *>(papoBands[0]);
-    if (poVRTBand->m_papoSources.size() != 1)
+    if (poVRTBand->m_papoSources.size() != 1 || !poVRTBand->GetSource(0))
         return nullptr;
 
     VRTSimpleSource *poSource =
@@ -2350,7 +2654,7 @@ CPLErr VRTDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
 
     VRTSourcedRasterBand *poVRTBand =
         static_cast<VRTSourcedRasterBand *>(papoBands[0]);
-    if (poVRTBand->m_papoSources.size() != 1)
+    if (poVRTBand->m_papoSources.size() != 1 || !poVRTBand->GetSource(0))
         return CE_None;
 
     VRTSimpleSource *poSource =
@@ -2415,6 +2719,261 @@ CPLErr VRTDataset::AdviseRead(int nXOff, int nYOff, int nXSize, int nYSize,
     return std::min(atoi(pszNumThreads), nLimit);
 }
 
+/************************************************************************/
+/*                        GetVRTPathForClones()                         */
+/************************************************************************/
+
+const char *VRTDataset::GetVRTPathForClones() const
+{
+    return m_pszVRTPath ? m_pszVRTPath : "";
+}
+
+/************************************************************************/
+/*                        AcquireThreadedClone()                        */
+/************************************************************************/
+
+/** Return a clone of this dataset, opened from m_oThreadedClones.osXML,
+ * to be used by a single thread, and given back with ReleaseThreadedClone().
+ */
+std::unique_ptr<VRTDataset> VRTDataset::AcquireThreadedClone()
+{
+    std::string osXML;
+    {
+        std::lock_guard oLock(m_oThreadedClones.oMutex);
+        if (!m_oThreadedClones.apoClones.empty())
+        {
+            auto poClone = std::move(m_oThreadedClones.apoClones.back());
+            m_oThreadedClones.apoClones.pop_back();
+            return poClone;
+        }
+        osXML = m_oThreadedClones.osXML;
+    }
+
+    auto poClone = OpenXML(osXML.c_str(), GetVRTPathForClones());
+    if (poClone)
+        poClone->m_bThreadedChunkedRasterIOAllowed = false;
+    return poClone;
+}
+
+/************************************************************************/
+/*                        ReleaseThreadedClone()                        */
+/************************************************************************/
+
+void VRTDataset::ReleaseThreadedClone(std::unique_ptr<VRTDataset> poClone)
+{
+    std::lock_guard oLock(m_oThreadedClones.oMutex);
+    m_oThreadedClones.apoClones.push_back(std::move(poClone));
+}
+
+/************************************************************************/
+/*                        VRTThreadedChunkJob                           */
+/************************************************************************/
+
+/** Structure used to declare a threaded job of ThreadedChunkedRasterIO()
+ * on a range of lines.
+ */
+struct VRTThreadedChunkJob
+{
+    std::atomic<int> *pnCompletedLines = nullptr;
+    std::atomic<bool> *pbSuccess = nullptr;
+    CPLErrorAccumulator *poErrorAccumulator = nullptr;
+
+    VRTDataset *poDS = nullptr;
+    const std::function<CPLErr(VRTDataset *, int, int,
+                               GDALRasterIOExtraArg *)> *pfnProcessChunk =
+        nullptr;
+    int nChunkYOff = 0;
+    int nChunkYSize = 0;
+    GDALRasterIOExtraArg *psExtraArg = nullptr;
+
+    static void Func(void *pData);
+};
+
+/************************************************************************/
+/*                      VRTThreadedChunkJob::Func()                     */
+/************************************************************************/
+
+void VRTThreadedChunkJob::Func(void *pData)
+{
+    auto psJob = std::unique_ptr<VRTThreadedChunkJob>(
+        static_cast<VRTThreadedChunkJob *>(pData));
+    if (*psJob->pbSuccess)
+    {
+        GDALRasterIOExtraArg sArg = *(psJob->psExtraArg);
+        sArg.pfnProgress = nullptr;
+        sArg.pProgressData = nullptr;
+        sArg.bFloatingPointWindowValidity = FALSE;
+
+        auto oAccumulator = psJob->poErrorAccumulator->InstallForCurrentScope();
+        CPL_IGNORE_RET_VAL(oAccumulator);
+
+        auto poClone = psJob->poDS->AcquireThreadedClone();
+        if (!poClone ||
+            (*psJob->pfnProcessChunk)(poClone.get(), psJob->nChunkYOff,
+                                      psJob->nChunkYSize, &sArg) != CE_None)
+        {
+            *psJob->pbSuccess = false;
+        }
+        if (poClone)
+            psJob->poDS->ReleaseThreadedClone(std::move(poClone));
+    }
+
+    *psJob->pnCompletedLines += psJob->nChunkYSize;
+}
+
+/************************************************************************/
+/*                      ThreadedChunkedRasterIO()                       */
+/************************************************************************/
+
+/** Evaluate a large request at full resolution by chunks of lines processed
+ * concurrently on the global thread pool.
+ *
+ * Each chunk is passed to fnProcessChunk() with a clone of this dataset,
+ * re-opened from its XML serialization, so that neither source datasets nor
+ * the state of pixel functions or processing steps are shared between
+ * threads. Clones are kept for next requests as long as the serialization
+ * of the dataset does not change, which is only checked again after
+ * SetNeedsFlush() has been called.
+ *
+ * @param bHandled Set to false if the request is not eligible, in which case
+ * the caller must process it itself, and CE_None is returned.
+ */
+CPLErr VRTDataset::ThreadedChunkedRasterIO(
+    int nXOff, int nYOff, int nXSize, int nYSize,
+    GDALRasterIOExtraArg *psExtraArg,
+    const std::function<CPLErr(VRTDataset *poClone, int nChunkYOff,
+                               int nChunkYSize,
+                               GDALRasterIOExtraArg *psChunkExtraArg)>
+        &fnProcessChunk,
+    bool &bHandled)
+{
+    bHandled = false;
+    constexpr int MINIMUM_PIXEL_COUNT_FOR_THREADED_IO = 1000 * 1000;
+    constexpr int MINIMUM_LINES_PER_CHUNK = 16;
+    if (!m_bThreadedChunkedRasterIOAllowed ||
+        static_cast<int64_t>(nXSize) * nYSize <
+            MINIMUM_PIXEL_COUNT_FOR_THREADED_IO ||
+        nYSize < 2 * MINIMUM_LINES_PER_CHUNK)
+    {
+        return CE_None;
+    }
+    if (psExtraArg->bFloatingPointWindowValidity &&
+        (psExtraArg->dfXOff != nXOff || psExtraArg->dfYOff != nYOff ||
+         psExtraArg->dfXSize != nXSize || psExtraArg->dfYSize != nYSize))
+    {
+        return CE_None;
+    }
+    const int nMaxThreads = GetNumThreads(this);
+    if (nMaxThreads <= 1)
+        return CE_None;
+
+    // Waiting for chunks queued in the global thread pool from one of its
+    // worker threads could deadlock.
+    CPLWorkerThreadPool *psThreadPool = GDALGetGlobalThreadPool(nMaxThreads);
+    if (!psThreadPool || psThreadPool->IsCurrentThreadWorker())
+        return CE_None;
+
+    // Refresh the clones if the dataset has been modified since they were
+    // opened.
+    if (!m_bThreadedClonesXMLUpToDate)
+    {
+        std::string osXML;
+        {
+            CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+            CPLXMLTreeCloser oTree(SerializeToXML(GetVRTPathForClones()));
+            if (oTree)
+            {
+                char *pszXML = CPLSerializeXMLTree(oTree.get());
+                if (pszXML)
+                    osXML = pszXML;
+                CPLFree(pszXML);
+            }
+        }
+        if (osXML.empty())
+        {
+            m_bThreadedChunkedRasterIOAllowed = false;
+            return CE_None;
+        }
+        {
+            std::lock_guard oLock(m_oThreadedClones.oMutex);
+            if (osXML != m_oThreadedClones.osXML)
+            {
+                m_oThreadedClones.apoClones.clear();
+                m_oThreadedClones.osXML = std::move(osXML);
+            }
+        }
+        m_bThreadedClonesXMLUpToDate = true;
+    }
+
+    // Check from the calling thread that the dataset can be re-opened
+    {
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        auto poClone = AcquireThreadedClone();
+        if (!poClone)
+        {
+            m_bThreadedChunkedRasterIOAllowed = false;
+            return CE_None;
+        }
+        ReleaseThreadedClone(std::move(poClone));
+    }
+
+    bHandled = true;
+
+    const int nThreads = std::min(nMaxThreads, psThreadPool->GetThreadCount());
+    // Use a few chunks per thread to balance the load
+    const int nChunks =
+        std::min(nThreads * 4, nYSize / MINIMUM_LINES_PER_CHUNK);
+    const int nChunkYSize = DIV_ROUND_UP(nYSize, nChunks);
+    CPLDebugOnly("VRT",
+                 "ThreadedChunkedRasterIO(): using %d threads for %d chunks",
+                 nThreads, DIV_ROUND_UP(nYSize, nChunkYSize));
+
+    CPLErrorAccumulator errorAccumulator;
+    std::atomic<bool> bSuccess = true;
+    std::atomic<int> nCompletedLines = 0;
+    auto oQueue = psThreadPool->CreateJobQueue();
+    for (int iY = 0; iY < nYSize; iY += nChunkYSize)
+    {
+        auto psJob = new VRTThreadedChunkJob();
+        psJob->pnCompletedLines = &nCompletedLines;
+        psJob->pbSuccess = &bSuccess;
+        psJob->poErrorAccumulator = &errorAccumulator;
+        psJob->poDS = this;
+        psJob->pfnProcessChunk = &fnProcessChunk;
+        psJob->nChunkYOff = nYOff + iY;
+        psJob->nChunkYSize = std::min(nChunkYSize, nYSize - iY);
+        psJob->psExtraArg = psExtraArg;
+
+        if (!oQueue->SubmitJob(VRTThreadedChunkJob::Func, psJob))
+        {
+            delete psJob;
+            bSuccess = false;
+            break;
+        }
+    }
+
+    bool bInterrupted = false;
+    while (oQueue->WaitEvent())
+    {
+        if (psExtraArg->pfnProgress && !bInterrupted &&
+            !psExtraArg->pfnProgress(double(nCompletedLines.load()) / nYSize,
+                                     "", psExtraArg->pProgressData))
+        {
+            // Pending jobs will return immediately
+            bInterrupted = true;
+            bSuccess = false;
+        }
+    }
+
+    errorAccumulator.ReplayErrors();
+    if (bInterrupted)
+        CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+    else if (bSuccess && psExtraArg->pfnProgress)
+        psExtraArg->pfnProgress(1.0, "", psExtraArg->pProgressData);
+
+    return bSuccess ? CE_None : CE_Failure;
+}
+
 /************************************************************************/
 /*                       VRTDatasetRasterIOJob                          */
 /************************************************************************/
@@ -2635,9 +3194,13 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 
             auto oQueue = psThreadPool->CreateJobQueue();
             std::atomic<int> nCompletedJobs = 0;
-            for (auto &poSource : poBand->m_papoSources)
+            for (const int iSource : poBand->GetSourcesIntersecting(
+                     dfXOff, dfYOff, dfXSize, dfYSize))
             {
-                if (!poSource->IsSimpleSource())
+                // Deferred sources have been instantiated by
+                // CanMultiThreadRasterIO()
+                const auto &poSource = poBand->m_papoSources[iSource];
+                if (!poSource || !poSource->IsSimpleSource())
                     continue;
                 auto poSimpleSource =
                     cpl::down_cast<VRTSimpleSource *>(poSource.get());
@@ -2694,23 +3257,31 @@ CPLErr VRTDataset::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
             GDALProgressFunc pfnProgressGlobal = psExtraArg->pfnProgress;
             void *pProgressDataGlobal = psExtraArg->pProgressData;
 
-            const int nSources = static_cast<int>(poBand->m_papoSources.size());
-            for (int iSource = 0; eErr == CE_None && iSource < nSources;
-                 iSource++)
+            const auto anSources = poBand->GetSourcesIntersecting(
+                dfXOff, dfYOff, dfXSize, dfYSize);
+            const int nSources = anSources.size();
+            for (int i = 0; eErr == CE_None && i < nSources; i++)
             {
                 psExtraArg->pfnProgress = GDALScaledProgress;
                 psExtraArg->pProgressData = GDALCreateScaledProgress(
-                    1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+                    1.0 * i / nSources, 1.0 * (i + 1) / nSources,
                     pfnProgressGlobal, pProgressDataGlobal);
 
                 VRTSimpleSource *poSource = static_cast<VRTSimpleSource *>(
-                    poBand->m_papoSources[iSource].get());
+                    poBand->GetSource(anSources[i]));
 
-                eErr = poSource->DatasetRasterIO(
-                    poBand->GetRasterDataType(), nXOff, nYOff, nXSize, nYSize,
-                    pData, nBufXSize, nBufYSize, eBufType, nBandCount,
-                    panBandMap, nPixelSpace, nLineSpace, nBandSpace,
-                    psExtraArg);
+                if (poSource)
+                {
+                    eErr = poSource->DatasetRasterIO(
+                        poBand->GetRasterDataType(), nXOff, nYOff, nXSize,
+                        nYSize, pData, nBufXSize, nBufYSize, eBufType,
+                        nBandCount, panBandMap, nPixelSpace, nLineSpace,
+                        nBandSpace, psExtraArg);
+                }
+                else
+                {
+                    eErr = CE_Failure;
+                }
 
                 GDALDestroyScaledProgress(psExtraArg->pProgressData);
             }
@@ -2764,9 +3335,10 @@ void VRTDataset::UnsetPreservedRelativeFilenames()
 
         VRTSourcedRasterBand *poBand =
             static_cast<VRTSourcedRasterBand *>(papoBands[iBand]);
+        poBand->LoadDeferredSources();
         for (auto &poSource : poBand->m_papoSources)
         {
-            if (!poSource->IsSimpleSource())
+            if (!poSource || !poSource->IsSimpleSource())
                 continue;
 
             VRTSimpleSource *poSimpleSource =
@@ -2790,7 +3362,7 @@ static bool CheckBandForOverview(GDALRasterBand *poBand,
 
     VRTSourcedRasterBand *poVRTBand =
         cpl::down_cast<VRTSourcedRasterBand *>(poBand);
-    if (poVRTBand->m_papoSources.size() != 1)
+    if (poVRTBand->m_papoSources.size() != 1 || !poVRTBand->GetSource(0))
         return false;
     if (!poVRTBand->m_papoSources[0]->IsSimpleSource())
         return false;
@@ -3133,7 +3705,7 @@ bool VRTDataset::GetShiftedDataset(int nXOff, int nYOff, int nXSize, int nYSize,
 
     VRTSourcedRasterBand *poVRTBand =
         static_cast<VRTSourcedRasterBand *>(papoBands[0]);
-    if (poVRTBand->m_papoSources.size() != 1)
+    if (poVRTBand->m_papoSources.size() != 1 || !poVRTBand->GetSource(0))
         return false;
 
     VRTSimpleSource *poSource =
@@ -18,6 +18,7 @@
 
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -256,6 +257,7 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     friend class VRTSourcedRasterBand;
     friend class VRTSimpleSource;
     friend struct VRTSourcedRasterBandRasterIOJob;
+    friend struct VRTThreadedChunkJob;
     friend VRTDatasetH CPL_STDCALL VRTCreate(int nXSize, int nYSize);
 
     std::vector<gdal::GCP> m_asGCPs{};
@@ -300,9 +302,32 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
 
     bool m_bMultiThreadedRasterIOLastUsed = false;
 
+    // Used by ThreadedChunkedRasterIO(): clones of this dataset, opened
+    // from its XML serialization osXML, that are handed to worker threads
+    struct ThreadedClones
+    {
+        std::mutex oMutex{};
+        std::string osXML{};
+        std::vector<std::unique_ptr<VRTDataset>> apoClones{};
+    };
+
+    ThreadedClones m_oThreadedClones{};
+
+    // Whether m_oThreadedClones.osXML is the serialization of the current
+    // state of the dataset. Reset by SetNeedsFlush().
+    bool m_bThreadedClonesXMLUpToDate = false;
+
+    std::unique_ptr<VRTDataset> AcquireThreadedClone();
+    void ReleaseThreadedClone(std::unique_ptr<VRTDataset> poClone);
+
     std::unique_ptr<VRTRasterBand> InitBand(const char *pszSubclass, int nBand,
                                             bool bAllowPansharpenedOrProcessed);
     static GDALDataset *OpenVRTProtocol(const char *pszSpec);
+    static std::unique_ptr<VRTDataset>
+    OpenFromSourcesCache(const char *pszFilename, const GByte *pabyVRTHash,
+                         const char *pszVRTPath);
+    bool WriteSourcesCache(const char *pszFilename, const GByte *pabyVRTHash,
+                           const char *pszXML);
     bool AddVirtualOverview(int nOvFactor, const char *pszResampling);
 
     bool GetShiftedDataset(int nXOff, int nYOff, int nXSize, int nYSize,
@@ -323,8 +348,14 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     int m_bGeoTransformSet = false;
     GDALGeoTransform m_gt{};
 
+    // Whether ThreadedChunkedRasterIO() may be used. Unset on clones, and on
+    // datasets that cannot be re-opened from their serialization.
+    bool m_bThreadedChunkedRasterIOAllowed = true;
+
     virtual int CloseDependentDatasets() override;
 
+    virtual const char *GetVRTPathForClones() const;
+
   public:
     VRTDataset(int nXSize, int nYSize, int nBlockXSize = 0,
                int nBlockYSize = 0);
@@ -333,6 +364,7 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
     void SetNeedsFlush()
     {
         m_bNeedsFlush = true;
+        m_bThreadedClonesXMLUpToDate = false;
     }
 
     virtual CPLErr FlushCache(bool bAtClosing) override;
@@ -460,6 +492,15 @@ class CPL_DLL VRTDataset CPL_NON_FINAL : public GDALDataset
 
     static int GetNumThreads(GDALDataset *poDS);
 
+    CPLErr ThreadedChunkedRasterIO(
+        int nXOff, int nYOff, int nXSize, int nYSize,
+        GDALRasterIOExtraArg *psExtraArg,
+        const std::function<CPLErr(VRTDataset *poClone, int nChunkYOff,
+                                   int nChunkYSize,
+                                   GDALRasterIOExtraArg *psChunkExtraArg)>
+            &fnProcessChunk,
+        bool &bHandled);
+
     static bool IsRawRasterBandEnabled();
 };
 
@@ -669,6 +710,8 @@ class VRTProcessedDataset final : public VRTDataset
                              GSpacing nBandSpace,
                              GDALRasterIOExtraArg *psExtraArg) override;
 
+    const char *GetVRTPathForClones() const override;
+
   private:
     friend class VRTProcessedRasterBand;
 
@@ -931,7 +974,9 @@ class CPL_DLL VRTRasterBand CPL_NON_FINAL : public GDALRasterBand
 /*                         VRTSourcedRasterBand                         */
 /************************************************************************/
 
+class VRTDriver;
 class VRTSimpleSource;
+struct VRTDeferredSources;
 
 class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
 {
@@ -940,6 +985,28 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
     CPLStringList m_aosSourceList{};
     int m_nSkipBufferInitialization = -1;
 
+    // Spatial index of the destination window of the simple sources, built
+    // on demand by GetSourcesIntersecting() for large mosaics.
+    mutable std::unique_ptr<CPLQuadTree, decltype(&CPLQuadTreeDestroy)>
+        m_poSourcesIndex{nullptr, CPLQuadTreeDestroy};
+    // Indices of sources that are not in m_poSourcesIndex (non-simple sources,
+    // or sources without a valid destination window).
+    mutable std::vector<int> m_anSourcesNotIndexed{};
+    // State of m_papoSources when m_poSourcesIndex was built, to detect
+    // sources being added or removed.
+    mutable size_t m_nSourcesIndexed = 0;
+    mutable const std::unique_ptr<VRTSource> *m_papoSourcesIndexed = nullptr;
+
+    void BuildSourcesIndex() const;
+
+    // Description of the sources whose instantiation is deferred until they
+    // are needed. Such sources are nullptr in m_papoSources.
+    std::unique_ptr<VRTDeferredSources> m_poDeferredSources{};
+
+    bool DeferSource(const CPLXMLNode *psSrc);
+    bool LoadDeferredSource(VRTDriver *poDriver, int iSource);
+    void AdjustSourceMaxValue(VRTSource *poSource);
+
     bool CanUseSourcesMinMaxImplementations();
 
     bool IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
@@ -1004,6 +1071,89 @@ class CPL_DLL VRTSourcedRasterBand CPL_NON_FINAL : public VRTRasterBand
 
     CPLErr AddSource(VRTSource *);
 
+    // Indices of sources, in increasing order, returned by
+    // GetSourcesIntersecting(): either all the sources, which does not
+    // allocate anything, or a subset of them.
+    class SourceIndices
+    {
+        std::vector<int> m_anIndices{};
+        int m_nAllSourcesCount = -1;
+
+      public:
+        explicit SourceIndices(int nAllSourcesCount)
+            : m_nAllSourcesCount(nAllSourcesCount)
+        {
+        }
+
+        explicit SourceIndices(std::vector<int> &&anIndices)
+            : m_anIndices(std::move(anIndices))
+        {
+        }
+
+        int size() const
+        {
+            return m_nAllSourcesCount >= 0
+                       ? m_nAllSourcesCount
+                       : static_cast<int>(m_anIndices.size());
+        }
+
+        int operator[](int i) const
+        {
+            return m_nAllSourcesCount >= 0 ? i : m_anIndices[i];
+        }
+
+        class const_iterator
+        {
+            const SourceIndices *m_poIndices;
+            int m_i;
+
+          public:
+            const_iterator(const SourceIndices *poIndices, int i)
+                : m_poIndices(poIndices), m_i(i)
+            {
+            }
+
+            int operator*() const
+            {
+                return (*m_poIndices)[m_i];
+            }
+
+            const_iterator &operator++()
+            {
+                ++m_i;
+                return *this;
+            }
+
+            bool operator!=(const const_iterator &other) const
+            {
+                return m_i != other.m_i;
+            }
+        };
+
+        const_iterator begin() const
+        {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(this, size());
+        }
+    };
+
+    SourceIndices GetSourcesIntersecting(double dfXOff, double dfYOff,
+                                         double dfXSize, double dfYSize) const;
+    void InvalidateSourcesIndex();
+
+    VRTSource *GetSource(int iSource);
+    bool LoadDeferredSources();
+    bool HasDeferredSources() const;
+    bool DeferredSourcesAreSimpleSourcesOfBand(int nSrcBand) const;
+    bool AllSourcesDeferred() const;
+    bool WriteDeferredSources(VSILFILE *fp) const;
+    bool ReadDeferredSources(VSILFILE *fp, const char *pszCacheFilename,
+                             vsi_l_offset nCacheFileSize);
+
     CPLErr AddSimpleSource(const char *pszFilename, int nBand,
                            double dfSrcXOff = -1, double dfSrcYOff = -1,
                            double dfSrcXSize = -1, double dfSrcYSize = -1,
@@ -1191,6 +1341,7 @@ class CPL_DLL VRTDerivedRasterBand CPL_NON_FINAL : public VRTSourcedRasterBand
 {
     VRTDerivedRasterBandPrivateData *m_poPrivate;
     bool InitializePython();
+    bool SourcesCanBeReopened();
     CPLErr GetPixelFunctionArguments(
         const CPLString &, const std::vector<int> &anMapBufferIdxToSourceIdx,
         int nXOff, int nYOff, std::vector<std::pair<CPLString, CPLString>> &);
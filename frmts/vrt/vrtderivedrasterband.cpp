@@ -16,6 +16,7 @@
 #include "cpl_string.h"
 #include "vrtdataset.h"
 #include "cpl_multiproc.h"
+#include "gdal_proxy.h"
 #include "gdalpython.h"
 
 #include <algorithm>
@@ -421,6 +422,7 @@ std::vector<std::string> VRTDerivedRasterBand::GetPixelFunctionNames()
 void VRTDerivedRasterBand::SetPixelFunctionName(const char *pszFuncNameIn)
 {
     osFuncName = (pszFuncNameIn == nullptr) ? "" : pszFuncNameIn;
+    cpl::down_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 }
 
 /************************************************************************/
@@ -438,6 +440,7 @@ void VRTDerivedRasterBand::AddPixelFunctionArgument(const char *pszArg,
                                                     const char *pszValue)
 {
     m_poPrivate->m_oFunctionArgs.emplace_back(pszArg, pszValue);
+    cpl::down_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 }
 
 /************************************************************************/
@@ -454,6 +457,7 @@ void VRTDerivedRasterBand::AddPixelFunctionArgument(const char *pszArg,
 void VRTDerivedRasterBand::SetPixelFunctionLanguage(const char *pszLanguage)
 {
     m_poPrivate->m_osLanguage = pszLanguage;
+    cpl::down_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 }
 
 /************************************************************************/
@@ -474,6 +478,7 @@ void VRTDerivedRasterBand::SetSkipNonContributingSources(bool bSkip)
 {
     m_poPrivate->m_bSkipNonContributingSources = bSkip;
     m_poPrivate->m_bSkipNonContributingSourcesSpecified = true;
+    cpl::down_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 }
 
 /************************************************************************/
@@ -494,6 +499,7 @@ void VRTDerivedRasterBand::SetSkipNonContributingSources(bool bSkip)
 void VRTDerivedRasterBand::SetSourceTransferType(GDALDataType eDataTypeIn)
 {
     eSourceTransferType = eDataTypeIn;
+    cpl::down_cast<VRTDataset *>(poDS)->SetNeedsFlush();
 }
 
 /************************************************************************/
@@ -966,6 +972,43 @@ CPLErr VRTDerivedRasterBand::GetPixelFunctionArguments(
     return CE_None;
 }
 
+/************************************************************************/
+/*                        SourcesCanBeReopened()                        */
+/************************************************************************/
+
+/** Return whether the sources of this band can be re-opened from the XML
+ * serialization of the dataset, as done by
+ * VRTDataset::ThreadedChunkedRasterIO().
+ */
+bool VRTDerivedRasterBand::SourcesCanBeReopened()
+{
+    for (const auto &poSource : m_papoSources)
+    {
+        if (!poSource->IsSimpleSource())
+            return false;
+        const auto poSS = cpl::down_cast<VRTSimpleSource *>(poSource.get());
+        if (poSS->m_bSrcDSNameFromVRT)
+            continue;
+        const auto l_poBand = poSS->GetRasterBand();
+        const auto poSrcDS = l_poBand ? l_poBand->GetDataset() : nullptr;
+        if (!poSrcDS)
+            return false;
+        // Sources opened from the VRT XML are proxy datasets. Sources added
+        // through the API must at least be opened from an existing file.
+        VSIStatBufL sStat;
+        if (!dynamic_cast<GDALProxyPoolDataset *>(poSrcDS) &&
+            (poSS->m_osSrcDSName.empty() ||
+             (poSrcDS->GetDriver() &&
+              EQUAL(poSrcDS->GetDriver()->GetDescription(), "MEM")) ||
+             VSIStatExL(poSS->m_osSrcDSName.c_str(), &sStat,
+                        VSI_STAT_EXISTS_FLAG) != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -1119,6 +1162,33 @@ CPLErr VRTDerivedRasterBand::IRasterIO(
             return CE_None;
     }
 
+    /* -------------------------------------------------------------------- */
+    /*      Evaluate large requests by chunks of lines in several threads.  */
+    /* -------------------------------------------------------------------- */
+    auto l_poDS = dynamic_cast<VRTDataset *>(poDS);
+    if (l_poDS && !m_bIsMaskBand && l_poDS->GetRasterBand(nBand) == this &&
+        nBufXSize == nXSize && nBufYSize == nYSize &&
+        EQUAL(m_poPrivate->m_osLanguage, "C") && SourcesCanBeReopened())
+    {
+        const int nBandNum = nBand;
+        bool bHandled = false;
+        const CPLErr eErr = l_poDS->ThreadedChunkedRasterIO(
+            nXOff, nYOff, nXSize, nYSize, psExtraArg,
+            [=](VRTDataset *poClone, int nChunkYOff, int nChunkYSize,
+                GDALRasterIOExtraArg *psChunkExtraArg)
+            {
+                return poClone->GetRasterBand(nBandNum)->RasterIO(
+                    GF_Read, nXOff, nChunkYOff, nXSize, nChunkYSize,
+                    static_cast<GByte *>(pData) +
+                        (nChunkYOff - nYOff) * nLineSpace,
+                    nBufXSize, nChunkYSize, eBufType, nPixelSpace, nLineSpace,
+                    psChunkExtraArg);
+            },
+            bHandled);
+        if (bHandled)
+            return eErr;
+    }
+
     /* ---- Get pixel function for band ---- */
     const std::pair<PixelFunc, std::string> *poPixelFunc = nullptr;
     std::vector<std::pair<CPLString, CPLString>> oAdditionalArgs;
@@ -14,6 +14,9 @@
 
 #include "cpl_error.h"
 
+#include <cstddef>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -201,6 +204,58 @@ MathExpression::Create([[maybe_unused]] const char *pszExpression,
 
 bool MuParserHasDefineFunUserData();
 
+/**
+ * Array-at-a-time evaluation of expressions of the muparser dialect.
+ *
+ * Only the pure part of the dialect is handled: numbers, constants,
+ * variables, arithmetic, comparison, logical and conditional operators, and
+ * the built-in functions whose result only depends on their arguments. The
+ * expression is compiled to a sequence of operations on arrays of values,
+ * after folding constant sub-expressions and merging common ones, which are
+ * then applied to batches of values in loops that compilers vectorize.
+ */
+class VectorizedExpression
+{
+  public:
+    ~VectorizedExpression();
+
+    /**
+     * Compile an expression.
+     *
+     * @param osExpression The body of the expression, e.g. "(B1 - B2) / 2"
+     * @param aosVariables The names of the variables of the expression.
+     * @param nBandCount Number of the first variables making the BANDS
+     *                   vector, or 0 if it is not available.
+     * @param pdfNoData Pointer to the value of the NODATA variable, used by
+     *                  the isnodata() function, or nullptr if there is none.
+     * @return the compiled expression, or nullptr if it uses a construct
+     *         that is not handled, in which case no error is emitted and
+     *         MuParserExpression must be used instead.
+     */
+    static std::unique_ptr<VectorizedExpression>
+    Compile(std::string_view osExpression,
+            const std::vector<std::string> &aosVariables, size_t nBandCount,
+            const double *pdfNoData);
+
+    /**
+     * Evaluate the expression for nCount sets of values of the variables.
+     *
+     * @param papadfVariables Array with, for each variable given to Compile(),
+     *                        a pointer to nCount values.
+     * @param nCount Number of values.
+     * @param padfResults Array of nCount values receiving the results.
+     */
+    void Evaluate(const double *const *papadfVariables, size_t nCount,
+                  double *padfResults);
+
+  private:
+    class Impl;
+
+    std::unique_ptr<Impl> m_pImpl;
+
+    explicit VectorizedExpression(std::unique_ptr<Impl> pImpl);
+};
+
 /*! @endcond */
 
 }  // namespace gdal
@@ -0,0 +1,1182 @@
+/******************************************************************************
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Implementation of VectorizedExpression
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "vrtexpression.h"
+#include "cpl_conv.h"
+#include "cpl_port.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <tuple>
+
+namespace gdal
+{
+
+/*! @cond Doxygen_Suppress */
+
+namespace
+{
+
+// Number of values processed by each operation at a time. It is fixed so
+// that the loops of the kernels have a constant trip count, which lets
+// compilers vectorize them without runtime checks nor scalar epilogue.
+constexpr size_t BATCH_SIZE = 256;
+
+// Maximum nesting of sub-expressions, to bound the recursion of the parser.
+constexpr int MAX_DEPTH = 256;
+
+enum class Op
+{
+    CONST,
+    VAR,
+    // Unary operations
+    NEG,
+    ABS,
+    SQRT,
+    EXP,
+    LN,
+    LOG10,
+    SIN,
+    COS,
+    TAN,
+    ASIN,
+    ACOS,
+    ATAN,
+    SINH,
+    COSH,
+    TANH,
+    ASINH,
+    ACOSH,
+    ATANH,
+    ISNAN,
+    // Binary operations
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    POW,
+    LT,
+    LE,
+    GT,
+    GE,
+    EQ,
+    NE,
+    AND,
+    OR,
+    MIN,
+    MAX,
+    // Ternary operation
+    SELECT
+};
+
+constexpr int GetArity(Op eOp)
+{
+    return eOp < Op::NEG   ? 0
+           : eOp < Op::ADD ? 1
+           : eOp < Op::SELECT ? 2
+                              : 3;
+}
+
+/************************************************************************/
+/*                               Apply()                                */
+/************************************************************************/
+
+// Scalar semantics of the operations, which are those of the muparser
+// built-in operators and functions.
+template <Op eOp>
+inline double Apply([[maybe_unused]] double a, [[maybe_unused]] double b,
+                    [[maybe_unused]] double c)
+{
+    if constexpr (eOp == Op::NEG)
+        return -a;
+    else if constexpr (eOp == Op::ABS)
+        return a >= 0 ? a : -a;
+    else if constexpr (eOp == Op::SQRT)
+        return std::sqrt(a);
+    else if constexpr (eOp == Op::EXP)
+        return std::exp(a);
+    else if constexpr (eOp == Op::LN)
+        return std::log(a);
+    else if constexpr (eOp == Op::LOG10)
+        return std::log10(a);
+    else if constexpr (eOp == Op::SIN)
+        return std::sin(a);
+    else if constexpr (eOp == Op::COS)
+        return std::cos(a);
+    else if constexpr (eOp == Op::TAN)
+        return std::tan(a);
+    else if constexpr (eOp == Op::ASIN)
+        return std::asin(a);
+    else if constexpr (eOp == Op::ACOS)
+        return std::acos(a);
+    else if constexpr (eOp == Op::ATAN)
+        return std::atan(a);
+    else if constexpr (eOp == Op::SINH)
+        return std::sinh(a);
+    else if constexpr (eOp == Op::COSH)
+        return std::cosh(a);
+    else if constexpr (eOp == Op::TANH)
+        return std::tanh(a);
+    else if constexpr (eOp == Op::ASINH)
+        return std::asinh(a);
+    else if constexpr (eOp == Op::ACOSH)
+        return std::acosh(a);
+    else if constexpr (eOp == Op::ATANH)
+        return std::atanh(a);
+    else if constexpr (eOp == Op::ISNAN)
+        return a != a ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::ADD)
+        return a + b;
+    else if constexpr (eOp == Op::SUB)
+        return a - b;
+    else if constexpr (eOp == Op::MUL)
+        return a * b;
+    else if constexpr (eOp == Op::DIV)
+        return a / b;
+    else if constexpr (eOp == Op::POW)
+        return std::pow(a, b);
+    else if constexpr (eOp == Op::LT)
+        return a < b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::LE)
+        return a <= b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::GT)
+        return a > b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::GE)
+        return a >= b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::EQ)
+        return a == b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::NE)
+        return a != b ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::AND)
+        return (a != 0) & (b != 0) ? 1.0 : 0.0;
+    else if constexpr (eOp == Op::OR)
+        return (a != 0) | (b != 0) ? 1.0 : 0.0;
+    // Same as std::min() and std::max(), used by muparser
+    else if constexpr (eOp == Op::MIN)
+        return b < a ? b : a;
+    else if constexpr (eOp == Op::MAX)
+        return a < b ? b : a;
+    else
+    {
+        static_assert(eOp == Op::SELECT);
+        return a != 0 ? b : c;
+    }
+}
+
+/************************************************************************/
+/*                               Kernel()                               */
+/************************************************************************/
+
+typedef void (*KernelFunc)(double *CPL_RESTRICT padfDst,
+                           const double *CPL_RESTRICT padfA,
+                           const double *CPL_RESTRICT padfB,
+                           const double *CPL_RESTRICT padfC);
+
+template <Op eOp>
+void Kernel(double *CPL_RESTRICT padfDst, const double *CPL_RESTRICT padfA,
+            [[maybe_unused]] const double *CPL_RESTRICT padfB,
+            [[maybe_unused]] const double *CPL_RESTRICT padfC)
+{
+    if constexpr (GetArity(eOp) == 1)
+    {
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+            padfDst[i] = Apply<eOp>(padfA[i], 0, 0);
+    }
+    else if constexpr (GetArity(eOp) == 2)
+    {
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+            padfDst[i] = Apply<eOp>(padfA[i], padfB[i], 0);
+    }
+    else
+    {
+        for (size_t i = 0; i < BATCH_SIZE; ++i)
+            padfDst[i] = Apply<eOp>(padfA[i], padfB[i], padfC[i]);
+    }
+}
+
+/************************************************************************/
+/*                             GetOpFuncs()                             */
+/************************************************************************/
+
+struct OpFuncs
+{
+    KernelFunc pfnKernel;
+    double (*pfnApply)(double, double, double);
+};
+
+template <Op eOp> constexpr OpFuncs MakeOpFuncs()
+{
+    return {Kernel<eOp>, Apply<eOp>};
+}
+
+OpFuncs GetOpFuncs(Op eOp)
+{
+    switch (eOp)
+    {
+        case Op::CONST:
+        case Op::VAR:
+            break;
+        case Op::NEG:
+            return MakeOpFuncs<Op::NEG>();
+        case Op::ABS:
+            return MakeOpFuncs<Op::ABS>();
+        case Op::SQRT:
+            return MakeOpFuncs<Op::SQRT>();
+        case Op::EXP:
+            return MakeOpFuncs<Op::EXP>();
+        case Op::LN:
+            return MakeOpFuncs<Op::LN>();
+        case Op::LOG10:
+            return MakeOpFuncs<Op::LOG10>();
+        case Op::SIN:
+            return MakeOpFuncs<Op::SIN>();
+        case Op::COS:
+            return MakeOpFuncs<Op::COS>();
+        case Op::TAN:
+            return MakeOpFuncs<Op::TAN>();
+        case Op::ASIN:
+            return MakeOpFuncs<Op::ASIN>();
+        case Op::ACOS:
+            return MakeOpFuncs<Op::ACOS>();
+        case Op::ATAN:
+            return MakeOpFuncs<Op::ATAN>();
+        case Op::SINH:
+            return MakeOpFuncs<Op::SINH>();
+        case Op::COSH:
+            return MakeOpFuncs<Op::COSH>();
+        case Op::TANH:
+            return MakeOpFuncs<Op::TANH>();
+        case Op::ASINH:
+            return MakeOpFuncs<Op::ASINH>();
+        case Op::ACOSH:
+            return MakeOpFuncs<Op::ACOSH>();
+        case Op::ATANH:
+            return MakeOpFuncs<Op::ATANH>();
+        case Op::ISNAN:
+            return MakeOpFuncs<Op::ISNAN>();
+        case Op::ADD:
+            return MakeOpFuncs<Op::ADD>();
+        case Op::SUB:
+            return MakeOpFuncs<Op::SUB>();
+        case Op::MUL:
+            return MakeOpFuncs<Op::MUL>();
+        case Op::DIV:
+            return MakeOpFuncs<Op::DIV>();
+        case Op::POW:
+            return MakeOpFuncs<Op::POW>();
+        case Op::LT:
+            return MakeOpFuncs<Op::LT>();
+        case Op::LE:
+            return MakeOpFuncs<Op::LE>();
+        case Op::GT:
+            return MakeOpFuncs<Op::GT>();
+        case Op::GE:
+            return MakeOpFuncs<Op::GE>();
+        case Op::EQ:
+            return MakeOpFuncs<Op::EQ>();
+        case Op::NE:
+            return MakeOpFuncs<Op::NE>();
+        case Op::AND:
+            return MakeOpFuncs<Op::AND>();
+        case Op::OR:
+            return MakeOpFuncs<Op::OR>();
+        case Op::MIN:
+            return MakeOpFuncs<Op::MIN>();
+        case Op::MAX:
+            return MakeOpFuncs<Op::MAX>();
+        case Op::SELECT:
+            return MakeOpFuncs<Op::SELECT>();
+    }
+    CPLAssert(false);
+    return {nullptr, nullptr};
+}
+
+/************************************************************************/
+/*                                Node                                  */
+/************************************************************************/
+
+// Node of the expression graph. Arguments are indices of nodes created
+// before, so that the order of creation is a topological order.
+struct Node
+{
+    Op eOp = Op::CONST;
+    int anArgs[3] = {-1, -1, -1};
+    double dfValue = 0;  // Value of a CONST node
+    int nVar = -1;       // Index of the variable of a VAR node
+};
+
+/************************************************************************/
+/*                              Compiler                                */
+/************************************************************************/
+
+// Recursive descent parser of the muparser grammar, building the graph of
+// the expression. Sub-expressions whose arguments are all constant are
+// folded, and identical sub-expressions are created only once.
+//
+// Precedences, from lowest to highest: ?: (right associative), && and ||,
+// comparisons, + and -, * and /, unary - and +, ^ (right associative).
+// Old and recent versions of muparser differ on the relative precedence of
+// && and ||, so mixing them without parentheses is not handled.
+class Compiler
+{
+    CPL_DISALLOW_COPY_ASSIGN(Compiler)
+
+  public:
+    Compiler(std::string_view osExpression,
+             const std::vector<std::string> &aosVariables, size_t nBandCount,
+             const double *pdfNoData)
+        : m_osExpression(osExpression), m_aosVariables(aosVariables),
+          m_nBandCount(nBandCount), m_pdfNoData(pdfNoData)
+    {
+        for (size_t i = 0; i < aosVariables.size(); ++i)
+            m_oMapVariables[aosVariables[i]] = static_cast<int>(i);
+    }
+
+    // Return the root node, or -1 if the expression is not handled
+    int Parse()
+    {
+        const int nRoot = ParseTernary();
+        SkipSpaces();
+        return m_nPos == m_osExpression.size() ? nRoot : -1;
+    }
+
+    const std::vector<Node> &GetNodes() const
+    {
+        return m_aoNodes;
+    }
+
+  private:
+    const std::string_view m_osExpression;
+    const std::vector<std::string> &m_aosVariables;
+    const size_t m_nBandCount;
+    const double *const m_pdfNoData;
+    std::map<std::string, int> m_oMapVariables{};
+    size_t m_nPos = 0;
+    int m_nDepth = 0;
+
+    std::vector<Node> m_aoNodes{};
+    std::map<std::tuple<Op, int, int, int, int, uint64_t>, int> m_oMapNodes{};
+
+    int AddNode(const Node &oNode);
+    int MakeConst(double dfValue);
+    int MakeOp(Op eOp, int nA, int nB = -1, int nC = -1);
+
+    void SkipSpaces();
+    bool Accept(const char *pszToken);
+    bool PeekIdentifier(std::string &osIdentifier);
+
+    int ParseTernary();
+    int ParseLogical();
+    int ParseComparison();
+    int ParseAdditive();
+    int ParseMultiplicative();
+    int ParseUnary();
+    int ParsePower();
+    int ParsePrimary();
+    int ParseNumber();
+    int ParseFunction(const std::string &osName);
+    bool ParseArguments(std::vector<int> &anArgs);
+};
+
+/************************************************************************/
+/*                              AddNode()                               */
+/************************************************************************/
+
+int Compiler::AddNode(const Node &oNode)
+{
+    uint64_t nValueBits = 0;
+    memcpy(&nValueBits, &oNode.dfValue, sizeof(nValueBits));
+    const auto oKey =
+        std::make_tuple(oNode.eOp, oNode.anArgs[0], oNode.anArgs[1],
+                        oNode.anArgs[2], oNode.nVar, nValueBits);
+    const auto oIter = m_oMapNodes.find(oKey);
+    if (oIter != m_oMapNodes.end())
+        return oIter->second;
+    const int nIdx = static_cast<int>(m_aoNodes.size());
+    m_aoNodes.push_back(oNode);
+    m_oMapNodes[oKey] = nIdx;
+    return nIdx;
+}
+
+/************************************************************************/
+/*                             MakeConst()                              */
+/************************************************************************/
+
+int Compiler::MakeConst(double dfValue)
+{
+    Node oNode;
+    oNode.dfValue = dfValue;
+    return AddNode(oNode);
+}
+
+/************************************************************************/
+/*                               MakeOp()                               */
+/************************************************************************/
+
+int Compiler::MakeOp(Op eOp, int nA, int nB, int nC)
+{
+    const int nArity = GetArity(eOp);
+    const int anArgs[] = {nA, nB, nC};
+    bool bAllConst = true;
+    for (int i = 0; i < nArity; ++i)
+    {
+        if (anArgs[i] < 0)
+            return -1;
+        bAllConst = bAllConst && m_aoNodes[anArgs[i]].eOp == Op::CONST;
+    }
+    // Conditional with a constant condition
+    if (eOp == Op::SELECT && m_aoNodes[nA].eOp == Op::CONST)
+        return m_aoNodes[nA].dfValue != 0 ? nB : nC;
+    if (bAllConst)
+    {
+        double adfValues[] = {0, 0, 0};
+        for (int i = 0; i < nArity; ++i)
+            adfValues[i] = m_aoNodes[anArgs[i]].dfValue;
+        return MakeConst(GetOpFuncs(eOp).pfnApply(adfValues[0], adfValues[1],
+                                                  adfValues[2]));
+    }
+    Node oNode;
+    oNode.eOp = eOp;
+    for (int i = 0; i < nArity; ++i)
+        oNode.anArgs[i] = anArgs[i];
+    return AddNode(oNode);
+}
+
+/************************************************************************/
+/*                        Tokenization helpers                          */
+/************************************************************************/
+
+void Compiler::SkipSpaces()
+{
+    while (m_nPos < m_osExpression.size() &&
+           isspace(static_cast<unsigned char>(m_osExpression[m_nPos])))
+        ++m_nPos;
+}
+
+bool Compiler::Accept(const char *pszToken)
+{
+    SkipSpaces();
+    const size_t nLen = strlen(pszToken);
+    if (m_osExpression.substr(m_nPos, nLen) != pszToken)
+        return false;
+    m_nPos += nLen;
+    return true;
+}
+
+bool IsIdentifierChar(char ch, bool bFirst)
+{
+    return ch == '_' || isalpha(static_cast<unsigned char>(ch)) ||
+           (!bFirst && isdigit(static_cast<unsigned char>(ch)));
+}
+
+bool Compiler::PeekIdentifier(std::string &osIdentifier)
+{
+    SkipSpaces();
+    size_t nEnd = m_nPos;
+    while (nEnd < m_osExpression.size() &&
+           IsIdentifierChar(m_osExpression[nEnd], nEnd == m_nPos))
+        ++nEnd;
+    osIdentifier = std::string(m_osExpression.substr(m_nPos, nEnd - m_nPos));
+    return !osIdentifier.empty();
+}
+
+/************************************************************************/
+/*                           ParseTernary()                             */
+/************************************************************************/
+
+int Compiler::ParseTernary()
+{
+    if (++m_nDepth > MAX_DEPTH)
+        return -1;
+    int nRet = ParseLogical();
+    if (nRet >= 0 && Accept("?"))
+    {
+        const int nThen = ParseTernary();
+        if (nThen < 0 || !Accept(":"))
+            return -1;
+        const int nElse = ParseTernary();
+        nRet = MakeOp(Op::SELECT, nRet, nThen, nElse);
+    }
+    --m_nDepth;
+    return nRet;
+}
+
+/************************************************************************/
+/*                           ParseLogical()                             */
+/************************************************************************/
+
+int Compiler::ParseLogical()
+{
+    int nRet = ParseComparison();
+    Op eLogicalOp = Op::CONST;
+    while (nRet >= 0)
+    {
+        Op eOp;
+        if (Accept("&&"))
+            eOp = Op::AND;
+        else if (Accept("||"))
+            eOp = Op::OR;
+        else
+            break;
+        if (eLogicalOp != Op::CONST && eOp != eLogicalOp)
+            return -1;
+        eLogicalOp = eOp;
+        nRet = MakeOp(eOp, nRet, ParseComparison());
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                          ParseComparison()                           */
+/************************************************************************/
+
+int Compiler::ParseComparison()
+{
+    int nRet = ParseAdditive();
+    while (nRet >= 0)
+    {
+        Op eOp;
+        if (Accept("<="))
+            eOp = Op::LE;
+        else if (Accept(">="))
+            eOp = Op::GE;
+        else if (Accept("=="))
+            eOp = Op::EQ;
+        else if (Accept("!="))
+            eOp = Op::NE;
+        else if (Accept("<"))
+            eOp = Op::LT;
+        else if (Accept(">"))
+            eOp = Op::GT;
+        else
+            break;
+        nRet = MakeOp(eOp, nRet, ParseAdditive());
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                           ParseAdditive()                            */
+/************************************************************************/
+
+int Compiler::ParseAdditive()
+{
+    int nRet = ParseMultiplicative();
+    while (nRet >= 0)
+    {
+        Op eOp;
+        if (Accept("+"))
+            eOp = Op::ADD;
+        else if (Accept("-"))
+            eOp = Op::SUB;
+        else
+            break;
+        nRet = MakeOp(eOp, nRet, ParseMultiplicative());
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                        ParseMultiplicative()                         */
+/************************************************************************/
+
+int Compiler::ParseMultiplicative()
+{
+    int nRet = ParseUnary();
+    while (nRet >= 0)
+    {
+        Op eOp;
+        if (Accept("*"))
+            eOp = Op::MUL;
+        else if (Accept("/"))
+            eOp = Op::DIV;
+        else
+            break;
+        nRet = MakeOp(eOp, nRet, ParseUnary());
+    }
+    return nRet;
+}
+
+/************************************************************************/
+/*                            ParseUnary()                              */
+/************************************************************************/
+
+int Compiler::ParseUnary()
+{
+    if (++m_nDepth > MAX_DEPTH)
+        return -1;
+    int nRet;
+    if (Accept("-"))
+        nRet = MakeOp(Op::NEG, ParseUnary());
+    else if (Accept("+"))
+        nRet = ParseUnary();
+    else
+        nRet = ParsePower();
+    --m_nDepth;
+    return nRet;
+}
+
+/************************************************************************/
+/*                            ParsePower()                              */
+/************************************************************************/
+
+int Compiler::ParsePower()
+{
+    const int nBase = ParsePrimary();
+    if (nBase < 0 || !Accept("^"))
+        return nBase;
+    // Right associative, and binding tighter than a unary minus on its left
+    // but not on its right: -2^-2 is -(2^(-2))
+    const int nExponent = ParseUnary();
+    if (nExponent < 0)
+        return -1;
+
+    // Small integer powers of variables are computed by muparser as
+    // products, which can differ from std::pow() in the last bit.
+    const Node &oExponent = m_aoNodes[nExponent];
+    if (oExponent.eOp == Op::CONST)
+    {
+        if (oExponent.dfValue == 2)
+            return MakeOp(Op::MUL, nBase, nBase);
+        if (m_aoNodes[nBase].eOp == Op::VAR)
+        {
+            if (oExponent.dfValue == 3)
+                return MakeOp(Op::MUL, MakeOp(Op::MUL, nBase, nBase), nBase);
+            if (oExponent.dfValue == 4)
+                return MakeOp(Op::MUL,
+                              MakeOp(Op::MUL, MakeOp(Op::MUL, nBase, nBase),
+                                     nBase),
+                              nBase);
+        }
+    }
+    return MakeOp(Op::POW, nBase, nExponent);
+}
+
+/************************************************************************/
+/*                           ParsePrimary()                             */
+/************************************************************************/
+
+int Compiler::ParsePrimary()
+{
+    SkipSpaces();
+    if (m_nPos == m_osExpression.size())
+        return -1;
+
+    const char ch = m_osExpression[m_nPos];
+    if (isdigit(static_cast<unsigned char>(ch)) || ch == '.')
+        return ParseNumber();
+
+    if (Accept("("))
+    {
+        const int nRet = ParseTernary();
+        return Accept(")") ? nRet : -1;
+    }
+
+    std::string osName;
+    if (!PeekIdentifier(osName))
+        return -1;
+    m_nPos += osName.size();
+
+    // Variables such as X[1]
+    if (m_nPos < m_osExpression.size() && m_osExpression[m_nPos] == '[')
+    {
+        const size_t nEnd = m_osExpression.find(']', m_nPos);
+        if (nEnd == std::string::npos)
+            return -1;
+        osName += m_osExpression.substr(m_nPos, nEnd + 1 - m_nPos);
+        m_nPos = nEnd + 1;
+    }
+    else
+    {
+        SkipSpaces();
+        if (m_nPos < m_osExpression.size() && m_osExpression[m_nPos] == '(')
+            return ParseFunction(osName);
+    }
+
+    if (osName == "_pi")
+        return MakeConst(M_PI);
+    if (osName == "_e")
+        return MakeConst(M_E);
+    if (osName == "nan" || osName == "NaN")
+        return MakeConst(std::numeric_limits<double>::quiet_NaN());
+    if (osName == "NODATA" && m_pdfNoData)
+        return MakeConst(*m_pdfNoData);
+
+    const auto oIter = m_oMapVariables.find(osName);
+    if (oIter == m_oMapVariables.end())
+        return -1;
+    Node oNode;
+    oNode.eOp = Op::VAR;
+    oNode.nVar = oIter->second;
+    return AddNode(oNode);
+}
+
+/************************************************************************/
+/*                            ParseNumber()                             */
+/************************************************************************/
+
+int Compiler::ParseNumber()
+{
+    const size_t nStart = m_nPos;
+    const auto SkipDigits = [this]()
+    {
+        const size_t nDigitsStart = m_nPos;
+        while (m_nPos < m_osExpression.size() &&
+               isdigit(static_cast<unsigned char>(m_osExpression[m_nPos])))
+            ++m_nPos;
+        return m_nPos > nDigitsStart;
+    };
+    bool bHasDigits = SkipDigits();
+    if (m_nPos < m_osExpression.size() && m_osExpression[m_nPos] == '.')
+    {
+        ++m_nPos;
+        bHasDigits = SkipDigits() || bHasDigits;
+    }
+    if (!bHasDigits)
+        return -1;
+    if (m_nPos < m_osExpression.size() &&
+        (m_osExpression[m_nPos] == 'e' || m_osExpression[m_nPos] == 'E'))
+    {
+        ++m_nPos;
+        if (m_nPos < m_osExpression.size() &&
+            (m_osExpression[m_nPos] == '+' || m_osExpression[m_nPos] == '-'))
+            ++m_nPos;
+        if (!SkipDigits())
+            return -1;
+    }
+    // Something like 2x or 1.5.3 is left to muparser
+    if (m_nPos < m_osExpression.size() &&
+        (IsIdentifierChar(m_osExpression[m_nPos], false) ||
+         m_osExpression[m_nPos] == '.'))
+        return -1;
+    return MakeConst(CPLAtof(
+        std::string(m_osExpression.substr(nStart, m_nPos - nStart)).c_str()));
+}
+
+/************************************************************************/
+/*                          ParseArguments()                            */
+/************************************************************************/
+
+bool Compiler::ParseArguments(std::vector<int> &anArgs)
+{
+    if (!Accept("("))
+        return false;
+    do
+    {
+        // muparser expands the BANDS vector into the list of the bands
+        std::string osName;
+        const size_t nPosBefore = m_nPos;
+        if (m_nBandCount > 0 && PeekIdentifier(osName) && osName == "BANDS")
+        {
+            m_nPos += osName.size();
+            if (Accept(",") || Accept(")"))
+            {
+                --m_nPos;
+                for (size_t i = 0; i < m_nBandCount; ++i)
+                {
+                    Node oNode;
+                    oNode.eOp = Op::VAR;
+                    oNode.nVar = static_cast<int>(i);
+                    anArgs.push_back(AddNode(oNode));
+                }
+                continue;
+            }
+            m_nPos = nPosBefore;
+        }
+
+        const int nArg = ParseTernary();
+        if (nArg < 0)
+            return false;
+        anArgs.push_back(nArg);
+    } while (Accept(","));
+    return Accept(")");
+}
+
+/************************************************************************/
+/*                           ParseFunction()                            */
+/************************************************************************/
+
+int Compiler::ParseFunction(const std::string &osName)
+{
+    static const std::map<std::string, Op> oMapUnaryFunctions = {
+        {"abs", Op::ABS},     {"sqrt", Op::SQRT},   {"exp", Op::EXP},
+        {"ln", Op::LN},       {"log10", Op::LOG10}, {"sin", Op::SIN},
+        {"cos", Op::COS},     {"tan", Op::TAN},     {"asin", Op::ASIN},
+        {"acos", Op::ACOS},   {"atan", Op::ATAN},   {"sinh", Op::SINH},
+        {"cosh", Op::COSH},   {"tanh", Op::TANH},   {"asinh", Op::ASINH},
+        {"acosh", Op::ACOSH}, {"atanh", Op::ATANH}, {"isnan", Op::ISNAN},
+    };
+
+    std::vector<int> anArgs;
+    if (!ParseArguments(anArgs) || anArgs.empty())
+        return -1;
+
+    const auto oIter = oMapUnaryFunctions.find(osName);
+    if (oIter != oMapUnaryFunctions.end())
+    {
+        return anArgs.size() == 1 ? MakeOp(oIter->second, anArgs[0]) : -1;
+    }
+
+    if (osName == "isnodata")
+    {
+        if (!m_pdfNoData || anArgs.size() != 1)
+            return -1;
+        if (std::isnan(*m_pdfNoData))
+            return MakeOp(Op::ISNAN, anArgs[0]);
+        return MakeOp(Op::EQ, anArgs[0], MakeConst(*m_pdfNoData));
+    }
+
+    // Functions with a variable number of arguments, evaluated in the same
+    // order as muparser
+    if (osName == "sum" || osName == "avg")
+    {
+        int nRet = MakeConst(0);
+        for (int nArg : anArgs)
+            nRet = MakeOp(Op::ADD, nRet, nArg);
+        if (osName == "avg")
+            nRet = MakeOp(Op::DIV, nRet,
+                          MakeConst(static_cast<double>(anArgs.size())));
+        return nRet;
+    }
+    if (osName == "min" || osName == "max")
+    {
+        const Op eOp = osName == "min" ? Op::MIN : Op::MAX;
+        int nRet = anArgs[0];
+        for (size_t i = 1; i < anArgs.size(); ++i)
+            nRet = MakeOp(eOp, nRet, anArgs[i]);
+        return nRet;
+    }
+
+    return -1;
+}
+
+/************************************************************************/
+/*                         IsValidVariableName()                        */
+/************************************************************************/
+
+// Whether MuParserExpression accepts the name of a variable, names such as
+// X[1] being first converted to __X__1__.
+bool IsValidVariableName(const std::string &osName)
+{
+    std::string osMuParserName = osName;
+    const auto nOpen = osName.find('[');
+    const auto nClose = osName.find(']');
+    if (nOpen != std::string::npos && nClose != std::string::npos)
+    {
+        osMuParserName = "__" + osName.substr(0, nOpen) + "__" +
+                         osName.substr(nOpen + 1, nClose - nOpen - 1) + "__";
+    }
+    if (osMuParserName.empty())
+        return false;
+    for (size_t i = 0; i < osMuParserName.size(); ++i)
+    {
+        if (!IsIdentifierChar(osMuParserName[i], i == 0))
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                     VectorizedExpression::Impl                       */
+/************************************************************************/
+
+class VectorizedExpression::Impl
+{
+  public:
+    struct Operand
+    {
+        enum class Kind
+        {
+            VAR,
+            REGISTER,
+            CONST,
+            RESULT
+        };
+
+        Kind eKind = Kind::CONST;
+        int nIndex = 0;
+    };
+
+    struct Instruction
+    {
+        KernelFunc pfnKernel = nullptr;
+        Operand oDst{};
+        Operand aoArgs[3]{};
+    };
+
+    // Instructions computing the result. If empty, the expression is a
+    // constant or a variable, given by m_oResult.
+    std::vector<Instruction> m_aoInstructions{};
+    Operand m_oResult{};
+
+    // BATCH_SIZE copies of each constant argument
+    std::vector<double> m_adfConstants{};
+    std::vector<double> m_adfRegisters{};
+
+    // Variables used by the expression, and buffers used to evaluate the
+    // last partial batch
+    size_t m_nVariables = 0;
+    std::vector<int> m_anUsedVariables{};
+    std::vector<double> m_adfTailVariables{};
+    std::vector<double> m_adfTailResults{};
+
+    void Build(const std::vector<Node> &aoNodes, int nRoot);
+
+    const double *GetArg(const Operand &oOperand,
+                         const double *const *papadfVariables,
+                         size_t nOffset) const
+    {
+        switch (oOperand.eKind)
+        {
+            case Operand::Kind::VAR:
+                return papadfVariables[oOperand.nIndex] + nOffset;
+            case Operand::Kind::REGISTER:
+                return m_adfRegisters.data() + oOperand.nIndex * BATCH_SIZE;
+            case Operand::Kind::CONST:
+            case Operand::Kind::RESULT:
+                break;
+        }
+        return m_adfConstants.data() + oOperand.nIndex * BATCH_SIZE;
+    }
+
+    void EvaluateBatch(const double *const *papadfVariables, size_t nOffset,
+                       double *padfResults);
+};
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+// Generate the instructions computing the nodes the root depends on, in the
+// order of their creation. Registers are reused as soon as the value they
+// hold is no longer needed.
+void VectorizedExpression::Impl::Build(const std::vector<Node> &aoNodes,
+                                       int nRoot)
+{
+    const int nNodes = nRoot + 1;
+    std::vector<bool> abReachable(nNodes);
+    std::vector<int> anLastUse(nNodes, -1);
+    abReachable[nRoot] = true;
+    for (int i = nRoot; i >= 0; --i)
+    {
+        if (!abReachable[i])
+            continue;
+        for (int j = 0; j < GetArity(aoNodes[i].eOp); ++j)
+        {
+            const int nArg = aoNodes[i].anArgs[j];
+            abReachable[nArg] = true;
+            anLastUse[nArg] = std::max(anLastUse[nArg], i);
+        }
+    }
+
+    std::map<int, int> oMapConstants;
+    std::vector<int> anRegisters(nNodes, -1);
+    std::vector<int> anFreeRegisters;
+    int nRegisterCount = 0;
+
+    const auto GetOperand = [&](int nNode)
+    {
+        Operand oOperand;
+        const Node &oNode = aoNodes[nNode];
+        if (oNode.eOp == Op::CONST)
+        {
+            auto oIter = oMapConstants.find(nNode);
+            if (oIter == oMapConstants.end())
+            {
+                const int nIdx = static_cast<int>(oMapConstants.size());
+                oIter = oMapConstants.emplace(nNode, nIdx).first;
+                m_adfConstants.resize(m_adfConstants.size() + BATCH_SIZE,
+                                      oNode.dfValue);
+            }
+            oOperand.eKind = Operand::Kind::CONST;
+            oOperand.nIndex = oIter->second;
+        }
+        else if (oNode.eOp == Op::VAR)
+        {
+            oOperand.eKind = Operand::Kind::VAR;
+            oOperand.nIndex = oNode.nVar;
+            if (std::find(m_anUsedVariables.begin(), m_anUsedVariables.end(),
+                          oNode.nVar) == m_anUsedVariables.end())
+                m_anUsedVariables.push_back(oNode.nVar);
+        }
+        else
+        {
+            oOperand.eKind = Operand::Kind::REGISTER;
+            oOperand.nIndex = anRegisters[nNode];
+        }
+        return oOperand;
+    };
+
+    for (int i = 0; i < nNodes; ++i)
+    {
+        const Node &oNode = aoNodes[i];
+        if (!abReachable[i] || oNode.eOp == Op::CONST || oNode.eOp == Op::VAR)
+            continue;
+
+        Instruction oInstr;
+        oInstr.pfnKernel = GetOpFuncs(oNode.eOp).pfnKernel;
+        const int nArity = GetArity(oNode.eOp);
+        for (int j = 0; j < nArity; ++j)
+            oInstr.aoArgs[j] = GetOperand(oNode.anArgs[j]);
+        // Unused arguments of unary and binary kernels are never read
+        for (int j = nArity; j < 3; ++j)
+            oInstr.aoArgs[j] = oInstr.aoArgs[0];
+
+        // The destination register is allocated before the registers of the
+        // arguments are released, so that it differs from them.
+        if (i == nRoot)
+        {
+            oInstr.oDst.eKind = Operand::Kind::RESULT;
+        }
+        else
+        {
+            if (anFreeRegisters.empty())
+            {
+                anRegisters[i] = nRegisterCount++;
+            }
+            else
+            {
+                anRegisters[i] = anFreeRegisters.back();
+                anFreeRegisters.pop_back();
+            }
+            oInstr.oDst.eKind = Operand::Kind::REGISTER;
+            oInstr.oDst.nIndex = anRegisters[i];
+        }
+
+        for (int j = 0; j < nArity; ++j)
+        {
+            const int nArg = oNode.anArgs[j];
+            if (anRegisters[nArg] >= 0 && anLastUse[nArg] == i)
+            {
+                anFreeRegisters.push_back(anRegisters[nArg]);
+                anRegisters[nArg] = -1;
+            }
+        }
+        m_aoInstructions.push_back(oInstr);
+    }
+
+    if (m_aoInstructions.empty())
+        m_oResult = GetOperand(nRoot);
+
+    m_adfRegisters.resize(static_cast<size_t>(nRegisterCount) * BATCH_SIZE);
+    m_adfTailVariables.resize(m_anUsedVariables.size() * BATCH_SIZE);
+    m_adfTailResults.resize(BATCH_SIZE);
+}
+
+/************************************************************************/
+/*                           EvaluateBatch()                            */
+/************************************************************************/
+
+// Compute BATCH_SIZE results, from the values of the variables starting at
+// nOffset.
+void VectorizedExpression::Impl::EvaluateBatch(
+    const double *const *papadfVariables, size_t nOffset, double *padfResults)
+{
+    if (m_aoInstructions.empty())
+    {
+        memcpy(padfResults, GetArg(m_oResult, papadfVariables, nOffset),
+               BATCH_SIZE * sizeof(double));
+        return;
+    }
+
+    for (const auto &oInstr : m_aoInstructions)
+    {
+        double *padfDst =
+            oInstr.oDst.eKind == Operand::Kind::RESULT
+                ? padfResults
+                : m_adfRegisters.data() + oInstr.oDst.nIndex * BATCH_SIZE;
+        oInstr.pfnKernel(padfDst,
+                         GetArg(oInstr.aoArgs[0], papadfVariables, nOffset),
+                         GetArg(oInstr.aoArgs[1], papadfVariables, nOffset),
+                         GetArg(oInstr.aoArgs[2], papadfVariables, nOffset));
+    }
+}
+
+/************************************************************************/
+/*                        VectorizedExpression                          */
+/************************************************************************/
+
+VectorizedExpression::VectorizedExpression(std::unique_ptr<Impl> pImpl)
+    : m_pImpl(std::move(pImpl))
+{
+}
+
+VectorizedExpression::~VectorizedExpression() = default;
+
+/************************************************************************/
+/*                              Compile()                               */
+/************************************************************************/
+
+std::unique_ptr<VectorizedExpression>
+VectorizedExpression::Compile(std::string_view osExpression,
+                              const std::vector<std::string> &aosVariables,
+                              size_t nBandCount, const double *pdfNoData)
+{
+    // Let MuParserExpression report invalid names
+    for (const auto &osName : aosVariables)
+    {
+        if (!IsValidVariableName(osName))
+            return nullptr;
+    }
+
+    Compiler oCompiler(osExpression, aosVariables, nBandCount, pdfNoData);
+    const int nRoot = oCompiler.Parse();
+    if (nRoot < 0)
+        return nullptr;
+
+    auto poImpl = std::make_unique<Impl>();
+    poImpl->m_nVariables = aosVariables.size();
+    poImpl->Build(oCompiler.GetNodes(), nRoot);
+    return std::unique_ptr<VectorizedExpression>(
+        new VectorizedExpression(std::move(poImpl)));
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+void VectorizedExpression::Evaluate(const double *const *papadfVariables,
+                                    size_t nCount, double *padfResults)
+{
+    size_t i = 0;
+    for (; i + BATCH_SIZE <= nCount; i += BATCH_SIZE)
+        m_pImpl->EvaluateBatch(papadfVariables, i, padfResults + i);
+    if (i == nCount)
+        return;
+
+    // Last partial batch, evaluated from copies of the remaining values of
+    // the variables, so that the kernels do not read past them.
+    const size_t nRemaining = nCount - i;
+    std::vector<const double *> apadfTailVariables(m_pImpl->m_nVariables);
+    for (size_t j = 0; j < m_pImpl->m_anUsedVariables.size(); ++j)
+    {
+        const int nVar = m_pImpl->m_anUsedVariables[j];
+        double *padfTail = m_pImpl->m_adfTailVariables.data() + j * BATCH_SIZE;
+        memcpy(padfTail, papadfVariables[nVar] + i,
+               nRemaining * sizeof(double));
+        std::fill(padfTail + nRemaining, padfTail + BATCH_SIZE, 0.0);
+        apadfTailVariables[nVar] = padfTail;
+    }
+    m_pImpl->EvaluateBatch(apadfTailVariables.data(), 0,
+                           m_pImpl->m_adfTailResults.data());
+    memcpy(padfResults + i, m_pImpl->m_adfTailResults.data(),
+           nRemaining * sizeof(double));
+}
+
+/*! @endcond */
+
+}  // namespace gdal
@@ -249,6 +249,8 @@ CPLErr VRTProcessedDataset::Init(const CPLXMLNode *psTree,
     {
         m_poSrcDS.reset(
             GDALCreateOverviewDataset(poParentSrcDS, iOvrLevel, true));
+        // The serialization of an overview dataset is the one of its parent
+        m_bThreadedChunkedRasterIOAllowed = false;
     }
     else if (const CPLXMLNode *psSourceFileNameNode =
                  CPLGetXMLNode(psInput, "SourceFilename"))
@@ -1551,6 +1553,25 @@ CPLErr VRTProcessedDataset::IRasterIO(
         if (bIsBIPLike || bIsBSQLike)
         {
             GByte *pabyData = static_cast<GByte *>(pData);
+
+            // Evaluate large requests by chunks of lines in several threads
+            bool bHandled = false;
+            const CPLErr eErr = ThreadedChunkedRasterIO(
+                nXOff, nYOff, nXSize, nYSize, psExtraArg,
+                [=](VRTDataset *poClone, int nChunkYOff, int nChunkYSize,
+                    GDALRasterIOExtraArg *psChunkExtraArg)
+                {
+                    return poClone->RasterIO(
+                        GF_Read, nXOff, nChunkYOff, nXSize, nChunkYSize,
+                        pabyData + (nChunkYOff - nYOff) * nLineSpace,
+                        nBufXSize, nChunkYSize, eBufType, nBandCount,
+                        panBandMap, nPixelSpace, nLineSpace, nBandSpace,
+                        psChunkExtraArg);
+                },
+                bHandled);
+            if (bHandled)
+                return eErr;
+
             // If acquiring the region of interest in a single time is going
             // to consume too much RAM, split in halves.
             if (m_nAllowedRAMUsage > 0 &&
@@ -1684,6 +1705,15 @@ CPLErr VRTProcessedDataset::IRasterIO(
                                  nBandSpace, psExtraArg);
 }
 
+/************************************************************************/
+/*                        GetVRTPathForClones()                         */
+/************************************************************************/
+
+const char *VRTProcessedDataset::GetVRTPathForClones() const
+{
+    return m_osVRTPath.c_str();
+}
+
 /*! @endcond */
 
 /************************************************************************/
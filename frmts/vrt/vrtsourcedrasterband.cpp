@@ -36,6 +36,7 @@
 #include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_vsi_virtual.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "gdal_thread_pool.h"
@@ -43,6 +44,48 @@
 
 /*! @cond Doxygen_Suppress */
 
+/************************************************************************/
+/*                          VRTDeferredSources                          */
+/************************************************************************/
+
+/** Compact description of the SimpleSource and ComplexSource elements of a
+ * band, whose instantiation as VRTSource objects is deferred until a request
+ * needs them.
+ */
+struct VRTDeferredSources
+{
+    struct Source
+    {
+        //! Offset in osXML of the nul-terminated serialized source element
+        size_t nXMLOffset = 0;
+        //! Destination window, as found in the DstRect element
+        double dfDstXOff = 0;
+        double dfDstYOff = 0;
+        double dfDstXSize = 0;
+        double dfDstYSize = 0;
+        //! Value of the SourceBand element
+        int nSrcBand = 0;
+        bool bGetMaskBand = false;
+        bool bComplexSource = false;
+        bool bHasResampling = false;
+    };
+
+    std::string osVRTPath{};
+    bool bHasVRTPath = false;
+    VRTMapSharedResources *poMapSharedSources = nullptr;
+    std::string osXML{};
+    //! Sources cache file from which serialized elements are read on demand,
+    //! instead of osXML, when the dataset has been opened from it.
+    VSIVirtualHandleUniquePtr fpCache{};
+    //! Offset in fpCache of the serialized elements
+    vsi_l_offset nCacheXMLOffset = 0;
+    //! Size in fpCache of the serialized elements
+    size_t nCacheXMLSize = 0;
+    //! Indexed like VRTSourcedRasterBand::m_papoSources. Only meaningful for
+    //! entries that are nullptr in it.
+    std::vector<Source> asSources{};
+};
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          VRTSourcedRasterBand                        */
@@ -130,9 +173,16 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
         {
             return true;
         }
-        for (auto &poSource : m_papoSources)
+        for (size_t i = 0; i < m_papoSources.size(); ++i)
         {
-            if (poSource->GetType() == VRTComplexSource::GetTypeStatic())
+            const auto &poSource = m_papoSources[i];
+            if (!poSource)
+            {
+                const auto &sSource = m_poDeferredSources->asSources[i];
+                if (sSource.bComplexSource && sSource.bHasResampling)
+                    return true;
+            }
+            else if (poSource->GetType() == VRTComplexSource::GetTypeStatic())
             {
                 auto *const poComplexSource =
                     static_cast<VRTComplexSource *>(poSource.get());
@@ -156,16 +206,32 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
         const bool bIsDownsampling = (nBufXSize < nXSize && nBufYSize < nYSize);
         int nContributingSources = 0;
         bool bSourceFullySatisfiesRequest = true;
-        for (auto &poSource : m_papoSources)
+
+        double dfXOff = nXOff;
+        double dfYOff = nYOff;
+        double dfXSize = nXSize;
+        double dfYSize = nYSize;
+        if (psExtraArg->bFloatingPointWindowValidity)
         {
-            if (!poSource->IsSimpleSource())
+            dfXOff = psExtraArg->dfXOff;
+            dfYOff = psExtraArg->dfYOff;
+            dfXSize = psExtraArg->dfXSize;
+            dfYSize = psExtraArg->dfYSize;
+        }
+
+        for (const int iSource :
+             GetSourcesIntersecting(dfXOff, dfYOff, dfXSize, dfYSize))
+        {
+            VRTSource *const poSource =
+                const_cast<VRTSourcedRasterBand *>(this)->GetSource(iSource);
+            if (!poSource || !poSource->IsSimpleSource())
             {
                 return false;
             }
             else
             {
                 VRTSimpleSource *const poSimpleSource =
-                    static_cast<VRTSimpleSource *>(poSource.get());
+                    static_cast<VRTSimpleSource *>(poSource);
 
                 if (poSimpleSource->GetType() ==
                     VRTComplexSource::GetTypeStatic())
@@ -189,18 +255,6 @@ bool VRTSourcedRasterBand::CanIRasterIOBeForwardedToEachSource(
                     }
                 }
 
-                double dfXOff = nXOff;
-                double dfYOff = nYOff;
-                double dfXSize = nXSize;
-                double dfYSize = nYSize;
-                if (psExtraArg->bFloatingPointWindowValidity)
-                {
-                    dfXOff = psExtraArg->dfXOff;
-                    dfYOff = psExtraArg->dfYOff;
-                    dfXSize = psExtraArg->dfXSize;
-                    dfYSize = psExtraArg->dfYSize;
-                }
-
                 // The window we will actually request from the source raster
                 // band.
                 double dfReqXOff = 0.0;
@@ -279,17 +333,17 @@ bool VRTSourcedRasterBand::CanMultiThreadRasterIO(
     std::set<std::string> oSetDSName;
 
     nContributingSources = 0;
-    for (int iSource = 0; iSource < static_cast<int>(m_papoSources.size());
-         iSource++)
+    for (const int iSource :
+         GetSourcesIntersecting(dfXOff, dfYOff, dfXSize, dfYSize))
     {
-        const auto &poSource = m_papoSources[iSource];
-        if (!poSource->IsSimpleSource())
+        VRTSource *const poSource =
+            const_cast<VRTSourcedRasterBand *>(this)->GetSource(iSource);
+        if (!poSource || !poSource->IsSimpleSource())
         {
             bRet = false;
             break;
         }
-        const auto poSimpleSource =
-            cpl::down_cast<VRTSimpleSource *>(poSource.get());
+        const auto poSimpleSource = cpl::down_cast<VRTSimpleSource *>(poSource);
         if (poSimpleSource->DstWindowIntersects(dfXOff, dfYOff, dfXSize,
                                                 dfYSize))
         {
@@ -513,12 +567,26 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
         if (psExtraArg->eResampleAlg == GRIORA_NearestNeighbour)
         {
             std::string osResampling;
-            for (auto &poSource : m_papoSources)
+            for (int iSource = 0;
+                 iSource < static_cast<int>(m_papoSources.size()); ++iSource)
             {
+                // Only instantiate deferred sources that have a resampling
+                if (!m_papoSources[iSource] &&
+                    !(m_poDeferredSources->asSources[iSource].bComplexSource &&
+                      m_poDeferredSources->asSources[iSource].bHasResampling))
+                {
+                    continue;
+                }
+                VRTSource *const poSource = GetSource(iSource);
+                if (!poSource)
+                {
+                    l_poDS->SetEnableOverviews(bBackupEnabledOverviews);
+                    return CE_Failure;
+                }
                 if (poSource->GetType() == VRTComplexSource::GetTypeStatic())
                 {
                     auto *const poComplexSource =
-                        static_cast<VRTComplexSource *>(poSource.get());
+                        static_cast<VRTComplexSource *>(poSource);
                     if (!poComplexSource->GetResampling().empty())
                     {
                         if (osResampling.empty())
@@ -673,9 +741,13 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
 
         auto oQueue = psThreadPool->CreateJobQueue();
         std::atomic<int> nCompletedJobs = 0;
-        for (auto &poSource : m_papoSources)
+        for (const int iSource :
+             GetSourcesIntersecting(dfXOff, dfYOff, dfXSize, dfYSize))
         {
-            if (!poSource->IsSimpleSource())
+            // Deferred sources have been instantiated by
+            // CanMultiThreadRasterIO()
+            const auto &poSource = m_papoSources[iSource];
+            if (!poSource || !poSource->IsSimpleSource())
                 continue;
             auto poSimpleSource =
                 cpl::down_cast<VRTSimpleSource *>(poSource.get());
@@ -732,20 +804,30 @@ CPLErr VRTSourcedRasterBand::IRasterIO(
         void *const pProgressDataGlobal = psExtraArg->pProgressData;
 
         VRTSource::WorkingState oWorkingState;
-        const int nSources = static_cast<int>(m_papoSources.size());
-        for (int iSource = 0; eErr == CE_None && iSource < nSources; iSource++)
+        const auto anSources =
+            GetSourcesIntersecting(dfXOff, dfYOff, dfXSize, dfYSize);
+        const int nSources = anSources.size();
+        for (int i = 0; eErr == CE_None && i < nSources; i++)
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData = GDALCreateScaledProgress(
-                1.0 * iSource / nSources, 1.0 * (iSource + 1) / nSources,
+                1.0 * i / nSources, 1.0 * (i + 1) / nSources,
                 pfnProgressGlobal, pProgressDataGlobal);
             if (psExtraArg->pProgressData == nullptr)
                 psExtraArg->pfnProgress = nullptr;
 
-            eErr = m_papoSources[iSource]->RasterIO(
-                eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
-                nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg,
-                l_poDS ? l_poDS->m_oWorkingState : oWorkingState);
+            VRTSource *const poSource = GetSource(anSources[i]);
+            if (poSource)
+            {
+                eErr = poSource->RasterIO(
+                    eDataType, nXOff, nYOff, nXSize, nYSize, pData, nBufXSize,
+                    nBufYSize, eBufType, nPixelSpace, nLineSpace, psExtraArg,
+                    l_poDS ? l_poDS->m_oWorkingState : oWorkingState);
+            }
+            else
+            {
+                eErr = CE_Failure;
+            }
 
             GDALDestroyScaledProgress(psExtraArg->pProgressData);
         }
@@ -775,7 +857,8 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
         *pdfDataPct = -1.0;
 
     // Particular case for a single simple source covering the whole dataset
-    if (m_papoSources.size() == 1 && m_papoSources[0]->IsSimpleSource() &&
+    if (m_papoSources.size() == 1 && GetSource(0) &&
+        m_papoSources[0]->IsSimpleSource() &&
         m_papoSources[0]->GetType() == VRTSimpleSource::GetTypeStatic())
     {
         VRTSimpleSource *poSource =
@@ -836,14 +919,16 @@ int VRTSourcedRasterBand::IGetDataCoverageStatus(int nXOff, int nYOff,
         poPolyNonCoveredBySources->addRingDirectly(poLR.release());
     }
 
-    for (auto &poSource : m_papoSources)
+    for (const int iSource :
+         GetSourcesIntersecting(nXOff, nYOff, nXSize, nYSize))
     {
-        if (!poSource->IsSimpleSource())
+        VRTSource *const poSource = GetSource(iSource);
+        if (!poSource || !poSource->IsSimpleSource())
         {
             return GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED |
                    GDAL_DATA_COVERAGE_STATUS_DATA;
         }
-        VRTSimpleSource *poSS = static_cast<VRTSimpleSource *>(poSource.get());
+        VRTSimpleSource *poSS = static_cast<VRTSimpleSource *>(poSource);
         // Check if the AOI is fully inside the source
         double dfDstXOff = std::max(0.0, poSS->m_dfDstXOff);
         double dfDstYOff = std::max(0.0, poSS->m_dfDstYOff);
@@ -987,7 +1072,12 @@ bool VRTSourcedRasterBand::CanUseSourcesMinMaxImplementations()
     const char *pszUseSources =
         CPLGetConfigOption("VRT_MIN_MAX_FROM_SOURCES", nullptr);
     if (pszUseSources)
-        return CPLTestBool(pszUseSources);
+        return CPLTestBool(pszUseSources) && LoadDeferredSources();
+
+    // Sources have been deferred because there are many of them: querying
+    // all of them would be too slow.
+    if (HasDeferredSources())
+        return false;
 
     // Use heuristics to determine if we are going to use the source
     // GetMinimum() or GetMaximum() implementation: all the sources must be
@@ -1210,6 +1300,9 @@ bool VRTSourcedRasterBand::
     IsMosaicOfNonOverlappingSimpleSourcesOfFullRasterNoResAndTypeChange(
         bool bAllowMaxValAdjustment) const
 {
+    if (!const_cast<VRTSourcedRasterBand *>(this)->LoadDeferredSources())
+        return false;
+
     bool bRet = true;
     CPLRectObj sGlobalBounds;
     sGlobalBounds.minx = 0;
@@ -2151,7 +2244,7 @@ CPLErr VRTSourcedRasterBand::GetHistogram(double dfMin, double dfMax,
         }
     }
 
-    if (m_papoSources.size() != 1)
+    if (m_papoSources.size() != 1 || !GetSource(0))
         return VRTRasterBand::GetHistogram(dfMin, dfMax, nBuckets, panHistogram,
                                            bIncludeOutOfRange, bApproxOK,
                                            pfnProgress, pProgressData);
@@ -2214,10 +2307,22 @@ CPLErr VRTSourcedRasterBand::AddSource(std::unique_ptr<VRTSource> poNewSource)
     l_poDS->SetNeedsFlush();
     l_poDS->SourceAdded();
 
-    if (poNewSource->IsSimpleSource())
+    AdjustSourceMaxValue(poNewSource.get());
+
+    m_papoSources.push_back(std::move(poNewSource));
+
+    return CE_None;
+}
+
+/************************************************************************/
+/*                        AdjustSourceMaxValue()                        */
+/************************************************************************/
+
+void VRTSourcedRasterBand::AdjustSourceMaxValue(VRTSource *poSource)
+{
+    if (poSource->IsSimpleSource())
     {
-        VRTSimpleSource *poSS =
-            static_cast<VRTSimpleSource *>(poNewSource.get());
+        VRTSimpleSource *poSS = static_cast<VRTSimpleSource *>(poSource);
         if (GetMetadataItem("NBITS", "IMAGE_STRUCTURE") != nullptr)
         {
             int nBits = atoi(GetMetadataItem("NBITS", "IMAGE_STRUCTURE"));
@@ -2227,10 +2332,650 @@ CPLErr VRTSourcedRasterBand::AddSource(std::unique_ptr<VRTSource> poNewSource)
             }
         }
     }
+}
 
-    m_papoSources.push_back(std::move(poNewSource));
+/************************************************************************/
+/*                            DeferSource()                             */
+/************************************************************************/
 
-    return CE_None;
+/** Record the psSrc source element in m_poDeferredSources, if it is a
+ * SimpleSource or ComplexSource that can be instantiated later without
+ * error. Return false if it must be instantiated immediately.
+ */
+bool VRTSourcedRasterBand::DeferSource(const CPLXMLNode *psSrc)
+{
+    VRTDeferredSources::Source sSource;
+    sSource.bComplexSource =
+        EQUAL(psSrc->pszValue, VRTComplexSource::GetTypeStatic());
+    if (!sSource.bComplexSource &&
+        !EQUAL(psSrc->pszValue, VRTSimpleSource::GetTypeStatic()))
+    {
+        return false;
+    }
+
+    // Only defer sources made of elements whose parsing cannot fail
+    for (const CPLXMLNode *psIter = psSrc->psChild; psIter;
+         psIter = psIter->psNext)
+    {
+        if (psIter->eType == CXT_Attribute)
+        {
+            if (!EQUAL(psIter->pszValue, "resampling") &&
+                !EQUAL(psIter->pszValue, "name"))
+            {
+                return false;
+            }
+        }
+        else if (psIter->eType == CXT_Element)
+        {
+            static const char *const apszAllowedElements[] = {
+                "SourceFilename", "SourceBand",  "SourceProperties",
+                "SrcRect",        "DstRect",     "OpenOptions",
+                "NODATA",         "UseMaskBand", "ScaleOffset",
+                "ScaleRatio",     "ColorTableComponent"};
+            if (std::none_of(std::begin(apszAllowedElements),
+                             std::end(apszAllowedElements),
+                             [psIter](const char *pszName)
+                             { return EQUAL(psIter->pszValue, pszName); }))
+            {
+                return false;
+            }
+        }
+    }
+
+    const char *pszResampling = CPLGetXMLValue(psSrc, "resampling", "");
+    // SimpleSource with average resampling are VRTAveragedSource
+    if (!sSource.bComplexSource && STARTS_WITH_CI(pszResampling, "Aver"))
+        return false;
+    sSource.bHasResampling = pszResampling[0] != '\0';
+
+    if (CPLGetXMLValue(psSrc, "SourceFilename", "")[0] == '\0')
+        return false;
+
+    const char *pszSourceBand = CPLGetXMLValue(psSrc, "SourceBand", "1");
+    if (STARTS_WITH_CI(pszSourceBand, "mask"))
+    {
+        sSource.bGetMaskBand = true;
+        sSource.nSrcBand =
+            pszSourceBand[4] == ',' ? atoi(pszSourceBand + 5) : 1;
+    }
+    else
+    {
+        sSource.nSrcBand = atoi(pszSourceBand);
+    }
+    if (sSource.nSrcBand <= 0 || sSource.nSrcBand > 65536)
+        return false;
+
+    // Same checks as VRTSimpleSource::ParseSrcRectAndDstRect()
+    const auto GetRect = [psSrc](const char *pszRectName, double &dfXOff,
+                                 double &dfYOff, double &dfXSize,
+                                 double &dfYSize)
+    {
+        dfXOff = VRTSimpleSource::UNINIT_WINDOW;
+        dfYOff = VRTSimpleSource::UNINIT_WINDOW;
+        dfXSize = VRTSimpleSource::UNINIT_WINDOW;
+        dfYSize = VRTSimpleSource::UNINIT_WINDOW;
+        const CPLXMLNode *psRect = CPLGetXMLNode(psSrc, pszRectName);
+        if (!psRect)
+            return true;
+        const auto GetAttrValue = [psRect](const char *pszAttrName)
+        {
+            const char *pszVal = CPLGetXMLValue(psRect, pszAttrName, nullptr);
+            return pszVal ? CPLAtof(pszVal) : VRTSimpleSource::UNINIT_WINDOW;
+        };
+        dfXOff = GetAttrValue("xOff");
+        dfYOff = GetAttrValue("yOff");
+        dfXSize = GetAttrValue("xSize");
+        dfYSize = GetAttrValue("ySize");
+        constexpr double UNINIT_WINDOW = VRTSimpleSource::UNINIT_WINDOW;
+        // Test written that way to catch NaN values
+        return (dfXOff >= INT_MIN && dfXOff <= INT_MAX) &&
+               (dfYOff >= INT_MIN && dfYOff <= INT_MAX) &&
+               (dfXSize > 0 || dfXSize == UNINIT_WINDOW) &&
+               dfXSize <= INT_MAX &&
+               (dfYSize > 0 || dfYSize == UNINIT_WINDOW) && dfYSize <= INT_MAX;
+    };
+    double dfSrcXOff, dfSrcYOff, dfSrcXSize, dfSrcYSize;
+    if (!GetRect("SrcRect", dfSrcXOff, dfSrcYOff, dfSrcXSize, dfSrcYSize) ||
+        !GetRect("DstRect", sSource.dfDstXOff, sSource.dfDstYOff,
+                 sSource.dfDstXSize, sSource.dfDstYSize))
+    {
+        return false;
+    }
+
+    // Serialize the element alone, without its siblings
+    CPLXMLNode sNode;
+    sNode.eType = psSrc->eType;
+    sNode.pszValue = psSrc->pszValue;
+    sNode.psNext = nullptr;
+    sNode.psChild = psSrc->psChild;
+    char *pszXML = CPLSerializeXMLTree(&sNode);
+    if (!pszXML)
+        return false;
+    auto &osXML = m_poDeferredSources->osXML;
+    sSource.nXMLOffset = osXML.size();
+    osXML += pszXML;
+    osXML += '\0';
+    CPLFree(pszXML);
+
+    m_poDeferredSources->asSources.resize(m_papoSources.size());
+    m_poDeferredSources->asSources.push_back(sSource);
+    m_papoSources.push_back(nullptr);
+
+    auto l_poDS = static_cast<VRTDataset *>(poDS);
+    l_poDS->SetNeedsFlush();
+    l_poDS->SourceAdded();
+
+    return true;
+}
+
+/************************************************************************/
+/*                         LoadDeferredSource()                         */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::LoadDeferredSource(VRTDriver *poDriver,
+                                              int iSource)
+{
+    CPLAssert(m_poDeferredSources && !m_papoSources[iSource]);
+    const auto &sSource = m_poDeferredSources->asSources[iSource];
+
+    std::unique_ptr<VRTSource> poSource;
+    CPLXMLTreeCloser oTree(nullptr);
+    if (m_poDeferredSources->fpCache)
+    {
+        // Elements are stored consecutively in the sources cache file
+        const size_t nNextOffset =
+            static_cast<size_t>(iSource) + 1 <
+                    m_poDeferredSources->asSources.size()
+                ? m_poDeferredSources->asSources[iSource + 1].nXMLOffset
+                : m_poDeferredSources->nCacheXMLSize;
+        std::string osXML;
+        osXML.resize(nNextOffset - sSource.nXMLOffset);
+        VSILFILE *fp = m_poDeferredSources->fpCache.get();
+        if (VSIFSeekL(fp,
+                      m_poDeferredSources->nCacheXMLOffset +
+                          sSource.nXMLOffset,
+                      SEEK_SET) == 0 &&
+            VSIFReadL(osXML.data(), 1, osXML.size(), fp) == osXML.size())
+        {
+            oTree.reset(CPLParseXMLString(osXML.c_str()));
+        }
+    }
+    else
+    {
+        oTree.reset(CPLParseXMLString(m_poDeferredSources->osXML.c_str() +
+                                      sSource.nXMLOffset));
+    }
+    if (oTree && poDriver)
+    {
+        poSource.reset(poDriver->ParseSource(
+            oTree.get(),
+            m_poDeferredSources->bHasVRTPath
+                ? m_poDeferredSources->osVRTPath.c_str()
+                : nullptr,
+            *(m_poDeferredSources->poMapSharedSources)));
+    }
+    if (!poSource)
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Cannot instantiate source %d of band %d", iSource, nBand);
+        return false;
+    }
+
+    AdjustSourceMaxValue(poSource.get());
+    m_papoSources[iSource] = std::move(poSource);
+    return true;
+}
+
+/************************************************************************/
+/*                             GetSource()                              */
+/************************************************************************/
+
+/** Return the source of index iSource, instantiating it if it has been
+ * deferred. Return nullptr in case of error.
+ */
+VRTSource *VRTSourcedRasterBand::GetSource(int iSource)
+{
+    if (!m_papoSources[iSource] && m_poDeferredSources)
+    {
+        LoadDeferredSource(dynamic_cast<VRTDriver *>(
+                               GetGDALDriverManager()->GetDriverByName("VRT")),
+                           iSource);
+    }
+    return m_papoSources[iSource].get();
+}
+
+/************************************************************************/
+/*                        LoadDeferredSources()                         */
+/************************************************************************/
+
+/** Instantiate all sources whose parsing has been deferred.
+ *
+ * Must be called before iterating over m_papoSources, unless only
+ * GetSource() is used to access its elements.
+ */
+bool VRTSourcedRasterBand::LoadDeferredSources()
+{
+    if (!m_poDeferredSources)
+        return true;
+
+    // Sources may be temporarily swapped out by VRTDataset::IRasterIO()
+    if (m_papoSources.size() < m_poDeferredSources->asSources.size())
+        return true;
+
+    VRTDriver *const poDriver = dynamic_cast<VRTDriver *>(
+        GetGDALDriverManager()->GetDriverByName("VRT"));
+    for (int iSource = 0;
+         iSource < static_cast<int>(m_poDeferredSources->asSources.size());
+         ++iSource)
+    {
+        if (!m_papoSources[iSource] && !LoadDeferredSource(poDriver, iSource))
+            return false;
+    }
+    m_poDeferredSources.reset();
+    return true;
+}
+
+/************************************************************************/
+/*                         HasDeferredSources()                         */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::HasDeferredSources() const
+{
+    return m_poDeferredSources != nullptr;
+}
+
+/************************************************************************/
+/*               DeferredSourcesAreSimpleSourcesOfBand()                */
+/************************************************************************/
+
+/** Return whether all sources whose parsing has been deferred are
+ * SimpleSource elements reading band nSrcBand (and not its mask band).
+ */
+bool VRTSourcedRasterBand::DeferredSourcesAreSimpleSourcesOfBand(
+    int nSrcBand) const
+{
+    if (!m_poDeferredSources)
+        return true;
+    const auto &asSources = m_poDeferredSources->asSources;
+    for (size_t i = 0; i < asSources.size() && i < m_papoSources.size(); ++i)
+    {
+        if (!m_papoSources[i] &&
+            (asSources[i].bComplexSource || asSources[i].bGetMaskBand ||
+             asSources[i].nSrcBand != nSrcBand))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                         AllSourcesDeferred()                         */
+/************************************************************************/
+
+/** Return whether the band has sources, and none of them has been
+ * instantiated yet.
+ */
+bool VRTSourcedRasterBand::AllSourcesDeferred() const
+{
+    return m_poDeferredSources &&
+           m_poDeferredSources->asSources.size() == m_papoSources.size() &&
+           std::none_of(m_papoSources.begin(), m_papoSources.end(),
+                        [](const std::unique_ptr<VRTSource> &poSource)
+                        { return poSource != nullptr; });
+}
+
+/************************************************************************/
+/*                        WriteDeferredSources()                        */
+/************************************************************************/
+
+// Size of the description of a deferred source in a sources cache file:
+// destination window (4 doubles), offset of the serialized element (uint64),
+// source band (int32), flags (uint8) and padding.
+constexpr size_t DEFERRED_SOURCE_RECORD_SIZE = 4 * 8 + 8 + 4 + 4;
+
+constexpr GByte DEFERRED_SOURCE_FLAG_MASK_BAND = 1;
+constexpr GByte DEFERRED_SOURCE_FLAG_COMPLEX_SOURCE = 2;
+constexpr GByte DEFERRED_SOURCE_FLAG_HAS_RESAMPLING = 4;
+
+/** Write the section of a sources cache file describing the sources of
+ * this band, which is empty if AllSourcesDeferred() is false.
+ */
+bool VRTSourcedRasterBand::WriteDeferredSources(VSILFILE *fp) const
+{
+    const bool bAllSourcesDeferred =
+        AllSourcesDeferred() && !m_poDeferredSources->fpCache;
+    uint64_t anHeader[2] = {0, 0};
+    if (bAllSourcesDeferred)
+    {
+        anHeader[0] = m_poDeferredSources->asSources.size();
+        anHeader[1] = m_poDeferredSources->osXML.size();
+    }
+    CPL_LSBPTR64(&anHeader[0]);
+    CPL_LSBPTR64(&anHeader[1]);
+    if (VSIFWriteL(anHeader, sizeof(anHeader), 1, fp) != 1)
+        return false;
+    if (!bAllSourcesDeferred)
+        return true;
+
+    std::vector<GByte> abyRecords;
+    abyRecords.reserve(m_poDeferredSources->asSources.size() *
+                       DEFERRED_SOURCE_RECORD_SIZE);
+    for (const auto &sSource : m_poDeferredSources->asSources)
+    {
+        GByte abyRecord[DEFERRED_SOURCE_RECORD_SIZE] = {0};
+        const double adfDstWin[] = {sSource.dfDstXOff, sSource.dfDstYOff,
+                                    sSource.dfDstXSize, sSource.dfDstYSize};
+        for (int i = 0; i < 4; ++i)
+        {
+            memcpy(abyRecord + 8 * i, &adfDstWin[i], 8);
+            CPL_LSBPTR64(abyRecord + 8 * i);
+        }
+        const uint64_t nXMLOffset = sSource.nXMLOffset;
+        memcpy(abyRecord + 32, &nXMLOffset, 8);
+        CPL_LSBPTR64(abyRecord + 32);
+        const int32_t nSrcBand = sSource.nSrcBand;
+        memcpy(abyRecord + 40, &nSrcBand, 4);
+        CPL_LSBPTR32(abyRecord + 40);
+        abyRecord[44] = static_cast<GByte>(
+            (sSource.bGetMaskBand ? DEFERRED_SOURCE_FLAG_MASK_BAND : 0) |
+            (sSource.bComplexSource ? DEFERRED_SOURCE_FLAG_COMPLEX_SOURCE
+                                    : 0) |
+            (sSource.bHasResampling ? DEFERRED_SOURCE_FLAG_HAS_RESAMPLING
+                                    : 0));
+        abyRecords.insert(abyRecords.end(), abyRecord,
+                          abyRecord + DEFERRED_SOURCE_RECORD_SIZE);
+    }
+    return VSIFWriteL(abyRecords.data(), 1, abyRecords.size(), fp) ==
+               abyRecords.size() &&
+           VSIFWriteL(m_poDeferredSources->osXML.data(), 1,
+                      m_poDeferredSources->osXML.size(),
+                      fp) == m_poDeferredSources->osXML.size();
+}
+
+/************************************************************************/
+/*                        ReadDeferredSources()                         */
+/************************************************************************/
+
+/** Read the section of a sources cache file written by
+ * WriteDeferredSources(), whose serialized elements are then read on demand
+ * from pszCacheFilename.
+ *
+ * Must be called on a band initialized from a VRTRasterBand element whose
+ * SimpleSource and ComplexSource elements have been removed.
+ */
+bool VRTSourcedRasterBand::ReadDeferredSources(VSILFILE *fp,
+                                               const char *pszCacheFilename,
+                                               vsi_l_offset nCacheFileSize)
+{
+    uint64_t anHeader[2] = {0, 0};
+    if (VSIFReadL(anHeader, sizeof(anHeader), 1, fp) != 1)
+        return false;
+    CPL_LSBPTR64(&anHeader[0]);
+    CPL_LSBPTR64(&anHeader[1]);
+    const uint64_t nSourceCount = anHeader[0];
+    const uint64_t nXMLSize = anHeader[1];
+    if (nSourceCount == 0)
+        return nXMLSize == 0;
+
+    const vsi_l_offset nRecordsOffset = VSIFTellL(fp);
+    if (!m_papoSources.empty() || m_poDeferredSources ||
+        typeid(*this) != typeid(VRTSourcedRasterBand) ||
+        nSourceCount > static_cast<uint64_t>(INT_MAX) ||
+        nSourceCount > nXMLSize || nRecordsOffset > nCacheFileSize ||
+        nSourceCount > (nCacheFileSize - nRecordsOffset) /
+                           DEFERRED_SOURCE_RECORD_SIZE ||
+        nXMLSize > nCacheFileSize - nRecordsOffset -
+                       nSourceCount * DEFERRED_SOURCE_RECORD_SIZE ||
+        nXMLSize > std::numeric_limits<size_t>::max())
+    {
+        return false;
+    }
+
+    auto poDeferredSources = std::make_unique<VRTDeferredSources>();
+    std::vector<GByte> abyRecords;
+    try
+    {
+        abyRecords.resize(static_cast<size_t>(nSourceCount) *
+                          DEFERRED_SOURCE_RECORD_SIZE);
+        poDeferredSources->asSources.resize(static_cast<size_t>(nSourceCount));
+        m_papoSources.reserve(static_cast<size_t>(nSourceCount));
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Out of memory when reading sources cache");
+        return false;
+    }
+    if (VSIFReadL(abyRecords.data(), 1, abyRecords.size(), fp) !=
+        abyRecords.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < poDeferredSources->asSources.size(); ++i)
+    {
+        GByte *pabyRecord = abyRecords.data() + i * DEFERRED_SOURCE_RECORD_SIZE;
+        auto &sSource = poDeferredSources->asSources[i];
+        double adfDstWin[4];
+        for (int j = 0; j < 4; ++j)
+        {
+            CPL_LSBPTR64(pabyRecord + 8 * j);
+            memcpy(&adfDstWin[j], pabyRecord + 8 * j, 8);
+        }
+        sSource.dfDstXOff = adfDstWin[0];
+        sSource.dfDstYOff = adfDstWin[1];
+        sSource.dfDstXSize = adfDstWin[2];
+        sSource.dfDstYSize = adfDstWin[3];
+        uint64_t nXMLOffset = 0;
+        CPL_LSBPTR64(pabyRecord + 32);
+        memcpy(&nXMLOffset, pabyRecord + 32, 8);
+        int32_t nSrcBand = 0;
+        CPL_LSBPTR32(pabyRecord + 40);
+        memcpy(&nSrcBand, pabyRecord + 40, 4);
+        const GByte nSourceFlags = pabyRecord[44];
+        // Elements are stored consecutively, starting at offset 0
+        if ((i == 0 && nXMLOffset != 0) ||
+            (i > 0 && nXMLOffset <= poDeferredSources->asSources[i - 1]
+                                        .nXMLOffset) ||
+            nXMLOffset >= nXMLSize || nSrcBand <= 0 || nSrcBand > 65536)
+        {
+            CPLDebug("VRT", "Invalid source %d in sources cache %s",
+                     static_cast<int>(i), pszCacheFilename);
+            return false;
+        }
+        sSource.nXMLOffset = static_cast<size_t>(nXMLOffset);
+        sSource.nSrcBand = nSrcBand;
+        sSource.bGetMaskBand =
+            (nSourceFlags & DEFERRED_SOURCE_FLAG_MASK_BAND) != 0;
+        sSource.bComplexSource =
+            (nSourceFlags & DEFERRED_SOURCE_FLAG_COMPLEX_SOURCE) != 0;
+        sSource.bHasResampling =
+            (nSourceFlags & DEFERRED_SOURCE_FLAG_HAS_RESAMPLING) != 0;
+    }
+
+    poDeferredSources->fpCache.reset(VSIFOpenL(pszCacheFilename, "rb"));
+    if (!poDeferredSources->fpCache)
+        return false;
+    poDeferredSources->nCacheXMLOffset =
+        nRecordsOffset + nSourceCount * DEFERRED_SOURCE_RECORD_SIZE;
+    poDeferredSources->nCacheXMLSize = static_cast<size_t>(nXMLSize);
+    if (VSIFSeekL(fp, poDeferredSources->nCacheXMLOffset + nXMLSize,
+                  SEEK_SET) != 0)
+    {
+        return false;
+    }
+
+    auto l_poDS = static_cast<VRTDataset *>(poDS);
+    poDeferredSources->bHasVRTPath = l_poDS->m_pszVRTPath != nullptr;
+    if (l_poDS->m_pszVRTPath)
+        poDeferredSources->osVRTPath = l_poDS->m_pszVRTPath;
+    poDeferredSources->poMapSharedSources = &l_poDS->m_oMapSharedSources;
+    m_poDeferredSources = std::move(poDeferredSources);
+    m_papoSources.resize(m_poDeferredSources->asSources.size());
+    l_poDS->SourceAdded();
+    InvalidateSourcesIndex();
+
+    return true;
+}
+
+/************************************************************************/
+/*                         BuildSourcesIndex()                          */
+/************************************************************************/
+
+void VRTSourcedRasterBand::BuildSourcesIndex() const
+{
+    const int nSources = static_cast<int>(m_papoSources.size());
+    m_anSourcesNotIndexed.clear();
+    m_nSourcesIndexed = m_papoSources.size();
+    m_papoSourcesIndexed = m_papoSources.data();
+
+    CPLRectObj sGlobalBounds;
+    sGlobalBounds.minx = 0;
+    sGlobalBounds.miny = 0;
+    sGlobalBounds.maxx = nRasterXSize;
+    sGlobalBounds.maxy = nRasterYSize;
+
+    std::vector<CPLRectObj> asBounds(nSources);
+    std::vector<bool> abIndexed(nSources);
+    int nIndexedSources = 0;
+    for (int iSource = 0; iSource < nSources; ++iSource)
+    {
+        const auto &poSource = m_papoSources[iSource];
+        double dfDstXOff = 0;
+        double dfDstYOff = 0;
+        double dfDstXSize = 0;
+        double dfDstYSize = 0;
+        bool bDstWinSet = false;
+        if (!poSource)
+        {
+            // Deferred source, which is necessarily a simple source
+            const auto &sSource = m_poDeferredSources->asSources[iSource];
+            dfDstXOff = sSource.dfDstXOff;
+            dfDstYOff = sSource.dfDstYOff;
+            dfDstXSize = sSource.dfDstXSize;
+            dfDstYSize = sSource.dfDstYSize;
+            constexpr double UNINIT_WINDOW = VRTSimpleSource::UNINIT_WINDOW;
+            bDstWinSet = dfDstXOff != UNINIT_WINDOW ||
+                         dfDstYOff != UNINIT_WINDOW ||
+                         dfDstXSize != UNINIT_WINDOW ||
+                         dfDstYSize != UNINIT_WINDOW;
+        }
+        else if (poSource->IsSimpleSource())
+        {
+            const auto poSS =
+                cpl::down_cast<const VRTSimpleSource *>(poSource.get());
+            poSS->GetDstWindow(dfDstXOff, dfDstYOff, dfDstXSize,
+                               dfDstYSize);
+            bDstWinSet = poSS->IsDstWinSet();
+        }
+        if (bDstWinSet && std::isfinite(dfDstXOff) &&
+            std::isfinite(dfDstYOff) && std::isfinite(dfDstXSize) &&
+            std::isfinite(dfDstYSize) && dfDstXSize > 0 && dfDstYSize > 0)
+        {
+            CPLRectObj &sRect = asBounds[iSource];
+            sRect.minx = dfDstXOff;
+            sRect.miny = dfDstYOff;
+            sRect.maxx = dfDstXOff + dfDstXSize;
+            sRect.maxy = dfDstYOff + dfDstYSize;
+            sGlobalBounds.minx = std::min(sGlobalBounds.minx, sRect.minx);
+            sGlobalBounds.miny = std::min(sGlobalBounds.miny, sRect.miny);
+            sGlobalBounds.maxx = std::max(sGlobalBounds.maxx, sRect.maxx);
+            sGlobalBounds.maxy = std::max(sGlobalBounds.maxy, sRect.maxy);
+            abIndexed[iSource] = true;
+            ++nIndexedSources;
+        }
+        else
+        {
+            m_anSourcesNotIndexed.push_back(iSource);
+        }
+    }
+
+    m_poSourcesIndex.reset(CPLQuadTreeCreate(&sGlobalBounds, nullptr));
+    CPLQuadTreeSetMaxDepth(m_poSourcesIndex.get(),
+                           CPLQuadTreeGetAdvisedMaxDepth(nIndexedSources));
+    for (int iSource = 0; iSource < nSources; ++iSource)
+    {
+        if (abIndexed[iSource])
+        {
+            CPLQuadTreeInsertWithBounds(
+                m_poSourcesIndex.get(),
+                reinterpret_cast<void *>(static_cast<uintptr_t>(iSource)),
+                &asBounds[iSource]);
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GetSourcesIntersecting()                       */
+/************************************************************************/
+
+/** Return the indices, in increasing order, of the sources that may
+ * contribute to the (dfXOff, dfYOff, dfXSize, dfYSize) window.
+ *
+ * This is a superset of the sources whose destination window intersects
+ * the area of interest: non-simple sources and sources without a destination
+ * window are always returned. For mosaics with many sources, this uses a
+ * spatial index built on the first call, so that requests on a small area
+ * do not need to iterate over all sources.
+ */
+VRTSourcedRasterBand::SourceIndices
+VRTSourcedRasterBand::GetSourcesIntersecting(double dfXOff, double dfYOff,
+                                             double dfXSize,
+                                             double dfYSize) const
+{
+    // Below that threshold, iterating over all sources is cheap enough
+    constexpr size_t MIN_SOURCE_COUNT_FOR_INDEX = 64;
+    if (m_papoSources.size() < MIN_SOURCE_COUNT_FOR_INDEX)
+        return SourceIndices(static_cast<int>(m_papoSources.size()));
+
+    if (!m_poSourcesIndex || m_nSourcesIndexed != m_papoSources.size() ||
+        m_papoSourcesIndexed != m_papoSources.data())
+    {
+        BuildSourcesIndex();
+    }
+
+    CPLRectObj sAOI;
+    sAOI.minx = dfXOff;
+    sAOI.miny = dfYOff;
+    sAOI.maxx = dfXOff + dfXSize;
+    sAOI.maxy = dfYOff + dfYSize;
+    int nFeatureCount = 0;
+    void **pahFeatures =
+        CPLQuadTreeSearch(m_poSourcesIndex.get(), &sAOI, &nFeatureCount);
+    std::vector<int> anSources;
+    anSources.reserve(nFeatureCount + m_anSourcesNotIndexed.size());
+    for (int i = 0; i < nFeatureCount; ++i)
+    {
+        anSources.push_back(
+            static_cast<int>(reinterpret_cast<uintptr_t>(pahFeatures[i])));
+    }
+    CPLFree(pahFeatures);
+    anSources.insert(anSources.end(), m_anSourcesNotIndexed.begin(),
+                     m_anSourcesNotIndexed.end());
+
+    // Sources must be processed in their declaration order, as the last
+    // one wins where they overlap.
+    std::sort(anSources.begin(), anSources.end());
+    return SourceIndices(std::move(anSources));
+}
+
+/************************************************************************/
+/*                       InvalidateSourcesIndex()                       */
+/************************************************************************/
+
+/** Discard the spatial index of sources.
+ *
+ * Must be called by code that modifies in place the sources of
+ * m_papoSources or their destination window. Adding or removing sources is
+ * detected automatically.
+ */
+void VRTSourcedRasterBand::InvalidateSourcesIndex()
+{
+    m_poSourcesIndex.reset();
+    m_anSourcesNotIndexed.clear();
+    m_nSourcesIndexed = 0;
+    m_papoSourcesIndexed = nullptr;
 }
 
 /*! @endcond */
@@ -2276,12 +3021,57 @@ CPLErr VRTSourcedRasterBand::XMLInit(const CPLXMLNode *psTree,
     VRTDriver *const poDriver = dynamic_cast<VRTDriver *>(
         GetGDALDriverManager()->GetDriverByName("VRT"));
 
+    // For bands with many sources, defer the instantiation of simple
+    // sources until a request needs them. Not done for subclasses, like
+    // VRTDerivedRasterBand, that access all their sources.
+    if (poDriver && typeid(*this) == typeid(VRTSourcedRasterBand))
+    {
+        const char *pszLazySources =
+            CPLGetConfigOption("VRT_LAZY_SOURCES", "AUTO");
+        bool bLazySources = false;
+        if (EQUAL(pszLazySources, "AUTO"))
+        {
+            constexpr int MIN_SOURCE_COUNT_FOR_LAZY_SOURCES = 1000;
+            int nSourceCount = 0;
+            for (const CPLXMLNode *psChild = psTree->psChild;
+                 psChild != nullptr &&
+                 nSourceCount < MIN_SOURCE_COUNT_FOR_LAZY_SOURCES;
+                 psChild = psChild->psNext)
+            {
+                if (psChild->eType == CXT_Element &&
+                    (EQUAL(psChild->pszValue,
+                           VRTSimpleSource::GetTypeStatic()) ||
+                     EQUAL(psChild->pszValue,
+                           VRTComplexSource::GetTypeStatic())))
+                {
+                    ++nSourceCount;
+                }
+            }
+            bLazySources = nSourceCount >= MIN_SOURCE_COUNT_FOR_LAZY_SOURCES;
+        }
+        else
+        {
+            bLazySources = CPLTestBool(pszLazySources);
+        }
+        if (bLazySources)
+        {
+            m_poDeferredSources = std::make_unique<VRTDeferredSources>();
+            m_poDeferredSources->bHasVRTPath = pszVRTPath != nullptr;
+            if (pszVRTPath)
+                m_poDeferredSources->osVRTPath = pszVRTPath;
+            m_poDeferredSources->poMapSharedSources = &oMapSharedSources;
+        }
+    }
+
     for (const CPLXMLNode *psChild = psTree->psChild;
          psChild != nullptr && poDriver != nullptr; psChild = psChild->psNext)
     {
         if (psChild->eType != CXT_Element)
             continue;
 
+        if (m_poDeferredSources && DeferSource(psChild))
+            continue;
+
         CPLErrorReset();
         VRTSource *const poSource =
             poDriver->ParseSource(psChild, pszVRTPath, oMapSharedSources);
@@ -2291,6 +3081,9 @@ CPLErr VRTSourcedRasterBand::XMLInit(const CPLXMLNode *psTree,
             return CE_Failure;
     }
 
+    if (m_poDeferredSources && m_poDeferredSources->asSources.empty())
+        m_poDeferredSources.reset();
+
     /* -------------------------------------------------------------------- */
     /*      Done.                                                           */
     /* -------------------------------------------------------------------- */
@@ -2322,10 +3115,16 @@ CPLXMLNode *VRTSourcedRasterBand::SerializeToXML(const char *pszVRTPath,
     /*      Process Sources.                                                */
     /* -------------------------------------------------------------------- */
 
+    LoadDeferredSources();
+
     GIntBig nUsableRAM = -1;
 
     for (const auto &poSource : m_papoSources)
     {
+        // Sources that could not be instantiated have already been reported.
+        if (!poSource)
+            continue;
+
         CPLXMLNode *const psXMLSrc = poSource->SerializeToXML(pszVRTPath);
 
         if (psXMLSrc == nullptr)
@@ -2378,7 +3177,8 @@ bool VRTSourcedRasterBand::SkipBufferInitialization()
 
     // Note: if one day we do alpha compositing, we will need to check that.
     m_nSkipBufferInitialization = FALSE;
-    if (m_papoSources.size() != 1 || !m_papoSources[0]->IsSimpleSource())
+    if (m_papoSources.size() != 1 || !GetSource(0) ||
+        !m_papoSources[0]->IsSimpleSource())
     {
         return false;
     }
@@ -2835,13 +3635,14 @@ const char *VRTSourcedRasterBand::GetMetadataItem(const char *pszName,
         CPLHashSet *const hSetFiles =
             CPLHashSetNew(CPLHashSetHashStr, CPLHashSetEqualStr, nullptr);
 
-        for (auto &poSource : m_papoSources)
+        for (const int iSource : GetSourcesIntersecting(iPixel, iLine, 1, 1))
         {
-            if (!poSource->IsSimpleSource())
+            VRTSource *const poSource = GetSource(iSource);
+            if (!poSource || !poSource->IsSimpleSource())
                 continue;
 
             VRTSimpleSource *const poSrc =
-                static_cast<VRTSimpleSource *>(poSource.get());
+                static_cast<VRTSimpleSource *>(poSource);
 
             double dfReqXOff = 0.0;
             double dfReqYOff = 0.0;
@@ -2918,6 +3719,7 @@ char **VRTSourcedRasterBand::GetMetadata(const char *pszDomain)
     /* ==================================================================== */
     if (pszDomain != nullptr && EQUAL(pszDomain, "vrt_sources"))
     {
+        LoadDeferredSources();
         if (static_cast<size_t>(m_aosSourceList.size()) != m_papoSources.size())
         {
             m_aosSourceList.clear();
@@ -2926,6 +3728,8 @@ char **VRTSourcedRasterBand::GetMetadata(const char *pszDomain)
             for (int iSource = 0;
                  iSource < static_cast<int>(m_papoSources.size()); iSource++)
             {
+                if (!m_papoSources[iSource])
+                    continue;
                 CPLXMLNode *const psXMLSrc =
                     m_papoSources[iSource]->SerializeToXML(nullptr);
                 if (psXMLSrc == nullptr)
@@ -3024,6 +3828,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem(const char *pszName,
             if (poSource != nullptr)
             {
                 m_papoSources[iSource] = std::move(poSource);
+                InvalidateSourcesIndex();
                 static_cast<VRTDataset *>(poDS)->SetNeedsFlush();
                 return CE_None;
             }
@@ -3053,6 +3858,8 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
         if (EQUAL(pszDomain, "vrt_sources"))
         {
             m_papoSources.clear();
+            m_poDeferredSources.reset();
+            InvalidateSourcesIndex();
         }
 
         for (const char *const pszMDItem :
@@ -3092,9 +3899,12 @@ CPLErr VRTSourcedRasterBand::SetMetadata(char **papszNewMD,
 void VRTSourcedRasterBand::GetFileList(char ***ppapszFileList, int *pnSize,
                                        int *pnMaxSize, CPLHashSet *hSetFiles)
 {
+    LoadDeferredSources();
     for (auto &poSource : m_papoSources)
     {
-        poSource->GetFileList(ppapszFileList, pnSize, pnMaxSize, hSetFiles);
+        if (poSource)
+            poSource->GetFileList(ppapszFileList, pnSize, pnMaxSize,
+                                  hSetFiles);
     }
 
     VRTRasterBand::GetFileList(ppapszFileList, pnSize, pnMaxSize, hSetFiles);
@@ -3112,6 +3922,8 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
         return ret;
 
     m_papoSources.clear();
+    m_poDeferredSources.reset();
+    InvalidateSourcesIndex();
 
     return TRUE;
 }
@@ -3125,7 +3937,9 @@ CPLErr VRTSourcedRasterBand::FlushCache(bool bAtClosing)
     CPLErr eErr = VRTRasterBand::FlushCache(bAtClosing);
     for (size_t i = 0; i < m_papoSources.size() && eErr == CE_None; i++)
     {
-        eErr = m_papoSources[i]->FlushCache(bAtClosing);
+        // Deferred sources have not been read, hence have nothing to flush.
+        if (m_papoSources[i])
+            eErr = m_papoSources[i]->FlushCache(bAtClosing);
     }
     return eErr;
 }
@@ -3153,6 +3967,9 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
 #else
     (void)papszOptions;
 
+    if (!LoadDeferredSources())
+        return;
+
     CPLRectObj globalBounds;
     globalBounds.minx = 0;
     globalBounds.miny = 0;
@@ -3303,6 +4120,7 @@ void VRTSourcedRasterBand::RemoveCoveredSources(CSLConstList papszOptions)
                                        [](const std::unique_ptr<VRTSource> &src)
                                        { return src.get() == nullptr; }),
                         m_papoSources.end());
+    InvalidateSourcesIndex();
 
     CPLQuadTreeDestroy(hTree);
 #endif
@@ -1375,6 +1375,28 @@ int CPL_DLL CPL_STDCALL GDALGetAccess(GDALDatasetH hDS);
 CPLErr CPL_DLL CPL_STDCALL GDALFlushCache(GDALDatasetH hDS);
 CPLErr CPL_DLL CPL_STDCALL GDALDropCache(GDALDatasetH hDS);
 
+/** Priority class of the blocks of a dataset in the raster block cache.
+ *
+ * When the block cache is full, blocks of datasets of higher priority are
+ * only evicted when no block of lower priority can be.
+ *
+ * @since GDAL 3.12
+ */
+typedef enum
+{
+    /*! Blocks evicted first */ GBCP_Low = 0,
+    /*! Default priority */ GBCP_Normal = 1,
+    /*! Blocks evicted last */ GBCP_High = 2
+} GDALBlockCachePriority;
+
+void CPL_DLL GDALDatasetSetBlockCacheMax(GDALDatasetH hDS, GIntBig nMaxBytes);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheMax(GDALDatasetH hDS);
+GIntBig CPL_DLL GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS);
+void CPL_DLL GDALDatasetSetBlockCachePriority(GDALDatasetH hDS,
+                                              GDALBlockCachePriority ePriority);
+GDALBlockCachePriority CPL_DLL
+GDALDatasetGetBlockCachePriority(GDALDatasetH hDS);
+
 CPLErr CPL_DLL CPL_STDCALL GDALCreateDatasetMaskBand(GDALDatasetH hDS,
                                                      int nFlags);
 
@@ -1438,6 +1460,11 @@ OGRErr CPL_DLL GDALDatasetStartTransaction(GDALDatasetH hDS, int bForce);
 OGRErr CPL_DLL GDALDatasetCommitTransaction(GDALDatasetH hDS);
 OGRErr CPL_DLL GDALDatasetRollbackTransaction(GDALDatasetH hDS);
 void CPL_DLL GDALDatasetClearStatistics(GDALDatasetH hDS);
+CPLErr CPL_DLL GDALDatasetComputeStatistics(GDALDatasetH hDS, int nBandCount,
+                                            const int *panBandList,
+                                            int bApproxOK,
+                                            GDALProgressFunc pfnProgress,
+                                            void *pProgressData);
 
 char CPL_DLL **GDALDatasetGetFieldDomainNames(GDALDatasetH, CSLConstList)
     CPL_WARN_UNUSED_RESULT;
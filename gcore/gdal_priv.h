@@ -55,6 +55,7 @@ class GDALAlgorithm;
 #include <stdarg.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <complex>
 #include <cstdint>
@@ -721,9 +722,13 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     friend class GDALDefaultOverviews;
     friend class GDALProxyDataset;
     friend class GDALDriverManager;
+    friend class GDALRasterBlock;
 
     CPL_INTERNAL void AddToDatasetOpenList();
 
+    CPL_INTERNAL void AddBlockCacheUsed(GIntBig nDelta);
+    CPL_INTERNAL GDALDataset *GetBlockCacheOwner() const;
+
     CPL_INTERNAL void UnregisterFromSharedDataset();
 
     CPL_INTERNAL static void ReportErrorV(const char *pszDSName,
@@ -923,6 +928,12 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     virtual GIntBig GetEstimatedRAMUsage();
 
+    void SetBlockCacheMax(GIntBig nMaxBytes);
+    GIntBig GetBlockCacheMax() const;
+    GIntBig GetBlockCacheUsed() const;
+    void SetBlockCachePriority(GDALBlockCachePriority ePriority);
+    GDALBlockCachePriority GetBlockCachePriority() const;
+
     virtual const OGRSpatialReference *GetSpatialRef() const;
     virtual CPLErr SetSpatialRef(const OGRSpatialReference *poSRS);
 
@@ -1127,6 +1138,11 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     virtual void ClearStatistics();
 
+    virtual CPLErr ComputeStatistics(int nBandCount, const int *panBandList,
+                                     bool bApproxOK,
+                                     GDALProgressFunc pfnProgress,
+                                     void *pProgressData);
+
     /** Convert a GDALDataset* to a GDALDatasetH.
      * @since GDAL 2.3
      */
@@ -1482,8 +1498,19 @@ class CPL_DLL GDALRasterBlock
 
     bool bMustDetach;
 
+    // Queue of the block cache shard in which the block is linked. Only
+    // modified under the block cache lock, but read without it by Touch().
+    std::atomic<GByte> nCacheQueue;
+    // GDALBlockCachePriority of the dataset when the block was cached
+    GByte nCachePriority;
+    // Set by Touch() on cache hits, without taking the block cache lock.
+    std::atomic<bool> bReferenced;
+
     CPL_INTERNAL void Detach_unlocked(void);
+    CPL_INTERNAL void Evict_unlocked(void);
     CPL_INTERNAL void Touch_unlocked(void);
+    CPL_INTERNAL GDALRasterBlock *
+    GetNextEvictionCandidate_unlocked(int nFirstQueue);
 
     CPL_INTERNAL void RecycleFor(int nXOffIn, int nYOffIn);
 
@@ -1604,6 +1631,15 @@ class CPL_DLL GDALRasterBlock
     /* Should only be called by GDALDestroyDriverManager() */
     //! @cond Doxygen_Suppress
     CPL_INTERNAL static void DestroyRBMutex();
+
+    CPL_INTERNAL bool GiveSecondChance_unlocked();
+
+    /* Compressed block cache (GDAL_CACHE_COMPRESSED_MAX) */
+    CPL_INTERNAL bool LoadFromCompressedCache();
+    CPL_INTERNAL static void DropCompressedBlock(const GDALRasterBand *poBand,
+                                                 int nXOff, int nYOff);
+    CPL_INTERNAL static void
+    DropCompressedBlocks(const GDALRasterBand *poBand);
     //! @endcond
 
   private:
@@ -1829,6 +1865,12 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
         GSpacing nPixelSpace, GSpacing nLineSpace,
         GDALRasterIOExtraArg *psExtraArg) CPL_WARN_UNUSED_RESULT;
 
+    CPL_INTERNAL static CPLErr
+    ComputeStatisticsSinglePass(GDALDataset *poDS, int nBandCount,
+                                const int *panBandList,
+                                GDALProgressFunc pfnProgress,
+                                void *pProgressData);
+
   protected:
     //! @cond Doxygen_Suppress
     GDALDataset *poDS = nullptr;
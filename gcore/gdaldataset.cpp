@@ -16,6 +16,7 @@
 #include "gdal_priv.h"
 
 #include <array>
+#include <atomic>
 #include <climits>
 #include <cstdarg>
 #include <cstdio>
@@ -115,6 +116,12 @@ class GDALDataset::Private
     std::vector<int>
         m_anBandMap{};  // used by RasterIO(). Values are 1, 2, etc.
 
+    // Block cache quota (0 = no quota), usage and priority. They are read
+    // by the eviction code of other threads, hence atomic.
+    std::atomic<GIntBig> m_nBlockCacheMax{0};
+    std::atomic<GIntBig> m_nBlockCacheUsed{0};
+    std::atomic<GDALBlockCachePriority> m_eBlockCachePriority{GBCP_Normal};
+
     Private() = default;
 };
 
@@ -662,6 +669,260 @@ CPLErr CPL_STDCALL GDALDropCache(GDALDatasetH hDS)
     return GDALDataset::FromHandle(hDS)->DropCache();
 }
 
+/************************************************************************/
+/*                          SetBlockCacheMax()                          */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of the raster block cache that the blocks of
+ * the bands of this dataset may use.
+ *
+ * When a new block of this dataset must be cached and this limit would be
+ * exceeded, least recently used blocks of this dataset are evicted, even if
+ * the global limit (GDALSetCacheMax64()) is not reached. This protects the
+ * blocks of other datasets from being evicted by a single dataset read in
+ * its entirety.
+ *
+ * The limit is enforced when new blocks are cached. It is also possible to
+ * set it with the BLOCK_CACHE_MAX open option of GDALOpenEx().
+ *
+ * This method is the same as the C function GDALDatasetSetBlockCacheMax().
+ *
+ * @param nMaxBytes Maximum number of bytes, or 0 for no limit (default).
+ * @since GDAL 3.12
+ */
+
+void GDALDataset::SetBlockCacheMax(GIntBig nMaxBytes)
+{
+    GDALDataset *poOwner = GetBlockCacheOwner();
+    if (poOwner->m_poPrivate)
+        poOwner->m_poPrivate->m_nBlockCacheMax.store(
+            std::max<GIntBig>(0, nMaxBytes), std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                    GDALDatasetSetBlockCacheMax()                     */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum amount of the raster block cache that the blocks of
+ * the bands of this dataset may use.
+ *
+ * @see GDALDataset::SetBlockCacheMax()
+ * @since GDAL 3.12
+ */
+
+void GDALDatasetSetBlockCacheMax(GDALDatasetH hDS, GIntBig nMaxBytes)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+
+    GDALDataset::FromHandle(hDS)->SetBlockCacheMax(nMaxBytes);
+}
+
+/************************************************************************/
+/*                          GetBlockCacheMax()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the maximum amount of the raster block cache that the blocks
+ * of the bands of this dataset may use.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheMax().
+ *
+ * @return Maximum number of bytes, or 0 if there is no limit.
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDataset::GetBlockCacheMax() const
+{
+    const GDALDataset *poOwner = GetBlockCacheOwner();
+    return poOwner->m_poPrivate ? poOwner->m_poPrivate->m_nBlockCacheMax.load(
+                                      std::memory_order_relaxed)
+                                : 0;
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheMax()                     */
+/************************************************************************/
+
+/**
+ * \brief Return the maximum amount of the raster block cache that the blocks
+ * of the bands of this dataset may use.
+ *
+ * @see GDALDataset::GetBlockCacheMax()
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDatasetGetBlockCacheMax(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheMax();
+}
+
+/************************************************************************/
+/*                         GetBlockCacheUsed()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the amount of the raster block cache used by the blocks of
+ * the bands of this dataset.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheUsed().
+ *
+ * @return Number of bytes.
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDataset::GetBlockCacheUsed() const
+{
+    const GDALDataset *poOwner = GetBlockCacheOwner();
+    return poOwner->m_poPrivate ? poOwner->m_poPrivate->m_nBlockCacheUsed.load()
+                                : 0;
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheUsed()                    */
+/************************************************************************/
+
+/**
+ * \brief Return the amount of the raster block cache used by the blocks of
+ * the bands of this dataset.
+ *
+ * @see GDALDataset::GetBlockCacheUsed()
+ * @since GDAL 3.12
+ */
+
+GIntBig GDALDatasetGetBlockCacheUsed(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, 0);
+
+    return GDALDataset::FromHandle(hDS)->GetBlockCacheUsed();
+}
+
+/************************************************************************/
+/*                         AddBlockCacheUsed()                          */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+void GDALDataset::AddBlockCacheUsed(GIntBig nDelta)
+{
+    GDALDataset *poOwner = GetBlockCacheOwner();
+    if (poOwner->m_poPrivate)
+        poOwner->m_poPrivate->m_nBlockCacheUsed += nDelta;
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                        GetBlockCacheOwner()                          */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+// Datasets that share their lock with a parent dataset (e.g. GeoTIFF
+// overviews) also share its block cache limit, usage and priority.
+GDALDataset *GDALDataset::GetBlockCacheOwner() const
+{
+    const GDALDataset *poOwner = this;
+    while (poOwner->m_poPrivate && poOwner->m_poPrivate->poParentDataset)
+        poOwner = poOwner->m_poPrivate->poParentDataset;
+    return const_cast<GDALDataset *>(poOwner);
+}
+
+//! @endcond
+
+/************************************************************************/
+/*                       SetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Set the priority class of the blocks of this dataset in the raster
+ * block cache.
+ *
+ * When the block cache is full, blocks of datasets of higher priority are
+ * only evicted when no block of lower priority can be. This can be used by
+ * long-lived processes to keep the blocks of critical datasets in cache.
+ *
+ * The priority applies to blocks cached after this call. It is also possible
+ * to set it with the BLOCK_CACHE_PRIORITY open option of GDALOpenEx().
+ *
+ * This method is the same as the C function
+ * GDALDatasetSetBlockCachePriority().
+ *
+ * @param ePriority Priority class (default is GBCP_Normal).
+ * @since GDAL 3.12
+ */
+
+void GDALDataset::SetBlockCachePriority(GDALBlockCachePriority ePriority)
+{
+    GDALDataset *poOwner = GetBlockCacheOwner();
+    if (poOwner->m_poPrivate)
+        poOwner->m_poPrivate->m_eBlockCachePriority.store(
+            ePriority, std::memory_order_relaxed);
+}
+
+/************************************************************************/
+/*                  GDALDatasetSetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Set the priority class of the blocks of this dataset in the raster
+ * block cache.
+ *
+ * @see GDALDataset::SetBlockCachePriority()
+ * @since GDAL 3.12
+ */
+
+void GDALDatasetSetBlockCachePriority(GDALDatasetH hDS,
+                                      GDALBlockCachePriority ePriority)
+{
+    VALIDATE_POINTER0(hDS, __func__);
+
+    GDALDataset::FromHandle(hDS)->SetBlockCachePriority(ePriority);
+}
+
+/************************************************************************/
+/*                       GetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Return the priority class of the blocks of this dataset in the
+ * raster block cache.
+ *
+ * This method is the same as the C function
+ * GDALDatasetGetBlockCachePriority().
+ *
+ * @since GDAL 3.12
+ */
+
+GDALBlockCachePriority GDALDataset::GetBlockCachePriority() const
+{
+    const GDALDataset *poOwner = GetBlockCacheOwner();
+    return poOwner->m_poPrivate
+               ? poOwner->m_poPrivate->m_eBlockCachePriority.load(
+                     std::memory_order_relaxed)
+               : GBCP_Normal;
+}
+
+/************************************************************************/
+/*                  GDALDatasetGetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Return the priority class of the blocks of this dataset in the
+ * raster block cache.
+ *
+ * @see GDALDataset::GetBlockCachePriority()
+ * @since GDAL 3.12
+ */
+
+GDALBlockCachePriority GDALDatasetGetBlockCachePriority(GDALDatasetH hDS)
+{
+    VALIDATE_POINTER1(hDS, __func__, GBCP_Normal);
+
+    return GDALDataset::FromHandle(hDS)->GetBlockCachePriority();
+}
+
 /************************************************************************/
 /*                      GetEstimatedRAMUsage()                          */
 /************************************************************************/
@@ -3638,6 +3899,67 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
     return nullptr;
 }
 
+/************************************************************************/
+/*                   GDALApplyBlockCacheOpenOptions()                   */
+/************************************************************************/
+
+// Open options handled by GDALOpenEx() for all drivers, unless the driver
+// declares an option with the same name.
+static constexpr const char *apszGenericOpenOptions[] = {
+    "OVERVIEW_LEVEL", "BLOCK_CACHE_MAX", "BLOCK_CACHE_PRIORITY"};
+
+static void GDALApplyBlockCacheOpenOptions(GDALDataset *poDS,
+                                           GDALDriver *poDriver,
+                                           CSLConstList papszOpenOptions)
+{
+    const char *pszCacheMax =
+        CSLFetchNameValue(papszOpenOptions, "BLOCK_CACHE_MAX");
+    if (pszCacheMax && !poDriver->HasOpenOption("BLOCK_CACHE_MAX"))
+    {
+        GIntBig nCacheMax = 0;
+        bool bUnitSpecified = false;
+        const size_t nLen = strlen(pszCacheMax);
+        if (nLen > 0 && pszCacheMax[nLen - 1] == '%')
+        {
+            // Percentage of GDAL_CACHEMAX
+            nCacheMax = static_cast<GIntBig>(CPLAtof(pszCacheMax) / 100.0 *
+                                             GDALGetCacheMax64());
+        }
+        else if (CPLParseMemorySize(pszCacheMax, &nCacheMax,
+                                    &bUnitSpecified) == CE_None)
+        {
+            if (!bUnitSpecified)
+                nCacheMax *= 1024 * 1024;
+        }
+        else
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for BLOCK_CACHE_MAX: %s", pszCacheMax);
+            nCacheMax = 0;
+        }
+        poDS->SetBlockCacheMax(nCacheMax);
+    }
+
+    const char *pszPriority =
+        CSLFetchNameValue(papszOpenOptions, "BLOCK_CACHE_PRIORITY");
+    if (pszPriority && !poDriver->HasOpenOption("BLOCK_CACHE_PRIORITY"))
+    {
+        if (EQUAL(pszPriority, "LOW"))
+            poDS->SetBlockCachePriority(GBCP_Low);
+        else if (EQUAL(pszPriority, "NORMAL"))
+            poDS->SetBlockCachePriority(GBCP_Normal);
+        else if (EQUAL(pszPriority, "HIGH"))
+            poDS->SetBlockCachePriority(GBCP_High);
+        else
+        {
+            CPLError(CE_Warning, CPLE_IllegalArg,
+                     "Invalid value for BLOCK_CACHE_PRIORITY: %s. "
+                     "Expected LOW, NORMAL or HIGH",
+                     pszPriority);
+        }
+    }
+}
+
 /************************************************************************/
 /*                             GDALOpenEx()                             */
 /************************************************************************/
@@ -3732,6 +4054,13 @@ static GDALDataset *GetSharedDS(const char *pszFilename,
  * that it may not cause a warning if the driver doesn't declare this option.
  * Starting with GDAL 3.3, OVERVIEW_LEVEL=NONE is supported to indicate that
  * no overviews should be exposed.
+ * Starting with GDAL 3.12, the BLOCK_CACHE_MAX and BLOCK_CACHE_PRIORITY
+ * options are also available for all raster drivers. BLOCK_CACHE_MAX sets
+ * the maximum size of the raster block cache that the dataset can use (see
+ * GDALDataset::SetBlockCacheMax()). It can be expressed with units (e.g.
+ * "200MB"), as a percentage of GDAL_CACHEMAX (e.g. "10%"), or in megabytes
+ * if no unit is specified. BLOCK_CACHE_PRIORITY=LOW/NORMAL/HIGH sets the
+ * priority class of its blocks (see GDALDataset::SetBlockCachePriority()).
  *
  * @param papszSiblingFiles NULL, or a NULL terminated list of strings that are
  * filenames that are auxiliary to the main filename. If NULL is passed, a
@@ -3921,24 +4250,35 @@ retry:
             poDriver->GetMetadataItem(GDAL_DCAP_MULTIDIM_RASTER) == nullptr)
             continue;
 
-        // Remove general OVERVIEW_LEVEL open options from list before passing
+        // Remove general OVERVIEW_LEVEL, BLOCK_CACHE_MAX and
+        // BLOCK_CACHE_PRIORITY open options from list before passing
         // it to the driver, if it isn't a driver specific option already.
         char **papszTmpOpenOptions = nullptr;
         char **papszTmpOpenOptionsToValidate = nullptr;
         char **papszOptionsToValidate = const_cast<char **>(papszOpenOptions);
-        if (CSLFetchNameValue(papszOpenOptionsCleaned, "OVERVIEW_LEVEL") !=
-                nullptr &&
-            !poDriver->HasOpenOption("OVERVIEW_LEVEL"))
+        for (const char *pszGenericOption : apszGenericOpenOptions)
         {
-            papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
-            papszTmpOpenOptions =
-                CSLSetNameValue(papszTmpOpenOptions, "OVERVIEW_LEVEL", nullptr);
-            oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
-
-            papszOptionsToValidate = CSLDuplicate(papszOptionsToValidate);
-            papszOptionsToValidate = CSLSetNameValue(papszOptionsToValidate,
-                                                     "OVERVIEW_LEVEL", nullptr);
-            papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+            if (CSLFetchNameValue(papszOpenOptionsCleaned, pszGenericOption) !=
+                    nullptr &&
+                !poDriver->HasOpenOption(pszGenericOption))
+            {
+                if (!papszTmpOpenOptions)
+                {
+                    papszTmpOpenOptions = CSLDuplicate(papszOpenOptionsCleaned);
+                    oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
+
+                    papszOptionsToValidate =
+                        CSLDuplicate(papszOptionsToValidate);
+                    papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+                }
+                papszTmpOpenOptions = CSLSetNameValue(
+                    papszTmpOpenOptions, pszGenericOption, nullptr);
+                oOpenInfo.papszOpenOptions = papszTmpOpenOptions;
+
+                papszOptionsToValidate = CSLSetNameValue(
+                    papszOptionsToValidate, pszGenericOption, nullptr);
+                papszTmpOpenOptionsToValidate = papszOptionsToValidate;
+            }
         }
 
         const int nIdentifyRes =
@@ -4028,6 +4368,10 @@ retry:
                 papszOpenOptionsCleaned = nullptr;
             }
 
+            // Deal with generic BLOCK_CACHE_MAX and BLOCK_CACHE_PRIORITY open
+            // options, unless they are driver specific.
+            GDALApplyBlockCacheOpenOptions(poDS, poDriver, papszOpenOptions);
+
             // Deal with generic OVERVIEW_LEVEL open option, unless it is
             // driver specific.
             if (CSLFetchNameValue(papszOpenOptions, "OVERVIEW_LEVEL") !=
@@ -9263,6 +9607,161 @@ void GDALDatasetClearStatistics(GDALDatasetH hDS)
     GDALDataset::FromHandle(hDS)->ClearStatistics();
 }
 
+/************************************************************************/
+/*                         ComputeStatistics()                          */
+/************************************************************************/
+
+/**
+ \brief Compute image statistics of several bands.
+
+ This computes the same minimum, maximum, mean and standard deviation as
+ GDALRasterBand::ComputeStatistics() called on each band, and sets them back
+ on the bands with GDALRasterBand::SetStatistics().
+
+ When exact statistics are requested and the bands share the same data type
+ and block size, the default implementation reads the dataset only once, by
+ chunks of all the requested bands through GDALDataset::RasterIO(), instead
+ of once per band. This is much faster for pixel-interleaved compressed
+ datasets, where each block holds all bands and must otherwise be
+ decompressed once per band. Otherwise, or when bApproxOK is true,
+ GDALRasterBand::ComputeStatistics() is called on each band.
+
+ When computed in a single pass, the mean and standard deviation of bands
+ of non-integer data types may differ in the last digits from the ones
+ computed by GDALRasterBand::ComputeStatistics().
+
+ This is the same as the C function GDALDatasetComputeStatistics().
+
+ @param nBandCount Number of bands in panBandList, or 0 for all bands.
+ @param panBandList List of 1-based band numbers, or nullptr for all bands.
+ @param bApproxOK If true, statistics may be computed based on overviews or
+ a subset of all tiles.
+ @param pfnProgress a function to call to report progress, or nullptr.
+ @param pProgressData application data to pass to the progress function.
+
+ @return CE_None on success, or CE_Failure if an error occurs, if no valid
+ pixel is found in one of the bands, or if processing is terminated by the
+ user.
+
+ @since GDAL 3.12
+*/
+
+CPLErr GDALDataset::ComputeStatistics(int nBandCount, const int *panBandList,
+                                      bool bApproxOK,
+                                      GDALProgressFunc pfnProgress,
+                                      void *pProgressData)
+{
+    if (pfnProgress == nullptr)
+        pfnProgress = GDALDummyProgress;
+
+    std::vector<int> anBandList;
+    if (nBandCount == 0 || panBandList == nullptr)
+    {
+        if (nBandCount == 0)
+            nBandCount = GetRasterCount();
+        for (int i = 0; i < nBandCount; ++i)
+            anBandList.push_back(i + 1);
+    }
+    else
+    {
+        anBandList.assign(panBandList, panBandList + nBandCount);
+    }
+
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        if (anBandList[i] < 1 || anBandList[i] > GetRasterCount())
+        {
+            ReportError(CE_Failure, CPLE_IllegalArg,
+                        "ComputeStatistics(): panBandList[%d] = %d, this band "
+                        "does not exist on dataset.",
+                        i, anBandList[i]);
+            return CE_Failure;
+        }
+    }
+    if (nBandCount == 0)
+        return CE_None;
+
+    /* -------------------------------------------------------------------- */
+    /*      Read all bands in a single pass if they are compatible.         */
+    /* -------------------------------------------------------------------- */
+    if (!bApproxOK && nBandCount > 1)
+    {
+        auto poFirstBand = GetRasterBand(anBandList[0]);
+        const GDALDataType eDT = poFirstBand->GetRasterDataType();
+        int nBlockXSize = 0;
+        int nBlockYSize = 0;
+        poFirstBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+        bool bCompatible = true;
+        for (int i = 1; i < nBandCount && bCompatible; ++i)
+        {
+            auto poBand = GetRasterBand(anBandList[i]);
+            int nThisBlockXSize = 0;
+            int nThisBlockYSize = 0;
+            poBand->GetBlockSize(&nThisBlockXSize, &nThisBlockYSize);
+            bCompatible = poBand->GetRasterDataType() == eDT &&
+                          nThisBlockXSize == nBlockXSize &&
+                          nThisBlockYSize == nBlockYSize;
+        }
+        if (bCompatible)
+        {
+            return GDALRasterBand::ComputeStatisticsSinglePass(
+                this, nBandCount, anBandList.data(), pfnProgress,
+                pProgressData);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Otherwise process each band in turn.                            */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        void *pScaledProgress = GDALCreateScaledProgress(
+            static_cast<double>(i) / nBandCount,
+            static_cast<double>(i + 1) / nBandCount, pfnProgress,
+            pProgressData);
+        double dfMin = 0;
+        double dfMax = 0;
+        double dfMean = 0;
+        double dfStdDev = 0;
+        const CPLErr eBandErr = GetRasterBand(anBandList[i])->ComputeStatistics(
+            bApproxOK, &dfMin, &dfMax, &dfMean, &dfStdDev, GDALScaledProgress,
+            pScaledProgress);
+        GDALDestroyScaledProgress(pScaledProgress);
+        if (eBandErr != CE_None)
+        {
+            eErr = eBandErr;
+            if (CPLGetLastErrorNo() == CPLE_UserInterrupt)
+                break;
+        }
+    }
+
+    return eErr;
+}
+
+/************************************************************************/
+/*                    GDALDatasetComputeStatistics()                    */
+/************************************************************************/
+
+/**
+ \brief Compute image statistics of several bands.
+
+ This is the same as the C++ method GDALDataset::ComputeStatistics().
+
+ @since GDAL 3.12
+*/
+
+CPLErr GDALDatasetComputeStatistics(GDALDatasetH hDS, int nBandCount,
+                                    const int *panBandList, int bApproxOK,
+                                    GDALProgressFunc pfnProgress,
+                                    void *pProgressData)
+{
+    VALIDATE_POINTER1(hDS, __func__, CE_Failure);
+    return GDALDataset::FromHandle(hDS)->ComputeStatistics(
+        nBandCount, panBandList, CPL_TO_BOOL(bApproxOK), pfnProgress,
+        pProgressData);
+}
+
 /************************************************************************/
 /*                        GetFieldDomainNames()                         */
 /************************************************************************/
@@ -296,9 +296,10 @@ GDALDriverManager::~GDALDriverManager()
     GDALRasterBlock::DestroyRBMutex();
 
     /* -------------------------------------------------------------------- */
-    /*      Cleanup gdaltransformer.cpp mutex.                              */
+    /*      Cleanup gdaltransformer.cpp mutex and caches.                   */
     /* -------------------------------------------------------------------- */
     GDALCleanupTransformDeserializerMutex();
+    GDALCleanupApproxTransformerCaches();
 
     /* -------------------------------------------------------------------- */
     /*      Cleanup cpl_error.cpp mutex.                                    */
@@ -24,12 +24,18 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <new>
+#include <random>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
@@ -41,6 +47,8 @@
 #include "gdal_priv_templates.hpp"
 #include "gdal_interpolateatpoint.h"
 #include "gdal_minmax_element.hpp"
+#include "gdal_thread_pool.h"
+#include "statistics_avx2.h"
 
 /************************************************************************/
 /*                           GDALRasterBand()                           */
@@ -81,6 +89,7 @@ GDALRasterBand::~GDALRasterBand()
     GDALRasterBand::FlushCache(true);
 
     delete poBandBlockCache;
+    GDALRasterBlock::DropCompressedBlocks(this);
 
     if (static_cast<GIntBig>(nBlockReads) >
             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn &&
@@ -1723,6 +1732,8 @@ CPLErr GDALRasterBand::DropCache()
     if (poBandBlockCache)
         poBandBlockCache->EnableDirtyBlockWriting();
 
+    GDALRasterBlock::DropCompressedBlocks(this);
+
     return result;
 }
 
@@ -2016,7 +2027,7 @@ GDALRasterBlock *GDALRasterBand::GetLockedBlockRef(int nXBlockOff,
             return nullptr;
         }
 
-        if (!bJustInitialize)
+        if (!bJustInitialize && !poBlock->LoadFromCompressedCache())
         {
             const GUInt32 nErrorCounter = CPLGetErrorCounter();
             int bCallLeaveReadWrite = EnterReadWrite(GF_Read);
@@ -4130,6 +4141,540 @@ inline bool ARE_REAL_EQUAL(GFloat16 dfVal1, GFloat16 dfVal2, int ulp = 2)
                                       abs(dfVal1 + dfVal2) * ulp;
 }
 
+/************************************************************************/
+/*                      GDALParallelBlockVisitor                        */
+/************************************************************************/
+
+namespace
+{
+
+/* Visit all the blocks of a band with the help of the global thread pool.
+ *
+ * Used by ComputeStatistics(), ComputeRasterMinMax() and GetHistogram()
+ * when the GDAL_NUM_THREADS configuration option is set. Reading blocks of
+ * a band is not thread-safe, so the calling thread reads them, a strip of
+ * horizontally adjacent blocks at a time with RasterIO(), which lets drivers
+ * such as GTiff decode them in parallel. Each block of the strip is then
+ * processed by a job of the thread pool, while the next strip is read.
+ *
+ * The processing function receives a block slot, only used by this block
+ * among the ones in flight, and a worker slot, only used by this job among
+ * the running ones. Partial results that do not depend on the order of
+ * accumulation (integer sums, extrema, histograms) can be accumulated per
+ * worker slot. Others (floating-point moments) should be stored per block
+ * slot and accumulated by the merge function, which is called by the calling
+ * thread for each block in raster order, so that the result does not depend
+ * on the number of threads.
+ */
+class GDALParallelBlockVisitor
+{
+  public:
+    using ProcessFunc = std::function<void(
+        int iBlockSlot, int iWorkerSlot, const void *pData,
+        const GByte *pabyMaskData, int nXCheck, int nYCheck, int nLineStride)>;
+    using MergeFunc = std::function<void(int iBlockSlot)>;
+
+    GDALParallelBlockVisitor(GDALRasterBand *poBand, GDALRasterBand *poMaskBand,
+                             int nSampleRate);
+
+    /** Whether the multi-threaded path can be used */
+    bool IsEnabled() const
+    {
+        return m_poJobQueue != nullptr;
+    }
+
+    int GetBlockSlotCount() const
+    {
+        return 2 * m_nBlocksPerStrip;
+    }
+
+    int GetWorkerSlotCount() const
+    {
+        return static_cast<int>(m_anFreeWorkerSlots.size());
+    }
+
+    bool Run(const ProcessFunc &fnProcess, const MergeFunc &fnMerge,
+             const char *pszMessage, GDALProgressFunc pfnProgress,
+             void *pProgressData);
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(GDALParallelBlockVisitor)
+
+    GDALRasterBand *const m_poBand;
+    GDALRasterBand *const m_poMaskBand;
+    int m_nBlockXSize = 0;
+    int m_nBlockYSize = 0;
+    int m_nBlocksPerStrip = 0;
+    std::unique_ptr<CPLJobQueue> m_poJobQueue{};
+    std::mutex m_oMutex{};
+    std::vector<int> m_anFreeWorkerSlots{};
+};
+
+GDALParallelBlockVisitor::GDALParallelBlockVisitor(GDALRasterBand *poBand,
+                                                   GDALRasterBand *poMaskBand,
+                                                   int nSampleRate)
+    : m_poBand(poBand), m_poMaskBand(poMaskBand)
+{
+    // Sampling only reads a few blocks, not worth the overhead.
+    if (nSampleRate != 1)
+        return;
+
+    const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    const int nThreads = std::max(1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                                       ? CPLGetNumCPUs()
+                                                       : atoi(pszThreads)));
+    if (nThreads <= 1)
+        return;
+
+    poBand->GetBlockSize(&m_nBlockXSize, &m_nBlockYSize);
+    const int nBlocksPerRow =
+        DIV_ROUND_UP(poBand->GetXSize(), m_nBlockXSize);
+    const int nBlocksPerColumn =
+        DIV_ROUND_UP(poBand->GetYSize(), m_nBlockYSize);
+    if (static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn < 2)
+        return;
+
+    // Limit the size of a strip to 32 MB, but with at least one block.
+    const int nDTSize =
+        GDALGetDataTypeSizeBytes(poBand->GetRasterDataType());
+    const GIntBig nBlockBytes =
+        static_cast<GIntBig>(m_nBlockXSize) * m_nBlockYSize * nDTSize;
+    constexpr GIntBig MAX_STRIP_BYTES = 32 * 1024 * 1024;
+    m_nBlocksPerStrip = static_cast<int>(std::max<GIntBig>(
+        1, std::min<GIntBig>(nBlocksPerRow, MAX_STRIP_BYTES / nBlockBytes)));
+
+    auto poThreadPool = GDALGetGlobalThreadPool(nThreads);
+    // Run() waits for the completion of the jobs it submits, which could
+    // deadlock if it is itself called from a job of the global pool (for
+    // example a chunk of VRTDataset::ThreadedChunkedRasterIO()), so visit
+    // blocks serially in that case.
+    if (!poThreadPool || poThreadPool->IsCurrentThreadWorker())
+        return;
+    // The global thread pool may have more threads than requested, if it
+    // has been enlarged by someone else.
+    for (int i = 0; i < poThreadPool->GetThreadCount(); ++i)
+        m_anFreeWorkerSlots.push_back(i);
+    m_poJobQueue = poThreadPool->CreateJobQueue();
+}
+
+/************************************************************************/
+/*                                Run()                                 */
+/************************************************************************/
+
+bool GDALParallelBlockVisitor::Run(const ProcessFunc &fnProcess,
+                                   const MergeFunc &fnMerge,
+                                   const char *pszMessage,
+                                   GDALProgressFunc pfnProgress,
+                                   void *pProgressData)
+{
+    CPLAssert(IsEnabled());
+
+    const int nXSize = m_poBand->GetXSize();
+    const int nYSize = m_poBand->GetYSize();
+    const GDALDataType eDT = m_poBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nBlocksPerRow = DIV_ROUND_UP(nXSize, m_nBlockXSize);
+    const int nBlocksPerColumn = DIV_ROUND_UP(nYSize, m_nBlockYSize);
+    const int nStripsPerRow = DIV_ROUND_UP(nBlocksPerRow, m_nBlocksPerStrip);
+    const GIntBig nStrips =
+        static_cast<GIntBig>(nStripsPerRow) * nBlocksPerColumn;
+
+    // Double buffering: one strip is read while the previous one is processed
+    std::unique_ptr<GByte, VSIFreeReleaser> apabyData[2];
+    std::unique_ptr<GByte, VSIFreeReleaser> apabyMaskData[2];
+    const size_t nStripPixels =
+        static_cast<size_t>(m_nBlocksPerStrip) * m_nBlockXSize * m_nBlockYSize;
+    for (int i = 0; i < 2; ++i)
+    {
+        apabyData[i].reset(
+            static_cast<GByte *>(VSI_MALLOC2_VERBOSE(nStripPixels, nDTSize)));
+        if (!apabyData[i])
+            return false;
+        if (m_poMaskBand)
+        {
+            apabyMaskData[i].reset(
+                static_cast<GByte *>(VSI_MALLOC_VERBOSE(nStripPixels)));
+            if (!apabyMaskData[i])
+                return false;
+        }
+    }
+
+    // Number of blocks of the strip whose jobs are running
+    int nPendingBlocks = 0;
+    int iPendingBuffer = 0;
+    const auto MergePendingBlocks = [this, &fnMerge, &nPendingBlocks,
+                                     &iPendingBuffer]()
+    {
+        m_poJobQueue->WaitCompletion();
+        if (fnMerge)
+        {
+            for (int i = 0; i < nPendingBlocks; ++i)
+                fnMerge(iPendingBuffer * m_nBlocksPerStrip + i);
+        }
+        nPendingBlocks = 0;
+    };
+
+    for (GIntBig iStrip = 0; iStrip < nStrips; ++iStrip)
+    {
+        const int iBuffer = static_cast<int>(iStrip % 2);
+        const int iYBlock = static_cast<int>(iStrip / nStripsPerRow);
+        const int iXBlockStart =
+            static_cast<int>(iStrip % nStripsPerRow) * m_nBlocksPerStrip;
+        const int nBlocksInStrip =
+            std::min(m_nBlocksPerStrip, nBlocksPerRow - iXBlockStart);
+        const int nXOff = iXBlockStart * m_nBlockXSize;
+        const int nYOff = iYBlock * m_nBlockYSize;
+        const int nReqXSize =
+            std::min(nBlocksInStrip * m_nBlockXSize, nXSize - nXOff);
+        const int nReqYSize = std::min(m_nBlockYSize, nYSize - nYOff);
+
+        // Read the strip while the jobs of the previous one are running.
+        GByte *pabyData = apabyData[iBuffer].get();
+        GByte *pabyMaskData = apabyMaskData[iBuffer].get();
+        if (m_poBand->RasterIO(GF_Read, nXOff, nYOff, nReqXSize, nReqYSize,
+                               pabyData, nReqXSize, nReqYSize, eDT, 0, 0,
+                               nullptr) != CE_None ||
+            (m_poMaskBand &&
+             m_poMaskBand->RasterIO(GF_Read, nXOff, nYOff, nReqXSize,
+                                    nReqYSize, pabyMaskData, nReqXSize,
+                                    nReqYSize, GDT_Byte, 0, 0,
+                                    nullptr) != CE_None))
+        {
+            m_poJobQueue->WaitCompletion();
+            return false;
+        }
+
+        MergePendingBlocks();
+
+        for (int i = 0; i < nBlocksInStrip; ++i)
+        {
+            const int iBlockSlot = iBuffer * m_nBlocksPerStrip + i;
+            const int nBlockXOff = i * m_nBlockXSize;
+            const int nXCheck =
+                std::min(m_nBlockXSize, nReqXSize - nBlockXOff);
+            const void *pBlockData =
+                pabyData + static_cast<size_t>(nBlockXOff) * nDTSize;
+            const GByte *pabyBlockMaskData =
+                pabyMaskData ? pabyMaskData + nBlockXOff : nullptr;
+            m_poJobQueue->SubmitJob(
+                [this, &fnProcess, iBlockSlot, pBlockData, pabyBlockMaskData,
+                 nXCheck, nReqXSize, nReqYSize]()
+                {
+                    int iWorkerSlot;
+                    {
+                        std::lock_guard oLock(m_oMutex);
+                        CPLAssert(!m_anFreeWorkerSlots.empty());
+                        iWorkerSlot = m_anFreeWorkerSlots.back();
+                        m_anFreeWorkerSlots.pop_back();
+                    }
+                    fnProcess(iBlockSlot, iWorkerSlot, pBlockData,
+                              pabyBlockMaskData, nXCheck, nReqYSize,
+                              nReqXSize);
+                    {
+                        std::lock_guard oLock(m_oMutex);
+                        m_anFreeWorkerSlots.push_back(iWorkerSlot);
+                    }
+                });
+        }
+        nPendingBlocks = nBlocksInStrip;
+        iPendingBuffer = iBuffer;
+
+        if (!pfnProgress(static_cast<double>(iStrip + 1) / nStrips,
+                         pszMessage, pProgressData))
+        {
+            m_poJobQueue->WaitCompletion();
+            m_poBand->ReportError(CE_Failure, CPLE_UserInterrupt,
+                                  "User terminated");
+            return false;
+        }
+    }
+
+    MergePendingBlocks();
+    return true;
+}
+
+}  // namespace
+
+#ifdef HAVE_STATISTICS_AVX2
+
+/************************************************************************/
+/*                       GetInt16NoDataValue()                          */
+/************************************************************************/
+
+// Return whether there is an Int16 value matching the nodata value with
+// ARE_REAL_EQUAL(). There can be at most one, which is its nearest integer.
+static bool GetInt16NoDataValue(const GDALNoDataValues &sNoDataValues,
+                                GInt16 &nNoDataValue)
+{
+    if (!sNoDataValues.bGotNoDataValue)
+        return false;
+    const double dfRounded = std::round(sNoDataValues.dfNoDataValue);
+    if (!(dfRounded >= std::numeric_limits<GInt16>::min() &&
+          dfRounded <= std::numeric_limits<GInt16>::max()) ||
+        !ARE_REAL_EQUAL(dfRounded, sNoDataValues.dfNoDataValue))
+    {
+        return false;
+    }
+    nNoDataValue = static_cast<GInt16>(dfRounded);
+    return true;
+}
+
+/************************************************************************/
+/*                     ComputeBlockHistogramAVX2()                      */
+/************************************************************************/
+
+// Return false if there is no AVX2 implementation for the data type
+static bool ComputeBlockHistogramAVX2(
+    const void *pData, const GByte *pabyMaskData, int nXCheck, int nYCheck,
+    int nLineStride, GDALDataType eDataType,
+    const GDALNoDataValues &sNoDataValues, double dfMin, double dfScale,
+    int nBuckets, bool bIncludeOutOfRange, GUIntBig *panHistogram)
+{
+    switch (eDataType)
+    {
+        case GDT_Int16:
+        {
+            GInt16 nNoDataValue = 0;
+            const bool bHasNoData =
+                GetInt16NoDataValue(sNoDataValues, nNoDataValue);
+            GDALComputeBlockHistogram_AVX2(
+                static_cast<const GInt16 *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride, bHasNoData, nNoDataValue, dfMin, dfScale,
+                nBuckets, bIncludeOutOfRange, panHistogram);
+            return true;
+        }
+        case GDT_Float32:
+            GDALComputeBlockHistogram_AVX2(
+                static_cast<const float *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride, sNoDataValues.bGotFloatNoDataValue,
+                sNoDataValues.fNoDataValue, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        case GDT_Float64:
+            GDALComputeBlockHistogram_AVX2(
+                static_cast<const double *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride,
+                CPL_TO_BOOL(sNoDataValues.bGotNoDataValue),
+                sNoDataValues.dfNoDataValue, dfMin, dfScale, nBuckets,
+                bIncludeOutOfRange, panHistogram);
+            return true;
+        default:
+            break;
+    }
+    return false;
+}
+
+#endif  // HAVE_STATISTICS_AVX2
+
+/************************************************************************/
+/*                       ComputeBlockHistogram()                        */
+/************************************************************************/
+
+static void ComputeBlockHistogram(const void *pData, const GByte *pabyMaskData,
+                                  int nXCheck, int nYCheck, int nLineStride,
+                                  bool bFullBlock, GDALDataType eDataType,
+                                  bool bSignedByte,
+                                  const GDALNoDataValues &sNoDataValues,
+                                  double dfMin, double dfScale, int nBuckets,
+                                  bool bIncludeOutOfRange,
+                                  GUIntBig *panHistogram)
+{
+    // this is a special case for a common situation.
+    if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
+        (dfMin >= -0.5 && dfMin <= 0.5) && bFullBlock && nBuckets == 256)
+    {
+        const GByte *pabyData = static_cast<const GByte *>(pData);
+
+        for (int iY = 0; iY < nYCheck; iY++)
+        {
+            for (int iX = 0; iX < nXCheck; iX++)
+            {
+                const GPtrDiff_t i =
+                    iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+                if (pabyMaskData && pabyMaskData[i] == 0)
+                    continue;
+                if (!(sNoDataValues.bGotNoDataValue &&
+                      (pabyData[i] ==
+                       static_cast<GByte>(sNoDataValues.dfNoDataValue))))
+                {
+                    panHistogram[pabyData[i]]++;
+                }
+            }
+        }
+        return;
+    }
+
+#ifdef HAVE_STATISTICS_AVX2
+    if (CPLHaveRuntimeAVX2() &&
+        ComputeBlockHistogramAVX2(pData, pabyMaskData, nXCheck, nYCheck,
+                                  nLineStride, eDataType, sNoDataValues, dfMin,
+                                  dfScale, nBuckets, bIncludeOutOfRange,
+                                  panHistogram))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            double dfValue = 0.0;
+
+            switch (eDataType)
+            {
+                case GDT_Byte:
+                {
+                    if (bSignedByte)
+                        dfValue =
+                            static_cast<const signed char *>(pData)[iOffset];
+                    else
+                        dfValue = static_cast<const GByte *>(pData)[iOffset];
+                    break;
+                }
+                case GDT_Int8:
+                    dfValue = static_cast<const GInt8 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt16:
+                    dfValue = static_cast<const GUInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_Int16:
+                    dfValue = static_cast<const GInt16 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt32:
+                    dfValue = static_cast<const GUInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_Int32:
+                    dfValue = static_cast<const GInt32 *>(pData)[iOffset];
+                    break;
+                case GDT_UInt64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GUInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Int64:
+                    dfValue = static_cast<double>(
+                        static_cast<const GInt64 *>(pData)[iOffset]);
+                    break;
+                case GDT_Float16:
+                {
+                    using namespace std;
+                    const GFloat16 hfValue =
+                        static_cast<const GFloat16 *>(pData)[iOffset];
+                    if (isnan(hfValue) ||
+                        (sNoDataValues.bGotFloat16NoDataValue &&
+                         ARE_REAL_EQUAL(hfValue, sNoDataValues.hfNoDataValue)))
+                        continue;
+                    dfValue = hfValue;
+                    break;
+                }
+                case GDT_Float32:
+                {
+                    const float fValue =
+                        static_cast<const float *>(pData)[iOffset];
+                    if (std::isnan(fValue) ||
+                        (sNoDataValues.bGotFloatNoDataValue &&
+                         ARE_REAL_EQUAL(fValue, sNoDataValues.fNoDataValue)))
+                        continue;
+                    dfValue = fValue;
+                    break;
+                }
+                case GDT_Float64:
+                    dfValue = static_cast<const double *>(pData)[iOffset];
+                    if (std::isnan(dfValue))
+                        continue;
+                    break;
+                case GDT_CInt16:
+                {
+                    double dfReal =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt16 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CInt32:
+                {
+                    double dfReal =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GInt32 *>(pData)[iOffset * 2 + 1];
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat16:
+                {
+                    double dfReal =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const GFloat16 *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat32:
+                {
+                    double dfReal =
+                        static_cast<const float *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const float *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_CFloat64:
+                {
+                    double dfReal =
+                        static_cast<const double *>(pData)[iOffset * 2];
+                    double dfImag =
+                        static_cast<const double *>(pData)[iOffset * 2 + 1];
+                    if (std::isnan(dfReal) || std::isnan(dfImag))
+                        continue;
+                    dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
+                    break;
+                }
+                case GDT_Unknown:
+                case GDT_TypeCount:
+                    CPLAssert(false);
+                    return;
+            }
+
+            if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
+                sNoDataValues.bGotNoDataValue &&
+                ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
+                continue;
+
+            // Given that dfValue and dfMin are not NaN, and dfScale > 0
+            // and finite, the result of the multiplication cannot be
+            // NaN
+            const double dfIndex = floor((dfValue - dfMin) * dfScale);
+
+            if (dfIndex < 0)
+            {
+                if (bIncludeOutOfRange)
+                    panHistogram[0]++;
+            }
+            else if (dfIndex >= nBuckets)
+            {
+                if (bIncludeOutOfRange)
+                    ++panHistogram[nBuckets - 1];
+            }
+            else
+            {
+                ++panHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    }
+}
+
 /************************************************************************/
 /*                            GetHistogram()                            */
 /************************************************************************/
@@ -4156,6 +4701,10 @@ inline bool ARE_REAL_EQUAL(GFloat16 dfVal1, GFloat16 dfVal2, int ulp = 2)
  * in generating histogram based luts for instance.  Generally bApproxOK is
  * much faster than an exactly computed histogram.
  *
+ * Starting with GDAL 3.12, when all blocks are read, they are processed by
+ * the global thread pool if the GDAL_NUM_THREADS configuration option is set
+ * to a value greater than 1 (or ALL_CPUS).
+ *
  * This method is the same as the C functions GDALGetRasterHistogram() and
  * GDALGetRasterHistogramEx().
  *
@@ -4506,6 +5055,64 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 nSampleRate += 1;
         }
 
+        /* --------------------------------------------------------------------
+         */
+        /*      If GDAL_NUM_THREADS is set, process the blocks in the */
+        /*      global thread pool, with a partial histogram per worker. */
+        /* --------------------------------------------------------------------
+         */
+        GDALParallelBlockVisitor oVisitor(this, poMaskBand, nSampleRate);
+        if (oVisitor.IsEnabled())
+        {
+            const int nWorkerSlots = oVisitor.GetWorkerSlotCount();
+            std::vector<GUIntBig> anPartialHistograms;
+            try
+            {
+                anPartialHistograms.resize(static_cast<size_t>(nWorkerSlots) *
+                                           nBuckets);
+            }
+            catch (const std::exception &)
+            {
+                ReportError(CE_Failure, CPLE_OutOfMemory, "Out of memory");
+                return CE_Failure;
+            }
+
+            const bool bIncludeOutOfRangeB = CPL_TO_BOOL(bIncludeOutOfRange);
+            const auto ProcessBlock =
+                [this, bSignedByte, &sNoDataValues, dfMin, dfScale, nBuckets,
+                 bIncludeOutOfRangeB,
+                 &anPartialHistograms](int, int iWorkerSlot, const void *pData,
+                                       const GByte *pabyMaskData, int nXCheck,
+                                       int nYCheck, int nLineStride)
+            {
+                ComputeBlockHistogram(
+                    pData, pabyMaskData, nXCheck, nYCheck, nLineStride,
+                    nXCheck == nBlockXSize && nYCheck == nBlockYSize,
+                    eDataType, bSignedByte, sNoDataValues, dfMin, dfScale,
+                    nBuckets, bIncludeOutOfRangeB,
+                    anPartialHistograms.data() +
+                        static_cast<size_t>(iWorkerSlot) * nBuckets);
+            };
+            if (!oVisitor.Run(ProcessBlock, nullptr, "Compute Histogram",
+                              pfnProgress, pProgressData))
+            {
+                return CE_Failure;
+            }
+
+            for (int iSlot = 0; iSlot < nWorkerSlots; ++iSlot)
+            {
+                const GUIntBig *panPartialHistogram =
+                    anPartialHistograms.data() +
+                    static_cast<size_t>(iSlot) * nBuckets;
+                for (int iBucket = 0; iBucket < nBuckets; ++iBucket)
+                    panHistogram[iBucket] += panPartialHistogram[iBucket];
+            }
+
+            pfnProgress(1.0, "Compute Histogram", pProgressData);
+
+            return CE_None;
+        }
+
         GByte *pabyMaskData = nullptr;
         if (poMaskBand)
         {
@@ -4559,219 +5166,36 @@ CPLErr GDALRasterBand::GetHistogram(double dfMin, double dfMax, int nBuckets,
                 return CE_Failure;
             }
 
-            void *pData = poBlock->GetDataRef();
+            ComputeBlockHistogram(
+                poBlock->GetDataRef(), pabyMaskData, nXCheck, nYCheck,
+                nBlockXSize, nXCheck == nBlockXSize && nYCheck == nBlockYSize,
+                eDataType, bSignedByte, sNoDataValues, dfMin, dfScale,
+                nBuckets, CPL_TO_BOOL(bIncludeOutOfRange), panHistogram);
 
-            // this is a special case for a common situation.
-            if (eDataType == GDT_Byte && !bSignedByte && dfScale == 1.0 &&
-                (dfMin >= -0.5 && dfMin <= 0.5) && nYCheck == nBlockYSize &&
-                nXCheck == nBlockXSize && nBuckets == 256)
-            {
-                const GPtrDiff_t nPixels =
-                    static_cast<GPtrDiff_t>(nXCheck) * nYCheck;
-                GByte *pabyData = static_cast<GByte *>(pData);
+            poBlock->DropLock();
+        }
 
-                for (GPtrDiff_t i = 0; i < nPixels; i++)
-                {
-                    if (pabyMaskData && pabyMaskData[i] == 0)
-                        continue;
-                    if (!(sNoDataValues.bGotNoDataValue &&
-                          (pabyData[i] ==
-                           static_cast<GByte>(sNoDataValues.dfNoDataValue))))
-                    {
-                        panHistogram[pabyData[i]]++;
-                    }
-                }
+        CPLFree(pabyMaskData);
+    }
 
-                poBlock->DropLock();
-                continue;  // To next sample block.
-            }
+    pfnProgress(1.0, "Compute Histogram", pProgressData);
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
-                {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
+    return CE_None;
+}
 
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+/************************************************************************/
+/*                       GDALGetRasterHistogram()                       */
+/************************************************************************/
 
-                    double dfValue = 0.0;
-
-                    switch (eDataType)
-                    {
-                        case GDT_Byte:
-                        {
-                            if (bSignedByte)
-                                dfValue =
-                                    static_cast<signed char *>(pData)[iOffset];
-                            else
-                                dfValue = static_cast<GByte *>(pData)[iOffset];
-                            break;
-                        }
-                        case GDT_Int8:
-                            dfValue = static_cast<GInt8 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt16:
-                            dfValue = static_cast<GUInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int16:
-                            dfValue = static_cast<GInt16 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt32:
-                            dfValue = static_cast<GUInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_Int32:
-                            dfValue = static_cast<GInt32 *>(pData)[iOffset];
-                            break;
-                        case GDT_UInt64:
-                            dfValue = static_cast<double>(
-                                static_cast<GUInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Int64:
-                            dfValue = static_cast<double>(
-                                static_cast<GInt64 *>(pData)[iOffset]);
-                            break;
-                        case GDT_Float16:
-                        {
-                            using namespace std;
-                            const GFloat16 hfValue =
-                                static_cast<GFloat16 *>(pData)[iOffset];
-                            if (isnan(hfValue) ||
-                                (sNoDataValues.bGotFloat16NoDataValue &&
-                                 ARE_REAL_EQUAL(hfValue,
-                                                sNoDataValues.hfNoDataValue)))
-                                continue;
-                            dfValue = hfValue;
-                            break;
-                        }
-                        case GDT_Float32:
-                        {
-                            const float fValue =
-                                static_cast<float *>(pData)[iOffset];
-                            if (std::isnan(fValue) ||
-                                (sNoDataValues.bGotFloatNoDataValue &&
-                                 ARE_REAL_EQUAL(fValue,
-                                                sNoDataValues.fNoDataValue)))
-                                continue;
-                            dfValue = fValue;
-                            break;
-                        }
-                        case GDT_Float64:
-                            dfValue = static_cast<double *>(pData)[iOffset];
-                            if (std::isnan(dfValue))
-                                continue;
-                            break;
-                        case GDT_CInt16:
-                        {
-                            double dfReal =
-                                static_cast<GInt16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt16 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CInt32:
-                        {
-                            double dfReal =
-                                static_cast<GInt32 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GInt32 *>(pData)[iOffset * 2 + 1];
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat16:
-                        {
-                            double dfReal =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<GFloat16 *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat32:
-                        {
-                            double dfReal =
-                                static_cast<float *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<float *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_CFloat64:
-                        {
-                            double dfReal =
-                                static_cast<double *>(pData)[iOffset * 2];
-                            double dfImag =
-                                static_cast<double *>(pData)[iOffset * 2 + 1];
-                            if (std::isnan(dfReal) || std::isnan(dfImag))
-                                continue;
-                            dfValue = sqrt(dfReal * dfReal + dfImag * dfImag);
-                            break;
-                        }
-                        case GDT_Unknown:
-                        case GDT_TypeCount:
-                            CPLAssert(false);
-                            CPLFree(pabyMaskData);
-                            return CE_Failure;
-                    }
-
-                    if (eDataType != GDT_Float16 && eDataType != GDT_Float32 &&
-                        sNoDataValues.bGotNoDataValue &&
-                        ARE_REAL_EQUAL(dfValue, sNoDataValues.dfNoDataValue))
-                        continue;
-
-                    // Given that dfValue and dfMin are not NaN, and dfScale > 0
-                    // and finite, the result of the multiplication cannot be
-                    // NaN
-                    const double dfIndex = floor((dfValue - dfMin) * dfScale);
-
-                    if (dfIndex < 0)
-                    {
-                        if (bIncludeOutOfRange)
-                            panHistogram[0]++;
-                    }
-                    else if (dfIndex >= nBuckets)
-                    {
-                        if (bIncludeOutOfRange)
-                            ++panHistogram[nBuckets - 1];
-                    }
-                    else
-                    {
-                        ++panHistogram[static_cast<int>(dfIndex)];
-                    }
-                }
-            }
-
-            poBlock->DropLock();
-        }
-
-        CPLFree(pabyMaskData);
-    }
-
-    pfnProgress(1.0, "Compute Histogram", pProgressData);
-
-    return CE_None;
-}
-
-/************************************************************************/
-/*                       GDALGetRasterHistogram()                       */
-/************************************************************************/
-
-/**
- * \brief Compute raster histogram.
- *
- * Use GDALGetRasterHistogramEx() instead to get correct counts for values
- * exceeding 2 billion.
- *
- * @see GDALRasterBand::GetHistogram()
- * @see GDALGetRasterHistogramEx()
- */
+/**
+ * \brief Compute raster histogram.
+ *
+ * Use GDALGetRasterHistogramEx() instead to get correct counts for values
+ * exceeding 2 billion.
+ *
+ * @see GDALRasterBand::GetHistogram()
+ * @see GDALGetRasterHistogramEx()
+ */
 
 CPLErr CPL_STDCALL GDALGetRasterHistogram(GDALRasterBandH hBand, double dfMin,
                                           double dfMax, int nBuckets,
@@ -6492,6 +6916,332 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
 
 //! @endcond
 
+#ifdef HAVE_STATISTICS_AVX2
+
+/************************************************************************/
+/*                    ComputeBlockStatisticsAVX2()                      */
+/************************************************************************/
+
+// Return false if there is no AVX2 implementation for the data type
+static bool ComputeBlockStatisticsAVX2(
+    const void *pData, const GByte *pabyMaskData, int nXCheck, int nYCheck,
+    int nLineStride, GDALDataType eDataType,
+    const GDALNoDataValues &sNoDataValues, double &dfMin, double &dfMax,
+    double &dfMean, double &dfM2, double &dfSum, GUIntBig &nValidCount)
+{
+    GUIntBig nBlockValidCount = 0;
+    double dfBlockMin = 0;
+    double dfBlockMax = 0;
+    double dfBlockMean = 0;
+    double dfBlockM2 = 0;
+    switch (eDataType)
+    {
+        case GDT_Int16:
+        {
+            GInt16 nNoDataValue = 0;
+            const bool bHasNoData =
+                GetInt16NoDataValue(sNoDataValues, nNoDataValue);
+            GDALComputeBlockStatistics_AVX2(
+                static_cast<const GInt16 *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride, bHasNoData, nNoDataValue,
+                nBlockValidCount, dfBlockMin, dfBlockMax, dfBlockMean,
+                dfBlockM2);
+            break;
+        }
+        case GDT_Float32:
+            GDALComputeBlockStatistics_AVX2(
+                static_cast<const float *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride, sNoDataValues.bGotFloatNoDataValue,
+                sNoDataValues.fNoDataValue, nBlockValidCount, dfBlockMin,
+                dfBlockMax, dfBlockMean, dfBlockM2);
+            break;
+        case GDT_Float64:
+            GDALComputeBlockStatistics_AVX2(
+                static_cast<const double *>(pData), pabyMaskData, nXCheck,
+                nYCheck, nLineStride,
+                CPL_TO_BOOL(sNoDataValues.bGotNoDataValue),
+                sNoDataValues.dfNoDataValue, nBlockValidCount, dfBlockMin,
+                dfBlockMax, dfBlockMean, dfBlockM2);
+            break;
+        default:
+            return false;
+    }
+
+    if (nBlockValidCount == 0)
+        return true;
+
+    // Merge the statistics of the block with the previous ones, with the
+    // parallel variant of Welford algorithm.
+    dfMin = std::min(dfMin, dfBlockMin);
+    dfMax = std::max(dfMax, dfBlockMax);
+    const double dfNewCount =
+        static_cast<double>(nValidCount + nBlockValidCount);
+    const double dfDelta = dfBlockMean - dfMean;
+    const double dfBlockWeight = nBlockValidCount / dfNewCount;
+    dfMean += dfDelta * dfBlockWeight;
+    dfM2 += dfBlockM2 + dfDelta * dfDelta * nValidCount * dfBlockWeight;
+    dfSum += dfBlockMean * static_cast<double>(nBlockValidCount);
+    nValidCount += nBlockValidCount;
+    return true;
+}
+
+#endif  // HAVE_STATISTICS_AVX2
+
+/************************************************************************/
+/*                       ComputeBlockStatistics()                       */
+/************************************************************************/
+
+// Update the minimum, maximum, mean, sum of squares of differences to the
+// mean (dfM2), sum and count of valid pixels with the pixels of a block,
+// using Welford algorithm (or its parallel variant for the AVX2 code path,
+// which computes the statistics of the block in two passes).
+static void ComputeBlockStatistics(const void *pData,
+                                   const GByte *pabyMaskData, int nXCheck,
+                                   int nYCheck, int nLineStride,
+                                   GDALDataType eDataType, bool bSignedByte,
+                                   const GDALNoDataValues &sNoDataValues,
+                                   double &dfMin, double &dfMax, double &dfMean,
+                                   double &dfM2, double &dfSum,
+                                   GUIntBig &nValidCount)
+{
+#ifdef HAVE_STATISTICS_AVX2
+    if (CPLHaveRuntimeAVX2() &&
+        ComputeBlockStatisticsAVX2(pData, pabyMaskData, nXCheck, nYCheck,
+                                   nLineStride, eDataType, sNoDataValues,
+                                   dfMin, dfMax, dfMean, dfM2, dfSum,
+                                   nValidCount))
+    {
+        return;
+    }
+#endif
+
+    // This isn't the fastest way to do this, but is easier for now.
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        for (int iX = 0; iX < nXCheck; iX++)
+        {
+            const GPtrDiff_t iOffset =
+                iX + static_cast<GPtrDiff_t>(iY) * nLineStride;
+            if (pabyMaskData && pabyMaskData[iOffset] == 0)
+                continue;
+
+            bool bValid = true;
+            double dfValue = GetPixelValue(eDataType, bSignedByte, pData,
+                                           iOffset, sNoDataValues, bValid);
+
+            if (!bValid)
+                continue;
+
+            dfMin = std::min(dfMin, dfValue);
+            dfMax = std::max(dfMax, dfValue);
+            dfSum += dfValue;
+
+            nValidCount++;
+            if (dfMin == dfMax)
+            {
+                if (nValidCount == 1)
+                    dfMean = dfMin;
+            }
+            else
+            {
+                const double dfDelta = dfValue - dfMean;
+                dfMean += dfDelta / nValidCount;
+                dfM2 += dfDelta * (dfValue - dfMean);
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                     GDALStatisticsBlockSampler                       */
+/************************************************************************/
+
+namespace
+{
+
+/* Selection of the blocks read by ComputeStatistics().
+ *
+ * By default, one block every nSampleRate blocks is read. When approximate
+ * statistics are requested and GDAL_STATS_APPROX_SAMPLING=BLOCKS, the blocks
+ * are rather split into as many strata of consecutive blocks as can be read
+ * within the GDAL_STATS_APPROX_MAX_BYTES budget, and one random block of each
+ * stratum is read. This bounds the number of blocks fetched on remote
+ * rasters without overviews, and gives an unbiased sample from which the
+ * standard error of the mean can be estimated.
+ */
+class GDALStatisticsBlockSampler
+{
+  public:
+    GDALStatisticsBlockSampler() = default;
+
+    GDALStatisticsBlockSampler(GIntBig nTotalBlocks, int nSampleRate)
+        : m_nTotalBlocks(nTotalBlocks), m_nSampleRate(nSampleRate)
+    {
+    }
+
+    void InitRandomSampling(GIntBig nBlockBytes);
+
+    int GetSampleRate() const
+    {
+        return m_nSampleRate;
+    }
+
+    GIntBig GetCount() const
+    {
+        if (!m_anBlocks.empty())
+            return static_cast<GIntBig>(m_anBlocks.size());
+        return (m_nTotalBlocks + m_nSampleRate - 1) / m_nSampleRate;
+    }
+
+    GIntBig GetBlock(GIntBig i) const
+    {
+        if (!m_anBlocks.empty())
+            return m_anBlocks[static_cast<size_t>(i)];
+        return i * m_nSampleRate;
+    }
+
+    void AddBlockSum(GUIntBig nValidCount, double dfSum)
+    {
+        if (!m_anBlocks.empty())
+            m_asBlockSums.emplace_back(nValidCount, dfSum);
+    }
+
+    bool GetMeanStandardError(double &dfStdErr) const;
+
+  private:
+    GIntBig m_nTotalBlocks = 0;
+    int m_nSampleRate = 1;
+    std::vector<GIntBig> m_anBlocks{};
+    std::vector<std::pair<GUIntBig, double>> m_asBlockSums{};
+};
+
+/************************************************************************/
+/*                        InitRandomSampling()                          */
+/************************************************************************/
+
+void GDALStatisticsBlockSampler::InitRandomSampling(GIntBig nBlockBytes)
+{
+    if (!EQUAL(CPLGetConfigOption("GDAL_STATS_APPROX_SAMPLING", "STRIDED"),
+               "BLOCKS"))
+    {
+        return;
+    }
+
+    const char *pszMaxBytes =
+        CPLGetConfigOption("GDAL_STATS_APPROX_MAX_BYTES", "64MB");
+    GIntBig nMaxBytes = 0;
+    bool bUnitSpecified = false;
+    if (CPLParseMemorySize(pszMaxBytes, &nMaxBytes, &bUnitSpecified) !=
+        CE_None)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Invalid value for GDAL_STATS_APPROX_MAX_BYTES. "
+                 "Using 64MB.");
+        nMaxBytes = 64 * 1024 * 1024;
+    }
+    else if (!bUnitSpecified && nMaxBytes < 100000)
+    {
+        // Assume MB
+        nMaxBytes *= (1024 * 1024);
+    }
+
+    const GIntBig nBlocks = std::max<GIntBig>(
+        1, std::min(m_nTotalBlocks,
+                    nMaxBytes / std::max<GIntBig>(1, nBlockBytes)));
+    if (nBlocks == m_nTotalBlocks)
+    {
+        // The budget is large enough to read everything.
+        m_nSampleRate = 1;
+        return;
+    }
+
+    // Use a fixed seed, so that the result is reproducible.
+    std::mt19937_64 oGenerator(0);
+    m_anBlocks.reserve(static_cast<size_t>(nBlocks));
+    const GIntBig nStratumSize = m_nTotalBlocks / nBlocks;
+    const GIntBig nLargerStrata = m_nTotalBlocks % nBlocks;
+    GIntBig nStart = 0;
+    for (GIntBig i = 0; i < nBlocks; ++i)
+    {
+        // The first nLargerStrata strata have one more block.
+        const GIntBig nEnd =
+            nStart + nStratumSize + (i < nLargerStrata ? 1 : 0);
+        // std::uniform_int_distribution is implementation-defined, so
+        // reduce the output of the generator ourselves, to select the same
+        // blocks with all standard libraries. The modulo bias is negligible
+        // for strata much smaller than 2^64.
+        const auto nStratumBlocks = static_cast<GUIntBig>(nEnd - nStart);
+        m_anBlocks.push_back(
+            nStart + static_cast<GIntBig>(oGenerator() % nStratumBlocks));
+        nStart = nEnd;
+    }
+    // Not used to select blocks any longer, only to tell that a subset is
+    // read.
+    m_nSampleRate = static_cast<int>(std::min<GIntBig>(
+        INT_MAX, std::max<GIntBig>(2, m_nTotalBlocks / nBlocks)));
+}
+
+/************************************************************************/
+/*                       GetMeanStandardError()                         */
+/************************************************************************/
+
+// Estimate the standard error of the mean of the valid values of the
+// sampled blocks, considered as a cluster sample (ratio estimator).
+bool GDALStatisticsBlockSampler::GetMeanStandardError(double &dfStdErr) const
+{
+    const size_t nBlocks = m_asBlockSums.size();
+    if (nBlocks < 2)
+        return false;
+    GUIntBig nValidCount = 0;
+    double dfSum = 0;
+    for (const auto &[nBlockValidCount, dfBlockSum] : m_asBlockSums)
+    {
+        nValidCount += nBlockValidCount;
+        dfSum += dfBlockSum;
+    }
+    if (nValidCount == 0)
+        return false;
+    const double dfMean = dfSum / static_cast<double>(nValidCount);
+    double dfSumSquares = 0;
+    for (const auto &[nBlockValidCount, dfBlockSum] : m_asBlockSums)
+    {
+        const double dfResidual =
+            dfBlockSum - dfMean * static_cast<double>(nBlockValidCount);
+        dfSumSquares += dfResidual * dfResidual;
+    }
+    const double dfAvgValidCount =
+        static_cast<double>(nValidCount) / static_cast<double>(nBlocks);
+    const double dfFiniteCorrection =
+        1.0 -
+        static_cast<double>(nBlocks) / static_cast<double>(m_nTotalBlocks);
+    dfStdErr = sqrt(dfFiniteCorrection * dfSumSquares /
+                    (static_cast<double>(nBlocks) * (nBlocks - 1))) /
+               dfAvgValidCount;
+    return true;
+}
+
+/************************************************************************/
+/*                        SetSamplingMetadata()                         */
+/************************************************************************/
+
+void SetSamplingMetadata(GDALRasterBand *poBand,
+                         const GDALStatisticsBlockSampler &oSampler)
+{
+    double dfStdErr = 0;
+    if (oSampler.GetMeanStandardError(dfStdErr))
+    {
+        char szValue[128] = {0};
+        CPLsnprintf(szValue, sizeof(szValue), "%.14g", dfStdErr);
+        poBand->SetMetadataItem("STATISTICS_MEAN_STDERR", szValue);
+    }
+    else if (poBand->GetMetadataItem("STATISTICS_MEAN_STDERR"))
+    {
+        poBand->SetMetadataItem("STATISTICS_MEAN_STDERR", nullptr);
+    }
+}
+
+}  // namespace
+
 /************************************************************************/
 /*                         ComputeStatistics()                          */
 /************************************************************************/
@@ -6509,6 +7259,23 @@ void GDALRasterBand::SetValidPercent(GUIntBig nSampleCount,
  *
  * Cached statistics can be cleared with GDALDataset::ClearStatistics().
  *
+ * Starting with GDAL 3.12, when all blocks are read, they are processed by
+ * the global thread pool if the GDAL_NUM_THREADS configuration option is set
+ * to a value greater than 1 (or ALL_CPUS). The mean and standard deviation
+ * may then differ in the last digits from the ones computed by a single
+ * thread, but do not depend on the number of threads.
+ *
+ * When bApproxOK is set and the band has no overviews, one block out of
+ * a number of blocks that grows with the square root of the number of blocks
+ * is read. Starting with GDAL 3.12, if the GDAL_STATS_APPROX_SAMPLING
+ * configuration option is set to BLOCKS, a random subset of blocks, whose
+ * uncompressed size is bounded by the GDAL_STATS_APPROX_MAX_BYTES
+ * configuration option (64MB by default), is read instead, one in each
+ * stratum of consecutive blocks. The standard error of the estimated mean is
+ * then stored in the STATISTICS_MEAN_STDERR metadata item: the mean of the
+ * whole band is within 1.96 times this value of the computed one with a 95%
+ * confidence.
+ *
  * This method is the same as the C function GDALComputeRasterStatistics().
  *
  * @param bApproxOK If TRUE statistics may be computed based on overviews
@@ -6559,6 +7326,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 if (pdfMin && pdfMax && pdfMean && pdfStdDev)
                 {
                     SetMetadataItem("STATISTICS_APPROXIMATE", "YES");
+                    SetSamplingMetadata(this, GDALStatisticsBlockSampler());
                     SetStatistics(*pdfMin, *pdfMax, *pdfMean, *pdfStdDev);
                 }
 
@@ -6624,6 +7392,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
 
     GUIntBig nSampleCount = 0;
     GUIntBig nValidCount = 0;
+    GDALStatisticsBlockSampler oSampler;
 
     if (bApproxOK && HasArbitraryOverviews())
     {
@@ -6745,6 +7514,16 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             if (nSampleRate == nBlocksPerRow && nBlocksPerRow > 1)
                 nSampleRate += 1;
         }
+        oSampler = GDALStatisticsBlockSampler(
+            static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn,
+            nSampleRate);
+        if (bApproxOK)
+        {
+            oSampler.InitRandomSampling(
+                static_cast<GIntBig>(nBlockXSize) * nBlockYSize *
+                GDALGetDataTypeSizeBytes(eDataType));
+            nSampleRate = oSampler.GetSampleRate();
+        }
         if (nSampleRate == 1)
             bApproxOK = false;
 
@@ -6754,14 +7533,12 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         // can fit on a uint64. Should be 99.99999% of cases.
         // For GUInt16, this limits to raster of 4 giga pixels
         if ((!poMaskBand && eDataType == GDT_Byte && !bSignedByte &&
-             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
-                     nSampleRate <
+             static_cast<GUIntBig>(oSampler.GetCount()) <
                  GUINTBIG_MAX / (255U * 255U) /
                      (static_cast<GUInt64>(nBlockXSize) *
                       static_cast<GUInt64>(nBlockYSize))) ||
             (eDataType == GDT_UInt16 &&
-             static_cast<GUIntBig>(nBlocksPerRow) * nBlocksPerColumn /
-                     nSampleRate <
+             static_cast<GUIntBig>(oSampler.GetCount()) <
                  GUINTBIG_MAX / (65535U * 65535U) /
                      (static_cast<GUInt64>(nBlockXSize) *
                       static_cast<GUInt64>(nBlockYSize))))
@@ -6782,55 +7559,126 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                     ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
                     : nMaxValueType + 1;
 
-            for (GIntBig iSampleBlock = 0;
-                 iSampleBlock <
-                 static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-                 iSampleBlock += nSampleRate)
+            GDALParallelBlockVisitor oVisitor(this, nullptr, nSampleRate);
+            if (oVisitor.IsEnabled())
             {
-                const int iYBlock =
-                    static_cast<int>(iSampleBlock / nBlocksPerRow);
-                const int iXBlock =
-                    static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-                GDALRasterBlock *const poBlock =
-                    GetLockedBlockRef(iXBlock, iYBlock);
-                if (poBlock == nullptr)
+                // Integer sums do not depend on the order of accumulation,
+                // so they can be kept per worker.
+                struct Accumulator
+                {
+                    GUInt32 nMin = 0;
+                    GUInt32 nMax = 0;
+                    GUIntBig nSum = 0;
+                    GUIntBig nSumSquare = 0;
+                    GUIntBig nSampleCount = 0;
+                    GUIntBig nValidCount = 0;
+                };
+
+                std::vector<Accumulator> asAccumulators(
+                    oVisitor.GetWorkerSlotCount());
+                for (auto &sAcc : asAccumulators)
+                    sAcc.nMin = nMaxValueType;
+                const auto ProcessBlock =
+                    [this, nMaxValueType, nNoDataValue,
+                     &asAccumulators](int, int iSlot, const void *pData,
+                                      const GByte *, int nXCheck, int nYCheck,
+                                      int nLineStride)
+                {
+                    auto &sAcc = asAccumulators[iSlot];
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nLineStride, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              sAcc.nMin, sAcc.nMax, sAcc.nSum, sAcc.nSumSquare,
+                              sAcc.nSampleCount, sAcc.nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nLineStride, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              sAcc.nMin, sAcc.nMax, sAcc.nSum, sAcc.nSumSquare,
+                              sAcc.nSampleCount, sAcc.nValidCount);
+                    }
+                };
+                if (!oVisitor.Run(ProcessBlock, nullptr, "Compute Statistics",
+                                  pfnProgress, pProgressData))
+                {
                     return CE_Failure;
+                }
 
-                void *const pData = poBlock->GetDataRef();
-
-                int nXCheck = 0, nYCheck = 0;
-                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-                if (eDataType == GDT_Byte)
+                for (const auto &sAcc : asAccumulators)
                 {
-                    ComputeStatisticsInternal<
-                        GByte, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GByte *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                    nMin = std::min(nMin, sAcc.nMin);
+                    nMax = std::max(nMax, sAcc.nMax);
+                    nSum += sAcc.nSum;
+                    nSumSquare += sAcc.nSumSquare;
+                    nSampleCount += sAcc.nSampleCount;
+                    nValidCount += sAcc.nValidCount;
                 }
-                else
+            }
+            else
+            {
+                const GIntBig nSampleBlocks = oSampler.GetCount();
+                for (GIntBig i = 0; i < nSampleBlocks; ++i)
                 {
-                    ComputeStatisticsInternal<
-                        GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
-                        f(nXCheck, nBlockXSize, nYCheck,
-                          static_cast<const GUInt16 *>(pData),
-                          nNoDataValue <= nMaxValueType, nNoDataValue, nMin,
-                          nMax, nSum, nSumSquare, nSampleCount, nValidCount);
-                }
+                    const GIntBig iSampleBlock = oSampler.GetBlock(i);
+                    const int iYBlock =
+                        static_cast<int>(iSampleBlock / nBlocksPerRow);
+                    const int iXBlock =
+                        static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-                poBlock->DropLock();
+                    GDALRasterBlock *const poBlock =
+                        GetLockedBlockRef(iXBlock, iYBlock);
+                    if (poBlock == nullptr)
+                        return CE_Failure;
 
-                if (!pfnProgress(static_cast<double>(iSampleBlock) /
-                                     (static_cast<double>(nBlocksPerRow) *
-                                      nBlocksPerColumn),
-                                 "Compute Statistics", pProgressData))
-                {
-                    ReportError(CE_Failure, CPLE_UserInterrupt,
-                                "User terminated");
-                    return CE_Failure;
+                    void *const pData = poBlock->GetDataRef();
+
+                    int nXCheck = 0, nYCheck = 0;
+                    GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
+
+                    const GUIntBig nSumBefore = nSum;
+                    const GUIntBig nValidCountBefore = nValidCount;
+                    if (eDataType == GDT_Byte)
+                    {
+                        ComputeStatisticsInternal<
+                            GByte, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GByte *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
+                    else
+                    {
+                        ComputeStatisticsInternal<
+                            GUInt16, /* COMPUTE_OTHER_STATS = */ true>::
+                            f(nXCheck, nBlockXSize, nYCheck,
+                              static_cast<const GUInt16 *>(pData),
+                              nNoDataValue <= nMaxValueType, nNoDataValue,
+                              nMin, nMax, nSum, nSumSquare, nSampleCount,
+                              nValidCount);
+                    }
+                    oSampler.AddBlockSum(
+                        nValidCount - nValidCountBefore,
+                        static_cast<double>(nSum - nSumBefore));
+
+                    poBlock->DropLock();
+
+                    if (!pfnProgress(static_cast<double>(i) /
+                                         static_cast<double>(nSampleBlocks),
+                                     "Compute Statistics", pProgressData))
+                    {
+                        ReportError(CE_Failure, CPLE_UserInterrupt,
+                                    "User terminated");
+                        return CE_Failure;
+                    }
                 }
             }
 
@@ -6869,6 +7717,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
                 {
                     SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
                 }
+                SetSamplingMetadata(this, oSampler);
                 SetStatistics(nMin, nMax, dfMean, dfStdDev);
             }
 
@@ -6899,100 +7748,140 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
             return CE_Failure;
         }
 
-        GByte *pabyMaskData = nullptr;
-        if (poMaskBand)
+        GDALParallelBlockVisitor oVisitor(this, poMaskBand, nSampleRate);
+        if (oVisitor.IsEnabled())
         {
-            pabyMaskData = static_cast<GByte *>(
-                VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
-            if (!pabyMaskData)
+            // Floating-point moments depend on the order of accumulation, so
+            // they are computed per block, and merged in raster order with
+            // the parallel variant of Welford algorithm.
+            struct BlockStatistics
+            {
+                double dfMin = 0;
+                double dfMax = 0;
+                double dfMean = 0;
+                double dfM2 = 0;
+                GUIntBig nSampleCount = 0;
+                GUIntBig nValidCount = 0;
+            };
+
+            std::vector<BlockStatistics> asBlockStats(
+                oVisitor.GetBlockSlotCount());
+            const auto ProcessBlock =
+                [this, bSignedByte, &sNoDataValues,
+                 &asBlockStats](int iBlockSlot, int, const void *pData,
+                                const GByte *pabyMaskData, int nXCheck,
+                                int nYCheck, int nLineStride)
+            {
+                auto &sStats = asBlockStats[iBlockSlot];
+                sStats.dfMin = std::numeric_limits<double>::infinity();
+                sStats.dfMax = -std::numeric_limits<double>::infinity();
+                sStats.dfMean = 0;
+                sStats.dfM2 = 0;
+                sStats.nValidCount = 0;
+                sStats.nSampleCount = static_cast<GUIntBig>(nXCheck) * nYCheck;
+                double dfSumUnused = 0;
+                ComputeBlockStatistics(pData, pabyMaskData, nXCheck, nYCheck,
+                                       nLineStride, eDataType, bSignedByte,
+                                       sNoDataValues, sStats.dfMin,
+                                       sStats.dfMax, sStats.dfMean, sStats.dfM2,
+                                       dfSumUnused, sStats.nValidCount);
+            };
+            const auto MergeBlock = [&asBlockStats, &dfMin, &dfMax, &dfMean,
+                                     &dfM2, &nSampleCount,
+                                     &nValidCount](int iBlockSlot)
+            {
+                const auto &sStats = asBlockStats[iBlockSlot];
+                nSampleCount += sStats.nSampleCount;
+                if (sStats.nValidCount == 0)
+                    return;
+                dfMin = std::min(dfMin, sStats.dfMin);
+                dfMax = std::max(dfMax, sStats.dfMax);
+                const double dfNewCount =
+                    static_cast<double>(nValidCount + sStats.nValidCount);
+                const double dfDelta = sStats.dfMean - dfMean;
+                const double dfBlockWeight = sStats.nValidCount / dfNewCount;
+                dfMean += dfDelta * dfBlockWeight;
+                dfM2 += sStats.dfM2 +
+                        dfDelta * dfDelta * nValidCount * dfBlockWeight;
+                nValidCount += sStats.nValidCount;
+            };
+            if (!oVisitor.Run(ProcessBlock, MergeBlock, "Compute Statistics",
+                              pfnProgress, pProgressData))
             {
                 return CE_Failure;
             }
         }
-
-        for (GIntBig iSampleBlock = 0;
-             iSampleBlock <
-             static_cast<GIntBig>(nBlocksPerRow) * nBlocksPerColumn;
-             iSampleBlock += nSampleRate)
+        else
         {
-            const int iYBlock = static_cast<int>(iSampleBlock / nBlocksPerRow);
-            const int iXBlock = static_cast<int>(iSampleBlock % nBlocksPerRow);
-
-            int nXCheck = 0, nYCheck = 0;
-            GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
-
-            if (poMaskBand &&
-                poMaskBand->RasterIO(GF_Read, iXBlock * nBlockXSize,
-                                     iYBlock * nBlockYSize, nXCheck, nYCheck,
-                                     pabyMaskData, nXCheck, nYCheck, GDT_Byte,
-                                     0, nBlockXSize, nullptr) != CE_None)
+            GByte *pabyMaskData = nullptr;
+            if (poMaskBand)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
+                pabyMaskData = static_cast<GByte *>(
+                    VSI_MALLOC2_VERBOSE(nBlockXSize, nBlockYSize));
+                if (!pabyMaskData)
+                {
+                    return CE_Failure;
+                }
             }
 
-            GDALRasterBlock *const poBlock =
-                GetLockedBlockRef(iXBlock, iYBlock);
-            if (poBlock == nullptr)
+            const GIntBig nSampleBlocks = oSampler.GetCount();
+            for (GIntBig i = 0; i < nSampleBlocks; ++i)
             {
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+                const GIntBig iSampleBlock = oSampler.GetBlock(i);
+                const int iYBlock =
+                    static_cast<int>(iSampleBlock / nBlocksPerRow);
+                const int iXBlock =
+                    static_cast<int>(iSampleBlock % nBlocksPerRow);
 
-            void *const pData = poBlock->GetDataRef();
+                int nXCheck = 0, nYCheck = 0;
+                GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-            // This isn't the fastest way to do this, but is easier for now.
-            for (int iY = 0; iY < nYCheck; iY++)
-            {
-                for (int iX = 0; iX < nXCheck; iX++)
+                if (poMaskBand &&
+                    poMaskBand->RasterIO(
+                        GF_Read, iXBlock * nBlockXSize, iYBlock * nBlockYSize,
+                        nXCheck, nYCheck, pabyMaskData, nXCheck, nYCheck,
+                        GDT_Byte, 0, nBlockXSize, nullptr) != CE_None)
                 {
-                    const GPtrDiff_t iOffset =
-                        iX + static_cast<GPtrDiff_t>(iY) * nBlockXSize;
-                    if (pabyMaskData && pabyMaskData[iOffset] == 0)
-                        continue;
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    bool bValid = true;
-                    double dfValue =
-                        GetPixelValue(eDataType, bSignedByte, pData, iOffset,
-                                      sNoDataValues, bValid);
+                GDALRasterBlock *const poBlock =
+                    GetLockedBlockRef(iXBlock, iYBlock);
+                if (poBlock == nullptr)
+                {
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
+                }
 
-                    if (!bValid)
-                        continue;
+                // The sum of the block is accumulated directly, as deriving
+                // it from the running mean would cancel catastrophically.
+                const GUIntBig nValidCountBefore = nValidCount;
+                double dfBlockSum = 0;
+                ComputeBlockStatistics(poBlock->GetDataRef(), pabyMaskData,
+                                       nXCheck, nYCheck, nBlockXSize, eDataType,
+                                       bSignedByte, sNoDataValues, dfMin, dfMax,
+                                       dfMean, dfM2, dfBlockSum, nValidCount);
+                oSampler.AddBlockSum(nValidCount - nValidCountBefore,
+                                     dfBlockSum);
 
-                    dfMin = std::min(dfMin, dfValue);
-                    dfMax = std::max(dfMax, dfValue);
+                nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
 
-                    nValidCount++;
-                    if (dfMin == dfMax)
-                    {
-                        if (nValidCount == 1)
-                            dfMean = dfMin;
-                    }
-                    else
-                    {
-                        const double dfDelta = dfValue - dfMean;
-                        dfMean += dfDelta / nValidCount;
-                        dfM2 += dfDelta * (dfValue - dfMean);
-                    }
+                poBlock->DropLock();
+
+                if (!pfnProgress(static_cast<double>(i) /
+                                     static_cast<double>(nSampleBlocks),
+                                 "Compute Statistics", pProgressData))
+                {
+                    ReportError(CE_Failure, CPLE_UserInterrupt,
+                                "User terminated");
+                    CPLFree(pabyMaskData);
+                    return CE_Failure;
                 }
             }
 
-            nSampleCount += static_cast<GUIntBig>(nXCheck) * nYCheck;
-
-            poBlock->DropLock();
-
-            if (!pfnProgress(
-                    static_cast<double>(iSampleBlock) /
-                        (static_cast<double>(nBlocksPerRow) * nBlocksPerColumn),
-                    "Compute Statistics", pProgressData))
-            {
-                ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
-                CPLFree(pabyMaskData);
-                return CE_Failure;
-            }
+            CPLFree(pabyMaskData);
         }
-
-        CPLFree(pabyMaskData);
     }
 
     if (!pfnProgress(1.0, "Compute Statistics", pProgressData))
@@ -7016,6 +7905,7 @@ CPLErr GDALRasterBand::ComputeStatistics(int bApproxOK, double *pdfMin,
         {
             SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
         }
+        SetSamplingMetadata(this, oSampler);
         SetStatistics(dfMin, dfMax, dfMean, dfStdDev);
     }
     else
@@ -7075,6 +7965,309 @@ CPLErr CPL_STDCALL GDALComputeRasterStatistics(GDALRasterBandH hBand,
                                      pdfStdDev, pfnProgress, pProgressData);
 }
 
+/************************************************************************/
+/*                    ComputeStatisticsSinglePass()                     */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+
+// Compute the exact statistics of bands of a same dataset sharing the same
+// data type and block size, reading each chunk of the dataset only once.
+// Used by GDALDataset::ComputeStatistics(). Results are the same as the ones
+// of ComputeStatistics(), apart from rounding in the mean and standard
+// deviation of bands processed with the Welford algorithm, as pixels are
+// visited in a different order.
+
+CPLErr GDALRasterBand::ComputeStatisticsSinglePass(
+    GDALDataset *poDS, int nBandCount, const int *panBandList,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    if (!pfnProgress(0.0, "Compute Statistics", pProgressData))
+    {
+        poDS->ReportError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+        return CE_Failure;
+    }
+
+    struct BandStatistics
+    {
+        GDALRasterBand *poBand;
+        GDALNoDataValues sNoDataValues;
+        bool bSignedByte = false;
+        GDALRasterBand *poMaskBand = nullptr;
+        int iMaskBuffer = -1;
+
+        // Integer sums, for Byte and UInt16, as in ComputeStatistics()
+        bool bIntegerSums = false;
+        GUInt32 nMaxValueType = 0;
+        GUInt32 nNoDataValue = 0;
+        GUInt32 nMin = 0;
+        GUInt32 nMax = 0;
+        GUIntBig nSum = 0;
+        GUIntBig nSumSquare = 0;
+
+        // Welford algorithm otherwise
+        double dfMin = std::numeric_limits<double>::infinity();
+        double dfMax = -std::numeric_limits<double>::infinity();
+        double dfMean = 0;
+        double dfM2 = 0;
+
+        GUIntBig nSampleCount = 0;
+        GUIntBig nValidCount = 0;
+
+        explicit BandStatistics(GDALRasterBand *poBandIn)
+            : poBand(poBandIn),
+              sNoDataValues(poBandIn, poBandIn->GetRasterDataType())
+        {
+        }
+    };
+
+    GDALRasterBand *poFirstBand = poDS->GetRasterBand(panBandList[0]);
+    const GDALDataType eDT = poFirstBand->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const int nXSize = poDS->GetRasterXSize();
+    const int nYSize = poDS->GetRasterYSize();
+    const GUIntBig nPixels = static_cast<GUIntBig>(nXSize) * nYSize;
+
+    std::vector<BandStatistics> asStats;
+    std::vector<GDALRasterBand *> apoMaskBands;
+    asStats.reserve(nBandCount);
+    for (int i = 0; i < nBandCount; ++i)
+    {
+        asStats.emplace_back(poDS->GetRasterBand(panBandList[i]));
+        auto &sStats = asStats.back();
+        GDALRasterBand *poBand = sStats.poBand;
+
+        if (!sStats.sNoDataValues.bGotNoDataValue)
+        {
+            const int l_nMaskFlags = poBand->GetMaskFlags();
+            if (l_nMaskFlags != GMF_ALL_VALID &&
+                poBand->GetColorInterpretation() != GCI_AlphaBand)
+            {
+                sStats.poMaskBand = poBand->GetMaskBand();
+            }
+        }
+
+        if (eDT == GDT_Byte)
+        {
+            poBand->EnablePixelTypeSignedByteWarning(false);
+            const char *pszPixelType =
+                poBand->GetMetadataItem("PIXELTYPE", "IMAGE_STRUCTURE");
+            poBand->EnablePixelTypeSignedByteWarning(true);
+            sStats.bSignedByte =
+                pszPixelType != nullptr && EQUAL(pszPixelType, "SIGNEDBYTE");
+        }
+
+        sStats.bIntegerSums =
+            (!sStats.poMaskBand && eDT == GDT_Byte && !sStats.bSignedByte &&
+             nPixels < GUINTBIG_MAX / (255U * 255U)) ||
+            (eDT == GDT_UInt16 && nPixels < GUINTBIG_MAX / (65535U * 65535U));
+        if (sStats.bIntegerSums)
+        {
+            const auto &sNoDataValues = sStats.sNoDataValues;
+            sStats.nMaxValueType = (eDT == GDT_Byte) ? 255 : 65535;
+            sStats.nMin = sStats.nMaxValueType;
+            // If no valid nodata, map to invalid value (256 for Byte)
+            sStats.nNoDataValue =
+                (sNoDataValues.bGotNoDataValue &&
+                 sNoDataValues.dfNoDataValue >= 0 &&
+                 sNoDataValues.dfNoDataValue <= sStats.nMaxValueType &&
+                 fabs(sNoDataValues.dfNoDataValue -
+                      static_cast<GUInt32>(sNoDataValues.dfNoDataValue +
+                                           1e-10)) < 1e-10)
+                    ? static_cast<GUInt32>(sNoDataValues.dfNoDataValue + 1e-10)
+                    : sStats.nMaxValueType + 1;
+        }
+        else if (sStats.poMaskBand)
+        {
+            // Bands sharing a per-dataset mask only read it once.
+            const auto oIter = std::find(apoMaskBands.begin(),
+                                         apoMaskBands.end(), sStats.poMaskBand);
+            sStats.iMaskBuffer =
+                static_cast<int>(oIter - apoMaskBands.begin());
+            if (oIter == apoMaskBands.end())
+                apoMaskBands.push_back(sStats.poMaskBand);
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Read chunks of whole rows of blocks if possible, limited to     */
+    /*      about 64 MB.                                                    */
+    /* -------------------------------------------------------------------- */
+    int nBlockXSize = 0;
+    int nBlockYSize = 0;
+    poFirstBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+    constexpr GIntBig MAX_CHUNK_BYTES = 64 * 1024 * 1024;
+    const GIntBig nBytesPerPixel =
+        static_cast<GIntBig>(nDTSize) * nBandCount +
+        static_cast<GIntBig>(apoMaskBands.size());
+    int nChunkXSize = nXSize;
+    int nChunkYSize = std::min(nBlockYSize, nYSize);
+    const GIntBig nBlockColumnBytes =
+        static_cast<GIntBig>(nBlockXSize) * nChunkYSize * nBytesPerPixel;
+    if (nBlockColumnBytes <= MAX_CHUNK_BYTES)
+    {
+        const GIntBig nBlocksPerChunk = MAX_CHUNK_BYTES / nBlockColumnBytes;
+        nChunkXSize = static_cast<int>(
+            std::min<GIntBig>(nXSize, nBlocksPerChunk * nBlockXSize));
+    }
+    else
+    {
+        nChunkYSize = static_cast<int>(std::max<GIntBig>(
+            1, std::min<GIntBig>(nChunkYSize,
+                                 MAX_CHUNK_BYTES / (nXSize * nBytesPerPixel))));
+    }
+
+    const size_t nChunkPixels = static_cast<size_t>(nChunkXSize) * nChunkYSize;
+    std::unique_ptr<GByte, VSIFreeReleaser> pabyData(static_cast<GByte *>(
+        VSI_MALLOC3_VERBOSE(nChunkPixels, nDTSize, nBandCount)));
+    std::unique_ptr<GByte, VSIFreeReleaser> pabyMaskData;
+    if (!apoMaskBands.empty())
+    {
+        pabyMaskData.reset(static_cast<GByte *>(
+            VSI_MALLOC2_VERBOSE(nChunkPixels, apoMaskBands.size())));
+    }
+    if (!pabyData || (!apoMaskBands.empty() && !pabyMaskData))
+        return CE_Failure;
+
+    /* -------------------------------------------------------------------- */
+    /*      Read each chunk once, and update the statistics of all bands.   */
+    /* -------------------------------------------------------------------- */
+    const int nChunksPerRow = DIV_ROUND_UP(nXSize, nChunkXSize);
+    const GIntBig nChunks =
+        static_cast<GIntBig>(nChunksPerRow) * DIV_ROUND_UP(nYSize, nChunkYSize);
+    for (GIntBig iChunk = 0; iChunk < nChunks; ++iChunk)
+    {
+        const int nXOff =
+            static_cast<int>(iChunk % nChunksPerRow) * nChunkXSize;
+        const int nYOff =
+            static_cast<int>(iChunk / nChunksPerRow) * nChunkYSize;
+        const int nReqXSize = std::min(nChunkXSize, nXSize - nXOff);
+        const int nReqYSize = std::min(nChunkYSize, nYSize - nYOff);
+        const size_t nReqPixels = static_cast<size_t>(nReqXSize) * nReqYSize;
+
+        if (poDS->RasterIO(GF_Read, nXOff, nYOff, nReqXSize, nReqYSize,
+                           pabyData.get(), nReqXSize, nReqYSize, eDT,
+                           nBandCount, panBandList, nDTSize,
+                           static_cast<GSpacing>(nDTSize) * nReqXSize,
+                           static_cast<GSpacing>(nDTSize) * nReqPixels,
+                           nullptr) != CE_None)
+        {
+            return CE_Failure;
+        }
+        for (size_t i = 0; i < apoMaskBands.size(); ++i)
+        {
+            if (apoMaskBands[i]->RasterIO(
+                    GF_Read, nXOff, nYOff, nReqXSize, nReqYSize,
+                    pabyMaskData.get() + i * nReqPixels, nReqXSize, nReqYSize,
+                    GDT_Byte, 0, 0, nullptr) != CE_None)
+            {
+                return CE_Failure;
+            }
+        }
+
+        for (int i = 0; i < nBandCount; ++i)
+        {
+            auto &sStats = asStats[i];
+            const GByte *pabyBandData =
+                pabyData.get() + static_cast<size_t>(i) * nDTSize * nReqPixels;
+            if (sStats.bIntegerSums && eDT == GDT_Byte)
+            {
+                ComputeStatisticsInternal<GByte,
+                                          /* COMPUTE_OTHER_STATS = */ true>::
+                    f(nReqXSize, nReqXSize, nReqYSize, pabyBandData,
+                      sStats.nNoDataValue <= sStats.nMaxValueType,
+                      sStats.nNoDataValue, sStats.nMin, sStats.nMax,
+                      sStats.nSum, sStats.nSumSquare, sStats.nSampleCount,
+                      sStats.nValidCount);
+            }
+            else if (sStats.bIntegerSums)
+            {
+                ComputeStatisticsInternal<GUInt16,
+                                          /* COMPUTE_OTHER_STATS = */ true>::
+                    f(nReqXSize, nReqXSize, nReqYSize,
+                      reinterpret_cast<const GUInt16 *>(pabyBandData),
+                      sStats.nNoDataValue <= sStats.nMaxValueType,
+                      sStats.nNoDataValue, sStats.nMin, sStats.nMax,
+                      sStats.nSum, sStats.nSumSquare, sStats.nSampleCount,
+                      sStats.nValidCount);
+            }
+            else
+            {
+                double dfSumUnused = 0;
+                ComputeBlockStatistics(
+                    pabyBandData,
+                    sStats.iMaskBuffer >= 0
+                        ? pabyMaskData.get() + sStats.iMaskBuffer * nReqPixels
+                        : nullptr,
+                    nReqXSize, nReqYSize, nReqXSize, eDT, sStats.bSignedByte,
+                    sStats.sNoDataValues, sStats.dfMin, sStats.dfMax,
+                    sStats.dfMean, sStats.dfM2, dfSumUnused,
+                    sStats.nValidCount);
+                sStats.nSampleCount += nReqPixels;
+            }
+        }
+
+        if (!pfnProgress(static_cast<double>(iChunk + 1) / nChunks,
+                         "Compute Statistics", pProgressData))
+        {
+            poDS->ReportError(CE_Failure, CPLE_UserInterrupt,
+                              "User terminated");
+            return CE_Failure;
+        }
+    }
+
+    /* -------------------------------------------------------------------- */
+    /*      Save computed information.                                      */
+    /* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+    for (auto &sStats : asStats)
+    {
+        GDALRasterBand *poBand = sStats.poBand;
+        const GUIntBig nValidCount = sStats.nValidCount;
+        double dfStdDev = 0;
+        if (sStats.bIntegerSums && nValidCount > 0)
+        {
+            sStats.dfMin = sStats.nMin;
+            sStats.dfMax = sStats.nMax;
+            sStats.dfMean = static_cast<double>(sStats.nSum) / nValidCount;
+            // To avoid potential precision issues when doing the difference,
+            // we need to do that computation on 128 bit rather than casting
+            // to double
+            const GDALUInt128 nTmpForStdDev(
+                GDALUInt128::Mul(sStats.nSumSquare, nValidCount) -
+                GDALUInt128::Mul(sStats.nSum, sStats.nSum));
+            dfStdDev = sqrt(static_cast<double>(nTmpForStdDev)) / nValidCount;
+        }
+        else if (nValidCount > 0)
+        {
+            dfStdDev = sqrt(sStats.dfM2 / nValidCount);
+        }
+
+        if (nValidCount > 0)
+        {
+            if (poBand->GetMetadataItem("STATISTICS_APPROXIMATE"))
+                poBand->SetMetadataItem("STATISTICS_APPROXIMATE", nullptr);
+            if (poBand->GetMetadataItem("STATISTICS_MEAN_STDERR"))
+                poBand->SetMetadataItem("STATISTICS_MEAN_STDERR", nullptr);
+            poBand->SetStatistics(sStats.dfMin, sStats.dfMax, sStats.dfMean,
+                                  dfStdDev);
+        }
+        else
+        {
+            poBand->ReportError(CE_Failure, CPLE_AppDefined,
+                                "Failed to compute statistics, no valid "
+                                "pixels found in sampling.");
+            eErr = CE_Failure;
+        }
+
+        poBand->SetValidPercent(sStats.nSampleCount, nValidCount);
+    }
+
+    return eErr;
+}
+
+//! @endcond
+
 /************************************************************************/
 /*                           SetStatistics()                            */
 /************************************************************************/
@@ -7395,6 +8588,10 @@ static bool ComputeMinMaxGenericIterBlocks(
  * If bApprox is FALSE, then all pixels will be read and used to compute
  * an exact range.
  *
+ * Starting with GDAL 3.12, when all blocks are read, they are processed by
+ * the global thread pool if the GDAL_NUM_THREADS configuration option is set
+ * to a value greater than 1 (or ALL_CPUS).
+ *
  * This method is the same as the C function GDALComputeRasterMinMax().
  *
  * @param bApproxOK TRUE if an approximate (faster) answer is OK, otherwise
@@ -7485,9 +8682,10 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                         eDataType == GDT_Int16 || eDataType == GDT_UInt16);
 
     const auto ComputeMinMaxForBlock =
-        [this, bSignedByte, &sNoDataValues, &nMin, &nMax, &nMinInt16,
-         &nMaxInt16](const void *pData, int nXCheck, int nBufferWidth,
-                     int nYCheck)
+        [this, bSignedByte,
+         &sNoDataValues](const void *pData, int nXCheck, int nBufferWidth,
+                         int nYCheck, GUInt32 &nAccMin, GUInt32 &nAccMax,
+                         GInt16 &nAccMinInt16, GInt16 &nAccMaxInt16)
     {
         if (eDataType == GDT_Byte && !bSignedByte)
         {
@@ -7504,7 +8702,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GByte *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nAccMin, nAccMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_UInt16)
         {
@@ -7521,7 +8720,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                                       /* COMPUTE_OTHER_STATS = */ false>::
                 f(nXCheck, nBufferWidth, nYCheck,
                   static_cast<const GUInt16 *>(pData), bHasNoData, nNoDataValue,
-                  nMin, nMax, nSum, nSumSquare, nSampleCount, nValidCount);
+                  nAccMin, nAccMax, nSum, nSumSquare, nSampleCount,
+                  nValidCount);
         }
         else if (eDataType == GDT_Int16)
         {
@@ -7539,7 +8739,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, true>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, nNoDataValue, &nMinInt16, &nMaxInt16);
+                        nXCheck, nNoDataValue, &nAccMinInt16, &nAccMaxInt16);
                 }
             }
             else
@@ -7549,7 +8749,7 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                     ComputeMinMax<int16_t, false>(
                         static_cast<const int16_t *>(pData) +
                             static_cast<size_t>(iY) * nBufferWidth,
-                        nXCheck, 0, &nMinInt16, &nMaxInt16);
+                        nXCheck, 0, &nAccMinInt16, &nAccMaxInt16);
                 }
             }
         }
@@ -7615,7 +8815,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
 
         if (bUseOptimizedPath)
         {
-            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced);
+            ComputeMinMaxForBlock(pData, nXReduced, nXReduced, nYReduced, nMin,
+                                  nMax, nMinInt16, nMaxInt16);
         }
         else
         {
@@ -7653,7 +8854,57 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 nSampleRate += 1;
         }
 
-        if (bUseOptimizedPath)
+        GDALParallelBlockVisitor oVisitor(this, poMaskBand, nSampleRate);
+        if (oVisitor.IsEnabled())
+        {
+            // Extrema do not depend on the order of accumulation, so they
+            // can be kept per worker.
+            const int nWorkerSlots = oVisitor.GetWorkerSlotCount();
+            std::vector<GUInt32> anMin(nWorkerSlots, nMin);
+            std::vector<GUInt32> anMax(nWorkerSlots, nMax);
+            std::vector<GInt16> anMinInt16(nWorkerSlots, nMinInt16);
+            std::vector<GInt16> anMaxInt16(nWorkerSlots, nMaxInt16);
+            std::vector<double> adfMin(nWorkerSlots, dfMin);
+            std::vector<double> adfMax(nWorkerSlots, dfMax);
+            const auto ProcessBlock =
+                [this, bUseOptimizedPath, bSignedByte, &sNoDataValues,
+                 &ComputeMinMaxForBlock, &anMin, &anMax, &anMinInt16,
+                 &anMaxInt16, &adfMin,
+                 &adfMax](int, int iSlot, const void *pData,
+                          const GByte *pabyMaskData, int nXCheck, int nYCheck,
+                          int nLineStride)
+            {
+                if (bUseOptimizedPath)
+                {
+                    ComputeMinMaxForBlock(pData, nXCheck, nLineStride, nYCheck,
+                                          anMin[iSlot], anMax[iSlot],
+                                          anMinInt16[iSlot], anMaxInt16[iSlot]);
+                }
+                else
+                {
+                    ComputeMinMaxGeneric(pData, eDataType, bSignedByte, nXCheck,
+                                         nYCheck, nLineStride, sNoDataValues,
+                                         pabyMaskData, adfMin[iSlot],
+                                         adfMax[iSlot]);
+                }
+            };
+            if (!oVisitor.Run(ProcessBlock, nullptr, nullptr,
+                              GDALDummyProgress, nullptr))
+            {
+                return CE_Failure;
+            }
+
+            for (int iSlot = 0; iSlot < nWorkerSlots; ++iSlot)
+            {
+                nMin = std::min(nMin, anMin[iSlot]);
+                nMax = std::max(nMax, anMax[iSlot]);
+                nMinInt16 = std::min(nMinInt16, anMinInt16[iSlot]);
+                nMaxInt16 = std::max(nMaxInt16, anMaxInt16[iSlot]);
+                dfMin = std::min(dfMin, adfMin[iSlot]);
+                dfMax = std::max(dfMax, adfMax[iSlot]);
+            }
+        }
+        else if (bUseOptimizedPath)
         {
             for (GIntBig iSampleBlock = 0;
                  iSampleBlock <
@@ -7674,7 +8925,8 @@ CPLErr GDALRasterBand::ComputeRasterMinMax(int bApproxOK, double *adfMinMax)
                 int nXCheck = 0, nYCheck = 0;
                 GetActualBlockSize(iXBlock, iYBlock, &nXCheck, &nYCheck);
 
-                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck);
+                ComputeMinMaxForBlock(pData, nXCheck, nBlockXSize, nYCheck,
+                                      nMin, nMax, nMinInt16, nMaxInt16);
 
                 poBlock->DropLock();
 
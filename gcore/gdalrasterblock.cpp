@@ -17,37 +17,208 @@
 #include "gdal_priv.h"
 
 #include <algorithm>
+#include <atomic>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <list>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "cpl_atomic_ops.h"
+#include "cpl_compressor.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 
+#if defined(__linux__) && defined(HAVE_MMAP)
+#include <sys/mman.h>  // madvise
+#endif
+
 // Will later be overridden by the default 5% if GDAL_CACHEMAX not defined.
 static GIntBig nCacheMax = 40 * 1024 * 1024;
-static GIntBig nCacheUsed = 0;
+static std::atomic<GIntBig> nCacheUsed{0};
 
-static GDALRasterBlock *poOldest = nullptr;  // Tail.
-static GDALRasterBlock *poNewest = nullptr;  // Head.
+// Number of cached blocks, per GDALBlockCachePriority value.
+static std::atomic<GIntBig> anCachedBlocksPerPriority[GBCP_High + 1]{};
 
 static int nDisableDirtyBlockFlushCounter = 0;
 
-#if 0
-static CPLMutex *hRBLock = nullptr;
-#define INITIALIZE_LOCK CPLMutexHolderD(&hRBLock)
-#define TAKE_LOCK CPLMutexHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyMutex(hRBLock)
-#else
-
-static CPLLock *hRBLock = nullptr;
 static bool bDebugContention = false;
+// Whether cache hits are counted. Not done by default, as updating a shared
+// counter on each hit would defeat the lock-free hit path of Touch().
+static bool bCountHits = false;
 static bool bSleepsForBockCacheDebug = false;
 
+/************************************************************************/
+/*                         GDALRasterBlockShard                         */
+/************************************************************************/
+
+// The global block cache is split into shards, each one with its own lock
+// and its own eviction queues. A block is assigned to a shard from a hash of
+// its band and block coordinates, so that threads working on different blocks
+// rarely compete for the same lock. Memory usage (nCacheUsed) is accounted
+// globally, so GDAL_CACHEMAX is still honoured, but the eviction order is only
+// respected within a shard.
+//
+// Two eviction policies are available (GDAL_CACHE_POLICY):
+// - LRU: all blocks are in QUEUE_MAIN, ordered by last access.
+// - 2Q (Johnson & Shasha, 1994): newly read blocks enter QUEUE_PROBATION
+//   (A1in), a FIFO whose accesses do not reorder it. When a block is evicted
+//   from it, its key is remembered in a "ghost" list (A1out). Only blocks
+//   that are read again while their key is in the ghost list enter
+//   QUEUE_MAIN (Am), a LRU list. A single scan through a large dataset thus
+//   only recycles QUEUE_PROBATION, and does not evict the working set of
+//   other users of the cache.
+
+namespace
+{
+inline GUInt64 HashBlockKey(const GDALRasterBand *poBand, int nXOff, int nYOff)
+{
+    GUInt64 nHash =
+        static_cast<GUInt64>(reinterpret_cast<std::uintptr_t>(poBand));
+    nHash = nHash * 31 + static_cast<GUInt32>(nYOff);
+    nHash = nHash * 31 + static_cast<GUInt32>(nXOff);
+    return nHash * UINT64_C(0x9E3779B97F4A7C15);
+}
+
+enum class GDALRasterBlockCachePolicy
+{
+    LRU,
+    TWO_Q,
+    CLOCK,
+};
+
+constexpr int QUEUE_NONE = 0;
+constexpr int QUEUE_MAIN = 1;
+constexpr int QUEUE_PROBATION = 2;
+
+struct GDALRasterBlockQueue
+{
+    GDALRasterBlock *poOldest = nullptr;  // Tail.
+    GDALRasterBlock *poNewest = nullptr;  // Head.
+    GIntBig nBytes = 0;
+};
+
+struct GDALRasterBlockKey
+{
+    const GDALRasterBand *poBand;
+    int nXOff;
+    int nYOff;
+
+    bool operator==(const GDALRasterBlockKey &other) const
+    {
+        return poBand == other.poBand && nXOff == other.nXOff &&
+               nYOff == other.nYOff;
+    }
+};
+
+struct GDALRasterBlockKeyHasher
+{
+    size_t operator()(const GDALRasterBlockKey &oKey) const
+    {
+        const GUInt64 nHash =
+            HashBlockKey(oKey.poBand, oKey.nXOff, oKey.nYOff);
+        return static_cast<size_t>(nHash ^ (nHash >> 32));
+    }
+};
+
+// Keys of the blocks recently evicted from QUEUE_PROBATION (2Q policy),
+// oldest first.
+struct GDALRasterBlockGhostList
+{
+    std::list<GDALRasterBlockKey> oFIFO{};
+    std::unordered_map<
+        GDALRasterBlockKey,
+        std::pair<std::list<GDALRasterBlockKey>::iterator, GIntBig>,
+        GDALRasterBlockKeyHasher>
+        oMap{};
+    GIntBig nBytes = 0;
+};
+
+struct alignas(64) GDALRasterBlockShard
+{
+    CPLLock *hLock = nullptr;
+
+    // Indexed by QUEUE_MAIN and QUEUE_PROBATION.
+    GDALRasterBlockQueue aoQueues[3]{};
+
+    // Number of blocks in the queues, per GDALBlockCachePriority value.
+    GIntBig anBlocksPerPriority[GBCP_High + 1]{};
+
+    // Only allocated for the 2Q policy.
+    GDALRasterBlockGhostList *poGhosts = nullptr;
+
+    // Number of threads holding or waiting for hLock.
+    std::atomic<int> nHolders{0};
+
+    // Lock statistics, updated while holding hLock, and reported by
+    // GDALRasterBlock::DestroyRBMutex()
+    GUIntBig nAcquisitions = 0;
+    GUIntBig nContentions = 0;
+
+    // Eviction policy statistics, also reported by DestroyRBMutex().
+    // nHits is updated without holding hLock, the others while holding it.
+    std::atomic<GUIntBig> nHits{0};
+    GUIntBig nMisses = 0;
+    GUIntBig nEvictions = 0;
+    GUIntBig nGhostHits = 0;
+};
+
+/************************************************************************/
+/*                       GDALRasterBlockShardLock                       */
+/************************************************************************/
+
+// Scoped lock of a shard, that keeps track of lock contention.
+// Does nothing if the lock of the shard has not been created (or has been
+// destroyed), similarly to CPLLockHolderOptionalLockD.
+class GDALRasterBlockShardLock
+{
+    GDALRasterBlockShard &m_oShard;
+    CPLLock *const m_hLock;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterBlockShardLock)
+
+  public:
+    explicit GDALRasterBlockShardLock(GDALRasterBlockShard &oShard)
+        : m_oShard(oShard), m_hLock(oShard.hLock)
+    {
+        if (m_hLock)
+        {
+            const bool bContended =
+                m_oShard.nHolders.fetch_add(1, std::memory_order_relaxed) > 0;
+            CPLAcquireLock(m_hLock);
+            ++m_oShard.nAcquisitions;
+            if (bContended)
+                ++m_oShard.nContentions;
+        }
+    }
+
+    ~GDALRasterBlockShardLock()
+    {
+        if (m_hLock)
+        {
+            CPLReleaseLock(m_hLock);
+            m_oShard.nHolders.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+};
+
+}  // namespace
+
+constexpr int MAX_SHARD_COUNT = 64;
+static GDALRasterBlockShard asShards[MAX_SHARD_COUNT];
+// Power of two. Determined once, at first initialization.
+static int nShardCount = 0;
+static GDALRasterBlockCachePolicy eCachePolicy =
+    GDALRasterBlockCachePolicy::LRU;
+static std::atomic<bool> bShardsInitialized{false};
+
 static CPLLockType GetLockType()
 {
     static int nLockType = -1;
@@ -75,13 +246,748 @@ static CPLLockType GetLockType()
     return static_cast<CPLLockType>(nLockType);
 }
 
-#define INITIALIZE_LOCK                                                        \
-    CPLLockHolderD(&hRBLock, GetLockType());                                   \
-    CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK CPLLockHolderOptionalLockD(hRBLock)
-#define DESTROY_LOCK CPLDestroyLock(hRBLock)
+/************************************************************************/
+/*                          GetShardCount()                             */
+/************************************************************************/
+
+static int GetShardCount()
+{
+    const char *pszShards = CPLGetConfigOption("GDAL_RB_SHARDS", "AUTO");
+    int nShards;
+    if (EQUAL(pszShards, "AUTO"))
+    {
+        // A single lock scales well up to ~8 threads.
+        nShards = CPLGetNumCPUs() / 8;
+    }
+    else
+    {
+        nShards = atoi(pszShards);
+    }
+    nShards = std::clamp(nShards, 1, MAX_SHARD_COUNT);
+    // Round down to a power of two.
+    while ((nShards & (nShards - 1)) != 0)
+        nShards &= nShards - 1;
+    return nShards;
+}
+
+/************************************************************************/
+/*                          GetCachePolicy()                            */
+/************************************************************************/
+
+static GDALRasterBlockCachePolicy GetCachePolicy()
+{
+    const char *pszPolicy = CPLGetConfigOption("GDAL_CACHE_POLICY", "LRU");
+    if (EQUAL(pszPolicy, "LRU"))
+        return GDALRasterBlockCachePolicy::LRU;
+    if (EQUAL(pszPolicy, "2Q"))
+        return GDALRasterBlockCachePolicy::TWO_Q;
+    if (EQUAL(pszPolicy, "CLOCK"))
+        return GDALRasterBlockCachePolicy::CLOCK;
+    CPLError(CE_Warning, CPLE_NotSupported,
+             "GDAL_CACHE_POLICY=%s not supported. Falling back to LRU",
+             pszPolicy);
+    return GDALRasterBlockCachePolicy::LRU;
+}
+
+static const char *GetCachePolicyName()
+{
+    switch (eCachePolicy)
+    {
+        case GDALRasterBlockCachePolicy::LRU:
+            break;
+        case GDALRasterBlockCachePolicy::TWO_Q:
+            return "2Q";
+        case GDALRasterBlockCachePolicy::CLOCK:
+            return "CLOCK";
+    }
+    return "LRU";
+}
+
+/************************************************************************/
+/*                   GDALRasterBlockCompressedCache                     */
+/************************************************************************/
+
+// Optional second tier of the block cache (GDAL_CACHE_COMPRESSED_MAX). Clean
+// blocks of read-only datasets that are evicted by Internalize() are kept
+// compressed in RAM, so that GetLockedBlockRef() can restore them without
+// calling IReadBlock() again, which can be expensive for some codecs (JPEG,
+// WebP, LERC...) or for remote files. Entries are removed when the block is
+// marked dirty, when the cache of its band is dropped and when its band is
+// destroyed.
+
+namespace
+{
+struct GDALRasterBlockCompressedEntry
+{
+    std::list<GDALRasterBlockKey>::iterator oLRUIter{};
+    std::vector<GByte> abyData{};
+};
+
+struct GDALRasterBlockCompressedCache
+{
+    std::mutex oMutex{};
+    // Most recently used entries at the front.
+    std::list<GDALRasterBlockKey> oLRU{};
+    std::unordered_map<GDALRasterBlockKey, GDALRasterBlockCompressedEntry,
+                       GDALRasterBlockKeyHasher>
+        oMap{};
+    // Number of entries per band, to skip quickly bands without entries.
+    std::unordered_map<const GDALRasterBand *, int> oMapEntriesPerBand{};
+    GIntBig nBytes = 0;
+    GIntBig nMaxBytes = 0;
+    const CPLCompressor *psCompressor = nullptr;
+    const CPLCompressor *psDecompressor = nullptr;
+
+    GUIntBig nStored = 0;
+    GUIntBig nRejected = 0;
+    GUIntBig nHits = 0;
+
+    static GIntBig GetEntrySize(const GDALRasterBlockCompressedEntry &oEntry)
+    {
+        return static_cast<GIntBig>(oEntry.abyData.size() +
+                                    sizeof(GDALRasterBlockCompressedEntry) +
+                                    2 * sizeof(GDALRasterBlockKey));
+    }
 
+    void Remove_unlocked(decltype(oMap)::iterator oIter)
+    {
+        nBytes -= GetEntrySize(oIter->second);
+        auto oBandIter = oMapEntriesPerBand.find(oIter->first.poBand);
+        if (--oBandIter->second == 0)
+            oMapEntriesPerBand.erase(oBandIter);
+        oLRU.erase(oIter->second.oLRUIter);
+        oMap.erase(oIter);
+    }
+};
+}  // namespace
+
+static GDALRasterBlockCompressedCache *poCompressedCache = nullptr;
+
+/************************************************************************/
+/*                      CreateCompressedCache()                         */
+/************************************************************************/
+
+static GDALRasterBlockCompressedCache *CreateCompressedCache()
+{
+    const char *pszMax = CPLGetConfigOption("GDAL_CACHE_COMPRESSED_MAX", "0");
+    GIntBig nMaxBytes = 0;
+    bool bUnitSpecified = false;
+    if (CPLParseMemorySize(pszMax, &nMaxBytes, &bUnitSpecified) != CE_None)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "Invalid value for GDAL_CACHE_COMPRESSED_MAX. "
+                 "Compressed block cache disabled.");
+        return nullptr;
+    }
+    if (!bUnitSpecified && nMaxBytes < 100000)
+    {
+        // Assume MB
+        nMaxBytes *= (1024 * 1024);
+    }
+    if (nMaxBytes <= 0)
+        return nullptr;
+
+    const char *pszCompressor = CPLGetConfigOption("GDAL_CACHE_COMPRESSOR",
+                                                   nullptr);
+    const CPLCompressor *psCompressor = nullptr;
+    const CPLCompressor *psDecompressor = nullptr;
+    if (pszCompressor)
+    {
+        psCompressor = CPLGetCompressor(pszCompressor);
+        psDecompressor = CPLGetDecompressor(pszCompressor);
+    }
+    else
+    {
+        // Favor fast codecs.
+        for (const char *pszCandidate : {"lz4", "zstd", "zlib"})
+        {
+            psCompressor = CPLGetCompressor(pszCandidate);
+            psDecompressor = CPLGetDecompressor(pszCandidate);
+            if (psCompressor && psDecompressor)
+                break;
+        }
+    }
+    if (!psCompressor || !psDecompressor ||
+        psCompressor->eType != CCT_COMPRESSOR)
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "GDAL_CACHE_COMPRESSOR=%s not available. "
+                 "Compressed block cache disabled.",
+                 pszCompressor ? pszCompressor : "");
+        return nullptr;
+    }
+
+    auto poCache = new GDALRasterBlockCompressedCache();
+    poCache->nMaxBytes = nMaxBytes;
+    poCache->psCompressor = psCompressor;
+    poCache->psDecompressor = psDecompressor;
+    CPLDebug("GDAL", "Compressed block cache: " CPL_FRMT_GIB " MB, using %s",
+             nMaxBytes / (1024 * 1024), psCompressor->pszId);
+    return poCache;
+}
+
+/************************************************************************/
+/*                       StoreCompressedBlock()                         */
+/************************************************************************/
+
+// Called on a block that has been evicted, before its data is released.
+static void StoreCompressedBlock(GDALRasterBlock *poBlock)
+{
+    auto poCache = poCompressedCache;
+    if (!poCache || poBlock->GetDirty() || poBlock->GetDataRef() == nullptr)
+        return;
+    GDALRasterBand *poBand = poBlock->GetBand();
+    GDALDataset *poDS = poBand->GetDataset();
+    if (!poDS || poDS->GetAccess() != GA_ReadOnly)
+        return;
+
+    const GDALRasterBlockKey oKey{poBand, poBlock->GetXOff(),
+                                  poBlock->GetYOff()};
+    {
+        std::lock_guard<std::mutex> oGuard(poCache->oMutex);
+        auto oIter = poCache->oMap.find(oKey);
+        if (oIter != poCache->oMap.end())
+        {
+            // The content of the block cannot have changed since it was
+            // stored, as the entry would have been removed by MarkDirty().
+            poCache->oLRU.splice(poCache->oLRU.begin(), poCache->oLRU,
+                                 oIter->second.oLRUIter);
+            return;
+        }
+    }
+
+    // Blocks that do not compress to less than 7/8 of their size are not
+    // worth keeping. The compression is done in a scratch buffer reused by
+    // the evictions of the same thread, and only the final size is copied
+    // into the entry.
+    const size_t nBlockSize = static_cast<size_t>(poBlock->GetBlockSize());
+    const size_t nMaxCompressedSize = nBlockSize - nBlockSize / 8;
+    static thread_local std::vector<GByte> abyScratch;
+    try
+    {
+        if (abyScratch.size() < nMaxCompressedSize)
+            abyScratch.resize(nMaxCompressedSize);
+    }
+    catch (const std::exception &)
+    {
+        return;
+    }
+
+    const auto Compress = [poCache](const void *pInput, size_t nInputSize,
+                                    size_t nOutputMaxSize)
+    {
+        void *pOutput = abyScratch.data();
+        size_t nOutputSize = nOutputMaxSize;
+        CPLErrorStateBackuper oErrorStateBackuper(CPLQuietErrorHandler);
+        const char *const apszOptions[] = {"LEVEL=1", nullptr};
+        if (nOutputSize == 0 ||
+            !poCache->psCompressor->pfnFunc(
+                pInput, nInputSize, &pOutput, &nOutputSize, apszOptions,
+                poCache->psCompressor->user_data))
+        {
+            return static_cast<size_t>(0);
+        }
+        return nOutputSize;
+    };
+
+    // Large blocks whose first bytes do not compress (already compressed
+    // imagery, noise...) are unlikely to compress as a whole: do not spend
+    // the time of compressing them entirely.
+    constexpr size_t SAMPLE_SIZE = 16384;
+    size_t nOutputSize = 0;
+    if (nBlockSize < 4 * SAMPLE_SIZE ||
+        Compress(poBlock->GetDataRef(), SAMPLE_SIZE,
+                 SAMPLE_SIZE - SAMPLE_SIZE / 8) != 0)
+    {
+        nOutputSize =
+            Compress(poBlock->GetDataRef(), nBlockSize, nMaxCompressedSize);
+    }
+
+    GDALRasterBlockCompressedEntry oEntry;
+    if (nOutputSize != 0)
+    {
+        try
+        {
+            oEntry.abyData.assign(abyScratch.data(),
+                                  abyScratch.data() + nOutputSize);
+        }
+        catch (const std::exception &)
+        {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> oGuard(poCache->oMutex);
+    if (nOutputSize == 0)
+    {
+        ++poCache->nRejected;
+        return;
+    }
+
+    // Might have been stored by another thread in the meantime.
+    auto oIter = poCache->oMap.find(oKey);
+    if (oIter != poCache->oMap.end())
+        poCache->Remove_unlocked(oIter);
+
+    poCache->oLRU.push_front(oKey);
+    oEntry.oLRUIter = poCache->oLRU.begin();
+    poCache->nBytes += GDALRasterBlockCompressedCache::GetEntrySize(oEntry);
+    poCache->oMap[oKey] = std::move(oEntry);
+    ++poCache->oMapEntriesPerBand[oKey.poBand];
+    ++poCache->nStored;
+
+    while (poCache->nBytes > poCache->nMaxBytes && !poCache->oLRU.empty())
+        poCache->Remove_unlocked(poCache->oMap.find(poCache->oLRU.back()));
+}
+
+/************************************************************************/
+/*                      GDALRasterBlockSlabAllocator                    */
+/************************************************************************/
+
+// Optional allocator of block buffers (GDAL_CACHE_ALLOCATOR=SLAB). Buffers
+// of the same size (rounded up to 64 bytes) are carved from 2 MB slabs, which
+// limits the fragmentation of the heap of long running processes that cycle
+// through many blocks, and enables the use of transparent huge pages
+// (GDAL_CACHE_HUGE_PAGES=YES). Buffers larger than a quarter of a slab are
+// allocated individually.
+
+namespace
+{
+constexpr size_t SLAB_SIZE = 2 * 1024 * 1024;
+constexpr size_t SLAB_MAX_SLOT_SIZE = SLAB_SIZE / 4;
+
+struct GDALRasterBlockSlab
+{
+    GByte *pabyBase = nullptr;
+    // Singly linked list of free slots, whose first bytes store the pointer
+    // to the next free slot.
+    void *pFirstFree = nullptr;
+    // Number of slots never allocated, at the end of the slab.
+    int nUntouchedSlots = 0;
+    int nUsedSlots = 0;
+    // Links in the list of slabs of the size class with free slots.
+    GDALRasterBlockSlab *poPrev = nullptr;
+    GDALRasterBlockSlab *poNext = nullptr;
+    bool bInPartialList = false;
+};
+
+struct GDALRasterBlockSlabClass
+{
+    // Slabs that have at least one free slot.
+    GDALRasterBlockSlab *poFirstPartial = nullptr;
+    int nEmptySlabs = 0;
+};
+
+struct GDALRasterBlockSlabAllocator
+{
+    std::mutex oMutex{};
+    bool bHugePages = false;
+    // Indexed by slot size / 64.
+    std::unordered_map<size_t, GDALRasterBlockSlabClass> oMapClasses{};
+    // Indexed by slab base address.
+    std::unordered_map<std::uintptr_t, GDALRasterBlockSlab *> oMapSlabs{};
+
+    GUIntBig nSlabsAllocated = 0;
+    GUIntBig nSlabsFreed = 0;
+    size_t nMaxSlabs = 0;
+
+    static size_t GetSlotSize(size_t nSize)
+    {
+        return DIV_ROUND_UP(nSize, 64) * 64;
+    }
+
+    void *Alloc(size_t nSize);
+    void Free(void *pData, size_t nSize);
+    void ReleaseEmptySlabs();
+
+    static void LinkPartial(GDALRasterBlockSlabClass &oClass,
+                            GDALRasterBlockSlab *poSlab)
+    {
+        poSlab->poPrev = nullptr;
+        poSlab->poNext = oClass.poFirstPartial;
+        if (oClass.poFirstPartial)
+            oClass.poFirstPartial->poPrev = poSlab;
+        oClass.poFirstPartial = poSlab;
+        poSlab->bInPartialList = true;
+    }
+
+    static void UnlinkPartial(GDALRasterBlockSlabClass &oClass,
+                              GDALRasterBlockSlab *poSlab)
+    {
+        if (poSlab->poPrev)
+            poSlab->poPrev->poNext = poSlab->poNext;
+        else
+            oClass.poFirstPartial = poSlab->poNext;
+        if (poSlab->poNext)
+            poSlab->poNext->poPrev = poSlab->poPrev;
+        poSlab->poPrev = nullptr;
+        poSlab->poNext = nullptr;
+        poSlab->bInPartialList = false;
+    }
+};
+
+/************************************************************************/
+/*                GDALRasterBlockSlabAllocator::Alloc()                 */
+/************************************************************************/
+
+void *GDALRasterBlockSlabAllocator::Alloc(size_t nSize)
+{
+    const size_t nSlotSize = GetSlotSize(nSize);
+    std::lock_guard<std::mutex> oGuard(oMutex);
+    auto &oClass = oMapClasses[nSlotSize / 64];
+    GDALRasterBlockSlab *poSlab = oClass.poFirstPartial;
+    if (poSlab == nullptr)
+    {
+        GByte *pabyBase =
+            static_cast<GByte *>(VSIMallocAligned(SLAB_SIZE, SLAB_SIZE));
+        if (pabyBase == nullptr)
+            return nullptr;
+#if defined(HAVE_MMAP) && defined(MADV_HUGEPAGE)
+        if (bHugePages)
+            madvise(pabyBase, SLAB_SIZE, MADV_HUGEPAGE);
+#endif
+        poSlab = new GDALRasterBlockSlab();
+        poSlab->pabyBase = pabyBase;
+        poSlab->nUntouchedSlots = static_cast<int>(SLAB_SIZE / nSlotSize);
+        oMapSlabs[reinterpret_cast<std::uintptr_t>(pabyBase)] = poSlab;
+        LinkPartial(oClass, poSlab);
+        ++oClass.nEmptySlabs;
+        ++nSlabsAllocated;
+        nMaxSlabs = std::max(nMaxSlabs, oMapSlabs.size());
+    }
+
+    if (poSlab->nUsedSlots == 0)
+        --oClass.nEmptySlabs;
+
+    void *pRet;
+    if (poSlab->pFirstFree)
+    {
+        pRet = poSlab->pFirstFree;
+        memcpy(&poSlab->pFirstFree, pRet, sizeof(void *));
+    }
+    else
+    {
+        // Slots are handed out in address order the first time, so that
+        // pages of the slab are only touched when needed.
+        const int nTotalSlots = static_cast<int>(SLAB_SIZE / nSlotSize);
+        pRet = poSlab->pabyBase +
+               static_cast<size_t>(nTotalSlots - poSlab->nUntouchedSlots) *
+                   nSlotSize;
+        --poSlab->nUntouchedSlots;
+    }
+    ++poSlab->nUsedSlots;
+    if (poSlab->pFirstFree == nullptr && poSlab->nUntouchedSlots == 0)
+        UnlinkPartial(oClass, poSlab);
+    return pRet;
+}
+
+/************************************************************************/
+/*                 GDALRasterBlockSlabAllocator::Free()                 */
+/************************************************************************/
+
+void GDALRasterBlockSlabAllocator::Free(void *pData, size_t nSize)
+{
+    const size_t nSlotSize = GetSlotSize(nSize);
+    const auto nBase = reinterpret_cast<std::uintptr_t>(pData) &
+                       ~static_cast<std::uintptr_t>(SLAB_SIZE - 1);
+    std::lock_guard<std::mutex> oGuard(oMutex);
+    auto oIter = oMapSlabs.find(nBase);
+    CPLAssert(oIter != oMapSlabs.end());
+    GDALRasterBlockSlab *poSlab = oIter->second;
+    auto &oClass = oMapClasses[nSlotSize / 64];
+
+    memcpy(pData, &poSlab->pFirstFree, sizeof(void *));
+    poSlab->pFirstFree = pData;
+    --poSlab->nUsedSlots;
+    if (!poSlab->bInPartialList)
+        LinkPartial(oClass, poSlab);
+
+    if (poSlab->nUsedSlots == 0)
+    {
+        // Keep one empty slab per size class, to avoid allocating and freeing
+        // a slab repeatedly when a block is evicted and another one loaded.
+        if (oClass.nEmptySlabs > 0)
+        {
+            UnlinkPartial(oClass, poSlab);
+            oMapSlabs.erase(oIter);
+            VSIFreeAligned(poSlab->pabyBase);
+            delete poSlab;
+            ++nSlabsFreed;
+        }
+        else
+        {
+            ++oClass.nEmptySlabs;
+        }
+    }
+}
+
+/************************************************************************/
+/*           GDALRasterBlockSlabAllocator::ReleaseEmptySlabs()          */
+/************************************************************************/
+
+// Return to the system the empty slab kept by each size class. Called when
+// the cache size is lowered and by GDALDestroy().
+void GDALRasterBlockSlabAllocator::ReleaseEmptySlabs()
+{
+    std::lock_guard<std::mutex> oGuard(oMutex);
+    for (auto &oClassIter : oMapClasses)
+    {
+        auto &oClass = oClassIter.second;
+        GDALRasterBlockSlab *poSlab = oClass.poFirstPartial;
+        while (poSlab && oClass.nEmptySlabs > 0)
+        {
+            GDALRasterBlockSlab *poNext = poSlab->poNext;
+            if (poSlab->nUsedSlots == 0)
+            {
+                UnlinkPartial(oClass, poSlab);
+                oMapSlabs.erase(
+                    reinterpret_cast<std::uintptr_t>(poSlab->pabyBase));
+                VSIFreeAligned(poSlab->pabyBase);
+                delete poSlab;
+                --oClass.nEmptySlabs;
+                ++nSlabsFreed;
+            }
+            poSlab = poNext;
+        }
+    }
+}
+
+}  // namespace
+
+static GDALRasterBlockSlabAllocator *poSlabAllocator = nullptr;
+
+/************************************************************************/
+/*                         CreateSlabAllocator()                        */
+/************************************************************************/
+
+static GDALRasterBlockSlabAllocator *CreateSlabAllocator()
+{
+    const char *pszAllocator =
+        CPLGetConfigOption("GDAL_CACHE_ALLOCATOR", "MALLOC");
+    if (EQUAL(pszAllocator, "MALLOC"))
+        return nullptr;
+    if (!EQUAL(pszAllocator, "SLAB"))
+    {
+        CPLError(CE_Warning, CPLE_NotSupported,
+                 "GDAL_CACHE_ALLOCATOR=%s not supported. "
+                 "Falling back to MALLOC",
+                 pszAllocator);
+        return nullptr;
+    }
+    auto poAllocator = new GDALRasterBlockSlabAllocator();
+    poAllocator->bHugePages =
+        CPLTestBool(CPLGetConfigOption("GDAL_CACHE_HUGE_PAGES", "NO"));
+#if !(defined(HAVE_MMAP) && defined(MADV_HUGEPAGE))
+    if (poAllocator->bHugePages)
+    {
+        CPLDebug("GDAL", "GDAL_CACHE_HUGE_PAGES not supported on this "
+                         "platform");
+    }
 #endif
+    CPLDebug("GDAL", "Block cache slab allocator enabled");
+    return poAllocator;
+}
+
+/************************************************************************/
+/*                           AllocBlockData()                           */
+/************************************************************************/
+
+static void *AllocBlockData(GPtrDiff_t nSize)
+{
+    if (poSlabAllocator && static_cast<size_t>(nSize) <= SLAB_MAX_SLOT_SIZE)
+    {
+        void *pRet = poSlabAllocator->Alloc(static_cast<size_t>(nSize));
+        if (pRet == nullptr)
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate block cache slab");
+        }
+        return pRet;
+    }
+    return VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSize);
+}
+
+/************************************************************************/
+/*                           FreeBlockData()                            */
+/************************************************************************/
+
+static void FreeBlockData(void *pData, GPtrDiff_t nSize)
+{
+    if (pData == nullptr)
+        return;
+    if (poSlabAllocator && static_cast<size_t>(nSize) <= SLAB_MAX_SLOT_SIZE)
+        poSlabAllocator->Free(pData, static_cast<size_t>(nSize));
+    else
+        VSIFreeAligned(pData);
+}
+
+/************************************************************************/
+/*                         InitializeShards()                           */
+/************************************************************************/
+
+static void InitializeShards()
+{
+    if (bShardsInitialized.load(std::memory_order_acquire))
+        return;
+
+    static std::mutex oMutex;
+    std::lock_guard<std::mutex> oGuard(oMutex);
+    if (bShardsInitialized.load(std::memory_order_relaxed))
+        return;
+
+    const CPLLockType eLockType = GetLockType();
+    if (nShardCount == 0)
+    {
+        nShardCount = GetShardCount();
+        if (nShardCount > 1)
+            CPLDebug("GDAL", "Block cache split into %d shards", nShardCount);
+        eCachePolicy = GetCachePolicy();
+        if (eCachePolicy != GDALRasterBlockCachePolicy::LRU)
+            CPLDebug("GDAL", "Block cache policy: %s", GetCachePolicyName());
+    }
+    bCountHits = CPLIsDebugEnabled();
+    for (int i = 0; i < nShardCount; ++i)
+    {
+        auto &oShard = asShards[i];
+        oShard.hLock = CPLCreateLock(eLockType);
+        if (oShard.hLock)
+            CPLLockSetDebugPerf(oShard.hLock, bDebugContention);
+        if (eCachePolicy == GDALRasterBlockCachePolicy::TWO_Q &&
+            !oShard.poGhosts)
+            oShard.poGhosts = new GDALRasterBlockGhostList();
+        oShard.nAcquisitions = 0;
+        oShard.nContentions = 0;
+        oShard.nHits = 0;
+        oShard.nMisses = 0;
+        oShard.nEvictions = 0;
+        oShard.nGhostHits = 0;
+    }
+    if (!poCompressedCache)
+        poCompressedCache = CreateCompressedCache();
+    // The allocator must remain the same while blocks exist, so it is never
+    // destroyed.
+    static std::once_flag flagSlabAllocator;
+    std::call_once(flagSlabAllocator,
+                   []() { poSlabAllocator = CreateSlabAllocator(); });
+    bShardsInitialized.store(true, std::memory_order_release);
+}
+
+/************************************************************************/
+/*                             GetShard()                               */
+/************************************************************************/
+
+static inline GDALRasterBlockShard &GetShard(GDALRasterBlock *poBlock)
+{
+    if (nShardCount <= 1)
+        return asShards[0];
+    const GUInt64 nHash = HashBlockKey(poBlock->GetBand(), poBlock->GetXOff(),
+                                       poBlock->GetYOff());
+    return asShards[static_cast<int>(nHash >> 58) & (nShardCount - 1)];
+}
+
+/************************************************************************/
+/*                        GetShardCacheMax()                            */
+/************************************************************************/
+
+// Share of GDAL_CACHEMAX of a single shard.
+static GIntBig GetShardCacheMax()
+{
+    return nCacheMax / std::max(1, nShardCount);
+}
+
+/************************************************************************/
+/*                     GetFirstEvictionCandidate()                      */
+/************************************************************************/
+
+// Return the first block to consider for eviction in a shard, and the queue
+// to which it belongs. Candidates must then be iterated with
+// GDALRasterBlock::GetNextEvictionCandidate_unlocked(nFirstQueue).
+static GDALRasterBlock *
+GetFirstEvictionCandidate(GDALRasterBlockShard &oShard, int &nFirstQueue)
+{
+    const auto &oProbation = oShard.aoQueues[QUEUE_PROBATION];
+    const auto &oMain = oShard.aoQueues[QUEUE_MAIN];
+
+    // With the CLOCK policy, cache hits only flag blocks as referenced (see
+    // Touch()). Give them a second chance by moving them to the head of the
+    // queue when they reach its tail.
+    if (eCachePolicy == GDALRasterBlockCachePolicy::CLOCK)
+    {
+        while (oMain.poOldest != nullptr &&
+               oMain.poOldest->GiveSecondChance_unlocked())
+        {
+        }
+    }
+
+    // 2Q evicts from A1in if it is above its target size (25% of the cache),
+    // and from Am otherwise.
+    if (oProbation.poOldest != nullptr &&
+        (oMain.poOldest == nullptr ||
+         oProbation.nBytes > GetShardCacheMax() / 4))
+    {
+        nFirstQueue = QUEUE_PROBATION;
+        return oProbation.poOldest;
+    }
+    nFirstQueue = QUEUE_MAIN;
+    return oMain.poOldest;
+}
+
+/************************************************************************/
+/*                           AddGhostBlock()                            */
+/************************************************************************/
+
+// Remember the key of a block evicted from QUEUE_PROBATION.
+static void AddGhostBlock(GDALRasterBlockShard &oShard,
+                          const GDALRasterBlockKey &oKey, GIntBig nBytes)
+{
+    auto poGhosts = oShard.poGhosts;
+    if (!poGhosts)
+        return;
+
+    auto oIter = poGhosts->oMap.find(oKey);
+    if (oIter != poGhosts->oMap.end())
+    {
+        poGhosts->nBytes -= oIter->second.second;
+        poGhosts->oFIFO.erase(oIter->second.first);
+        poGhosts->oMap.erase(oIter);
+    }
+    poGhosts->oFIFO.push_back(oKey);
+    poGhosts->oMap[oKey] = std::make_pair(std::prev(poGhosts->oFIFO.end()),
+                                          nBytes);
+    poGhosts->nBytes += nBytes;
+
+    // The ghost list covers blocks worth 50% of the cache.
+    const GIntBig nMaxGhostBytes = GetShardCacheMax() / 2;
+    while (poGhosts->nBytes > nMaxGhostBytes && !poGhosts->oFIFO.empty())
+    {
+        oIter = poGhosts->oMap.find(poGhosts->oFIFO.front());
+        CPLAssert(oIter != poGhosts->oMap.end());
+        poGhosts->nBytes -= oIter->second.second;
+        poGhosts->oMap.erase(oIter);
+        poGhosts->oFIFO.pop_front();
+    }
+}
+
+/************************************************************************/
+/*                         ConsumeGhostBlock()                          */
+/************************************************************************/
+
+// Return whether the key was in the ghost list, and remove it from it.
+static bool ConsumeGhostBlock(GDALRasterBlockShard &oShard,
+                              const GDALRasterBlockKey &oKey)
+{
+    auto poGhosts = oShard.poGhosts;
+    if (!poGhosts)
+        return false;
+
+    auto oIter = poGhosts->oMap.find(oKey);
+    if (oIter == poGhosts->oMap.end())
+        return false;
+    poGhosts->nBytes -= oIter->second.second;
+    poGhosts->oFIFO.erase(oIter->second.first);
+    poGhosts->oMap.erase(oIter);
+    return true;
+}
 
 // #define ENABLE_DEBUG
 
@@ -155,6 +1061,9 @@ void CPL_STDCALL GDALSetCacheMax64(GIntBig nNewSizeInBytes)
         if (nCacheUsed == nOldCacheUsed)
             break;
     }
+
+    if (poSlabAllocator)
+        poSlabAllocator->ReleaseEmptySlabs();
 }
 
 /************************************************************************/
@@ -221,9 +1130,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
         flagSetupGDALGetCacheMax64,
         []()
         {
-            {
-                INITIALIZE_LOCK;
-            }
+            InitializeShards();
             bSleepsForBockCacheDebug =
                 CPLTestBool(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO"));
 
@@ -377,11 +1284,23 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    InitializeShards();
+
+    // Start from a different shard at each call, so that repeated calls
+    // (e.g. from GDALSetCacheMax64()) drain all shards evenly.
+    static std::atomic<unsigned> nNextShard{0};
+    const int nFirstShard =
+        static_cast<int>(nNextShard.fetch_add(1, std::memory_order_relaxed));
 
+    GDALRasterBlock *poTarget = nullptr;
+
+    for (int iShard = 0; iShard < nShardCount && poTarget == nullptr;
+         ++iShard)
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        auto &oShard = asShards[(nFirstShard + iShard) & (nShardCount - 1)];
+        GDALRasterBlockShardLock oLock(oShard);
+        int nFirstQueue = QUEUE_MAIN;
+        poTarget = GetFirstEvictionCandidate(oShard, nFirstQueue);
 
         while (poTarget != nullptr)
         {
@@ -391,11 +1310,11 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
                 if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1))
                     break;
             }
-            poTarget = poTarget->poPrevious;
+            poTarget = poTarget->GetNextEvictionCandidate_unlocked(nFirstQueue);
         }
 
         if (poTarget == nullptr)
-            return FALSE;
+            continue;
 #ifndef __COVERITY__
         // Disabled to avoid complains about sleeping under locks, that
         // are only true for debug/testing code
@@ -408,10 +1327,13 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 #endif
 
-        poTarget->Detach_unlocked();
+        poTarget->Evict_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
 
+    if (poTarget == nullptr)
+        return FALSE;
+
 #ifndef __COVERITY__
     // Disabled to avoid complains about sleeping under locks, that
     // are only true for debug/testing code
@@ -434,7 +1356,7 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
     }
 
-    VSIFreeAligned(poTarget->pData);
+    FreeBlockData(poTarget->pData, poTarget->GetBlockSize());
     poTarget->pData = nullptr;
     poTarget->GetBand()->AddBlockToFreeList(poTarget);
 
@@ -534,13 +1456,14 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
                                  int nYOffIn)
     : eType(poBandIn->GetRasterDataType()), bDirty(false), nLockCount(0),
       nXOff(nXOffIn), nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr),
-      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true)
+      poBand(poBandIn), poNext(nullptr), poPrevious(nullptr), bMustDetach(true),
+      nCacheQueue(QUEUE_NONE), nCachePriority(GBCP_Normal), bReferenced(false)
 {
-    if (!hRBLock)
+    if (!bShardsInitialized.load(std::memory_order_acquire))
     {
         // Needed for scenarios where GDALAllRegister() is called after
         // GDALDestroyDriverManager()
-        INITIALIZE_LOCK;
+        InitializeShards();
     }
 
     CPLAssert(poBandIn != nullptr);
@@ -568,7 +1491,8 @@ GDALRasterBlock::GDALRasterBlock(GDALRasterBand *poBandIn, int nXOffIn,
 GDALRasterBlock::GDALRasterBlock(int nXOffIn, int nYOffIn)
     : eType(GDT_Unknown), bDirty(false), nLockCount(0), nXOff(nXOffIn),
       nYOff(nYOffIn), nXSize(0), nYSize(0), pData(nullptr), poBand(nullptr),
-      poNext(nullptr), poPrevious(nullptr), bMustDetach(false)
+      poNext(nullptr), poPrevious(nullptr), bMustDetach(false),
+      nCacheQueue(QUEUE_NONE), nCachePriority(GBCP_Normal), bReferenced(false)
 {
 }
 
@@ -591,6 +1515,8 @@ void GDALRasterBlock::RecycleFor(int nXOffIn, int nYOffIn)
 
     poNext = nullptr;
     poPrevious = nullptr;
+    nCacheQueue = QUEUE_NONE;
+    bReferenced.store(false, std::memory_order_relaxed);
 
     nXOff = nXOffIn;
     nYOff = nYOffIn;
@@ -614,7 +1540,7 @@ GDALRasterBlock::~GDALRasterBlock()
 
     if (pData != nullptr)
     {
-        VSIFreeAligned(pData);
+        FreeBlockData(pData, GetBlockSize());
     }
 
     CPLAssert(nLockCount <= 0);
@@ -657,19 +1583,30 @@ void GDALRasterBlock::Detach()
 {
     if (bMustDetach)
     {
-        TAKE_LOCK;
+        GDALRasterBlockShardLock oLock(GetShard(this));
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if (poOldest == this)
-        poOldest = poPrevious;
-
-    if (poNewest == this)
+    if (nCacheQueue != QUEUE_NONE)
     {
-        poNewest = poNext;
+        auto &oQueue = GetShard(this).aoQueues[nCacheQueue];
+        if (oQueue.poOldest == this)
+            oQueue.poOldest = poPrevious;
+
+        if (oQueue.poNewest == this)
+        {
+            oQueue.poNewest = poNext;
+        }
+
+        const GIntBig nBlockCacheSize = GetEffectiveBlockSize(GetBlockSize());
+        oQueue.nBytes -= nBlockCacheSize;
+        --GetShard(this).anBlocksPerPriority[nCachePriority];
+        --anCachedBlocksPerPriority[nCachePriority];
+        if (GDALDataset *poDS = poBand->GetDataset())
+            poDS->AddBlockCacheUsed(-nBlockCacheSize);
     }
 
     if (poPrevious != nullptr)
@@ -681,6 +1618,7 @@ void GDALRasterBlock::Detach_unlocked()
     poPrevious = nullptr;
     poNext = nullptr;
     bMustDetach = false;
+    nCacheQueue = QUEUE_NONE;
 
     if (pData)
         nCacheUsed -= GetEffectiveBlockSize(GetBlockSize());
@@ -690,12 +1628,63 @@ void GDALRasterBlock::Detach_unlocked()
 #endif
 }
 
+/************************************************************************/
+/*                           Evict_unlocked()                           */
+/************************************************************************/
+
+// Detach a block selected for eviction, and update the statistics and ghost
+// list of its shard.
+void GDALRasterBlock::Evict_unlocked()
+{
+    auto &oShard = GetShard(this);
+    ++oShard.nEvictions;
+    if (nCacheQueue == QUEUE_PROBATION)
+    {
+        AddGhostBlock(oShard, GDALRasterBlockKey{poBand, nXOff, nYOff},
+                      GetEffectiveBlockSize(GetBlockSize()));
+    }
+    Detach_unlocked();
+}
+
+/************************************************************************/
+/*                  GetNextEvictionCandidate_unlocked()                 */
+/************************************************************************/
+
+// Return the block to consider for eviction after this one, once
+// GetFirstEvictionCandidate() returned nFirstQueue: oldest to newest blocks of
+// nFirstQueue, and then oldest to newest blocks of the other queue.
+GDALRasterBlock *GDALRasterBlock::GetNextEvictionCandidate_unlocked(
+    int nFirstQueue)
+{
+    if (poPrevious != nullptr)
+        return poPrevious;
+    if (nCacheQueue != nFirstQueue)
+        return nullptr;
+    const int nOtherQueue =
+        nFirstQueue == QUEUE_MAIN ? QUEUE_PROBATION : QUEUE_MAIN;
+    return GetShard(this).aoQueues[nOtherQueue].poOldest;
+}
+
+/************************************************************************/
+/*                      GiveSecondChance_unlocked()                     */
+/************************************************************************/
+
+// If the block has been referenced since the last call, move it to the head
+// of its queue and return true.
+bool GDALRasterBlock::GiveSecondChance_unlocked()
+{
+    if (!bReferenced.exchange(false, std::memory_order_relaxed))
+        return false;
+    Touch_unlocked();
+    return true;
+}
+
 /************************************************************************/
 /*                               Verify()                               */
 /************************************************************************/
 
 /**
- * Confirms (via assertions) that the block cache linked list is in a
+ * Confirms (via assertions) that the block cache linked lists are in a
  * consistent state.
  */
 
@@ -703,26 +1692,37 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
+    {
+        auto &oShard = asShards[iShard];
+        GDALRasterBlockShardLock oLock(oShard);
+        for (int nQueue : {QUEUE_MAIN, QUEUE_PROBATION})
+        {
+            GDALRasterBlock *const poNewest = oShard.aoQueues[nQueue].poNewest;
+            GDALRasterBlock *const poOldest = oShard.aoQueues[nQueue].poOldest;
 
-    CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
-              (poNewest != nullptr && poOldest != nullptr));
+            CPLAssert((poNewest == nullptr && poOldest == nullptr) ||
+                      (poNewest != nullptr && poOldest != nullptr));
 
-    if (poNewest != nullptr)
-    {
-        CPLAssert(poNewest->poPrevious == nullptr);
-        CPLAssert(poOldest->poNext == nullptr);
+            if (poNewest != nullptr)
+            {
+                CPLAssert(poNewest->poPrevious == nullptr);
+                CPLAssert(poOldest->poNext == nullptr);
 
-        GDALRasterBlock *poLast = nullptr;
-        for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-             poBlock = poBlock->poNext)
-        {
-            CPLAssert(poBlock->poPrevious == poLast);
+                GDALRasterBlock *poLast = nullptr;
+                for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
+                     poBlock = poBlock->poNext)
+                {
+                    CPLAssert(poBlock->poPrevious == poLast);
+                    CPLAssert(&GetShard(poBlock) == &oShard);
+                    CPLAssert(poBlock->nCacheQueue == nQueue);
 
-            poLast = poBlock;
-        }
+                    poLast = poBlock;
+                }
 
-        CPLAssert(poOldest == poLast);
+                CPLAssert(poOldest == poLast);
+            }
+        }
     }
 }
 
@@ -735,24 +1735,31 @@ void GDALRasterBlock::Verify()
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand *poBand)
 {
-    TAKE_LOCK;
-    for (GDALRasterBlock *poBlock = poNewest; poBlock != nullptr;
-         poBlock = poBlock->poNext)
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
     {
-        if (poBlock->GetBand() == poBand)
+        GDALRasterBlockShardLock oLock(asShards[iShard]);
+        for (int nQueue : {QUEUE_MAIN, QUEUE_PROBATION})
         {
-            printf("Cache has still blocks of band %p\n", poBand); /*ok*/
-            printf("Band : %d\n", poBand->GetBand());              /*ok*/
-            printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
-            printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
-            int nBlockXSize, nBlockYSize;
-            poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
-            printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
-            printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
-            printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
-            if (poBand->GetDataset())
-                printf("Dataset : %s\n", /*ok*/
-                       poBand->GetDataset()->GetDescription());
+            for (GDALRasterBlock *poBlock =
+                     asShards[iShard].aoQueues[nQueue].poNewest;
+                 poBlock != nullptr; poBlock = poBlock->poNext)
+            {
+                if (poBlock->GetBand() != poBand)
+                    continue;
+
+                printf("Cache has still blocks of band %p\n", poBand); /*ok*/
+                printf("Band : %d\n", poBand->GetBand());              /*ok*/
+                printf("nRasterXSize = %d\n", poBand->GetXSize());     /*ok*/
+                printf("nRasterYSize = %d\n", poBand->GetYSize());     /*ok*/
+                int nBlockXSize, nBlockYSize;
+                poBand->GetBlockSize(&nBlockXSize, &nBlockYSize);
+                printf("nBlockXSize = %d\n", nBlockXSize);      /*ok*/
+                printf("nBlockYSize = %d\n", nBlockYSize);      /*ok*/
+                printf("Dataset : %p\n", poBand->GetDataset()); /*ok*/
+                if (poBand->GetDataset())
+                    printf("Dataset : %s\n", /*ok*/
+                           poBand->GetDataset()->GetDescription());
+            }
         }
     }
 }
@@ -804,35 +1811,97 @@ CPLErr GDALRasterBlock::Write()
  *
  * This method is normally called when a block is used to keep track
  * that it has been recently used.
+ *
+ * With the CLOCK cache policy (GDAL_CACHE_POLICY=CLOCK), blocks already in
+ * the cache are only flagged as recently used, and are moved to the top of
+ * the list when they reach its bottom, so that this method does not need to
+ * take the block cache lock.
+ *
+ * With the 2Q cache policy (GDAL_CACHE_POLICY=2Q), blocks that have only
+ * been read once recently are kept in a FIFO list, and are not moved by this
+ * method.
  */
 
 void GDALRasterBlock::Touch()
 
 {
+    auto &oShard = GetShard(this);
+    if (bCountHits)
+        oShard.nHits.fetch_add(1, std::memory_order_relaxed);
+
+    // Blocks in QUEUE_PROBATION are in FIFO order. With the CLOCK policy,
+    // blocks in QUEUE_MAIN are only flagged as referenced, and are moved to
+    // the head of the queue when they reach its tail (see
+    // GetFirstEvictionCandidate()).
+    // The caller holds a lock on the block, so it cannot be evicted
+    // concurrently, and the referenced flag is only a hint for eviction:
+    // relaxed ordering is enough.
+    const int nQueue = nCacheQueue.load(std::memory_order_relaxed);
+    if (nQueue == QUEUE_PROBATION)
+        return;
+    if (nQueue == QUEUE_MAIN &&
+        eCachePolicy == GDALRasterBlockCachePolicy::CLOCK)
+    {
+        // Avoid writing to the cache line if the flag is already set
+        if (!bReferenced.load(std::memory_order_relaxed))
+            bReferenced.store(true, std::memory_order_relaxed);
+        return;
+    }
+
     // Can be safely tested outside the lock
-    if (poNewest == this)
+    if (oShard.aoQueues[QUEUE_MAIN].poNewest == this)
         return;
 
-    TAKE_LOCK;
+    GDALRasterBlockShardLock oLock(oShard);
     Touch_unlocked();
 }
 
 void GDALRasterBlock::Touch_unlocked()
 
 {
+    auto &oShard = GetShard(this);
+
+    // Blocks in QUEUE_PROBATION are in FIFO order.
+    if (nCacheQueue == QUEUE_PROBATION)
+        return;
+
     // Could happen even if tested in Touch() before taking the lock
     // Scenario would be :
     // 0. this is the second block (the one pointed by poNewest->poNext)
     // 1. Thread 1 calls Touch() and poNewest != this at that point
     // 2. Thread 2 detaches poNewest
     // 3. Thread 1 arrives here
-    if (poNewest == this)
+    if (oShard.aoQueues[QUEUE_MAIN].poNewest == this)
         return;
 
     // We should not try to touch a block that has been detached.
     // If that happen, corruption has already occurred.
     CPLAssert(bMustDetach);
 
+    if (nCacheQueue == QUEUE_NONE)
+    {
+        // New block in the cache.
+        ++oShard.nMisses;
+        nCacheQueue = QUEUE_MAIN;
+        if (eCachePolicy == GDALRasterBlockCachePolicy::TWO_Q)
+        {
+            if (ConsumeGhostBlock(oShard,
+                                  GDALRasterBlockKey{poBand, nXOff, nYOff}))
+                ++oShard.nGhostHits;
+            else
+                nCacheQueue = QUEUE_PROBATION;
+        }
+        const GIntBig nBlockCacheSize = GetEffectiveBlockSize(GetBlockSize());
+        oShard.aoQueues[nCacheQueue].nBytes += nBlockCacheSize;
+        ++oShard.anBlocksPerPriority[nCachePriority];
+        ++anCachedBlocksPerPriority[nCachePriority];
+        if (GDALDataset *poDS = poBand->GetDataset())
+            poDS->AddBlockCacheUsed(nBlockCacheSize);
+    }
+
+    GDALRasterBlock *&poNewest = oShard.aoQueues[nCacheQueue].poNewest;
+    GDALRasterBlock *&poOldest = oShard.aoQueues[nCacheQueue].poOldest;
+
     if (poOldest == this)
         poOldest = this->poPrevious;
 
@@ -884,8 +1953,8 @@ CPLErr GDALRasterBlock::Internalize()
 
     void *pNewData = nullptr;
 
-    // This call will initialize the hRBLock mutex. Other call places can
-    // only be called if we have go through there.
+    // This call will initialize the block cache shard locks. Other call places
+    // can only be called if we have go through there.
     const GIntBig nCurCacheMax = GDALGetCacheMax64();
 
     // No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo().
@@ -893,23 +1962,95 @@ CPLErr GDALRasterBlock::Internalize()
 
     /* -------------------------------------------------------------------- */
     /*      Flush old blocks if we are nearing our memory limit.            */
+    /*      We first evict blocks from the shard of this block, and then    */
+    /*      from the other shards if that was not enough.                   */
+    /*      If only the quota of the dataset of this block is exceeded,     */
+    /*      only blocks of that dataset are evicted. Otherwise, blocks of   */
+    /*      lower priority classes are evicted first.                       */
     /* -------------------------------------------------------------------- */
-    bool bFirstIter = true;
-    bool bLoopAgain = false;
+    const GIntBig nThisBlockCacheSize = GetEffectiveBlockSize(nSizeInBytes);
+    nCacheUsed += nThisBlockCacheSize;
+
     GDALDataset *poThisDS = poBand->GetDataset();
+    GDALDataset *poThisOwnerDS =
+        poThisDS ? poThisDS->GetBlockCacheOwner() : nullptr;
+    const GIntBig nDSCacheMax =
+        poThisOwnerDS ? poThisOwnerDS->GetBlockCacheMax() : 0;
+    nCachePriority = static_cast<GByte>(
+        poThisOwnerDS ? poThisOwnerDS->GetBlockCachePriority() : GBCP_Normal);
+
+    enum
+    {
+        EVICT_NONE,
+        EVICT_ANY,
+        EVICT_THIS_DATASET
+    };
+
+    const auto GetEvictionMode = [&]()
+    {
+        if (nCacheUsed > nCurCacheMax)
+            return EVICT_ANY;
+        if (nDSCacheMax > 0 &&
+            poThisOwnerDS->GetBlockCacheUsed() + nThisBlockCacheSize >
+                nDSCacheMax)
+            return EVICT_THIS_DATASET;
+        return EVICT_NONE;
+    };
+
+    // Highest priority class of the blocks that may be evicted. All shards
+    // are visited before evicting blocks of the next priority class.
+    int nMaxPriority = GBCP_Low;
+    while (nMaxPriority < GBCP_High &&
+           anCachedBlocksPerPriority[nMaxPriority] == 0)
+        ++nMaxPriority;
+
+    const auto IsCandidate =
+        [&nMaxPriority, poThisOwnerDS](const GDALRasterBlock *poBlock, int eMode)
+    {
+        if (eMode == EVICT_THIS_DATASET)
+        {
+            const GDALDataset *poDS = poBlock->poBand->GetDataset();
+            return poDS && poDS->GetBlockCacheOwner() == poThisOwnerDS;
+        }
+        return poBlock->nCachePriority <= nMaxPriority;
+    };
+
+    auto &oThisShard = GetShard(this);
+    const int iThisShard = static_cast<int>(&oThisShard - asShards);
+    int iShardIter = 0;
+    bool bTouched = false;
+    bool bLoopAgain = false;
     do
     {
         bLoopAgain = false;
         GDALRasterBlock *apoBlocksToFree[64] = {nullptr};
         int nBlocksToFree = 0;
         {
-            TAKE_LOCK;
-
-            if (bFirstIter)
-                nCacheUsed += GetEffectiveBlockSize(nSizeInBytes);
-            GDALRasterBlock *poTarget = poOldest;
-            while (nCacheUsed > nCurCacheMax)
+            auto &oShard =
+                asShards[(iThisShard + iShardIter) & (nShardCount - 1)];
+            GDALRasterBlockShardLock oLock(oShard);
+
+            int nFirstQueue = QUEUE_MAIN;
+            GDALRasterBlock *poTarget = nullptr;
+            int eLastMode = EVICT_NONE;
+            int eMode;
+            while ((eMode = GetEvictionMode()) != EVICT_NONE)
             {
+                if (eMode != eLastMode)
+                {
+                    if (eMode == EVICT_ANY)
+                    {
+                        // Skip the shard if it has no block in the priority
+                        // classes that can be evicted
+                        GIntBig nCandidates = 0;
+                        for (int i = GBCP_Low; i <= nMaxPriority; ++i)
+                            nCandidates += oShard.anBlocksPerPriority[i];
+                        if (nCandidates == 0)
+                            break;
+                    }
+                    poTarget = GetFirstEvictionCandidate(oShard, nFirstQueue);
+                    eLastMode = eMode;
+                }
                 GDALRasterBlock *poDirtyBlockOtherDataset = nullptr;
                 // In this first pass, only discard dirty blocks of this
                 // dataset. We do this to decrease significantly the likelihood
@@ -922,7 +2063,12 @@ CPLErr GDALRasterBlock::Internalize()
                 //    so gets the old value.
                 while (poTarget != nullptr)
                 {
-                    if (!poTarget->GetDirty())
+                    if (!IsCandidate(poTarget, eMode))
+                    {
+                        // Protected by its priority class, or block of
+                        // another dataset while enforcing a quota
+                    }
+                    else if (!poTarget->GetDirty())
                     {
                         if (CPLAtomicCompareAndExchange(&(poTarget->nLockCount),
                                                         0, -1))
@@ -941,7 +2087,8 @@ CPLErr GDALRasterBlock::Internalize()
                             poDirtyBlockOtherDataset = poTarget;
                         }
                     }
-                    poTarget = poTarget->poPrevious;
+                    poTarget = poTarget->GetNextEvictionCandidate_unlocked(
+                        nFirstQueue);
                 }
                 if (poTarget == nullptr && poDirtyBlockOtherDataset)
                 {
@@ -954,10 +2101,12 @@ CPLErr GDALRasterBlock::Internalize()
                     }
                     else
                     {
-                        poTarget = poOldest;
+                        poTarget =
+                            GetFirstEvictionCandidate(oShard, nFirstQueue);
                         while (poTarget != nullptr)
                         {
-                            if (CPLAtomicCompareAndExchange(
+                            if (IsCandidate(poTarget, eMode) &&
+                                CPLAtomicCompareAndExchange(
                                     &(poTarget->nLockCount), 0, -1))
                             {
                                 CPLDebug(
@@ -965,7 +2114,9 @@ CPLErr GDALRasterBlock::Internalize()
                                     "Evicting dirty block of another dataset");
                                 break;
                             }
-                            poTarget = poTarget->poPrevious;
+                            poTarget =
+                                poTarget->GetNextEvictionCandidate_unlocked(
+                                    nFirstQueue);
                         }
                     }
                 }
@@ -984,9 +2135,11 @@ CPLErr GDALRasterBlock::Internalize()
                     }
 #endif
 
-                    GDALRasterBlock *_poPrevious = poTarget->poPrevious;
+                    GDALRasterBlock *_poPrevious =
+                        poTarget->GetNextEvictionCandidate_unlocked(
+                            nFirstQueue);
 
-                    poTarget->Detach_unlocked();
+                    poTarget->Evict_unlocked();
                     poTarget->GetBand()->UnreferenceBlock(poTarget);
 
                     apoBlocksToFree[nBlocksToFree++] = poTarget;
@@ -995,12 +2148,12 @@ CPLErr GDALRasterBlock::Internalize()
                         // Only free one dirty block at a time so that
                         // other dirty blocks of other bands with the same
                         // coordinates can be found with TryGetLockedBlock()
-                        bLoopAgain = nCacheUsed > nCurCacheMax;
+                        bLoopAgain = GetEvictionMode() != EVICT_NONE;
                         break;
                     }
                     if (nBlocksToFree == 64)
                     {
-                        bLoopAgain = (nCacheUsed > nCurCacheMax);
+                        bLoopAgain = GetEvictionMode() != EVICT_NONE;
                         break;
                     }
 
@@ -1017,12 +2170,13 @@ CPLErr GDALRasterBlock::Internalize()
             /*      Add this block to the list. */
             /* ------------------------------------------------------------------
              */
-            if (!bLoopAgain)
+            if (!bLoopAgain && !bTouched && &oShard == &oThisShard)
+            {
                 Touch_unlocked();
+                bTouched = true;
+            }
         }
 
-        bFirstIter = false;
-
         // Now free blocks we have detached and removed from their band.
         for (int i = 0; i < nBlocksToFree; ++i)
         {
@@ -1050,6 +2204,10 @@ CPLErr GDALRasterBlock::Internalize()
                     poBlock->GetBand()->SetFlushBlockErr(eErr);
                 }
             }
+            else
+            {
+                StoreCompressedBlock(poBlock);
+            }
 
             // Try to recycle the data of an existing block.
             void *pDataBlock = poBlock->pData;
@@ -1060,17 +2218,41 @@ CPLErr GDALRasterBlock::Internalize()
             }
             else
             {
-                VSIFreeAligned(poBlock->pData);
+                FreeBlockData(poBlock->pData, poBlock->GetBlockSize());
             }
             poBlock->pData = nullptr;
 
             poBlock->GetBand()->AddBlockToFreeList(poBlock);
         }
+
+        // Nothing more could be evicted from this shard: try the next one,
+        // and then the next priority class.
+        if (!bLoopAgain)
+        {
+            const int eMode = GetEvictionMode();
+            if (eMode != EVICT_NONE && iShardIter + 1 < nShardCount)
+            {
+                ++iShardIter;
+                bLoopAgain = true;
+            }
+            else if (eMode == EVICT_ANY && nMaxPriority < GBCP_High)
+            {
+                ++nMaxPriority;
+                iShardIter = 0;
+                bLoopAgain = true;
+            }
+        }
     } while (bLoopAgain);
 
+    if (!bTouched)
+    {
+        GDALRasterBlockShardLock oLock(oThisShard);
+        Touch_unlocked();
+    }
+
     if (pNewData == nullptr)
     {
-        pNewData = VSI_MALLOC_ALIGNED_AUTO_VERBOSE(nSizeInBytes);
+        pNewData = AllocBlockData(nSizeInBytes);
         if (pNewData == nullptr)
         {
             return (CE_Failure);
@@ -1099,7 +2281,11 @@ void GDALRasterBlock::MarkDirty()
     {
         poBand->InitRWLock();
         if (!bDirty)
+        {
             poBand->IncDirtyBlocks(1);
+            if (poCompressedCache)
+                DropCompressedBlock(poBand, nXOff, nYOff);
+        }
     }
     bDirty = true;
 }
@@ -1122,6 +2308,91 @@ void GDALRasterBlock::MarkClean()
     bDirty = false;
 }
 
+/************************************************************************/
+/*                      LoadFromCompressedCache()                       */
+/************************************************************************/
+
+/*! @cond Doxygen_Suppress */
+// Fill the data of a newly internalized block from the compressed block
+// cache. Return false if the block is not in it.
+bool GDALRasterBlock::LoadFromCompressedCache()
+{
+    auto poCache = poCompressedCache;
+    if (!poCache || pData == nullptr)
+        return false;
+
+    // Decompress outside of the lock, from a copy of the entry.
+    std::vector<GByte> abyData;
+    {
+        std::lock_guard<std::mutex> oGuard(poCache->oMutex);
+        auto oIter =
+            poCache->oMap.find(GDALRasterBlockKey{poBand, nXOff, nYOff});
+        if (oIter == poCache->oMap.end())
+            return false;
+        abyData = oIter->second.abyData;
+        // Keep the entry, so that the block does not need to be compressed
+        // again if it is evicted before being modified.
+        poCache->oLRU.splice(poCache->oLRU.begin(), poCache->oLRU,
+                             oIter->second.oLRUIter);
+        ++poCache->nHits;
+    }
+
+    void *pOutput = pData;
+    size_t nOutputSize = static_cast<size_t>(GetBlockSize());
+    if (!poCache->psDecompressor->pfnFunc(
+            abyData.data(), abyData.size(), &pOutput, &nOutputSize, nullptr,
+            poCache->psDecompressor->user_data) ||
+        nOutputSize != static_cast<size_t>(GetBlockSize()))
+    {
+        DropCompressedBlock(poBand, nXOff, nYOff);
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        DropCompressedBlock()                         */
+/************************************************************************/
+
+void GDALRasterBlock::DropCompressedBlock(const GDALRasterBand *poBandIn,
+                                          int nXOffIn, int nYOffIn)
+{
+    auto poCache = poCompressedCache;
+    if (!poCache)
+        return;
+
+    std::lock_guard<std::mutex> oGuard(poCache->oMutex);
+    auto oIter =
+        poCache->oMap.find(GDALRasterBlockKey{poBandIn, nXOffIn, nYOffIn});
+    if (oIter != poCache->oMap.end())
+        poCache->Remove_unlocked(oIter);
+}
+
+/************************************************************************/
+/*                       DropCompressedBlocks()                         */
+/************************************************************************/
+
+void GDALRasterBlock::DropCompressedBlocks(const GDALRasterBand *poBandIn)
+{
+    auto poCache = poCompressedCache;
+    if (!poCache)
+        return;
+
+    std::lock_guard<std::mutex> oGuard(poCache->oMutex);
+    if (poCache->oMapEntriesPerBand.find(poBandIn) ==
+        poCache->oMapEntriesPerBand.end())
+        return;
+    for (auto oIter = poCache->oLRU.begin(); oIter != poCache->oLRU.end();)
+    {
+        const auto oKey = *oIter;
+        ++oIter;
+        if (oKey.poBand == poBandIn)
+            poCache->Remove_unlocked(poCache->oMap.find(oKey));
+    }
+}
+
+/*! @endcond */
+
 /************************************************************************/
 /*                          DestroyRBMutex()                           */
 /************************************************************************/
@@ -1129,9 +2400,78 @@ void GDALRasterBlock::MarkClean()
 /*! @cond Doxygen_Suppress */
 void GDALRasterBlock::DestroyRBMutex()
 {
-    if (hRBLock != nullptr)
-        DESTROY_LOCK;
-    hRBLock = nullptr;
+    GUIntBig nTotalAcquisitions = 0;
+    GUIntBig nTotalContentions = 0;
+    GUIntBig nTotalHits = 0;
+    GUIntBig nTotalMisses = 0;
+    GUIntBig nTotalEvictions = 0;
+    GUIntBig nTotalGhostHits = 0;
+    for (int iShard = 0; iShard < nShardCount; ++iShard)
+    {
+        auto &oShard = asShards[iShard];
+        if (oShard.hLock != nullptr)
+            CPLDestroyLock(oShard.hLock);
+        oShard.hLock = nullptr;
+        delete oShard.poGhosts;
+        oShard.poGhosts = nullptr;
+        nTotalAcquisitions += oShard.nAcquisitions;
+        nTotalContentions += oShard.nContentions;
+        nTotalHits += oShard.nHits.load(std::memory_order_relaxed);
+        nTotalMisses += oShard.nMisses;
+        nTotalEvictions += oShard.nEvictions;
+        nTotalGhostHits += oShard.nGhostHits;
+        if (nShardCount > 1 && oShard.nAcquisitions > 0)
+        {
+            CPLDebug("GDAL",
+                     "Block cache shard %d: " CPL_FRMT_GUIB
+                     " lock acquisitions, " CPL_FRMT_GUIB " contended",
+                     iShard, oShard.nAcquisitions, oShard.nContentions);
+        }
+    }
+    if (nTotalAcquisitions > 0 && (nShardCount > 1 || bDebugContention))
+    {
+        CPLDebug("GDAL",
+                 "Block cache lock: " CPL_FRMT_GUIB
+                 " acquisitions, " CPL_FRMT_GUIB " contended (%.2f %%)",
+                 nTotalAcquisitions, nTotalContentions,
+                 100.0 * static_cast<double>(nTotalContentions) /
+                     static_cast<double>(nTotalAcquisitions));
+    }
+    if (nTotalMisses > 0)
+    {
+        CPLDebug("GDAL",
+                 "Block cache policy %s: " CPL_FRMT_GUIB " hits, " CPL_FRMT_GUIB
+                 " misses (hit ratio: %.2f %%), " CPL_FRMT_GUIB
+                 " evictions, " CPL_FRMT_GUIB " ghost hits",
+                 GetCachePolicyName(), nTotalHits, nTotalMisses,
+                 100.0 * static_cast<double>(nTotalHits) /
+                     static_cast<double>(nTotalHits + nTotalMisses),
+                 nTotalEvictions, nTotalGhostHits);
+    }
+    if (poCompressedCache)
+    {
+        CPLDebug("GDAL",
+                 "Compressed block cache: " CPL_FRMT_GUIB
+                 " blocks stored, " CPL_FRMT_GUIB
+                 " not compressible enough, " CPL_FRMT_GUIB " hits",
+                 poCompressedCache->nStored, poCompressedCache->nRejected,
+                 poCompressedCache->nHits);
+        delete poCompressedCache;
+        poCompressedCache = nullptr;
+    }
+    if (poSlabAllocator)
+    {
+        // Slabs still in use belong to blocks that have not been freed yet,
+        // and the allocator itself must outlive them.
+        poSlabAllocator->ReleaseEmptySlabs();
+        std::lock_guard<std::mutex> oGuard(poSlabAllocator->oMutex);
+        CPLDebug("GDAL",
+                 "Block cache slab allocator: " CPL_FRMT_GUIB
+                 " slabs allocated, " CPL_FRMT_GUIB " freed, %d at most",
+                 poSlabAllocator->nSlabsAllocated, poSlabAllocator->nSlabsFreed,
+                 static_cast<int>(poSlabAllocator->nMaxSlabs));
+    }
+    bShardsInitialized.store(false, std::memory_order_release);
 }
 
 /*! @endcond */
@@ -1214,7 +2554,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced.
-    TAKE_LOCK;
+    GDALRasterBlockShardLock oLock(GetShard(this));
 
     return FALSE;
 }
@@ -1223,14 +2563,22 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest;
-         poBlock != nullptr;
-         poBlock = poBlock->poNext )
-    {
-        printf("Block %d\n", iBlock);/*ok*/
-        poBlock->DumpBlock();
-        printf("\n");/*ok*/
-        iBlock++;
+    for( int iShard = 0; iShard < nShardCount; ++iShard )
+    {
+        for( int nQueue : {QUEUE_MAIN, QUEUE_PROBATION} )
+        {
+            for( GDALRasterBlock *poBlock =
+                     asShards[iShard].aoQueues[nQueue].poNewest;
+                 poBlock != nullptr;
+                 poBlock = poBlock->poNext )
+            {
+                printf("Block %d (shard %d, queue %d)\n",/*ok*/
+                       iBlock, iShard, nQueue);
+                poBlock->DumpBlock();
+                printf("\n");/*ok*/
+                iBlock++;
+            }
+        }
     }
 }
 
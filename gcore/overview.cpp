@@ -26,9 +26,11 @@
 #include <list>
 #include <memory>
 #include <mutex>
+#include <type_traits>
 #include <vector>
 
 #include "cpl_conv.h"
+#include "cpl_cpu_features.h"
 #include "cpl_error.h"
 #include "cpl_float.h"
 #include "cpl_progress.h"
@@ -37,6 +39,8 @@
 #include "gdal_thread_pool.h"
 #include "gdalwarper.h"
 #include "gdal_vrt.h"
+#include "memdataset.h"
+#include "overview_avx2.h"
 #include "vrtdataset.h"
 
 #ifdef USE_NEON_OPTIMIZATIONS
@@ -1322,36 +1326,53 @@ GDALResampleChunk_AverageOrRMS_T(const GDALOverviewResampleArgs &args,
                         static_cast<size_t>(nSrcYOff - nChunkYOff) *
                             nChunkXSize;
                     int iDstPixel = 0;
-#ifdef USE_SSE2
-                    if constexpr (eWrkDataType == GDT_Byte)
+#ifdef HAVE_OVERVIEW_AVX2
+                    if (!bQuadraticMean && CPLHaveRuntimeAVX2())
                     {
-                        if (bQuadraticMean)
+                        if constexpr (eWrkDataType == GDT_Byte)
                         {
-                            iDstPixel = QuadraticMeanByteSSE2OrAVX2(
+                            iDstPixel = GDALAverage2x2Byte_AVX2(
                                 nDstXWidth, nChunkXSize, pSrcScanlineShifted,
                                 pDstScanline);
                         }
                         else
                         {
-                            iDstPixel = AverageByteSSE2OrAVX2(
+                            iDstPixel = GDALAverage2x2UInt16_AVX2(
                                 nDstXWidth, nChunkXSize, pSrcScanlineShifted,
                                 pDstScanline);
                         }
                     }
+#endif
+#ifdef USE_SSE2
+                    if constexpr (eWrkDataType == GDT_Byte)
+                    {
+                        if (bQuadraticMean)
+                        {
+                            iDstPixel += QuadraticMeanByteSSE2OrAVX2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
+                        }
+                        else
+                        {
+                            iDstPixel += AverageByteSSE2OrAVX2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
+                        }
+                    }
                     else
                     {
                         static_assert(eWrkDataType == GDT_UInt16);
                         if (bQuadraticMean)
                         {
-                            iDstPixel = QuadraticMeanUInt16SSE2(
-                                nDstXWidth, nChunkXSize, pSrcScanlineShifted,
-                                pDstScanline);
+                            iDstPixel += QuadraticMeanUInt16SSE2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
                         }
                         else
                         {
-                            iDstPixel = AverageUInt16SSE2(
-                                nDstXWidth, nChunkXSize, pSrcScanlineShifted,
-                                pDstScanline);
+                            iDstPixel += AverageUInt16SSE2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
                         }
                     }
 #endif
@@ -1395,21 +1416,32 @@ GDALResampleChunk_AverageOrRMS_T(const GDALOverviewResampleArgs &args,
                         static_cast<size_t>(nSrcYOff - nChunkYOff) *
                             nChunkXSize;
                     int iDstPixel = 0;
+#ifdef HAVE_OVERVIEW_AVX2
+                    if constexpr (eWrkDataType == GDT_Float32)
+                    {
+                        if (!bQuadraticMean && CPLHaveRuntimeAVX2())
+                        {
+                            iDstPixel = GDALAverage2x2Float_AVX2(
+                                nDstXWidth, nChunkXSize, pSrcScanlineShifted,
+                                pDstScanline);
+                        }
+                    }
+#endif
 #ifdef USE_SSE2
                     if constexpr (eWrkDataType == GDT_Float32)
                     {
                         static_assert(std::is_same_v<T, float>);
                         if (bQuadraticMean)
                         {
-                            iDstPixel = QuadraticMeanFloatSSE2(
-                                nDstXWidth, nChunkXSize, pSrcScanlineShifted,
-                                pDstScanline);
+                            iDstPixel += QuadraticMeanFloatSSE2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
                         }
                         else
                         {
-                            iDstPixel = AverageFloatSSE2(
-                                nDstXWidth, nChunkXSize, pSrcScanlineShifted,
-                                pDstScanline);
+                            iDstPixel += AverageFloatSSE2(
+                                nDstXWidth - iDstPixel, nChunkXSize,
+                                pSrcScanlineShifted, pDstScanline + iDstPixel);
                         }
                     }
 #endif
@@ -1925,6 +1957,91 @@ static CPLErr GDALResampleChunk_Gauss(const GDALOverviewResampleArgs &args,
     const int nChunkBottomYOff = nChunkYOff + nChunkYSize;
     const int nDstXWidth = nDstXOff2 - nDstXOff;
 
+    /* -------------------------------------------------------------------- */
+    /*      Precompute the source columns of each destination pixel.        */
+    /* -------------------------------------------------------------------- */
+    struct SrcXWindow
+    {
+        int nSrcXOff;
+        int nSrcXOff2;
+        int nXShiftGaussMatrix;
+    };
+
+    std::vector<SrcXWindow> asSrcXWindows;
+    try
+    {
+        asSrcXWindows.resize(nDstXWidth);
+    }
+    catch (const std::exception &)
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate Gauss resampling buffer");
+        return CE_Failure;
+    }
+    for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
+    {
+        int nSrcXOff = static_cast<int>(0.5 + iDstPixel * dfXRatioDstToSrc);
+        int nSrcXOff2 =
+            static_cast<int>(0.5 + (iDstPixel + 1) * dfXRatioDstToSrc) + 1;
+
+        if (nSrcXOff < nChunkXOff)
+        {
+            nSrcXOff = nChunkXOff;
+            nSrcXOff2++;
+        }
+
+        const int iSizeX = nSrcXOff2 - nSrcXOff;
+        nSrcXOff = nSrcXOff + iSizeX / 2 - nGaussMatrixDim / 2;
+        nSrcXOff2 = nSrcXOff + nGaussMatrixDim;
+
+        if (nSrcXOff2 > nChunkRightXOff ||
+            (dfXRatioDstToSrc > 1 && iDstPixel == nOXSize - 1))
+        {
+            nSrcXOff2 = std::min(nChunkRightXOff, nSrcXOff + nGaussMatrixDim);
+        }
+
+        int nXShiftGaussMatrix = 0;
+        if (nSrcXOff < nChunkXOff)
+        {
+            nXShiftGaussMatrix = -(nSrcXOff - nChunkXOff);
+            nSrcXOff = nChunkXOff;
+        }
+
+        auto &sWindow = asSrcXWindows[iDstPixel - nDstXOff];
+        sWindow.nSrcXOff = nSrcXOff;
+        sWindow.nSrcXOff2 = nSrcXOff2;
+        sWindow.nXShiftGaussMatrix = nXShiftGaussMatrix;
+    }
+
+#ifdef HAVE_OVERVIEW_AVX2
+    // Find the range of destination pixels whose source window is complete,
+    // which can be computed with the AVX2 code path when there is no mask.
+    int nAVX2DstXOff = nDstXOff2;
+    int nAVX2DstXOff2 = nDstXOff2;
+    std::vector<int> anAVX2SrcXOff;
+    if (poColorTable == nullptr && pabyChunkNodataMask == nullptr &&
+        CPLHaveRuntimeAVX2())
+    {
+        const auto IsCompleteWindow = [&asSrcXWindows, nDstXOff,
+                                       nGaussMatrixDim](int iDstPixel)
+        {
+            const auto &sWindow = asSrcXWindows[iDstPixel - nDstXOff];
+            return sWindow.nXShiftGaussMatrix == 0 &&
+                   sWindow.nSrcXOff2 - sWindow.nSrcXOff == nGaussMatrixDim;
+        };
+        nAVX2DstXOff = nDstXOff;
+        while (nAVX2DstXOff < nDstXOff2 && !IsCompleteWindow(nAVX2DstXOff))
+            ++nAVX2DstXOff;
+        nAVX2DstXOff2 = nAVX2DstXOff;
+        while (nAVX2DstXOff2 < nDstXOff2 && IsCompleteWindow(nAVX2DstXOff2))
+        {
+            anAVX2SrcXOff.push_back(
+                asSrcXWindows[nAVX2DstXOff2 - nDstXOff].nSrcXOff - nChunkXOff);
+            ++nAVX2DstXOff2;
+        }
+    }
+#endif
+
     /* ==================================================================== */
     /*      Loop over destination scanlines.                                */
     /* ==================================================================== */
@@ -1973,33 +2090,26 @@ static CPLErr GDALResampleChunk_Gauss(const GDALOverviewResampleArgs &args,
             padfDstBuffer + (iDstLine - nDstYOff) * nDstXWidth;
         for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
         {
-            int nSrcXOff = static_cast<int>(0.5 + iDstPixel * dfXRatioDstToSrc);
-            int nSrcXOff2 =
-                static_cast<int>(0.5 + (iDstPixel + 1) * dfXRatioDstToSrc) + 1;
-
-            if (nSrcXOff < nChunkXOff)
-            {
-                nSrcXOff = nChunkXOff;
-                nSrcXOff2++;
-            }
-
-            const int iSizeX = nSrcXOff2 - nSrcXOff;
-            nSrcXOff = nSrcXOff + iSizeX / 2 - nGaussMatrixDim / 2;
-            nSrcXOff2 = nSrcXOff + nGaussMatrixDim;
-
-            if (nSrcXOff2 > nChunkRightXOff ||
-                (dfXRatioDstToSrc > 1 && iDstPixel == nOXSize - 1))
+#ifdef HAVE_OVERVIEW_AVX2
+            if (iDstPixel == nAVX2DstXOff && nAVX2DstXOff2 > nAVX2DstXOff &&
+                nSrcYOff2 > nSrcYOff)
             {
-                nSrcXOff2 =
-                    std::min(nChunkRightXOff, nSrcXOff + nGaussMatrixDim);
+                GDALResampleGauss_AVX2(
+                    padfSrcScanline, nChunkXSize, nSrcYOff2 - nSrcYOff,
+                    nGaussMatrixDim,
+                    panGaussMatrix + nYShiftGaussMatrix * nGaussMatrixDim,
+                    nGaussMatrixDim, anAVX2SrcXOff.data(),
+                    nAVX2DstXOff2 - nAVX2DstXOff,
+                    padfDstScanline + nAVX2DstXOff - nDstXOff);
+                iDstPixel = nAVX2DstXOff2 - 1;
+                continue;
             }
+#endif
 
-            int nXShiftGaussMatrix = 0;
-            if (nSrcXOff < nChunkXOff)
-            {
-                nXShiftGaussMatrix = -(nSrcXOff - nChunkXOff);
-                nSrcXOff = nChunkXOff;
-            }
+            const auto &sWindow = asSrcXWindows[iDstPixel - nDstXOff];
+            const int nSrcXOff = sWindow.nSrcXOff;
+            const int nSrcXOff2 = sWindow.nSrcXOff2;
+            const int nXShiftGaussMatrix = sWindow.nXShiftGaussMatrix;
 
             if (poColorTable == nullptr)
             {
@@ -3313,6 +3423,9 @@ static CPLErr GDALResampleChunk_ConvolutionT(
     const int nChunkRightXOff = nChunkXOff + nChunkXSize;
 #ifdef USE_SSE2
     bool bSrcPixelCountLess8 = dfXScaledRadius < 4;
+#endif
+#ifdef HAVE_OVERVIEW_AVX2
+    const bool bUseAVX2 = CPLHaveRuntimeAVX2();
 #endif
     for (int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; ++iDstPixel)
     {
@@ -3372,6 +3485,30 @@ static CPLErr GDALResampleChunk_ConvolutionT(
                     padfWeights[i] *= dfInvWeightSum;
             }
             int iSrcLineOff = 0;
+#ifdef HAVE_OVERVIEW_AVX2
+            if constexpr (std::is_same_v<T, GByte> ||
+                          std::is_same_v<T, GUInt16>)
+            {
+                if (bUseAVX2)
+                {
+                    // Process the lines handled 3 at a time by the SSE2 code
+                    // below, with the same split between vector and scalar
+                    // accumulation, so that results are identical. The
+                    // remaining lines go through the generic code.
+                    const int nVecPixelCount =
+                        (nSrcPixelCount == 4 || bSrcPixelCountLess8)
+                            ? (nSrcPixelCount & ~3)
+                            : (nSrcPixelCount & ~7);
+                    const int nRows = nHeight - nHeight % 3;
+                    GDALResampleConvolutionHorizontal_AVX2(
+                        pChunk + (nSrcPixelStart - nChunkXOff), nChunkXSize,
+                        padfWeights, nSrcPixelCount, nVecPixelCount, nRows,
+                        padfHorizontalFiltered + iDstPixel - nDstXOff,
+                        nDstXSize);
+                    iSrcLineOff = nRows;
+                }
+            }
+#endif
 #ifdef USE_SSE2
             if (nSrcPixelCount == 4)
             {
@@ -3598,6 +3735,29 @@ static CPLErr GDALResampleChunk_ConvolutionT(
             // j used after for.
             size_t j =
                 (nSrcLineStart - nChunkYOff) * static_cast<size_t>(nDstXSize);
+#ifdef HAVE_OVERVIEW_AVX2
+            // Lines are accumulated in the same order as the SSE2 code below,
+            // so that results are identical. The Float64 working type uses
+            // the generic code, which has another summation order.
+            if constexpr (eWrkDataType == GDT_Float32)
+            {
+                if (bUseAVX2)
+                {
+                    iFilteredPixelOff = GDALResampleConvolutionVertical_AVX2(
+                        padfHorizontalFiltered + j, nDstXSize, padfWeights,
+                        nSrcLineCount, nDstXSize, pafDstScanline);
+                    j += iFilteredPixelOff;
+                    if (bHasNoData)
+                    {
+                        for (int k = 0; k < iFilteredPixelOff; k++)
+                        {
+                            pafDstScanline[k] =
+                                replaceValIfNodata(pafDstScanline[k]);
+                        }
+                    }
+                }
+            }
+#endif
 #ifdef USE_SSE2
             if constexpr (eWrkDataType == GDT_Float32)
             {
@@ -5108,6 +5268,435 @@ CPLErr GDALRegenerateOverviewsEx(GDALRasterBandH hSrcBand, int nOverviewCount,
     return eErr;
 }
 
+/************************************************************************/
+/*             GDALRegenerateOverviewsMultiBandSinglePass()             */
+/************************************************************************/
+
+// Whether GDALRegenerateOverviewsMultiBandSinglePass() gives the same result
+// as computing each overview level from the previous one once written: the
+// result of the resampling function must not depend on the chunking (no
+// kernel radius), each overview level must be smaller than the previous one,
+// and masks of overviews must be derived from their values.
+static bool GDALCanRegenerateOverviewsMultiBandSinglePass(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands, int nKernelRadius,
+    bool bUseNoDataMask)
+{
+    if (nKernelRadius != 0 || papoSrcBands[0]->IsMaskBand())
+        return false;
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        const auto poOvrBand = papapoOverviewBands[0][iOverview];
+        const auto poPrevBand = iOverview == 0
+                                    ? papoSrcBands[0]
+                                    : papapoOverviewBands[0][iOverview - 1];
+        if (poOvrBand->GetXSize() >= poPrevBand->GetXSize() ||
+            poOvrBand->GetYSize() >= poPrevBand->GetYSize())
+        {
+            return false;
+        }
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            const auto poBand = papapoOverviewBands[iBand][iOverview];
+            if (poBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE"))
+                return false;
+            if (bUseNoDataMask && poBand->GetMaskFlags() != GMF_NODATA &&
+                poBand->GetMaskFlags() != GMF_ALL_VALID)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Generate all overview levels in a single pass over the source bands. The
+// source is read by strips of full rows, and each overview level is computed
+// from the rows of the previous level kept in memory, instead of being read
+// back from the previous overview once it has been written, which avoids
+// decoding (and for lossy compression, degrading) each overview level again.
+static CPLErr GDALRegenerateOverviewsMultiBandSinglePass(
+    int nBands, GDALRasterBand *const *papoSrcBands, int nOverviews,
+    GDALRasterBand *const *const *papapoOverviewBands,
+    const char *pszResampling, GDALResampleFunction pfnResampleFn,
+    GDALDataType eDataType, GDALDataType eWrkDataType, bool bUseNoDataMask,
+    const std::vector<bool> &abHasNoData,
+    const std::vector<double> &adfNoDataValue, bool bPropagateNoData,
+    CPLJobQueue *poJobQueue, GIntBig nChunkMaxSize, double dfTotalPixelCount,
+    GDALProgressFunc pfnProgress, void *pProgressData)
+{
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDataType);
+    const int nWrkDTSize = GDALGetDataTypeSizeBytes(eWrkDataType);
+
+    // Rows [nYOff, nYEnd[ of a level (the source or an overview) kept in
+    // memory, in the working data type.
+    struct Level
+    {
+        int nWidth = 0;
+        int nHeight = 0;
+        int nYOff = 0;
+        int nYEnd = 0;
+        std::vector<std::vector<GByte>> aabyData{};
+        std::vector<std::vector<GByte>> aabyMask{};
+        // Rows [nPendingYOff, nYEnd[ of an overview level not written yet,
+        // in the data type of the bands.
+        int nPendingYOff = 0;
+        std::vector<std::vector<GByte>> aabyPendingRows{};
+    };
+
+    std::vector<Level> aoLevels(nOverviews + 1);
+    for (int iLevel = 0; iLevel <= nOverviews; ++iLevel)
+    {
+        auto poBand = iLevel == 0 ? papoSrcBands[0]
+                                  : papapoOverviewBands[0][iLevel - 1];
+        aoLevels[iLevel].nWidth = poBand->GetXSize();
+        aoLevels[iLevel].nHeight = poBand->GetYSize();
+        aoLevels[iLevel].aabyData.resize(nBands);
+        aoLevels[iLevel].aabyPendingRows.resize(nBands);
+        if (bUseNoDataMask)
+            aoLevels[iLevel].aabyMask.resize(nBands);
+    }
+
+    // Read the source by strips of whole blocks, of about nChunkMaxSize bytes.
+    const int nSrcWidth = aoLevels[0].nWidth;
+    const int nSrcHeight = aoLevels[0].nHeight;
+    int nSrcBlockYSize = 0;
+    papoSrcBands[0]->GetBlockSize(nullptr, &nSrcBlockYSize);
+    nSrcBlockYSize = std::max(1, nSrcBlockYSize);
+    const GIntBig nBlockRowSize = static_cast<GIntBig>(nSrcWidth) *
+                                  nSrcBlockYSize * nBands * nWrkDTSize;
+    const GIntBig nBlockRows =
+        std::max<GIntBig>(1, nChunkMaxSize / nBlockRowSize);
+    const int nStripHeight = static_cast<int>(
+        std::min<GIntBig>(nSrcHeight, nBlockRows * nSrcBlockYSize));
+
+    // Remove the rows of a level that are before nYOff.
+    const auto DiscardRows = [nBands, nWrkDTSize](Level &oLevel, int nYOff)
+    {
+        if (nYOff <= oLevel.nYOff)
+            return;
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            auto &abyData = oLevel.aabyData[iBand];
+            abyData.erase(abyData.begin(),
+                          abyData.begin() + static_cast<size_t>(nYOff -
+                                                                oLevel.nYOff) *
+                                                oLevel.nWidth * nWrkDTSize);
+            if (!oLevel.aabyMask.empty())
+            {
+                auto &abyMask = oLevel.aabyMask[iBand];
+                abyMask.erase(abyMask.begin(),
+                              abyMask.begin() +
+                                  static_cast<size_t>(nYOff - oLevel.nYOff) *
+                                      oLevel.nWidth);
+            }
+        }
+        oLevel.nYOff = nYOff;
+    };
+
+    // Append rows to a level, as values of the data type of the bands.
+    const auto AppendRows =
+        [nWrkDTSize, eDataType, eWrkDataType, bUseNoDataMask](
+            Level &oLevel, int iBand, const GByte *pabyRows, int nRows,
+            GDALRasterBand *poOvrBand)
+    {
+        const size_t nValues = static_cast<size_t>(nRows) * oLevel.nWidth;
+        auto &abyData = oLevel.aabyData[iBand];
+        const size_t nOldSize = abyData.size();
+        abyData.resize(nOldSize + nValues * nWrkDTSize);
+        GDALCopyWords64(pabyRows, eDataType,
+                        GDALGetDataTypeSizeBytes(eDataType),
+                        abyData.data() + nOldSize, eWrkDataType, nWrkDTSize,
+                        nValues);
+        if (!bUseNoDataMask)
+            return CE_None;
+
+        // Compute the mask as GDALNoDataMaskBand would do on the overview.
+        auto &abyMask = oLevel.aabyMask[iBand];
+        const size_t nOldMaskSize = abyMask.size();
+        abyMask.resize(nOldMaskSize + nValues, 255);
+        int bHasNoData = FALSE;
+        const double dfNoData = poOvrBand->GetNoDataValue(&bHasNoData);
+        if (!bHasNoData)
+            return CE_None;
+        std::unique_ptr<MEMDataset> poMEMDS(MEMDataset::Create(
+            "", oLevel.nWidth, nRows, 0, eDataType, nullptr));
+        GDALRasterBandH hMEMBand = MEMCreateRasterBandEx(
+            poMEMDS.get(), 1, const_cast<GByte *>(pabyRows), eDataType, 0, 0,
+            false);
+        poMEMDS->AddMEMBand(hMEMBand);
+        auto poMEMBand = poMEMDS->GetRasterBand(1);
+        poMEMBand->SetNoDataValue(dfNoData);
+        return poMEMBand->GetMaskBand()->RasterIO(
+            GF_Read, 0, 0, oLevel.nWidth, nRows, abyMask.data() + nOldMaskSize,
+            oLevel.nWidth, nRows, GDT_Byte, 0, 0, nullptr);
+    };
+
+    struct Job
+    {
+        GDALOverviewResampleArgs args{};
+        const void *pChunk = nullptr;
+        CPLErr eErr = CE_Failure;
+        void *pDstBuffer = nullptr;
+        GDALDataType eDstBufferDataType = GDT_Unknown;
+    };
+
+    double dfCurPixelCount = 0;
+    CPLErr eErr = CE_None;
+    std::vector<GByte> abyRows;
+    while (eErr == CE_None && aoLevels[0].nYEnd < nSrcHeight)
+    {
+        // Read the next strip of the source bands.
+        Level &oSrcLevel = aoLevels[0];
+        const int nRows = std::min(nStripHeight, nSrcHeight - oSrcLevel.nYEnd);
+        for (int iBand = 0; iBand < nBands && eErr == CE_None; ++iBand)
+        {
+            auto &abyData = oSrcLevel.aabyData[iBand];
+            const size_t nOldSize = abyData.size();
+            try
+            {
+                abyData.resize(nOldSize + static_cast<size_t>(nRows) *
+                                              nSrcWidth * nWrkDTSize);
+                if (bUseNoDataMask)
+                    oSrcLevel.aabyMask[iBand].resize(
+                        oSrcLevel.aabyMask[iBand].size() +
+                        static_cast<size_t>(nRows) * nSrcWidth);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating temporary buffer");
+                return CE_Failure;
+            }
+            eErr = papoSrcBands[iBand]->RasterIO(
+                GF_Read, 0, oSrcLevel.nYEnd, nSrcWidth, nRows,
+                abyData.data() + nOldSize, nSrcWidth, nRows, eWrkDataType, 0,
+                0, nullptr);
+            if (eErr == CE_None && bUseNoDataMask)
+            {
+                auto &abyMask = oSrcLevel.aabyMask[iBand];
+                eErr = papoSrcBands[iBand]->GetMaskBand()->RasterIO(
+                    GF_Read, 0, oSrcLevel.nYEnd, nSrcWidth, nRows,
+                    abyMask.data() + abyMask.size() -
+                        static_cast<size_t>(nRows) * nSrcWidth,
+                    nSrcWidth, nRows, GDT_Byte, 0, 0, nullptr);
+            }
+        }
+        oSrcLevel.nYEnd += nRows;
+
+        // Compute all the rows of each overview level that can be computed
+        // from the rows of the previous level.
+        for (int iLevel = 1; iLevel <= nOverviews && eErr == CE_None;
+             ++iLevel)
+        {
+            Level &oPrevLevel = aoLevels[iLevel - 1];
+            Level &oLevel = aoLevels[iLevel];
+            const double dfXRatioDstToSrc =
+                static_cast<double>(oPrevLevel.nWidth) / oLevel.nWidth;
+            const double dfYRatioDstToSrc =
+                static_cast<double>(oPrevLevel.nHeight) / oLevel.nHeight;
+
+            // Leave a margin of one row so that source rows of the last
+            // computed row are available, whatever the rounding.
+            const int nYEnd =
+                oPrevLevel.nYEnd == oPrevLevel.nHeight
+                    ? oLevel.nHeight
+                    : std::min(oLevel.nHeight,
+                               static_cast<int>((oPrevLevel.nYEnd - 1) /
+                                                dfYRatioDstToSrc));
+            if (nYEnd <= oLevel.nYEnd)
+                break;
+            const int nDstYOff = oLevel.nYEnd;
+            const int nDstRows = nYEnd - nDstYOff;
+
+            int nDstChunkXSize = 0;
+            papapoOverviewBands[0][iLevel - 1]->GetBlockSize(&nDstChunkXSize,
+                                                             nullptr);
+            if (!poJobQueue)
+                nDstChunkXSize = oLevel.nWidth;
+
+            std::vector<std::unique_ptr<Job>> apoJobs;
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                auto poDstBand = papapoOverviewBands[iBand][iLevel - 1];
+                const char *pszNBITS =
+                    poDstBand->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+                for (int nDstXOff = 0; nDstXOff < oLevel.nWidth;
+                     nDstXOff += nDstChunkXSize)
+                {
+                    auto poJob = std::make_unique<Job>();
+                    poJob->args.eOvrDataType = poDstBand->GetRasterDataType();
+                    poJob->args.nOvrXSize = oLevel.nWidth;
+                    poJob->args.nOvrYSize = oLevel.nHeight;
+                    poJob->args.nOvrNBITS = pszNBITS ? atoi(pszNBITS) : 0;
+                    poJob->args.dfXRatioDstToSrc = dfXRatioDstToSrc;
+                    poJob->args.dfYRatioDstToSrc = dfYRatioDstToSrc;
+                    poJob->args.eWrkDataType = eWrkDataType;
+                    poJob->pChunk = oPrevLevel.aabyData[iBand].data();
+                    poJob->args.pabyChunkNodataMask =
+                        bUseNoDataMask ? oPrevLevel.aabyMask[iBand].data()
+                                       : nullptr;
+                    poJob->args.nChunkXOff = 0;
+                    poJob->args.nChunkXSize = oPrevLevel.nWidth;
+                    poJob->args.nChunkYOff = oPrevLevel.nYOff;
+                    poJob->args.nChunkYSize =
+                        oPrevLevel.nYEnd - oPrevLevel.nYOff;
+                    poJob->args.nDstXOff = nDstXOff;
+                    poJob->args.nDstXOff2 =
+                        std::min(oLevel.nWidth, nDstXOff + nDstChunkXSize);
+                    poJob->args.nDstYOff = nDstYOff;
+                    poJob->args.nDstYOff2 = nYEnd;
+                    poJob->args.pszResampling = pszResampling;
+                    poJob->args.bHasNoData = abHasNoData[iBand];
+                    poJob->args.dfNoDataValue = adfNoDataValue[iBand];
+                    poJob->args.eSrcDataType = eDataType;
+                    poJob->args.bPropagateNoData = bPropagateNoData;
+                    apoJobs.push_back(std::move(poJob));
+                }
+            }
+
+            const auto RunJob = [pfnResampleFn](Job *poJob)
+            {
+                poJob->eErr =
+                    pfnResampleFn(poJob->args, poJob->pChunk,
+                                  &(poJob->pDstBuffer),
+                                  &(poJob->eDstBufferDataType));
+            };
+            for (auto &poJob : apoJobs)
+            {
+                if (poJobQueue)
+                {
+                    Job *poJobPtr = poJob.get();
+                    poJobQueue->SubmitJob([RunJob, poJobPtr]()
+                                          { RunJob(poJobPtr); });
+                }
+                else
+                {
+                    RunJob(poJob.get());
+                }
+            }
+            if (poJobQueue)
+                poJobQueue->WaitCompletion();
+
+            // Assemble the rows of each band, write them to the overview,
+            // and keep them to compute the next level.
+            try
+            {
+                abyRows.resize(static_cast<size_t>(nDstRows) * oLevel.nWidth *
+                               nDTSize);
+            }
+            catch (const std::exception &)
+            {
+                CPLError(CE_Failure, CPLE_OutOfMemory,
+                         "Out of memory allocating temporary buffer");
+                eErr = CE_Failure;
+            }
+            size_t iJob = 0;
+            for (int iBand = 0; iBand < nBands; ++iBand)
+            {
+                for (int nDstXOff = 0; nDstXOff < oLevel.nWidth;
+                     nDstXOff += nDstChunkXSize, ++iJob)
+                {
+                    const Job *poJob = apoJobs[iJob].get();
+                    std::unique_ptr<void, VSIFreeReleaser> pDstBuffer(
+                        poJob->pDstBuffer);
+                    if (eErr == CE_None)
+                        eErr = poJob->eErr;
+                    if (eErr != CE_None)
+                        continue;
+                    const int nDstXCount =
+                        poJob->args.nDstXOff2 - poJob->args.nDstXOff;
+                    const int nBufDTSize =
+                        GDALGetDataTypeSizeBytes(poJob->eDstBufferDataType);
+                    for (int iRow = 0; iRow < nDstRows; ++iRow)
+                    {
+                        GDALCopyWords64(
+                            static_cast<const GByte *>(pDstBuffer.get()) +
+                                static_cast<size_t>(iRow) * nDstXCount *
+                                    nBufDTSize,
+                            poJob->eDstBufferDataType, nBufDTSize,
+                            abyRows.data() +
+                                (static_cast<size_t>(iRow) * oLevel.nWidth +
+                                 nDstXOff) *
+                                    nDTSize,
+                            eDataType, nDTSize, nDstXCount);
+                    }
+                }
+                if (eErr != CE_None)
+                    continue;
+
+                auto &abyPending = oLevel.aabyPendingRows[iBand];
+                abyPending.insert(abyPending.end(), abyRows.begin(),
+                                  abyRows.end());
+                if (iLevel < nOverviews)
+                {
+                    eErr = AppendRows(oLevel, iBand, abyRows.data(), nDstRows,
+                                      papapoOverviewBands[iBand][iLevel - 1]);
+                }
+            }
+            oLevel.nYEnd = nYEnd;
+
+            // Write the pending rows that make complete rows of blocks of the
+            // overview, so that blocks are written, and compressed, once.
+            int nDstBlockYSize = 0;
+            papapoOverviewBands[0][iLevel - 1]->GetBlockSize(nullptr,
+                                                             &nDstBlockYSize);
+            nDstBlockYSize = std::max(1, nDstBlockYSize);
+            const int nWriteYEnd =
+                nYEnd == oLevel.nHeight
+                    ? nYEnd
+                    : nYEnd - (nYEnd % nDstBlockYSize);
+            const int nWriteRows = nWriteYEnd - oLevel.nPendingYOff;
+            for (int iBand = 0;
+                 iBand < nBands && eErr == CE_None && nWriteRows > 0; ++iBand)
+            {
+                auto &abyPending = oLevel.aabyPendingRows[iBand];
+                eErr = papapoOverviewBands[iBand][iLevel - 1]->RasterIO(
+                    GF_Write, 0, oLevel.nPendingYOff, oLevel.nWidth,
+                    nWriteRows, abyPending.data(), oLevel.nWidth, nWriteRows,
+                    eDataType, 0, 0, nullptr);
+                abyPending.erase(abyPending.begin(),
+                                 abyPending.begin() +
+                                     static_cast<size_t>(nWriteRows) *
+                                         oLevel.nWidth * nDTSize);
+            }
+            if (nWriteRows > 0)
+                oLevel.nPendingYOff = nWriteYEnd;
+
+            // Rows of the previous level before the source rows of the next
+            // row to compute are no longer needed.
+            DiscardRows(oPrevLevel,
+                        static_cast<int>(nYEnd * dfYRatioDstToSrc));
+
+            dfCurPixelCount += static_cast<double>(oLevel.nWidth) * nDstRows;
+        }
+
+        if (eErr == CE_None &&
+            !pfnProgress(std::min(1.0, dfCurPixelCount / dfTotalPixelCount),
+                         nullptr, pProgressData))
+        {
+            CPLError(CE_Failure, CPLE_UserInterrupt, "User terminated");
+            eErr = CE_Failure;
+        }
+    }
+
+    // Flush the data to overviews.
+    for (int iOverview = 0; iOverview < nOverviews; ++iOverview)
+    {
+        for (int iBand = 0; iBand < nBands; ++iBand)
+        {
+            if (papapoOverviewBands[iBand][iOverview]->FlushCache(false) !=
+                CE_None)
+                eErr = CE_Failure;
+        }
+    }
+
+    if (eErr == CE_None)
+        pfnProgress(1.0, nullptr, pProgressData);
+
+    return eErr;
+}
+
 /************************************************************************/
 /*            GDALRegenerateOverviewsMultiBand()                        */
 /************************************************************************/
@@ -5340,6 +5929,21 @@ CPLErr GDALRegenerateOverviewsMultiBand(
         return 100 * 1024 * 1024;
     }();
 
+    if (CPLTestBool(CPLGetConfigOption("GDAL_OVR_SINGLE_PASS", "NO")) &&
+        nSrcXOff == 0 && nSrcYOff == 0 && nSrcXSize == nToplevelSrcWidth &&
+        nSrcYSize == nToplevelSrcHeight &&
+        GDALCanRegenerateOverviewsMultiBandSinglePass(
+            nBands, papoSrcBands, nOverviews, papapoOverviewBands,
+            nKernelRadius, bUseNoDataMask))
+    {
+        return GDALRegenerateOverviewsMultiBandSinglePass(
+            nBands, papoSrcBands, nOverviews, papapoOverviewBands,
+            pszResampling, pfnResampleFn, eDataType, eWrkDataType,
+            bUseNoDataMask, abHasNoData, adfNoDataValue, bPropagateNoData,
+            poJobQueue.get(), nChunkMaxSize, dfTotalPixelCount, pfnProgress,
+            pProgressData);
+    }
+
     // Second pass to do the real job.
     double dfCurPixelCount = 0;
     CPLErr eErr = CE_None;
@@ -0,0 +1,417 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of overview resampling kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+#include "cpl_error.h"
+
+#include "overview_avx2.h"
+
+#ifdef HAVE_OVERVIEW_AVX2
+
+#include <immintrin.h>
+
+#include <cstring>
+
+// Note: on purpose, gdal_priv.h is not included, so that none of its inline
+// functions gets compiled with AVX2 instructions in this compilation unit.
+//
+// FMA instructions are deliberately not used: they are not covered by
+// CPLHaveRuntimeAVX2(), and the Gaussian filter below computes exactly the
+// same values as the generic code.
+
+namespace
+{
+
+/************************************************************************/
+/*                             FixupLanes()                             */
+/************************************************************************/
+
+// Pack instructions operate on each 128-bit lane separately: reorder the
+// 64-bit words of their result so that they are in memory order.
+inline __m256i FixupLanes(__m256i x)
+{
+    return _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+inline __m256 FixupLanes(__m256 x)
+{
+    return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x),
+                                                  _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+/************************************************************************/
+/*                               Load4()                                */
+/************************************************************************/
+
+// Load 4 values and convert them to double
+inline __m256d Load4(const GByte *p)
+{
+    int n;
+    memcpy(&n, p, sizeof(n));
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(n)));
+}
+
+inline __m256d Load4(const GUInt16 *p)
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p))));
+}
+
+inline __m256d Load4(const float *p)
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+inline __m256d Load4(const double *p)
+{
+    return _mm256_loadu_pd(p);
+}
+
+/************************************************************************/
+/*                               Store4()                               */
+/************************************************************************/
+
+inline void Store4(float *p, __m256d v)
+{
+    _mm_storeu_ps(p, _mm256_cvtpd_ps(v));
+}
+
+inline void Store4(double *p, __m256d v)
+{
+    _mm256_storeu_pd(p, v);
+}
+
+/************************************************************************/
+/*                              HorizSum()                              */
+/************************************************************************/
+
+inline double HorizSum(__m256d a)
+{
+    const __m128d s =
+        _mm_add_pd(_mm256_castpd256_pd128(a), _mm256_extractf128_pd(a, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+// Return the sums of the 4 values of a, b, c and d, in that order. Each sum
+// is computed as (x0 + x2) + (x1 + x3), like HorizSum() and
+// XMMReg4Double::GetHorizSum().
+inline __m256d HorizSum4(__m256d a, __m256d b, __m256d c, __m256d d)
+{
+    // [a0 + a2, a1 + a3, b0 + b2, b1 + b3]
+    const __m256d ab = _mm256_add_pd(_mm256_permute2f128_pd(a, b, 0x20),
+                                     _mm256_permute2f128_pd(a, b, 0x31));
+    // [c0 + c2, c1 + c3, d0 + d2, d1 + d3]
+    const __m256d cd = _mm256_add_pd(_mm256_permute2f128_pd(c, d, 0x20),
+                                     _mm256_permute2f128_pd(c, d, 0x31));
+    // [a, c, b, d] reordered as [a, b, c, d]
+    return _mm256_permute4x64_pd(_mm256_hadd_pd(ab, cd), 0xD8);
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALAverage2x2Byte_AVX2()                       */
+/************************************************************************/
+
+int GDALAverage2x2Byte_AVX2(int nDstXWidth, int nChunkXSize,
+                            const GByte *&pSrcInOut, GByte *pDst)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto two16 = _mm256_set1_epi16(2);
+    const GByte *CPL_RESTRICT pSrc = pSrcInOut;
+
+    // Compute 16 output pixels from 32 bytes of each line
+    const auto Average16 = [zero, two16, nChunkXSize](const GByte *p)
+    {
+        const auto firstLine =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const auto secondLine = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p + nChunkXSize));
+        // Vertical addition of the values extended to UInt16
+        const auto sumLo =
+            _mm256_add_epi16(_mm256_unpacklo_epi8(firstLine, zero),
+                             _mm256_unpacklo_epi8(secondLine, zero));
+        const auto sumHi =
+            _mm256_add_epi16(_mm256_unpackhi_epi8(firstLine, zero),
+                             _mm256_unpackhi_epi8(secondLine, zero));
+        // Horizontal addition of adjacent pairs. Thanks to the lane
+        // organization of unpack and hadd, the result is in memory order.
+        const auto sum = _mm256_hadd_epi16(sumLo, sumHi);
+        // average = (sum + 2) / 4
+        return _mm256_srli_epi16(_mm256_add_epi16(sum, two16), 2);
+    };
+
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - 31; iDstPixel += 32)
+    {
+        const auto average0 = Average16(pSrc);
+        const auto average1 = Average16(pSrc + 32);
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(pDst + iDstPixel),
+            FixupLanes(_mm256_packus_epi16(average0, average1)));
+        pSrc += 64;
+    }
+
+    pSrcInOut = pSrc;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*                     GDALAverage2x2UInt16_AVX2()                      */
+/************************************************************************/
+
+int GDALAverage2x2UInt16_AVX2(int nDstXWidth, int nChunkXSize,
+                              const GUInt16 *&pSrcInOut, GUInt16 *pDst)
+{
+    const auto mask = _mm256_set1_epi32(0xFFFF);
+    const auto two = _mm256_set1_epi32(2);
+    const GUInt16 *CPL_RESTRICT pSrc = pSrcInOut;
+
+    // Compute 8 output pixels, as UInt32, from 16 values of each line
+    const auto Average8 = [mask, two, nChunkXSize](const GUInt16 *p)
+    {
+        const auto firstLine =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        const auto secondLine = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(p + nChunkXSize));
+        // Horizontal addition and extension to 32 bit
+        const auto horizAddFirstLine =
+            _mm256_add_epi32(_mm256_and_si256(firstLine, mask),
+                             _mm256_srli_epi32(firstLine, 16));
+        const auto horizAddSecondLine =
+            _mm256_add_epi32(_mm256_and_si256(secondLine, mask),
+                             _mm256_srli_epi32(secondLine, 16));
+        // average = (sum + 2) >> 2
+        return _mm256_srli_epi32(
+            _mm256_add_epi32(
+                _mm256_add_epi32(horizAddFirstLine, horizAddSecondLine), two),
+            2);
+    };
+
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - 15; iDstPixel += 16)
+    {
+        const auto averageLow = Average8(pSrc);
+        const auto averageHigh = Average8(pSrc + 16);
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(pDst + iDstPixel),
+            FixupLanes(_mm256_packus_epi32(averageLow, averageHigh)));
+        pSrc += 32;
+    }
+
+    pSrcInOut = pSrc;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*                      GDALAverage2x2Float_AVX2()                      */
+/************************************************************************/
+
+int GDALAverage2x2Float_AVX2(int nDstXWidth, int nChunkXSize,
+                             const float *&pSrcInOut, float *pDst)
+{
+    const auto zeroDot25 = _mm256_set1_ps(0.25f);
+    const float *CPL_RESTRICT pSrc = pSrcInOut;
+
+    int iDstPixel = 0;
+    for (; iDstPixel < nDstXWidth - 7; iDstPixel += 8)
+    {
+        // Vertical addition of 16 values of each line
+        const auto sumLo = _mm256_add_ps(_mm256_loadu_ps(pSrc),
+                                         _mm256_loadu_ps(pSrc + nChunkXSize));
+        const auto sumHi =
+            _mm256_add_ps(_mm256_loadu_ps(pSrc + 8),
+                          _mm256_loadu_ps(pSrc + 8 + nChunkXSize));
+
+        // Horizontal addition, in the same order as the SSE2 code path
+        const auto sum = FixupLanes(_mm256_hadd_ps(sumLo, sumHi));
+
+        _mm256_storeu_ps(pDst + iDstPixel, _mm256_mul_ps(sum, zeroDot25));
+        pSrc += 16;
+    }
+
+    pSrcInOut = pSrc;
+    return iDstPixel;
+}
+
+/************************************************************************/
+/*              GDALResampleConvolutionHorizontal_AVX2()                */
+/************************************************************************/
+
+template <class T>
+void GDALResampleConvolutionHorizontal_AVX2(const T *pChunk,
+                                            size_t nChunkStride,
+                                            const double *padfWeights,
+                                            int nSrcPixelCount,
+                                            int nVecPixelCount, int nRows,
+                                            double *padfDst, size_t nDstStride)
+{
+    CPLAssert((nVecPixelCount % 4) == 0 && nVecPixelCount <= nSrcPixelCount);
+
+    // Process 4 lines at a time, to amortize the load of the weights and
+    // the horizontal additions.
+    int iRow = 0;
+    for (; iRow + 3 < nRows; iRow += 4)
+    {
+        const T *const pRow0 = pChunk + iRow * nChunkStride;
+        const T *const pRow1 = pRow0 + nChunkStride;
+        const T *const pRow2 = pRow1 + nChunkStride;
+        const T *const pRow3 = pRow2 + nChunkStride;
+        auto acc0 = _mm256_setzero_pd();
+        auto acc1 = _mm256_setzero_pd();
+        auto acc2 = _mm256_setzero_pd();
+        auto acc3 = _mm256_setzero_pd();
+        for (int i = 0; i < nVecPixelCount; i += 4)
+        {
+            const auto w = _mm256_loadu_pd(padfWeights + i);
+            acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(Load4(pRow0 + i), w));
+            acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(Load4(pRow1 + i), w));
+            acc2 = _mm256_add_pd(acc2, _mm256_mul_pd(Load4(pRow2 + i), w));
+            acc3 = _mm256_add_pd(acc3, _mm256_mul_pd(Load4(pRow3 + i), w));
+        }
+        double adfSum[4];
+        _mm256_storeu_pd(adfSum, HorizSum4(acc0, acc1, acc2, acc3));
+        for (int i = nVecPixelCount; i < nSrcPixelCount; ++i)
+        {
+            const double dfWeight = padfWeights[i];
+            adfSum[0] += pRow0[i] * dfWeight;
+            adfSum[1] += pRow1[i] * dfWeight;
+            adfSum[2] += pRow2[i] * dfWeight;
+            adfSum[3] += pRow3[i] * dfWeight;
+        }
+        padfDst[iRow * nDstStride] = adfSum[0];
+        padfDst[(iRow + 1) * nDstStride] = adfSum[1];
+        padfDst[(iRow + 2) * nDstStride] = adfSum[2];
+        padfDst[(iRow + 3) * nDstStride] = adfSum[3];
+    }
+
+    for (; iRow < nRows; ++iRow)
+    {
+        const T *const pRow = pChunk + iRow * nChunkStride;
+        auto acc = _mm256_setzero_pd();
+        for (int i = 0; i < nVecPixelCount; i += 4)
+        {
+            acc = _mm256_add_pd(acc, _mm256_mul_pd(Load4(pRow + i),
+                                                   _mm256_loadu_pd(
+                                                       padfWeights + i)));
+        }
+        double dfSum = HorizSum(acc);
+        for (int i = nVecPixelCount; i < nSrcPixelCount; ++i)
+            dfSum += pRow[i] * padfWeights[i];
+        padfDst[iRow * nDstStride] = dfSum;
+    }
+}
+
+template void GDALResampleConvolutionHorizontal_AVX2<GByte>(
+    const GByte *, size_t, const double *, int, int, int, double *, size_t);
+template void GDALResampleConvolutionHorizontal_AVX2<GUInt16>(
+    const GUInt16 *, size_t, const double *, int, int, int, double *, size_t);
+
+/************************************************************************/
+/*               GDALResampleConvolutionVertical_AVX2()                 */
+/************************************************************************/
+
+template <class Twork>
+int GDALResampleConvolutionVertical_AVX2(const double *padfSrc, size_t nStride,
+                                         const double *padfWeights,
+                                         int nSrcLineCount, int nCols,
+                                         Twork *pDst)
+{
+    int iCol = 0;
+    for (; iCol < nCols - 15; iCol += 16)
+    {
+        auto acc0 = _mm256_setzero_pd();
+        auto acc1 = _mm256_setzero_pd();
+        auto acc2 = _mm256_setzero_pd();
+        auto acc3 = _mm256_setzero_pd();
+        const double *p = padfSrc + iCol;
+        for (int i = 0; i < nSrcLineCount; ++i, p += nStride)
+        {
+            const auto w = _mm256_broadcast_sd(padfWeights + i);
+            acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(p), w));
+            acc1 =
+                _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(p + 4), w));
+            acc2 =
+                _mm256_add_pd(acc2, _mm256_mul_pd(_mm256_loadu_pd(p + 8), w));
+            acc3 =
+                _mm256_add_pd(acc3, _mm256_mul_pd(_mm256_loadu_pd(p + 12), w));
+        }
+        Store4(pDst + iCol, acc0);
+        Store4(pDst + iCol + 4, acc1);
+        Store4(pDst + iCol + 8, acc2);
+        Store4(pDst + iCol + 12, acc3);
+    }
+    return iCol;
+}
+
+template int GDALResampleConvolutionVertical_AVX2<float>(const double *,
+                                                         size_t,
+                                                         const double *, int,
+                                                         int, float *);
+
+/************************************************************************/
+/*                       GDALResampleGauss_AVX2()                       */
+/************************************************************************/
+
+void GDALResampleGauss_AVX2(const double *padfSrc, size_t nSrcStride,
+                            int nRows, int nCols, const int *panWeights,
+                            int nWeightStride, const int *panSrcXOff,
+                            int nDstCount, double *padfDst)
+{
+    GInt64 nWeightSum = 0;
+    for (int j = 0; j < nRows; ++j)
+    {
+        for (int i = 0; i < nCols; ++i)
+            nWeightSum += panWeights[j * nWeightStride + i];
+    }
+    const double dfWeightSum = static_cast<double>(nWeightSum);
+
+    // Compute 4 output pixels at a time, gathering the source values of
+    // their windows. Each lane accumulates in the same order as the generic
+    // code, so that results are identical.
+    int iDst = 0;
+    for (; iDst < nDstCount - 3; iDst += 4)
+    {
+        const auto offsets = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(panSrcXOff + iDst));
+        auto acc = _mm256_setzero_pd();
+        const double *padfLine = padfSrc;
+        const int *panLineWeight = panWeights;
+        for (int j = 0; j < nRows;
+             ++j, padfLine += nSrcStride, panLineWeight += nWeightStride)
+        {
+            for (int i = 0; i < nCols; ++i)
+            {
+                const auto val = _mm256_i32gather_pd(padfLine + i, offsets, 8);
+                acc = _mm256_add_pd(
+                    acc, _mm256_mul_pd(val, _mm256_set1_pd(panLineWeight[i])));
+            }
+        }
+        _mm256_storeu_pd(padfDst + iDst,
+                         _mm256_div_pd(acc, _mm256_set1_pd(dfWeightSum)));
+    }
+
+    for (; iDst < nDstCount; ++iDst)
+    {
+        double dfTotal = 0;
+        const double *padfLine = padfSrc + panSrcXOff[iDst];
+        const int *panLineWeight = panWeights;
+        for (int j = 0; j < nRows;
+             ++j, padfLine += nSrcStride, panLineWeight += nWeightStride)
+        {
+            for (int i = 0; i < nCols; ++i)
+                dfTotal += padfLine[i] * panLineWeight[i];
+        }
+        padfDst[iDst] = dfTotal / dfWeightSum;
+    }
+}
+
+#endif  // HAVE_OVERVIEW_AVX2
@@ -0,0 +1,82 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of overview resampling kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef OVERVIEW_AVX2_H_INCLUDED
+#define OVERVIEW_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+#include <cstddef>
+
+//! @cond Doxygen_Suppress
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#define HAVE_OVERVIEW_AVX2
+
+// Those functions must only be called if CPLHaveRuntimeAVX2() is true.
+
+// Average by a factor of 2 of the line pointed by pSrc and the next one,
+// nChunkXSize pixels after it, into pDst. Integer results are rounded to the
+// nearest, with the same formula as the generic code.
+// Return the number of output pixels computed, which is a multiple of the
+// vector width and at most nDstXWidth, and advance pSrc accordingly.
+int GDALAverage2x2Byte_AVX2(int nDstXWidth, int nChunkXSize,
+                            const GByte *&pSrc, GByte *pDst);
+int GDALAverage2x2UInt16_AVX2(int nDstXWidth, int nChunkXSize,
+                              const GUInt16 *&pSrc, GUInt16 *pDst);
+int GDALAverage2x2Float_AVX2(int nDstXWidth, int nChunkXSize,
+                             const float *&pSrc, float *pDst);
+
+// Horizontal pass of the separable convolution for one output pixel: for
+// each of the nRows lines of pChunk, separated by nChunkStride pixels,
+// padfDst[iRow * nDstStride] is set to the sum of the nSrcPixelCount first
+// pixels of the line multiplied by padfWeights.
+// The products of the nVecPixelCount first pixels (a multiple of 4) are
+// accumulated in 4 lanes, which are then summed as (l0 + l2) + (l1 + l3),
+// and the remaining ones are added sequentially. This is the order of the
+// SSE2 code paths of overview.cpp, so that results are identical.
+// Instantiated for T = GByte and GUInt16.
+template <class T>
+void GDALResampleConvolutionHorizontal_AVX2(const T *pChunk,
+                                            size_t nChunkStride,
+                                            const double *padfWeights,
+                                            int nSrcPixelCount,
+                                            int nVecPixelCount, int nRows,
+                                            double *padfDst, size_t nDstStride);
+
+// Vertical pass of the separable convolution for one output line: pDst[i] is
+// set to the sum of padfSrc[i + j * nStride] * padfWeights[j], for j in
+// [0, nSrcLineCount[.
+// Return the number of output pixels computed, which is a multiple of 16 and
+// at most nCols.
+// Instantiated for Twork = float.
+template <class Twork>
+int GDALResampleConvolutionVertical_AVX2(const double *padfSrc, size_t nStride,
+                                         const double *padfWeights,
+                                         int nSrcLineCount, int nCols,
+                                         Twork *pDst);
+
+// Gaussian filter of nDstCount output pixels whose source windows are made of
+// the nRows lines of padfSrc, separated by nSrcStride values, and of the nCols
+// columns starting at panSrcXOff[i]. panWeights points to the weight of the
+// top left pixel of the windows, and weight lines are separated by
+// nWeightStride values.
+void GDALResampleGauss_AVX2(const double *padfSrc, size_t nSrcStride,
+                            int nRows, int nCols, const int *panWeights,
+                            int nWeightStride, const int *panSrcXOff,
+                            int nDstCount, double *padfDst);
+
+#endif
+
+//! @endcond
+
+#endif /* OVERVIEW_AVX2_H_INCLUDED */
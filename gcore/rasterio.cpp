@@ -26,8 +26,11 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_cpu_features.h"
@@ -37,6 +40,7 @@
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal_priv_templates.hpp"
+#include "gdal_thread_pool.h"
 #include "gdal_vrt.h"
 #include "gdalwarper.h"
 #include "memdataset.h"
@@ -57,6 +61,8 @@
 #endif
 #endif
 
+#include "rasterio_avx2.h"
+
 #ifdef __SSE4_1__
 #include <smmintrin.h>
 #endif
@@ -254,6 +260,91 @@ CPLErr GDALRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
          (nXOff == psExtraArg->dfXOff && nYOff == psExtraArg->dfYOff &&
           nXSize == psExtraArg->dfXSize && nYSize == psExtraArg->dfYSize));
 
+    /* ==================================================================== */
+    /*      Reads of exactly one block column, in the data type of the      */
+    /*      band, into a packed buffer: blocks that are not in the cache    */
+    /*      are read directly into the buffer, which saves a copy and       */
+    /*      avoids evicting other blocks. Cached blocks are copied, as they */
+    /*      might be dirty. The remaining lines, if any, are read           */
+    /*      separately. This is not done for nested requests issued by      */
+    /*      IReadBlock(), which could otherwise recurse endlessly, since    */
+    /*      the block is not put in the cache while it is read.             */
+    /* ==================================================================== */
+    static thread_local bool tl_bInDirectBlockRead = false;
+    if (eRWFlag == GF_Read && !tl_bInDirectBlockRead && eDataType == eBufType &&
+        nPixelSpace == nBufDataSize && nXSize == nBlockXSize &&
+        nLineSpace == nPixelSpace * nXSize && nXOff % nBlockXSize == 0 &&
+        nYOff % nBlockYSize == 0 && nYSize >= nBlockYSize &&
+        nBufXSize == nXSize && nBufYSize == nYSize && bUseIntegerRequestCoords)
+    {
+        const int nLBlockX = nXOff / nBlockXSize;
+        const int nFullBlockLines = nYSize - nYSize % nBlockYSize;
+        const size_t nBlockBytes =
+            static_cast<size_t>(nLineSpace) * nBlockYSize;
+        for (int iBufYOff = 0; iBufYOff < nFullBlockLines;
+             iBufYOff += nBlockYSize)
+        {
+            const int nLBlockY = (nYOff + iBufYOff) / nBlockYSize;
+            GByte *pabyDst = static_cast<GByte *>(pData) +
+                             static_cast<GPtrDiff_t>(iBufYOff) * nLineSpace;
+            poBlock = TryGetLockedBlockRef(nLBlockX, nLBlockY);
+            if (poBlock)
+            {
+                memcpy(pabyDst, poBlock->GetDataRef(), nBlockBytes);
+                poBlock->DropLock();
+            }
+            else
+            {
+                const GUInt32 nErrorCounter = CPLGetErrorCounter();
+                tl_bInDirectBlockRead = true;
+                const CPLErr eErr = ReadBlock(nLBlockX, nLBlockY, pabyDst);
+                tl_bInDirectBlockRead = false;
+                if (eErr != CE_None)
+                {
+                    CPLError(CE_Failure, CPLE_AppDefined,
+                             "IReadBlock failed at X offset %d, Y offset %d%s",
+                             nLBlockX, nLBlockY,
+                             (nErrorCounter != CPLGetErrorCounter())
+                                 ? CPLSPrintf(": %s", CPLGetLastErrorMsg())
+                                 : "");
+                    return CE_Failure;
+                }
+            }
+
+            if (psExtraArg->pfnProgress != nullptr &&
+                !psExtraArg->pfnProgress(
+                    1.0 * (iBufYOff + nBlockYSize) / nBufYSize, "",
+                    psExtraArg->pProgressData))
+            {
+                return CE_Failure;
+            }
+        }
+        if (nFullBlockLines == nYSize)
+            return CE_None;
+
+        GDALRasterIOExtraArg sExtraArg;
+        GDALCopyRasterIOExtraArg(&sExtraArg, psExtraArg);
+        void *pProgressDataScaled = nullptr;
+        if (psExtraArg->pfnProgress != nullptr)
+        {
+            pProgressDataScaled = GDALCreateScaledProgress(
+                1.0 * nFullBlockLines / nBufYSize, 1.0,
+                psExtraArg->pfnProgress, psExtraArg->pProgressData);
+            sExtraArg.pfnProgress = GDALScaledProgress;
+            sExtraArg.pProgressData = pProgressDataScaled;
+        }
+        const int nRemainingLines = nYSize - nFullBlockLines;
+        sExtraArg.bFloatingPointWindowValidity = false;
+        const CPLErr eErr = GDALRasterBand::IRasterIO(
+            eRWFlag, nXOff, nYOff + nFullBlockLines, nXSize, nRemainingLines,
+            static_cast<GByte *>(pData) +
+                static_cast<GPtrDiff_t>(nFullBlockLines) * nLineSpace,
+            nBufXSize, nRemainingLines, eBufType, nPixelSpace, nLineSpace,
+            &sExtraArg);
+        GDALDestroyScaledProgress(pProgressDataScaled);
+        return eErr;
+    }
+
     /* ==================================================================== */
     /*      A common case is the data requested with the destination        */
     /*      is packed, and the block width is the raster width.             */
@@ -1289,33 +1380,130 @@ CPLErr GDALRasterBand::RasterIOResampled(
         if (nFullResYSizeQueried > nRasterYSize)
             nFullResYSizeQueried = nRasterYSize;
 
-        void *pChunk =
-            VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eWrkDataType),
-                                nFullResXSizeQueried, nFullResYSizeQueried);
-        GByte *pabyChunkNoDataMask = nullptr;
-
         GDALRasterBand *poMaskBand = GetMaskBand();
         int l_nMaskFlags = GetMaskFlags();
 
         bool bUseNoDataMask = ((l_nMaskFlags & GMF_ALL_VALID) == 0);
-        if (bUseNoDataMask)
-        {
-            pabyChunkNoDataMask = static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
-                nFullResXSizeQueried, nFullResYSizeQueried));
-        }
-        if (pChunk == nullptr ||
-            (bUseNoDataMask && pabyChunkNoDataMask == nullptr))
-        {
-            GDALClose(poMEMDS);
-            CPLFree(pChunk);
-            CPLFree(pabyChunkNoDataMask);
-            VSIFree(pTempBuffer);
-            return CE_Failure;
-        }
 
         const int nTotalBlocks = DIV_ROUND_UP(nBufXSize, nDstBlockXSize) *
                                  DIV_ROUND_UP(nBufYSize, nDstBlockYSize);
+
+        // Source chunks are read from this thread, as the band may not be
+        // accessed concurrently, but they can be resampled by worker threads
+        // while the next ones are read. Chunk buffers are recycled, so that
+        // at most nThreads of them are allocated at the same time.
+        const char *pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+        const int nThreads = std::max(
+            1, std::min(128, EQUAL(pszThreads, "ALL_CPUS")
+                                 ? CPLGetNumCPUs()
+                                 : atoi(pszThreads)));
+        auto poThreadPool = nThreads > 1 && nTotalBlocks > 1
+                                ? GDALGetGlobalThreadPool(nThreads)
+                                : nullptr;
+        // A job of the global pool waiting for other jobs of that pool could
+        // deadlock if they are queued behind other waiting jobs (for example
+        // chunks of VRTDataset::ThreadedChunkedRasterIO()), so resample
+        // serially in that case.
+        if (poThreadPool && poThreadPool->IsCurrentThreadWorker())
+            poThreadPool = nullptr;
+        auto poJobQueue = poThreadPool ? poThreadPool->CreateJobQueue()
+                                       : std::unique_ptr<CPLJobQueue>(nullptr);
+
+        struct ChunkBuffers
+        {
+            void *pChunk = nullptr;
+            GByte *pabyChunkNoDataMask = nullptr;
+
+            ChunkBuffers() = default;
+
+            ~ChunkBuffers()
+            {
+                CPLFree(pChunk);
+                CPLFree(pabyChunkNoDataMask);
+            }
+
+            CPL_DISALLOW_COPY_ASSIGN(ChunkBuffers)
+        };
+
+        std::mutex oMutex;
+        // Protected by oMutex
+        std::vector<std::unique_ptr<ChunkBuffers>> apoFreeBuffers{};
         int nBlocksDone = 0;
+        bool bJobFailed = false;
+
+        const auto AcquireBuffers = [&]() -> std::unique_ptr<ChunkBuffers>
+        {
+            {
+                std::lock_guard oLock(oMutex);
+                if (!apoFreeBuffers.empty())
+                {
+                    auto poBuffers = std::move(apoFreeBuffers.back());
+                    apoFreeBuffers.pop_back();
+                    return poBuffers;
+                }
+            }
+            auto poBuffers = std::make_unique<ChunkBuffers>();
+            poBuffers->pChunk =
+                VSI_MALLOC3_VERBOSE(GDALGetDataTypeSizeBytes(eWrkDataType),
+                                    nFullResXSizeQueried, nFullResYSizeQueried);
+            if (bUseNoDataMask)
+            {
+                poBuffers->pabyChunkNoDataMask =
+                    static_cast<GByte *>(VSI_MALLOC2_VERBOSE(
+                        nFullResXSizeQueried, nFullResYSizeQueried));
+            }
+            if (poBuffers->pChunk == nullptr ||
+                (bUseNoDataMask && poBuffers->pabyChunkNoDataMask == nullptr))
+            {
+                return nullptr;
+            }
+            return poBuffers;
+        };
+
+        const auto ReleaseBuffers =
+            [&oMutex, &apoFreeBuffers,
+             &nBlocksDone](std::unique_ptr<ChunkBuffers> poBuffers)
+        {
+            std::lock_guard oLock(oMutex);
+            apoFreeBuffers.push_back(std::move(poBuffers));
+            ++nBlocksDone;
+        };
+
+        // Resample a chunk and write the result in the output buffer. This
+        // is what a RasterIO() on poMEMDS would do, but can be safely called
+        // from several threads as their output windows do not overlap.
+        const auto ResampleChunk =
+            [pfnResampleFunc, pDataMem, nPSMem, nLSMem, eDTMem,
+             nDestXOffVirtual,
+             nDestYOffVirtual](const GDALOverviewResampleArgs &args,
+                               const void *pChunk)
+        {
+            void *pDstBuffer = nullptr;
+            GDALDataType eDstBufferDataType = GDT_Unknown;
+            const CPLErr eResampleErr =
+                pfnResampleFunc(args, pChunk, &pDstBuffer, &eDstBufferDataType);
+            if (eResampleErr == CE_None)
+            {
+                const int nDstXCount = args.nDstXOff2 - args.nDstXOff;
+                const size_t nDstLineSize =
+                    static_cast<size_t>(nDstXCount) *
+                    GDALGetDataTypeSizeBytes(eDstBufferDataType);
+                for (int iY = args.nDstYOff; iY < args.nDstYOff2; ++iY)
+                {
+                    GDALCopyWords64(
+                        static_cast<GByte *>(pDstBuffer) +
+                            (iY - args.nDstYOff) * nDstLineSize,
+                        eDstBufferDataType,
+                        GDALGetDataTypeSizeBytes(eDstBufferDataType),
+                        static_cast<GByte *>(pDataMem) +
+                            nLSMem * (iY - nDestYOffVirtual) +
+                            nPSMem * (args.nDstXOff - nDestXOffVirtual),
+                        eDTMem, static_cast<int>(nPSMem), nDstXCount);
+                }
+            }
+            CPLFree(pDstBuffer);
+            return eResampleErr;
+        };
 
         int nDstYOff;
         for (nDstYOff = 0; nDstYOff < nBufYSize && eErr == CE_None;
@@ -1382,6 +1570,27 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     nChunkXSizeQueried = nRasterXSize - nChunkXOffQueried;
                 CPLAssert(nChunkXSizeQueried <= nFullResXSizeQueried);
 
+                if (poJobQueue)
+                {
+                    // Wait for a worker thread to be available.
+                    poJobQueue->WaitCompletion(nThreads - 1);
+                    std::lock_guard oLock(oMutex);
+                    if (bJobFailed)
+                    {
+                        eErr = CE_Failure;
+                        break;
+                    }
+                }
+
+                auto poBuffers = AcquireBuffers();
+                if (!poBuffers)
+                {
+                    eErr = CE_Failure;
+                    break;
+                }
+                void *pChunk = poBuffers->pChunk;
+                GByte *pabyChunkNoDataMask = poBuffers->pabyChunkNoDataMask;
+
                 // Read the source buffers.
                 eErr = RasterIO(GF_Read, nChunkXOffQueried, nChunkYOffQueried,
                                 nChunkXSizeQueried, nChunkYSizeQueried, pChunk,
@@ -1433,8 +1642,6 @@ CPLErr GDALRasterBand::RasterIOResampled(
                 if (!bSkipResample && eErr == CE_None)
                 {
                     const bool bPropagateNoData = false;
-                    void *pDstBuffer = nullptr;
-                    GDALDataType eDstBufferDataType = GDT_Unknown;
                     GDALRasterBand *poMEMBand =
                         GDALRasterBand::FromHandle(hMEMBand);
                     GDALOverviewResampleArgs args;
@@ -1467,22 +1674,49 @@ CPLErr GDALRasterBand::RasterIOResampled(
                     args.dfNoDataValue = dfNoDataValue;
                     args.poColorTable = GetColorTable();
                     args.bPropagateNoData = bPropagateNoData;
-                    eErr = pfnResampleFunc(args, pChunk, &pDstBuffer,
-                                           &eDstBufferDataType);
-                    if (eErr == CE_None)
+
+                    if (poJobQueue)
+                    {
+                        // std::function<> requires a copyable functor, hence
+                        // the raw pointer.
+                        ChunkBuffers *poJobBuffers = poBuffers.release();
+                        const auto Job = [&ResampleChunk, &ReleaseBuffers,
+                                          &oMutex, &bJobFailed, args,
+                                          poJobBuffers]()
+                        {
+                            std::unique_ptr<ChunkBuffers> poBuffersToRelease(
+                                poJobBuffers);
+                            if (ResampleChunk(args,
+                                              poBuffersToRelease->pChunk) !=
+                                CE_None)
+                            {
+                                std::lock_guard oLock(oMutex);
+                                bJobFailed = true;
+                            }
+                            ReleaseBuffers(std::move(poBuffersToRelease));
+                        };
+                        if (!poJobQueue->SubmitJob(Job))
+                        {
+                            Job();
+                        }
+                    }
+                    else
                     {
-                        eErr = poMEMBand->RasterIO(
-                            GF_Write, nDstXOff + nDestXOffVirtual,
-                            nDstYOff + nDestYOffVirtual, nDstXCount, nDstYCount,
-                            pDstBuffer, nDstXCount, nDstYCount,
-                            eDstBufferDataType, 0, 0, nullptr);
+                        eErr = ResampleChunk(args, pChunk);
                     }
-                    CPLFree(pDstBuffer);
                 }
 
-                nBlocksDone++;
+                if (poBuffers)
+                    ReleaseBuffers(std::move(poBuffers));
+
+                int nBlocksDoneCopy;
+                {
+                    std::lock_guard oLock(oMutex);
+                    nBlocksDoneCopy = nBlocksDone;
+                }
                 if (eErr == CE_None && psExtraArg->pfnProgress != nullptr &&
-                    !psExtraArg->pfnProgress(1.0 * nBlocksDone / nTotalBlocks,
+                    !psExtraArg->pfnProgress(1.0 * nBlocksDoneCopy /
+                                                 nTotalBlocks,
                                              "", psExtraArg->pProgressData))
                 {
                     eErr = CE_Failure;
@@ -1490,8 +1724,19 @@ CPLErr GDALRasterBand::RasterIOResampled(
             }
         }
 
-        CPLFree(pChunk);
-        CPLFree(pabyChunkNoDataMask);
+        if (poJobQueue)
+        {
+            // Even on error, jobs must be completed as they reference local
+            // variables.
+            poJobQueue->WaitCompletion();
+            if (bJobFailed)
+                eErr = CE_Failure;
+            if (eErr == CE_None && psExtraArg->pfnProgress != nullptr &&
+                !psExtraArg->pfnProgress(1.0, "", psExtraArg->pProgressData))
+            {
+                eErr = CE_Failure;
+            }
+        }
     }
 
     if (eBufType != eDataType)
@@ -3930,6 +4175,34 @@ void CPL_STDCALL GDALCopyWords64(const void *CPL_RESTRICT pSrcData,
         }
     }
 
+#ifdef HAVE_COPYWORDS_AVX2
+    // Packed buffers are converted with AVX2 when the pair of types is
+    // handled, complex values being processed as pairs of components. The
+    // remaining words, if any, go through the generic code below.
+    // CPLHaveRuntimeAVX2() reads the GDAL_USE_AVX2 configuration option in
+    // debug builds, which is too slow to be done on each call.
+    static const bool bHasAVX2 = CPLHaveRuntimeAVX2();
+    if (nWordCount >= 16 && nSrcPixelStride == nSrcDataTypeSize &&
+        nDstPixelStride == nDstDataTypeSize &&
+        GDALDataTypeIsComplex(eSrcType) == GDALDataTypeIsComplex(eDstType) &&
+        bHasAVX2)
+    {
+        const int nComponents = GDALDataTypeIsComplex(eSrcType) ? 2 : 1;
+        const size_t nDone =
+            GDALCopyWordsPacked_AVX2(
+                pSrcData, GDALGetNonComplexDataType(eSrcType), pDstData,
+                GDALGetNonComplexDataType(eDstType),
+                static_cast<size_t>(nWordCount) * nComponents) /
+            nComponents;
+        if (nDone == static_cast<size_t>(nWordCount))
+            return;
+        pSrcData = static_cast<const GByte *>(pSrcData) +
+                   nDone * nSrcDataTypeSize;
+        pDstData = static_cast<GByte *>(pDstData) + nDone * nDstDataTypeSize;
+        nWordCount -= static_cast<GPtrDiff_t>(nDone);
+    }
+#endif
+
     // Handle the more general case -- deals with conversion of data types
     // directly.
     switch (eSrcType)
@@ -0,0 +1,379 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#include "rasterio_avx2.h"
+
+#ifdef HAVE_COPYWORDS_AVX2
+
+#include <immintrin.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// Note: on purpose, gdal_priv.h is not included, so that none of its inline
+// functions gets compiled with AVX2 instructions in this compilation unit.
+//
+// The conversion of each pair of types is generated from the templates below:
+// integer values are widened to 8 x int32 vectors, which are then clamped and
+// packed to the output type, or converted to floating point. Floating point
+// values are rounded and clamped following the rules of GDALCopyWord(),
+// before being converted to int32 vectors.
+
+namespace
+{
+
+/************************************************************************/
+/*                             LoadInt32()                              */
+/************************************************************************/
+
+// Load 8 integer values and widen them to int32
+template <class Tin> inline __m256i LoadInt32(const Tin *p)
+{
+    if constexpr (std::is_same_v<Tin, int32_t>)
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    }
+    else if constexpr (sizeof(Tin) == 2)
+    {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        if constexpr (std::is_signed_v<Tin>)
+            return _mm256_cvtepi16_epi32(x);
+        else
+            return _mm256_cvtepu16_epi32(x);
+    }
+    else
+    {
+        static_assert(sizeof(Tin) == 1);
+        const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p));
+        if constexpr (std::is_signed_v<Tin>)
+            return _mm256_cvtepi8_epi32(x);
+        else
+            return _mm256_cvtepu8_epi32(x);
+    }
+}
+
+/************************************************************************/
+/*                             StoreInt32()                             */
+/************************************************************************/
+
+// Store the 16 int32 values of v0 and v1 as Tout values. They are clamped to
+// the range of Tout if it does not contain the one of Tin.
+template <class Tin, class Tout>
+inline void StoreInt32(__m256i v0, __m256i v1, Tout *p)
+{
+    if constexpr (std::is_same_v<Tout, int32_t>)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + 8), v1);
+    }
+    else if constexpr (std::is_same_v<Tout, float>)
+    {
+        _mm256_storeu_ps(p, _mm256_cvtepi32_ps(v0));
+        _mm256_storeu_ps(p + 8, _mm256_cvtepi32_ps(v1));
+    }
+    else if constexpr (std::is_same_v<Tout, double>)
+    {
+        _mm256_storeu_pd(p, _mm256_cvtepi32_pd(_mm256_castsi256_si128(v0)));
+        _mm256_storeu_pd(p + 4,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(v0, 1)));
+        _mm256_storeu_pd(p + 8,
+                         _mm256_cvtepi32_pd(_mm256_castsi256_si128(v1)));
+        _mm256_storeu_pd(p + 12,
+                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(v1, 1)));
+    }
+    else
+    {
+        constexpr int32_t nMin = std::numeric_limits<Tout>::lowest();
+        constexpr int32_t nMax = std::numeric_limits<Tout>::max();
+        if constexpr (static_cast<int64_t>(std::numeric_limits<Tin>::lowest()) <
+                          nMin ||
+                      static_cast<int64_t>(std::numeric_limits<Tin>::max()) >
+                          nMax)
+        {
+            const __m256i vMin = _mm256_set1_epi32(nMin);
+            const __m256i vMax = _mm256_set1_epi32(nMax);
+            v0 = _mm256_min_epi32(_mm256_max_epi32(v0, vMin), vMax);
+            v1 = _mm256_min_epi32(_mm256_max_epi32(v1, vMin), vMax);
+        }
+
+        // Values are now in the range of Tout, so that saturating packs are
+        // exact. They operate on each 128-bit lane separately, hence the
+        // permutation to get values back in memory order.
+        __m256i v16 = std::is_same_v<Tout, uint16_t>
+                          ? _mm256_packus_epi32(v0, v1)
+                          : _mm256_packs_epi32(v0, v1);
+        v16 = _mm256_permute4x64_epi64(v16, _MM_SHUFFLE(3, 1, 2, 0));
+        if constexpr (sizeof(Tout) == 2)
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v16);
+        }
+        else
+        {
+            const __m128i lo = _mm256_castsi256_si128(v16);
+            const __m128i hi = _mm256_extracti128_si256(v16, 1);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(p),
+                             std::is_same_v<Tout, uint8_t>
+                                 ? _mm_packus_epi16(lo, hi)
+                                 : _mm_packs_epi16(lo, hi));
+        }
+    }
+}
+
+/************************************************************************/
+/*                            FloatToInt32()                            */
+/************************************************************************/
+
+// Round and clamp 8 float values to the range of the integer type Tout, and
+// convert them to int32, as GDALCopyWord() does.
+template <class Tout> inline __m256i FloatToInt32(__m256 v)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    if constexpr (std::is_unsigned_v<Tout>)
+    {
+        // NaN values are mapped to 0 by _mm256_max_ps() which returns its
+        // second operand when one of them is NaN.
+        v = _mm256_add_ps(v, half);
+        const __m256 vMax = _mm256_set1_ps(
+            static_cast<float>(std::numeric_limits<Tout>::max()));
+        v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), vMax);
+        return _mm256_cvttps_epi32(v);
+    }
+    else
+    {
+        // Round half away from zero, and map NaN values to 0
+        const __m256 signBit = _mm256_set1_ps(-0.0f);
+        const __m256 isNotNaN = _mm256_cmp_ps(v, v, _CMP_ORD_Q);
+        __m256 r =
+            _mm256_add_ps(v, _mm256_or_ps(half, _mm256_and_ps(v, signBit)));
+        r = _mm256_and_ps(r, isNotNaN);
+        if constexpr (std::is_same_v<Tout, int32_t>)
+        {
+            // Out of range values are converted to INT_MIN, which is only
+            // correct for negative ones.
+            const __m256i i = _mm256_cvttps_epi32(r);
+            const __m256 isTooLarge =
+                _mm256_cmp_ps(v, _mm256_set1_ps(2147483648.0f), _CMP_GE_OQ);
+            return _mm256_blendv_epi8(
+                i, _mm256_set1_epi32(std::numeric_limits<int32_t>::max()),
+                _mm256_castps_si256(isTooLarge));
+        }
+        else
+        {
+            r = _mm256_min_ps(
+                _mm256_max_ps(r, _mm256_set1_ps(static_cast<float>(
+                                     std::numeric_limits<Tout>::lowest()))),
+                _mm256_set1_ps(
+                    static_cast<float>(std::numeric_limits<Tout>::max())));
+            return _mm256_cvttps_epi32(r);
+        }
+    }
+}
+
+/************************************************************************/
+/*                           DoubleToInt32()                            */
+/************************************************************************/
+
+// Round and clamp 4 double values to the range of the integer type Tout, and
+// convert them to int32, as GDALCopyWord() does.
+template <class Tout> inline __m128i DoubleToInt32(__m256d v)
+{
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d vMax =
+        _mm256_set1_pd(static_cast<double>(std::numeric_limits<Tout>::max()));
+    if constexpr (std::is_unsigned_v<Tout>)
+    {
+        // NaN values are mapped to 0 by _mm256_max_pd() which returns its
+        // second operand when one of them is NaN.
+        v = _mm256_add_pd(v, half);
+        v = _mm256_min_pd(_mm256_max_pd(v, _mm256_setzero_pd()), vMax);
+    }
+    else
+    {
+        // Round half away from zero, and map NaN values to 0
+        const __m256d signBit = _mm256_set1_pd(-0.0);
+        const __m256d isNotNaN = _mm256_cmp_pd(v, v, _CMP_ORD_Q);
+        v = _mm256_add_pd(v, _mm256_or_pd(half, _mm256_and_pd(v, signBit)));
+        v = _mm256_min_pd(
+            _mm256_max_pd(v, _mm256_set1_pd(static_cast<double>(
+                                 std::numeric_limits<Tout>::lowest()))),
+            vMax);
+        v = _mm256_and_pd(v, isNotNaN);
+    }
+    return _mm256_cvttpd_epi32(v);
+}
+
+/************************************************************************/
+/*                         HasFastSSE2Path()                            */
+/************************************************************************/
+
+// Pairs of types for which the SSE2 code paths of rasterio.cpp are at least
+// as fast, their throughput being bounded by memory bandwidth.
+template <class Tin, class Tout> constexpr bool HasFastSSE2Path()
+{
+    return (sizeof(Tin) == 1 && sizeof(Tout) == 1) ||
+           (std::is_same_v<Tin, uint8_t> && std::is_same_v<Tout, double>) ||
+           (std::is_same_v<Tin, uint16_t> &&
+            (std::is_same_v<Tout, uint8_t> || std::is_same_v<Tout, int16_t>)) ||
+           (std::is_same_v<Tin, int16_t> &&
+            (std::is_same_v<Tout, uint16_t> || std::is_same_v<Tout, float> ||
+             std::is_same_v<Tout, double>)) ||
+           (std::is_same_v<Tin, float> && std::is_same_v<Tout, double>);
+}
+
+/************************************************************************/
+/*                          CopyWordsPacked()                           */
+/************************************************************************/
+
+template <class Tin, class Tout>
+size_t CopyWordsPacked(const Tin *pSrc, Tout *pDst, size_t nCount)
+{
+    if constexpr (std::is_same_v<Tin, Tout> || HasFastSSE2Path<Tin, Tout>())
+    {
+        return 0;
+    }
+    else
+    {
+        size_t i = 0;
+        for (; i + 16 <= nCount; i += 16)
+        {
+            if constexpr (std::is_integral_v<Tin>)
+            {
+                StoreInt32<Tin>(LoadInt32(pSrc + i), LoadInt32(pSrc + i + 8),
+                                pDst + i);
+            }
+            else if constexpr (std::is_same_v<Tin, float>)
+            {
+                const __m256 v0 = _mm256_loadu_ps(pSrc + i);
+                const __m256 v1 = _mm256_loadu_ps(pSrc + i + 8);
+                if constexpr (std::is_same_v<Tout, double>)
+                {
+                    _mm256_storeu_pd(
+                        pDst + i, _mm256_cvtps_pd(_mm256_castps256_ps128(v0)));
+                    _mm256_storeu_pd(
+                        pDst + i + 4,
+                        _mm256_cvtps_pd(_mm256_extractf128_ps(v0, 1)));
+                    _mm256_storeu_pd(
+                        pDst + i + 8,
+                        _mm256_cvtps_pd(_mm256_castps256_ps128(v1)));
+                    _mm256_storeu_pd(
+                        pDst + i + 12,
+                        _mm256_cvtps_pd(_mm256_extractf128_ps(v1, 1)));
+                }
+                else
+                {
+                    StoreInt32<Tout>(FloatToInt32<Tout>(v0),
+                                     FloatToInt32<Tout>(v1), pDst + i);
+                }
+            }
+            else
+            {
+                static_assert(std::is_same_v<Tin, double>);
+                const __m256d v0 = _mm256_loadu_pd(pSrc + i);
+                const __m256d v1 = _mm256_loadu_pd(pSrc + i + 4);
+                const __m256d v2 = _mm256_loadu_pd(pSrc + i + 8);
+                const __m256d v3 = _mm256_loadu_pd(pSrc + i + 12);
+                if constexpr (std::is_same_v<Tout, float>)
+                {
+                    _mm256_storeu_ps(pDst + i,
+                                     _mm256_set_m128(_mm256_cvtpd_ps(v1),
+                                                     _mm256_cvtpd_ps(v0)));
+                    _mm256_storeu_ps(pDst + i + 8,
+                                     _mm256_set_m128(_mm256_cvtpd_ps(v3),
+                                                     _mm256_cvtpd_ps(v2)));
+                }
+                else
+                {
+                    StoreInt32<Tout>(
+                        _mm256_set_m128i(DoubleToInt32<Tout>(v1),
+                                         DoubleToInt32<Tout>(v0)),
+                        _mm256_set_m128i(DoubleToInt32<Tout>(v3),
+                                         DoubleToInt32<Tout>(v2)),
+                        pDst + i);
+                }
+            }
+        }
+        return i;
+    }
+}
+
+/************************************************************************/
+/*                        CopyWordsPackedFrom()                         */
+/************************************************************************/
+
+template <class Tin>
+size_t CopyWordsPackedFrom(const Tin *pSrc, void *pDst, GDALDataType eDstType,
+                           size_t nCount)
+{
+    switch (eDstType)
+    {
+        case GDT_Byte:
+            return CopyWordsPacked(pSrc, static_cast<uint8_t *>(pDst), nCount);
+        case GDT_Int8:
+            return CopyWordsPacked(pSrc, static_cast<int8_t *>(pDst), nCount);
+        case GDT_UInt16:
+            return CopyWordsPacked(pSrc, static_cast<uint16_t *>(pDst), nCount);
+        case GDT_Int16:
+            return CopyWordsPacked(pSrc, static_cast<int16_t *>(pDst), nCount);
+        case GDT_Int32:
+            return CopyWordsPacked(pSrc, static_cast<int32_t *>(pDst), nCount);
+        case GDT_Float32:
+            return CopyWordsPacked(pSrc, static_cast<float *>(pDst), nCount);
+        case GDT_Float64:
+            return CopyWordsPacked(pSrc, static_cast<double *>(pDst), nCount);
+        default:
+            break;
+    }
+    return 0;
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                      GDALCopyWordsPacked_AVX2()                      */
+/************************************************************************/
+
+size_t GDALCopyWordsPacked_AVX2(const void *pSrcData, GDALDataType eSrcType,
+                                void *pDstData, GDALDataType eDstType,
+                                size_t nCount)
+{
+    switch (eSrcType)
+    {
+        case GDT_Byte:
+            return CopyWordsPackedFrom(static_cast<const uint8_t *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_Int8:
+            return CopyWordsPackedFrom(static_cast<const int8_t *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_UInt16:
+            return CopyWordsPackedFrom(static_cast<const uint16_t *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_Int16:
+            return CopyWordsPackedFrom(static_cast<const int16_t *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_Int32:
+            return CopyWordsPackedFrom(static_cast<const int32_t *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_Float32:
+            return CopyWordsPackedFrom(static_cast<const float *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        case GDT_Float64:
+            return CopyWordsPackedFrom(static_cast<const double *>(pSrcData),
+                                       pDstData, eDstType, nCount);
+        default:
+            break;
+    }
+    return 0;
+}
+
+#endif  // HAVE_COPYWORDS_AVX2
@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of GDALCopyWords()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef RASTERIO_AVX2_H_INCLUDED
+#define RASTERIO_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+#include "gdal.h"
+
+#include <cstddef>
+
+//! @cond Doxygen_Suppress
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#define HAVE_COPYWORDS_AVX2
+
+// Must only be called if CPLHaveRuntimeAVX2() is true.
+//
+// Convert the nCount packed values of pSrcData to packed values of pDstData,
+// with the same rounding and clamping rules as GDALCopyWord(). Source and
+// destination types must be different non-complex types among Byte, Int8,
+// UInt16, Int16, Int32, Float32 and Float64.
+// Return the number of converted values, which is a multiple of 16 and at
+// most nCount, or 0 if the pair of types is not handled, either because it is
+// not supported or because the generic code is as fast.
+size_t GDALCopyWordsPacked_AVX2(const void *pSrcData, GDALDataType eSrcType,
+                                void *pDstData, GDALDataType eDstType,
+                                size_t nCount);
+
+#endif
+
+//! @endcond
+
+#endif /* RASTERIO_AVX2_H_INCLUDED */
@@ -1068,7 +1068,20 @@ CPLErr RawRasterBand::IRasterIO(GDALRWFlag eRWFlag, int nXOff, int nYOff,
 #endif
     const int nBufDataSize = GDALGetDataTypeSizeBytes(eBufType);
 
-    if (!CanUseDirectIO(nXOff, nYOff, nXSize, nYSize, eBufType, psExtraArg))
+    // Reads of whole lines in the data type of the band, when the lines are
+    // contiguous both in the file and in the buffer, are done in a single
+    // read into the buffer unless a significant number of them is cached.
+    // Cached lines must not be dirty, as the file would not be up to date.
+    const bool bContiguousRead =
+        eRWFlag == GF_Read && nXSize == GetXSize() && nXSize == nBufXSize &&
+        nYSize == nBufYSize && eBufType == eDataType &&
+        nPixelOffset == nBandDataSize && nPixelSpace == nBufDataSize &&
+        nLineSpace == nPixelSpace * nXSize &&
+        nLineOffset == nPixelOffset * nXSize && !bLoadedScanlineDirty &&
+        !HasDirtyBlocks() && !IsSignificantNumberOfLinesLoaded(nYOff, nYSize);
+
+    if (!bContiguousRead &&
+        !CanUseDirectIO(nXOff, nYOff, nXSize, nYSize, eBufType, psExtraArg))
     {
         return GDALRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
                                          pData, nBufXSize, nBufYSize, eBufType,
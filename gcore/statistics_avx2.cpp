@@ -0,0 +1,509 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of statistics and histogram computations
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#include "cpl_port.h"
+
+#include "statistics_avx2.h"
+
+#ifdef HAVE_STATISTICS_AVX2
+
+#include <immintrin.h>
+
+#include <cmath>
+#include <limits>
+
+// Note: on purpose, gdal_priv.h is not included, so that none of its inline
+// functions gets compiled with AVX2 instructions in this compilation unit.
+
+namespace
+{
+
+constexpr int VALUES_PER_ITER = 8;
+
+/************************************************************************/
+/*                              IsNoData()                              */
+/************************************************************************/
+
+// Same as ARE_REAL_EQUAL() from gdal_priv.h
+inline bool IsNoData(float fVal, float fNoData)
+{
+    return fVal == fNoData ||
+           std::fabs(fVal - fNoData) < std::numeric_limits<float>::epsilon() *
+                                           std::fabs(fVal + fNoData) * 2;
+}
+
+inline bool IsNoData(double dfVal, double dfNoData)
+{
+    return dfVal == dfNoData ||
+           std::fabs(dfVal - dfNoData) < std::numeric_limits<float>::epsilon() *
+                                             std::fabs(dfVal + dfNoData) * 2;
+}
+
+/************************************************************************/
+/*                              IsValid()                               */
+/************************************************************************/
+
+template <bool HAS_NODATA> inline bool IsValid(GInt16 nVal, GInt16 nNoData)
+{
+    return !HAS_NODATA || nVal != nNoData;
+}
+
+template <bool HAS_NODATA> inline bool IsValid(float fVal, float fNoData)
+{
+    return !std::isnan(fVal) && !(HAS_NODATA && IsNoData(fVal, fNoData));
+}
+
+template <bool HAS_NODATA> inline bool IsValid(double dfVal, double dfNoData)
+{
+    return !std::isnan(dfVal) && !(HAS_NODATA && IsNoData(dfVal, dfNoData));
+}
+
+/************************************************************************/
+/*                               Load8()                                */
+/************************************************************************/
+
+// Load 8 values as 2 vectors of 4 doubles, and set the corresponding
+// invalid0 / invalid1 masks to all bits set for NaN and nodata values.
+
+template <bool HAS_NODATA>
+inline void Load8(const GInt16 *panData, GInt16 nNoData, __m256d &v0,
+                  __m256d &v1, __m256d &invalid0, __m256d &invalid1)
+{
+    const __m256i v = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(panData)));
+    v0 = _mm256_cvtepi32_pd(_mm256_castsi256_si128(v));
+    v1 = _mm256_cvtepi32_pd(_mm256_extracti128_si256(v, 1));
+    if constexpr (HAS_NODATA)
+    {
+        const __m256i isNoData =
+            _mm256_cmpeq_epi32(v, _mm256_set1_epi32(nNoData));
+        invalid0 = _mm256_castsi256_pd(
+            _mm256_cvtepi32_epi64(_mm256_castsi256_si128(isNoData)));
+        invalid1 = _mm256_castsi256_pd(
+            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(isNoData, 1)));
+    }
+    else
+    {
+        invalid0 = _mm256_setzero_pd();
+        invalid1 = _mm256_setzero_pd();
+    }
+}
+
+template <bool HAS_NODATA>
+inline void Load8(const float *pafData, float fNoData, __m256d &v0,
+                  __m256d &v1, __m256d &invalid0, __m256d &invalid1)
+{
+    const __m256 v = _mm256_loadu_ps(pafData);
+    v0 = _mm256_cvtps_pd(_mm256_castps256_ps128(v));
+    v1 = _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1));
+    __m256 invalid = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+    if constexpr (HAS_NODATA)
+    {
+        const __m256 noData = _mm256_set1_ps(fNoData);
+        const __m256 absMask =
+            _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+        const __m256 diff = _mm256_and_ps(_mm256_sub_ps(v, noData), absMask);
+        const __m256 tolerance = _mm256_mul_ps(
+            _mm256_and_ps(_mm256_add_ps(v, noData), absMask),
+            _mm256_set1_ps(2 * std::numeric_limits<float>::epsilon()));
+        invalid = _mm256_or_ps(
+            invalid, _mm256_or_ps(_mm256_cmp_ps(v, noData, _CMP_EQ_OQ),
+                                  _mm256_cmp_ps(diff, tolerance, _CMP_LT_OQ)));
+    }
+    const __m256i invalidI = _mm256_castps_si256(invalid);
+    invalid0 = _mm256_castsi256_pd(
+        _mm256_cvtepi32_epi64(_mm256_castsi256_si128(invalidI)));
+    invalid1 = _mm256_castsi256_pd(
+        _mm256_cvtepi32_epi64(_mm256_extracti128_si256(invalidI, 1)));
+}
+
+template <bool HAS_NODATA>
+inline __m256d GetInvalidMask(__m256d v, double dfNoData)
+{
+    __m256d invalid = _mm256_cmp_pd(v, v, _CMP_UNORD_Q);
+    if constexpr (HAS_NODATA)
+    {
+        const __m256d noData = _mm256_set1_pd(dfNoData);
+        const __m256d absMask =
+            _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FFFFFFFFFFFFFFFLL));
+        const __m256d diff =
+            _mm256_and_pd(_mm256_sub_pd(v, noData), absMask);
+        const __m256d tolerance = _mm256_mul_pd(
+            _mm256_and_pd(_mm256_add_pd(v, noData), absMask),
+            _mm256_set1_pd(2.0 * std::numeric_limits<float>::epsilon()));
+        invalid = _mm256_or_pd(
+            invalid, _mm256_or_pd(_mm256_cmp_pd(v, noData, _CMP_EQ_OQ),
+                                  _mm256_cmp_pd(diff, tolerance, _CMP_LT_OQ)));
+    }
+    return invalid;
+}
+
+template <bool HAS_NODATA>
+inline void Load8(const double *padfData, double dfNoData, __m256d &v0,
+                  __m256d &v1, __m256d &invalid0, __m256d &invalid1)
+{
+    v0 = _mm256_loadu_pd(padfData);
+    v1 = _mm256_loadu_pd(padfData + 4);
+    invalid0 = GetInvalidMask<HAS_NODATA>(v0, dfNoData);
+    invalid1 = GetInvalidMask<HAS_NODATA>(v1, dfNoData);
+}
+
+/************************************************************************/
+/*                             LoadMask8()                              */
+/************************************************************************/
+
+// Add the pixels whose mask value is 0 to the invalid0 / invalid1 masks
+inline void LoadMask8(const GByte *pabyMask, __m256d &invalid0,
+                      __m256d &invalid1)
+{
+    const __m128i isMasked = _mm_cmpeq_epi8(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(pabyMask)),
+        _mm_setzero_si128());
+    invalid0 = _mm256_or_pd(
+        invalid0, _mm256_castsi256_pd(_mm256_cvtepi8_epi64(isMasked)));
+    invalid1 = _mm256_or_pd(invalid1,
+                            _mm256_castsi256_pd(_mm256_cvtepi8_epi64(
+                                _mm_srli_si128(isMasked, 4))));
+}
+
+/************************************************************************/
+/*                       ComputeBlockStatistics()                       */
+/************************************************************************/
+
+template <class T, bool HAS_NODATA, bool HAS_MASK>
+void ComputeBlockStatistics(const T *pData, const GByte *pabyMaskData,
+                            int nXCheck, int nYCheck, int nLineStride,
+                            T noDataValue, GUIntBig &nValidCount,
+                            double &dfMin, double &dfMax, double &dfMean,
+                            double &dfM2)
+{
+    constexpr double INF = std::numeric_limits<double>::infinity();
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d posInf = _mm256_set1_pd(INF);
+    const __m256d negInf = _mm256_set1_pd(-INF);
+
+    // First pass: count, sum, minimum and maximum.
+    __m256d count0 = zero;
+    __m256d count1 = zero;
+    __m256d sum0 = zero;
+    __m256d sum1 = zero;
+    __m256d min0 = posInf;
+    __m256d min1 = posInf;
+    __m256d max0 = negInf;
+    __m256d max1 = negInf;
+    double dfCount = 0;
+    double dfSum = 0;
+    dfMin = INF;
+    dfMax = -INF;
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nLineStride;
+        const T *pLine = pData + iLineOffset;
+        const GByte *pabyMaskLine =
+            HAS_MASK ? pabyMaskData + iLineOffset : nullptr;
+        int iX = 0;
+        for (; iX + VALUES_PER_ITER <= nXCheck; iX += VALUES_PER_ITER)
+        {
+            __m256d v0, v1, invalid0, invalid1;
+            Load8<HAS_NODATA>(pLine + iX, noDataValue, v0, v1, invalid0,
+                              invalid1);
+            if constexpr (HAS_MASK)
+                LoadMask8(pabyMaskLine + iX, invalid0, invalid1);
+
+            count0 = _mm256_add_pd(count0, _mm256_andnot_pd(invalid0, one));
+            count1 = _mm256_add_pd(count1, _mm256_andnot_pd(invalid1, one));
+            sum0 = _mm256_add_pd(sum0, _mm256_andnot_pd(invalid0, v0));
+            sum1 = _mm256_add_pd(sum1, _mm256_andnot_pd(invalid1, v1));
+            min0 = _mm256_min_pd(min0, _mm256_blendv_pd(v0, posInf, invalid0));
+            min1 = _mm256_min_pd(min1, _mm256_blendv_pd(v1, posInf, invalid1));
+            max0 = _mm256_max_pd(max0, _mm256_blendv_pd(v0, negInf, invalid0));
+            max1 = _mm256_max_pd(max1, _mm256_blendv_pd(v1, negInf, invalid1));
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            if (HAS_MASK && pabyMaskLine[iX] == 0)
+                continue;
+            const T value = pLine[iX];
+            if (!IsValid<HAS_NODATA>(value, noDataValue))
+                continue;
+            const double dfValue = static_cast<double>(value);
+            dfCount += 1;
+            dfSum += dfValue;
+            if (dfValue < dfMin)
+                dfMin = dfValue;
+            if (dfValue > dfMax)
+                dfMax = dfValue;
+        }
+    }
+
+    double adfCount[4], adfSum[4], adfMin[4], adfMax[4];
+    _mm256_storeu_pd(adfCount, _mm256_add_pd(count0, count1));
+    _mm256_storeu_pd(adfSum, _mm256_add_pd(sum0, sum1));
+    _mm256_storeu_pd(adfMin, _mm256_min_pd(min0, min1));
+    _mm256_storeu_pd(adfMax, _mm256_max_pd(max0, max1));
+    for (int i = 0; i < 4; ++i)
+    {
+        dfCount += adfCount[i];
+        dfSum += adfSum[i];
+        if (adfMin[i] < dfMin)
+            dfMin = adfMin[i];
+        if (adfMax[i] > dfMax)
+            dfMax = adfMax[i];
+    }
+
+    nValidCount = static_cast<GUIntBig>(dfCount);
+    dfMean = 0;
+    dfM2 = 0;
+    if (nValidCount == 0)
+        return;
+    dfMean = dfSum / dfCount;
+    if (dfMin == dfMax)
+        return;
+
+    // Second pass: sum of squares of differences to the mean.
+    const __m256d mean = _mm256_set1_pd(dfMean);
+    __m256d m2_0 = zero;
+    __m256d m2_1 = zero;
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nLineStride;
+        const T *pLine = pData + iLineOffset;
+        const GByte *pabyMaskLine =
+            HAS_MASK ? pabyMaskData + iLineOffset : nullptr;
+        int iX = 0;
+        for (; iX + VALUES_PER_ITER <= nXCheck; iX += VALUES_PER_ITER)
+        {
+            __m256d v0, v1, invalid0, invalid1;
+            Load8<HAS_NODATA>(pLine + iX, noDataValue, v0, v1, invalid0,
+                              invalid1);
+            if constexpr (HAS_MASK)
+                LoadMask8(pabyMaskLine + iX, invalid0, invalid1);
+
+            const __m256d delta0 = _mm256_sub_pd(v0, mean);
+            const __m256d delta1 = _mm256_sub_pd(v1, mean);
+            m2_0 = _mm256_add_pd(m2_0, _mm256_andnot_pd(
+                                           invalid0,
+                                           _mm256_mul_pd(delta0, delta0)));
+            m2_1 = _mm256_add_pd(m2_1, _mm256_andnot_pd(
+                                           invalid1,
+                                           _mm256_mul_pd(delta1, delta1)));
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            if (HAS_MASK && pabyMaskLine[iX] == 0)
+                continue;
+            const T value = pLine[iX];
+            if (!IsValid<HAS_NODATA>(value, noDataValue))
+                continue;
+            const double dfDelta = static_cast<double>(value) - dfMean;
+            dfM2 += dfDelta * dfDelta;
+        }
+    }
+
+    double adfM2[4];
+    _mm256_storeu_pd(adfM2, _mm256_add_pd(m2_0, m2_1));
+    for (int i = 0; i < 4; ++i)
+        dfM2 += adfM2[i];
+}
+
+/************************************************************************/
+/*                       ComputeBlockHistogram()                        */
+/************************************************************************/
+
+template <class T, bool HAS_NODATA, bool HAS_MASK>
+void ComputeBlockHistogram(const T *pData, const GByte *pabyMaskData,
+                           int nXCheck, int nYCheck, int nLineStride,
+                           T noDataValue, double dfMin, double dfScale,
+                           int nBuckets, bool bIncludeOutOfRange,
+                           GUIntBig *panHistogram)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d min = _mm256_set1_pd(dfMin);
+    const __m256d scale = _mm256_set1_pd(dfScale);
+    const __m256d buckets = _mm256_set1_pd(nBuckets);
+    const __m256d lastBucket = _mm256_set1_pd(nBuckets - 1);
+    int anIndex[VALUES_PER_ITER];
+
+    for (int iY = 0; iY < nYCheck; iY++)
+    {
+        const GPtrDiff_t iLineOffset =
+            static_cast<GPtrDiff_t>(iY) * nLineStride;
+        const T *pLine = pData + iLineOffset;
+        const GByte *pabyMaskLine =
+            HAS_MASK ? pabyMaskData + iLineOffset : nullptr;
+        int iX = 0;
+        for (; iX + VALUES_PER_ITER <= nXCheck; iX += VALUES_PER_ITER)
+        {
+            __m256d v0, v1, invalid0, invalid1;
+            Load8<HAS_NODATA>(pLine + iX, noDataValue, v0, v1, invalid0,
+                              invalid1);
+            if constexpr (HAS_MASK)
+                LoadMask8(pabyMaskLine + iX, invalid0, invalid1);
+
+            __m256d index0 = _mm256_floor_pd(
+                _mm256_mul_pd(_mm256_sub_pd(v0, min), scale));
+            __m256d index1 = _mm256_floor_pd(
+                _mm256_mul_pd(_mm256_sub_pd(v1, min), scale));
+            if (bIncludeOutOfRange)
+            {
+                index0 = _mm256_min_pd(_mm256_max_pd(index0, zero), lastBucket);
+                index1 = _mm256_min_pd(_mm256_max_pd(index1, zero), lastBucket);
+            }
+            else
+            {
+                invalid0 = _mm256_or_pd(
+                    invalid0,
+                    _mm256_or_pd(_mm256_cmp_pd(index0, zero, _CMP_LT_OQ),
+                                 _mm256_cmp_pd(index0, buckets, _CMP_GE_OQ)));
+                invalid1 = _mm256_or_pd(
+                    invalid1,
+                    _mm256_or_pd(_mm256_cmp_pd(index1, zero, _CMP_LT_OQ),
+                                 _mm256_cmp_pd(index1, buckets, _CMP_GE_OQ)));
+            }
+
+            // There is no scatter-add instruction, so update the buckets
+            // one at a time.
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(anIndex),
+                             _mm256_cvttpd_epi32(index0));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(anIndex + 4),
+                             _mm256_cvttpd_epi32(index1));
+            const int nValidMask = ~(_mm256_movemask_pd(invalid0) |
+                                     (_mm256_movemask_pd(invalid1) << 4));
+            for (int i = 0; i < VALUES_PER_ITER; ++i)
+            {
+                if (nValidMask & (1 << i))
+                    ++panHistogram[anIndex[i]];
+            }
+        }
+        for (; iX < nXCheck; iX++)
+        {
+            if (HAS_MASK && pabyMaskLine[iX] == 0)
+                continue;
+            const T value = pLine[iX];
+            if (!IsValid<HAS_NODATA>(value, noDataValue))
+                continue;
+            const double dfIndex =
+                std::floor((static_cast<double>(value) - dfMin) * dfScale);
+            if (dfIndex < 0)
+            {
+                if (bIncludeOutOfRange)
+                    panHistogram[0]++;
+            }
+            else if (dfIndex >= nBuckets)
+            {
+                if (bIncludeOutOfRange)
+                    ++panHistogram[nBuckets - 1];
+            }
+            else
+            {
+                ++panHistogram[static_cast<int>(dfIndex)];
+            }
+        }
+    }
+}
+
+}  // namespace
+
+/************************************************************************/
+/*                  GDALComputeBlockStatistics_AVX2()                   */
+/************************************************************************/
+
+template <class T>
+void GDALComputeBlockStatistics_AVX2(const T *pData, const GByte *pabyMaskData,
+                                     int nXCheck, int nYCheck, int nLineStride,
+                                     bool bHasNoData, T noDataValue,
+                                     GUIntBig &nValidCount, double &dfMin,
+                                     double &dfMax, double &dfMean,
+                                     double &dfM2)
+{
+    if (bHasNoData)
+    {
+        if (pabyMaskData)
+            ComputeBlockStatistics<T, true, true>(
+                pData, pabyMaskData, nXCheck, nYCheck, nLineStride,
+                noDataValue, nValidCount, dfMin, dfMax, dfMean, dfM2);
+        else
+            ComputeBlockStatistics<T, true, false>(
+                pData, nullptr, nXCheck, nYCheck, nLineStride, noDataValue,
+                nValidCount, dfMin, dfMax, dfMean, dfM2);
+    }
+    else
+    {
+        if (pabyMaskData)
+            ComputeBlockStatistics<T, false, true>(
+                pData, pabyMaskData, nXCheck, nYCheck, nLineStride,
+                noDataValue, nValidCount, dfMin, dfMax, dfMean, dfM2);
+        else
+            ComputeBlockStatistics<T, false, false>(
+                pData, nullptr, nXCheck, nYCheck, nLineStride, noDataValue,
+                nValidCount, dfMin, dfMax, dfMean, dfM2);
+    }
+}
+
+/************************************************************************/
+/*                   GDALComputeBlockHistogram_AVX2()                   */
+/************************************************************************/
+
+template <class T>
+void GDALComputeBlockHistogram_AVX2(const T *pData, const GByte *pabyMaskData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    bool bHasNoData, T noDataValue,
+                                    double dfMin, double dfScale, int nBuckets,
+                                    bool bIncludeOutOfRange,
+                                    GUIntBig *panHistogram)
+{
+    if (bHasNoData)
+    {
+        if (pabyMaskData)
+            ComputeBlockHistogram<T, true, true>(
+                pData, pabyMaskData, nXCheck, nYCheck, nLineStride,
+                noDataValue, dfMin, dfScale, nBuckets, bIncludeOutOfRange,
+                panHistogram);
+        else
+            ComputeBlockHistogram<T, true, false>(
+                pData, nullptr, nXCheck, nYCheck, nLineStride, noDataValue,
+                dfMin, dfScale, nBuckets, bIncludeOutOfRange, panHistogram);
+    }
+    else
+    {
+        if (pabyMaskData)
+            ComputeBlockHistogram<T, false, true>(
+                pData, pabyMaskData, nXCheck, nYCheck, nLineStride,
+                noDataValue, dfMin, dfScale, nBuckets, bIncludeOutOfRange,
+                panHistogram);
+        else
+            ComputeBlockHistogram<T, false, false>(
+                pData, nullptr, nXCheck, nYCheck, nLineStride, noDataValue,
+                dfMin, dfScale, nBuckets, bIncludeOutOfRange, panHistogram);
+    }
+}
+
+#define INSTANTIATE(T)                                                         \
+    template void GDALComputeBlockStatistics_AVX2<T>(                          \
+        const T *pData, const GByte *pabyMaskData, int nXCheck, int nYCheck,   \
+        int nLineStride, bool bHasNoData, T noDataValue,                       \
+        GUIntBig &nValidCount, double &dfMin, double &dfMax, double &dfMean,   \
+        double &dfM2);                                                         \
+    template void GDALComputeBlockHistogram_AVX2<T>(                           \
+        const T *pData, const GByte *pabyMaskData, int nXCheck, int nYCheck,   \
+        int nLineStride, bool bHasNoData, T noDataValue, double dfMin,         \
+        double dfScale, int nBuckets, bool bIncludeOutOfRange,                 \
+        GUIntBig *panHistogram);
+
+INSTANTIATE(GInt16)
+INSTANTIATE(float)
+INSTANTIATE(double)
+
+#endif  // HAVE_STATISTICS_AVX2
@@ -0,0 +1,55 @@
+/******************************************************************************
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX2 specializations of statistics and histogram computations
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+#ifndef STATISTICS_AVX2_H_INCLUDED
+#define STATISTICS_AVX2_H_INCLUDED
+
+#include "cpl_port.h"
+
+//! @cond Doxygen_Suppress
+
+#if defined(HAVE_AVX2_AT_COMPILE_TIME) && (defined(__x86_64) || defined(_M_X64))
+
+#define HAVE_STATISTICS_AVX2
+
+// Those functions must only be called if CPLHaveRuntimeAVX2() is true.
+// They are instantiated for T = GInt16, float and double.
+//
+// A pixel is ignored if its mask value is 0 (when pabyMaskData is not null),
+// if it is NaN, or if bHasNoData is set and it is equal to noDataValue, with
+// the same tolerance as ARE_REAL_EQUAL() for floating-point types.
+
+// Compute the number of valid pixels of a block, and their minimum, maximum,
+// mean, and sum of squares of differences to the mean (dfM2), using a
+// two-pass algorithm.
+template <class T>
+void GDALComputeBlockStatistics_AVX2(const T *pData, const GByte *pabyMaskData,
+                                     int nXCheck, int nYCheck, int nLineStride,
+                                     bool bHasNoData, T noDataValue,
+                                     GUIntBig &nValidCount, double &dfMin,
+                                     double &dfMax, double &dfMean,
+                                     double &dfM2);
+
+// Add the valid pixels of a block to an histogram whose bucket of index i
+// holds values in [dfMin + i / dfScale, dfMin + (i + 1) / dfScale[
+template <class T>
+void GDALComputeBlockHistogram_AVX2(const T *pData, const GByte *pabyMaskData,
+                                    int nXCheck, int nYCheck, int nLineStride,
+                                    bool bHasNoData, T noDataValue,
+                                    double dfMin, double dfScale, int nBuckets,
+                                    bool bIncludeOutOfRange,
+                                    GUIntBig *panHistogram);
+
+#endif
+
+//! @endcond
+
+#endif /* STATISTICS_AVX2_H_INCLUDED */
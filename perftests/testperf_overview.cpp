@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of overview resampling kernels
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Usage: testperf_overview [-size N] [-iters N] [--config GDAL_USE_AVX2 NO]
+//
+// Computes an overview by a factor of 2 of Byte, UInt16 and Float32 bands
+// with each resampling method, and reports the throughput of each kernel in
+// source megapixels per second. The result of AVERAGE is checked against a
+// straightforward implementation. GDAL_USE_AVX2=NO (only honoured in debug
+// builds) can be used to compare with the SSE2 or generic code paths.
+// perftests/overview.py benchmarks the whole BuildOverviews() pipeline
+// instead.
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+constexpr const char *const apszResamplings[] = {
+    "AVERAGE", "RMS", "GAUSS", "MODE", "BILINEAR", "CUBIC", "LANCZOS"};
+
+template <class T>
+bool CheckAverage(const std::vector<T> &aSrc, const std::vector<T> &aDst,
+                  int nSize)
+{
+    const int nOvrSize = nSize / 2;
+    for (int iY = 0; iY < nOvrSize; ++iY)
+    {
+        for (int iX = 0; iX < nOvrSize; ++iX)
+        {
+            const size_t i = static_cast<size_t>(2 * iY) * nSize + 2 * iX;
+            const double dfSum = static_cast<double>(aSrc[i]) + aSrc[i + 1] +
+                                 aSrc[i + nSize] + aSrc[i + nSize + 1];
+            const double dfExpected =
+                std::is_floating_point_v<T> ? dfSum / 4
+                                            : std::floor((dfSum + 2) / 4);
+            const double dfGot = static_cast<double>(
+                aDst[static_cast<size_t>(iY) * nOvrSize + iX]);
+            if (std::fabs(dfGot - dfExpected) > 1e-3 * std::fabs(dfExpected))
+            {
+                fprintf(stderr,
+                        "Wrong AVERAGE value at (%d, %d): got %.17g, "
+                        "expected %.17g\n",
+                        iX, iY, dfGot, dfExpected);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <class T>
+bool Bench(GDALDriver *poMEMDriver, GDALDataType eDT, int nSize, int nIters)
+{
+    std::mt19937 gen{0};
+    const double dfMax = std::is_same_v<T, GByte>     ? 255
+                         : std::is_same_v<T, GUInt16> ? 65535
+                                                      : 1000;
+    std::uniform_real_distribution<> dist{0, dfMax};
+    std::vector<T> aSrc(static_cast<size_t>(nSize) * nSize);
+    for (auto &val : aSrc)
+        val = static_cast<T>(dist(gen));
+
+    std::unique_ptr<GDALDataset> poSrcDS(
+        poMEMDriver->Create("", nSize, nSize, 1, eDT, nullptr));
+    std::unique_ptr<GDALDataset> poOvrDS(
+        poMEMDriver->Create("", nSize / 2, nSize / 2, 1, eDT, nullptr));
+    GDALRasterBand *poSrcBand = poSrcDS->GetRasterBand(1);
+    GDALRasterBandH hOvrBand =
+        GDALRasterBand::ToHandle(poOvrDS->GetRasterBand(1));
+    if (poSrcBand->RasterIO(GF_Write, 0, 0, nSize, nSize, aSrc.data(), nSize,
+                            nSize, eDT, 0, 0, nullptr) != CE_None)
+        return false;
+
+    for (const char *pszResampling : apszResamplings)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int iIter = 0; iIter < nIters; ++iIter)
+        {
+            if (GDALRegenerateOverviews(GDALRasterBand::ToHandle(poSrcBand), 1,
+                                        &hOvrBand, pszResampling, nullptr,
+                                        nullptr) != CE_None)
+                return false;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double dfElapsed =
+            std::chrono::duration<double>(end - start).count();
+        printf("%-8s %-9s: %8.1f Mpixels/s\n", GDALGetDataTypeName(eDT),
+               pszResampling,
+               static_cast<double>(nSize) * nSize * nIters / dfElapsed / 1e6);
+
+        if (strcmp(pszResampling, "AVERAGE") == 0)
+        {
+            std::vector<T> aDst(static_cast<size_t>(nSize / 2) * (nSize / 2));
+            if (GDALRasterBand::FromHandle(hOvrBand)->RasterIO(
+                    GF_Read, 0, 0, nSize / 2, nSize / 2, aDst.data(),
+                    nSize / 2, nSize / 2, eDT, 0, 0, nullptr) != CE_None ||
+                !CheckAverage(aSrc, aDst, nSize))
+                return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    int nSize = 2048;
+    int nIters = 1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-size") == 0 && i + 1 < argc)
+            nSize = std::max(2, atoi(argv[++i]));
+        else if (strcmp(argv[i], "-iters") == 0 && i + 1 < argc)
+            nIters = std::max(1, atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "Usage: testperf_overview [-size N] [-iters N]\n");
+            CSLDestroy(argv);
+            return 1;
+        }
+    }
+    CSLDestroy(argv);
+    nSize &= ~1;
+
+    GDALAllRegister();
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDriver == nullptr)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        return 1;
+    }
+
+    bool bOK = Bench<GByte>(poMEMDriver, GDT_Byte, nSize, nIters);
+    bOK &= Bench<GUInt16>(poMEMDriver, GDT_UInt16, nSize, nIters);
+    bOK &= Bench<float>(poMEMDriver, GDT_Float32, nSize, nIters);
+
+    GDALDestroyDriverManager();
+    return bOK ? 0 : 1;
+}
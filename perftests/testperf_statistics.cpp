@@ -0,0 +1,217 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of GDALRasterBand::ComputeStatistics() and
+ *           GDALRasterBand::GetHistogram()
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Usage: testperf_statistics [--config GDAL_USE_AVX2 NO]
+//
+// Computes the statistics and histogram of Int16, Float32 and Float64
+// bands, without and with nodata value or mask, and checks them against
+// a straightforward implementation. GDAL_USE_AVX2=NO (only honoured in
+// debug builds) can be used to compare with the generic code path.
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+constexpr int SIZE = 4096;
+constexpr int N_BUCKETS = 256;
+constexpr double NODATA = -9999;
+
+namespace
+{
+
+struct Reference
+{
+    double dfMin = std::numeric_limits<double>::infinity();
+    double dfMax = -std::numeric_limits<double>::infinity();
+    double dfMean = 0;
+    double dfStdDev = 0;
+    std::vector<GUIntBig> anHistogram{};
+};
+
+template <class T>
+Reference ComputeReference(const std::vector<T> &aValues,
+                           const std::vector<GByte> &abyMask, bool bNoData)
+{
+    const auto IsValid = [&aValues, &abyMask, bNoData](size_t i)
+    {
+        return !(!abyMask.empty() && abyMask[i] == 0) &&
+               !std::isnan(static_cast<double>(aValues[i])) &&
+               !(bNoData && static_cast<double>(aValues[i]) == NODATA);
+    };
+
+    Reference sRef;
+    double dfSum = 0;
+    size_t nCount = 0;
+    for (size_t i = 0; i < aValues.size(); ++i)
+    {
+        if (!IsValid(i))
+            continue;
+        const double dfValue = static_cast<double>(aValues[i]);
+        sRef.dfMin = std::min(sRef.dfMin, dfValue);
+        sRef.dfMax = std::max(sRef.dfMax, dfValue);
+        dfSum += dfValue;
+        ++nCount;
+    }
+    sRef.dfMean = dfSum / static_cast<double>(nCount);
+
+    double dfM2 = 0;
+    const double dfHistMin = sRef.dfMin - 0.5;
+    const double dfScale = N_BUCKETS / ((sRef.dfMax + 0.5) - dfHistMin);
+    sRef.anHistogram.resize(N_BUCKETS);
+    for (size_t i = 0; i < aValues.size(); ++i)
+    {
+        if (!IsValid(i))
+            continue;
+        const double dfValue = static_cast<double>(aValues[i]);
+        dfM2 += (dfValue - sRef.dfMean) * (dfValue - sRef.dfMean);
+        const int iBucket = std::min(
+            N_BUCKETS - 1,
+            static_cast<int>(std::floor((dfValue - dfHistMin) * dfScale)));
+        ++sRef.anHistogram[iBucket];
+    }
+    sRef.dfStdDev = sqrt(dfM2 / static_cast<double>(nCount));
+    return sRef;
+}
+
+bool IsClose(double dfA, double dfB)
+{
+    return std::fabs(dfA - dfB) <= 1e-9 * std::max(1.0, std::fabs(dfB));
+}
+
+template <class T>
+bool Bench(GDALDriver *poMEMDriver, GDALDataType eDT, const char *pszName,
+           bool bNoData, bool bMask)
+{
+    std::mt19937 gen{0};
+    std::normal_distribution<> dist{100, 30};
+    std::vector<T> aValues(static_cast<size_t>(SIZE) * SIZE);
+    std::vector<GByte> abyMask;
+    for (size_t i = 0; i < aValues.size(); ++i)
+    {
+        aValues[i] = static_cast<T>(dist(gen));
+        if (bNoData && (i % 7) == 0)
+            aValues[i] = static_cast<T>(NODATA);
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            if ((i % 1021) == 0)
+                aValues[i] = std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+    if (bMask)
+    {
+        abyMask.resize(aValues.size());
+        for (size_t i = 0; i < abyMask.size(); ++i)
+            abyMask[i] = (i % 5) == 0 ? 0 : 255;
+    }
+
+    std::unique_ptr<GDALDataset> poDS(
+        poMEMDriver->Create("", SIZE, SIZE, 1, eDT, nullptr));
+    GDALRasterBand *poBand = poDS->GetRasterBand(1);
+    if (poBand->RasterIO(GF_Write, 0, 0, SIZE, SIZE, aValues.data(), SIZE,
+                         SIZE, eDT, 0, 0, nullptr) != CE_None)
+        return false;
+    if (bNoData)
+        poBand->SetNoDataValue(NODATA);
+    if (bMask)
+    {
+        if (poBand->CreateMaskBand(0) != CE_None ||
+            poBand->GetMaskBand()->RasterIO(GF_Write, 0, 0, SIZE, SIZE,
+                                            abyMask.data(), SIZE, SIZE,
+                                            GDT_Byte, 0, 0,
+                                            nullptr) != CE_None)
+            return false;
+    }
+
+    const Reference sRef = ComputeReference(aValues, abyMask, bNoData);
+
+    double dfMin = 0, dfMax = 0, dfMean = 0, dfStdDev = 0;
+    auto start = std::chrono::steady_clock::now();
+    if (poBand->ComputeStatistics(false, &dfMin, &dfMax, &dfMean, &dfStdDev,
+                                  nullptr, nullptr) != CE_None)
+        return false;
+    auto end = std::chrono::steady_clock::now();
+    const double dfStatsElapsed =
+        std::chrono::duration<double>(end - start).count();
+
+    std::vector<GUIntBig> anHistogram(N_BUCKETS);
+    start = std::chrono::steady_clock::now();
+    if (poBand->GetHistogram(sRef.dfMin - 0.5, sRef.dfMax + 0.5, N_BUCKETS,
+                             anHistogram.data(), false, false, nullptr,
+                             nullptr) != CE_None)
+        return false;
+    end = std::chrono::steady_clock::now();
+    const double dfHistElapsed =
+        std::chrono::duration<double>(end - start).count();
+
+    printf("%-8s nodata=%d mask=%d: statistics %.3f s, histogram %.3f s\n",
+           pszName, bNoData, bMask, dfStatsElapsed, dfHistElapsed);
+
+    if (dfMin != sRef.dfMin || dfMax != sRef.dfMax ||
+        !IsClose(dfMean, sRef.dfMean) || !IsClose(dfStdDev, sRef.dfStdDev))
+    {
+        fprintf(stderr,
+                "Wrong statistics: got min=%.17g max=%.17g mean=%.17g "
+                "stddev=%.17g, expected min=%.17g max=%.17g mean=%.17g "
+                "stddev=%.17g\n",
+                dfMin, dfMax, dfMean, dfStdDev, sRef.dfMin, sRef.dfMax,
+                sRef.dfMean, sRef.dfStdDev);
+        return false;
+    }
+    if (anHistogram != sRef.anHistogram)
+    {
+        fprintf(stderr, "Wrong histogram\n");
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+    CSLDestroy(argv);
+
+    GDALAllRegister();
+    GDALDriver *poMEMDriver = GetGDALDriverManager()->GetDriverByName("MEM");
+    if (poMEMDriver == nullptr)
+    {
+        fprintf(stderr, "MEM driver not available\n");
+        return 1;
+    }
+
+    bool bOK = true;
+    for (int i = 0; i < 3; ++i)
+    {
+        const bool bNoData = i == 1;
+        const bool bMask = i == 2;
+        bOK &= Bench<GInt16>(poMEMDriver, GDT_Int16, "Int16", bNoData, bMask);
+        bOK &= Bench<float>(poMEMDriver, GDT_Float32, "Float32", bNoData,
+                            bMask);
+        bOK &= Bench<double>(poMEMDriver, GDT_Float64, "Float64", bNoData,
+                             bMask);
+    }
+
+    GDALDestroyDriverManager();
+    return bOK ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance and memory usage of the block cache allocator.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Usage: testperfblockcache [--config GDAL_CACHE_ALLOCATOR SLAB]
+//                           [--config GDAL_CACHE_HUGE_PAGES YES]
+//
+// Cycles through many blocks of different sizes with a small block cache,
+// as a long running server would do, and reports the elapsed time and the
+// resident set size of the process.
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+class PerfDataset;
+
+class PerfRasterBand final : public GDALRasterBand
+{
+  public:
+    PerfRasterBand(PerfDataset *poDSIn, GDALDataType eDT, int nBlockSize);
+
+  protected:
+    CPLErr IReadBlock(int nXBlock, int nYBlock, void *pData) override
+    {
+        memset(pData, (nXBlock + nYBlock) & 0xff,
+               static_cast<size_t>(nBlockXSize) * nBlockYSize *
+                   GDALGetDataTypeSizeBytes(eDataType));
+        return CE_None;
+    }
+};
+
+class PerfDataset final : public GDALDataset
+{
+  public:
+    PerfDataset(GDALDataType eDT, int nBlockSize)
+    {
+        nRasterXSize = 1024 * 1024;
+        nRasterYSize = 1024 * 1024;
+        SetBand(1, new PerfRasterBand(this, eDT, nBlockSize));
+    }
+};
+
+PerfRasterBand::PerfRasterBand(PerfDataset *poDSIn, GDALDataType eDT,
+                               int nBlockSize)
+{
+    poDS = poDSIn;
+    nBand = 1;
+    eDataType = eDT;
+    nRasterXSize = poDSIn->GetRasterXSize();
+    nRasterYSize = poDSIn->GetRasterYSize();
+    nBlockXSize = nBlockSize;
+    nBlockYSize = nBlockSize;
+}
+
+GIntBig GetRSS()
+{
+#ifdef __linux__
+    FILE *f = fopen("/proc/self/statm", "rb");
+    if (f)
+    {
+        long nSize = 0;
+        long nResident = 0;
+        const int nRead = fscanf(f, "%ld %ld", &nSize, &nResident);
+        fclose(f);
+        if (nRead == 2)
+            return static_cast<GIntBig>(nResident) * CPLGetPageSize();
+    }
+#endif
+    return -1;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+    CSLDestroy(argv);
+
+    GDALSetCacheMax64(64 * 1024 * 1024);
+
+    // Mix of block sizes typical of tiled rasters.
+    std::vector<std::unique_ptr<PerfDataset>> apoDS;
+    apoDS.push_back(std::make_unique<PerfDataset>(GDT_Byte, 256));
+    apoDS.push_back(std::make_unique<PerfDataset>(GDT_UInt16, 256));
+    apoDS.push_back(std::make_unique<PerfDataset>(GDT_Float32, 256));
+    apoDS.push_back(std::make_unique<PerfDataset>(GDT_Byte, 512));
+
+    constexpr int N_ITERS = 2 * 1000 * 1000;
+    const auto start = std::chrono::steady_clock::now();
+    GIntBig nMaxRSS = 0;
+    unsigned nSeed = 0;
+    for (int i = 0; i < N_ITERS; ++i)
+    {
+        nSeed = nSeed * 1103515245U + 12345U;
+        auto poBand = apoDS[(nSeed >> 16) % apoDS.size()]->GetRasterBand(1);
+        const int nBlockX = static_cast<int>((nSeed >> 8) % 2048);
+        const int nBlockY = i % 1024;
+        GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(nBlockX, nBlockY);
+        if (poBlock == nullptr)
+            return 1;
+        poBlock->DropLock();
+        if ((i % 100000) == 0)
+            nMaxRSS = std::max(nMaxRSS, GetRSS());
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    printf("Allocator: %s%s\n",
+           CPLGetConfigOption("GDAL_CACHE_ALLOCATOR", "MALLOC"),
+           CPLTestBool(CPLGetConfigOption("GDAL_CACHE_HUGE_PAGES", "NO"))
+               ? " (huge pages)"
+               : "");
+    printf("Elapsed: %.2f s\n",
+           std::chrono::duration<double>(end - start).count());
+    printf("Block cache used: " CPL_FRMT_GIB " MB\n",
+           GDALGetCacheUsed64() / (1024 * 1024));
+    if (nMaxRSS > 0)
+    {
+        printf("Max RSS: " CPL_FRMT_GIB " MB\n", nMaxRSS / (1024 * 1024));
+        // Difference between the memory held by the process and the memory
+        // held by the block cache, mostly due to heap fragmentation.
+        printf("Overhead: " CPL_FRMT_GIB " MB\n",
+               (GetRSS() - GDALGetCacheUsed64()) / (1024 * 1024));
+    }
+
+    apoDS.clear();
+    if (nMaxRSS > 0)
+    {
+        // Emptying the cache gives the slabs back to the system.
+        GDALSetCacheMax64(0);
+        printf("RSS after emptying the cache: " CPL_FRMT_GIB " MB\n",
+               GetRSS() / (1024 * 1024));
+    }
+    GDALDestroyDriverManager();
+    return 0;
+}
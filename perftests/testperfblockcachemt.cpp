@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Project:  GDAL Core
+ * Purpose:  Test performance of concurrent block cache hits.
+ *
+ ******************************************************************************
+ * Copyright (c) 2025, GDAL contributors
+ *
+ * SPDX-License-Identifier: MIT
+ ****************************************************************************/
+
+// Usage: testperfblockcachemt [-threads N] [-iters N]
+//                             [--config GDAL_BAND_BLOCK_CACHE HASHSET]
+//                             [--config GDAL_CACHE_POLICY CLOCK]
+//
+// Several threads repeatedly acquire blocks of the same band that are all in
+// the block cache, which exercises the cache hit path of
+// GDALRasterBand::GetLockedBlockRef().
+
+#include "gdal_priv.h"
+#include "cpl_conv.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class PerfDataset;
+
+class PerfRasterBand final : public GDALRasterBand
+{
+  public:
+    explicit PerfRasterBand(PerfDataset *poDSIn);
+
+  protected:
+    CPLErr IReadBlock(int, int, void *pData) override
+    {
+        memset(pData, 0, static_cast<size_t>(nBlockXSize) * nBlockYSize);
+        return CE_None;
+    }
+};
+
+class PerfDataset final : public GDALDataset
+{
+  public:
+    PerfDataset()
+    {
+        nRasterXSize = 64 * 256;
+        nRasterYSize = 64 * 256;
+        SetBand(1, new PerfRasterBand(this));
+    }
+};
+
+PerfRasterBand::PerfRasterBand(PerfDataset *poDSIn)
+{
+    poDS = poDSIn;
+    nBand = 1;
+    eDataType = GDT_Byte;
+    nRasterXSize = poDSIn->GetRasterXSize();
+    nRasterYSize = poDSIn->GetRasterYSize();
+    nBlockXSize = 256;
+    nBlockYSize = 256;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    if (argc < 1)
+        return 1;
+
+    int nThreads = CPLGetNumCPUs();
+    int nIters = 10 * 1000 * 1000;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+            nThreads = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "-iters") == 0 && i + 1 < argc)
+            nIters = std::max(1, atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "Usage: testperfblockcachemt [-threads N] "
+                            "[-iters N]\n");
+            CSLDestroy(argv);
+            return 1;
+        }
+    }
+    CSLDestroy(argv);
+
+    // 64 x 64 blocks of 64 KB: large enough to exceed CPU caches, small
+    // enough to fit in the block cache.
+    GDALSetCacheMax64(1024 * 1024 * 1024);
+    PerfDataset oDS;
+    GDALRasterBand *poBand = oDS.GetRasterBand(1);
+    const int nBlocksPerRow = 64;
+    const int nBlocks = nBlocksPerRow * nBlocksPerRow;
+
+    // Load all blocks in the cache from a single thread, as the miss path
+    // is not thread-safe on a same band.
+    for (int i = 0; i < nBlocks; ++i)
+    {
+        GDALRasterBlock *poBlock =
+            poBand->GetLockedBlockRef(i % nBlocksPerRow, i / nBlocksPerRow);
+        if (poBlock == nullptr)
+            return 1;
+        poBlock->DropLock();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> aoThreads;
+    for (int iThread = 0; iThread < nThreads; ++iThread)
+    {
+        aoThreads.emplace_back(
+            [poBand, nIters, nThreads, nBlocks, nBlocksPerRow, iThread]()
+            {
+                unsigned nSeed = static_cast<unsigned>(iThread);
+                for (int i = 0; i < nIters / nThreads; ++i)
+                {
+                    nSeed = nSeed * 1103515245U + 12345U;
+                    const int nBlock = static_cast<int>((nSeed >> 8) % nBlocks);
+                    GDALRasterBlock *poBlock = poBand->GetLockedBlockRef(
+                        nBlock % nBlocksPerRow, nBlock / nBlocksPerRow);
+                    if (poBlock == nullptr)
+                    {
+                        fprintf(stderr, "Unexpected cache miss\n");
+                        exit(1);
+                    }
+                    poBlock->DropLock();
+                }
+            });
+    }
+    for (auto &oThread : aoThreads)
+        oThread.join();
+    const auto end = std::chrono::steady_clock::now();
+
+    const double dfElapsed = std::chrono::duration<double>(end - start).count();
+    printf("Band block cache: %s\n",
+           CPLGetConfigOption("GDAL_BAND_BLOCK_CACHE", "AUTO"));
+    printf("Cache policy: %s\n",
+           CPLGetConfigOption("GDAL_CACHE_POLICY", "LRU"));
+    printf("Threads: %d\n", nThreads);
+    printf("Elapsed: %.2f s\n", dfElapsed);
+    printf("Million block acquisitions per second: %.2f\n",
+           nIters / dfElapsed / 1e6);
+    return 0;
+}
@@ -52,6 +52,8 @@ int main(int /* argc */, char * /* argv */[])
     void *in = calloc(1, 256 * 256 * 16);
     void *out = malloc(256 * 256 * 16);
 
+    // The AVX2 code path of GDALCopyWords() can be disabled by setting the
+    // GDAL_USE_AVX2=NO environment variable (only honoured in debug builds).
     for (int intype = GDT_Byte; intype < GDT_TypeCount; intype++)
     {
         for (int outtype = GDT_Byte; outtype < GDT_TypeCount; outtype++)
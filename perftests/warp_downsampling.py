@@ -0,0 +1,57 @@
+# SPDX-License-Identifier: MIT
+# Copyright 2025, GDAL contributors
+
+# Benchmark of the downsampling warp kernels (average, mode and quantiles),
+# by an integer factor and by a non-integer factor.
+
+import array
+import timeit
+
+from osgeo import gdal
+
+SIZE = 1024 * 8
+NITERS = 3
+
+
+def create_dataset(data_type, typecode):
+    ds = gdal.GetDriverByName("MEM").Create("", SIZE, SIZE, 1, data_type)
+    ds.SetGeoTransform([0, 1, 0, SIZE, 0, -1])
+    # Few distinct values, as in a land-cover classification
+    pattern = array.array(typecode, ((x // 7) % 20 for x in range(2 * SIZE)))
+    for y in range(SIZE):
+        row = pattern[y % SIZE : y % SIZE + SIZE]
+        ds.GetRasterBand(1).WriteRaster(0, y, SIZE, 1, row.tobytes())
+    return ds
+
+
+datasets = {
+    "Byte": create_dataset(gdal.GDT_Byte, "B"),
+    "UInt16": create_dataset(gdal.GDT_UInt16, "H"),
+}
+
+
+def warp(type_name, alg_name, factor):
+    gdal.Warp(
+        "",
+        datasets[type_name],
+        format="MEM",
+        resampleAlg=alg_name,
+        xRes=factor,
+        yRes=factor,
+    )
+
+
+for type_name in datasets:
+    for alg_name in ("average", "mode", "med", "q1"):
+        for factor in (4, 10, 7.5):
+            print(
+                "%s %s x%s: %.3f"
+                % (
+                    type_name,
+                    alg_name,
+                    factor,
+                    timeit.timeit(
+                        lambda: warp(type_name, alg_name, factor), number=NITERS
+                    ),
+                )
+            )
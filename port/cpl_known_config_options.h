@@ -222,10 +222,17 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "FORCE_BLOCKSIZE", // from hfaopen.cpp
    "GDAL_ALLOW_LARGE_LIBJPEG_MEM_ALLOC", // from JPEG_band.cpp, jpgdataset.cpp
    "GDAL_ALLOW_REMOTE_RESOURCE_TO_ACCESS_LOCAL_FILE", // from vsikerchunk.cpp
+   "GDAL_APPROX_TRANSFORMER_CACHE_SIZE", // from gdaltransformer.cpp
+   "GDAL_APPROX_TRANSFORMER_GRID_STEP", // from gdaltransformer.cpp
    "GDAL_BAG_BLOCK_SIZE", // from bagdataset.cpp
    "GDAL_BAG_MAX_SIZE_VARRES_MAP", // from bagdataset.cpp
    "GDAL_BAND_BLOCK_CACHE", // from gdalrasterband.cpp
+   "GDAL_CACHE_ALLOCATOR", // from gdalrasterblock.cpp
+   "GDAL_CACHE_COMPRESSED_MAX", // from gdalrasterblock.cpp
+   "GDAL_CACHE_COMPRESSOR", // from gdalrasterblock.cpp
    "GDAL_CACHE_DIRECTORY", // from gdal_misc.cpp
+   "GDAL_CACHE_HUGE_PAGES", // from gdalrasterblock.cpp
+   "GDAL_CACHE_POLICY", // from gdalrasterblock.cpp
    "GDAL_CACHEMAX", // from gdalrasterblock.cpp, nearblack_bin.cpp
    "GDAL_CONFIG_FILE", // from cpl_conv.cpp
    "GDAL_CURL_CA_BUNDLE", // from cpl_http.cpp
@@ -348,6 +355,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_OVR_CHUNK_MAX_SIZE_FOR_TEMP_FILE", // from overview.cpp
    "GDAL_OVR_CHUNKYSIZE", // from overview.cpp
    "GDAL_OVR_PROPAGATE_NODATA", // from overview.cpp
+   "GDAL_OVR_SINGLE_PASS", // from overview.cpp
    "GDAL_OVR_TEMP_DRIVER", // from overview.cpp
    "GDAL_PAM_ENABLE_MARK_DIRTY", // from gdalpamdataset.cpp
    "GDAL_PAM_ENABLED", // from gdalpamdataset.cpp
@@ -386,6 +394,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK", // from gdalrasterblock.cpp
    "GDAL_RB_LOCK_DEBUG_CONTENTION", // from gdalrasterblock.cpp
    "GDAL_RB_LOCK_TYPE", // from gdalrasterblock.cpp
+   "GDAL_RB_SHARDS", // from gdalrasterblock.cpp
    "GDAL_RB_TRYGET_SLEEP_AFTER_TAKE_LOCK", // from gdalrasterblock.cpp
    "GDAL_READDIR_LIMIT_ON_OPEN", // from gdalopeninfo.cpp, gtiffdataset_read.cpp, tiledbdense.cpp
    "GDAL_REPORT_DIRTY_BLOCK_FLUSHING", // from gdalabstractbandblockcache.cpp
@@ -394,6 +403,8 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_SIMUL_MEM_ALLOC_FAILURE_NODATA_MASK_BAND", // from gdalnodatamaskband.cpp
    "GDAL_SKIP", // from gdaldrivermanager.cpp
    "GDAL_STACTA_SKIP_MISSING_METATILE", // from stactadataset.cpp
+   "GDAL_STATS_APPROX_MAX_BYTES", // from gdalrasterband.cpp
+   "GDAL_STATS_APPROX_SAMPLING", // from gdalrasterband.cpp
    "GDAL_SWATH_SIZE", // from gdalmultidim.cpp, rasterio.cpp
    "GDAL_TEMP_DRIVER_NAME", // from nearblack_lib_floodfill.cpp
    "GDAL_TERM_PROGRESS_OSC_9_4", // from cpl_progress.cpp
@@ -406,6 +417,7 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "GDAL_TIFF_OVR_BLOCKSIZE", // from geotiff.cpp
    "GDAL_TRY_PDS3_WITH_VICAR", // from pdsdrivercore.cpp
    "GDAL_USE_AVX", // from gdalgrid.cpp
+   "GDAL_USE_AVX2", // from cpl_cpu_features.cpp
    "GDAL_USE_GEOJP2", // from gdaljp2metadata.cpp
    "GDAL_USE_GMLJP2", // from gdaljp2metadata.cpp
    "GDAL_USE_SSE", // from gdalgrid.cpp
@@ -1034,9 +1046,12 @@ constexpr static const char* const apszKnownConfigOptions[] =
    "USERNAME", // from gdal_misc.cpp, gdalwmscache.cpp, isis3dataset.cpp, wcsutils.cpp
    "USERPROFILE", // from cpl_aws.cpp, cpl_azure.cpp, cpl_conv.cpp, cpl_google_cloud.cpp, cpl_path.cpp, gdal_misc.cpp, gdalwmscache.cpp, wcsutils.cpp
    "VRT_ALLOW_MEM_DRIVER", // from vrtrasterband.cpp
+   "VRT_LAZY_SOURCES", // from vrtsourcedrasterband.cpp
    "VRT_MIN_MAX_FROM_SOURCES", // from vrtsourcedrasterband.cpp
    "VRT_NUM_THREADS", // from vrtdataset.cpp
    "VRT_SHARED_SOURCE", // from vrtsources.cpp
+   "VRT_SOURCES_CACHE", // from vrtdataset.cpp
+   "VRT_VECTORIZED_EXPRESSION", // from pixelfunctions.cpp
    "VRT_VIRTUAL_OVERVIEWS", // from gdalbuildvrt_lib.cpp, vrtdataset.cpp
    "VSI_CACHE", // from cpl_vsil_curl.cpp, cpl_vsil_curl_streaming.cpp, cpl_vsil_unix_stdio_64.cpp, cpl_vsil_win32.cpp
    "VSI_CACHE_SIZE", // from cpl_vsil_cache.cpp
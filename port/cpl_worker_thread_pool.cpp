@@ -83,6 +83,23 @@ int CPLWorkerThreadPool::GetThreadCount() const
     return m_nMaxThreads;
 }
 
+/************************************************************************/
+/*                       IsCurrentThreadWorker()                        */
+/************************************************************************/
+
+/** Return whether the calling thread is a worker thread of this pool.
+ *
+ * A job that waits for the completion of other jobs of the same pool may
+ * deadlock if all worker threads are busy, so callers running as a job can
+ * use this to process their work serially instead.
+ *
+ * @since GDAL 3.12
+ */
+bool CPLWorkerThreadPool::IsCurrentThreadWorker() const
+{
+    return threadLocalCurrentThreadPool == this;
+}
+
 /************************************************************************/
 /*                       WorkerThreadFunction()                         */
 /************************************************************************/
@@ -103,6 +103,8 @@ class CPL_DLL CPLWorkerThreadPool
 
     /** Return the number of threads setup */
     int GetThreadCount() const;
+
+    bool IsCurrentThreadWorker() const;
 };
 
 /** Job queue */